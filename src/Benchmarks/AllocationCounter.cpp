@@ -0,0 +1,94 @@
+//---------------------------------------------------------------------------------------------------------------------
+// AllocationCounter.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class AllocationCounter.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @class AllocationCounter
+ * @brief The AllocationCounter class counts the allocations made with operator new.
+ * @since 0.2.0
+ * @ingroup Benchmarks
+ *
+ * The benchmark program replaces the global operators new and delete by versions counting each allocation, so that
+ * benchmarks can report how many objects an operation allocates: take count() before and after the operation and
+ * subtract. Buffers Qt allocates with malloc() directly - e.g. the data of QString and QList - are not counted, and on
+ * Windows only allocations made by the program itself are counted, not those made inside the Qt libraries.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Replaced global operators
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static std::atomic<quint64> allocations(0);
+
+void* operator new(std::size_t size)
+{
+   allocations.fetch_add(1, std::memory_order_relaxed);
+   void* ptr = std::malloc(size > 0 ? size : 1);
+   if (ptr == nullptr) throw std::bad_alloc();
+   return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+   return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+   std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+   std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+   std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+   std::free(ptr);
+}
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Gets the number of allocations made with operator new since the program started. */
+quint64 AllocationCounter::count()
+{
+   return allocations.load(std::memory_order_relaxed);
+}
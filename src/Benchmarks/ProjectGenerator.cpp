@@ -0,0 +1,415 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectGenerator.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ProjectGenerator.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ProjectGenerator.h"
+
+#include "DiaEdge.h"
+#include "DiaNode.h"
+#include "UmlAssociation.h"
+#include "UmlAttribute.h"
+#include "UmlClass.h"
+#include "UmlDependency.h"
+#include "UmlDiagram.h"
+#include "UmlElementFactory.h"
+#include "UmlGeneralization.h"
+#include "UmlModel.h"
+#include "UmlOperation.h"
+#include "UmlPackage.h"
+#include "UmlProject.h"
+#include "UmlRoot.h"
+#include "UmlTemplateParameter.h"
+
+#include <QHash>
+#include <QObject>
+#include <QtMath>
+
+#include <random>
+
+/**
+ * @class ProjectGenerator
+ * @brief The ProjectGenerator class fills a project with synthetic elements and diagrams for benchmarks.
+ * @since 0.2.0
+ * @ingroup Benchmarks
+ *
+ * The ProjectGenerator class creates a model of configurable size and shape through the UmlElementFactory, the same
+ * way the GUI creates new elements:
+ * - one model containing packages() packages,
+ * - classes() classes per package, each with attributes() attributes and operations() operations, the first
+ *   templates() classes of each package with a template parameter,
+ * - links() links per class to other classes picked at random: generalizations to classes created before (so that
+ *   the class hierarchy is free of cycles), dependencies and associations,
+ * - diagrams() class diagrams showing nodes() consecutive classes each, arranged in a grid, together with all links
+ *   between them.
+ *
+ * The random choices are made with a generator seeded by seed(), so the same settings always produce projects of the
+ * same shape. The diagrams are saved by generate(), so the project must have been created with UmlProject::create()
+ * or loaded before. The element classes must have been registered with initCommon() and initClassifiers().
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const double KGridX = 200.0; ///< Horizontal distance of the nodes of a generated diagram.
+static const double KGridY = 160.0; ///< Vertical distance of the nodes of a generated diagram.
+
+struct ProjectGenerator::Data
+{
+   Data()
+   : packages(10)
+   , classes(20)
+   , attributes(4)
+   , operations(4)
+   , templates(0)
+   , links(2)
+   , diagrams(10)
+   , nodes(50)
+   , seed(1)
+   , count(0)
+   {
+   }
+
+   int     packages;
+   int     classes;
+   int     attributes;
+   int     operations;
+   int     templates;
+   int     links;
+   int     diagrams;
+   int     nodes;
+   quint32 seed;
+   int     count;
+   QString errorString;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the ProjectGenerator class. */
+ProjectGenerator::ProjectGenerator()
+: data(new Data())
+{
+}
+
+ProjectGenerator::~ProjectGenerator()
+{
+   delete data;
+}
+
+/** Gets the number of packages to generate; the default is 10. */
+int ProjectGenerator::packages() const
+{
+   return data->packages;
+}
+
+/** Sets the number of packages to generate (at least 1). */
+void ProjectGenerator::setPackages(int value)
+{
+   data->packages = qMax(1, value);
+}
+
+/** Gets the number of classes to generate per package; the default is 20. */
+int ProjectGenerator::classes() const
+{
+   return data->classes;
+}
+
+/** Sets the number of classes to generate per package. */
+void ProjectGenerator::setClasses(int value)
+{
+   data->classes = qMax(0, value);
+}
+
+/** Gets the number of attributes to generate per class; the default is 4. */
+int ProjectGenerator::attributes() const
+{
+   return data->attributes;
+}
+
+/** Sets the number of attributes to generate per class. */
+void ProjectGenerator::setAttributes(int value)
+{
+   data->attributes = qMax(0, value);
+}
+
+/** Gets the number of operations to generate per class; the default is 4. */
+int ProjectGenerator::operations() const
+{
+   return data->operations;
+}
+
+/** Sets the number of operations to generate per class. */
+void ProjectGenerator::setOperations(int value)
+{
+   data->operations = qMax(0, value);
+}
+
+/** Gets the number of template classes to generate per package; the default is 0. */
+int ProjectGenerator::templates() const
+{
+   return data->templates;
+}
+
+/** Sets the number of template classes to generate per package. */
+void ProjectGenerator::setTemplates(int value)
+{
+   data->templates = qMax(0, value);
+}
+
+/** Gets the number of links to generate per class; the default is 2. */
+int ProjectGenerator::links() const
+{
+   return data->links;
+}
+
+/** Sets the number of links to generate per class. */
+void ProjectGenerator::setLinks(int value)
+{
+   data->links = qMax(0, value);
+}
+
+/** Gets the number of diagrams to generate; the default is 10. */
+int ProjectGenerator::diagrams() const
+{
+   return data->diagrams;
+}
+
+/** Sets the number of diagrams to generate. */
+void ProjectGenerator::setDiagrams(int value)
+{
+   data->diagrams = qMax(0, value);
+}
+
+/** Gets the number of nodes per generated diagram; the default is 50. */
+int ProjectGenerator::nodes() const
+{
+   return data->nodes;
+}
+
+/** Sets the number of nodes per generated diagram; limited to the number of classes generated. */
+void ProjectGenerator::setNodes(int value)
+{
+   data->nodes = qMax(0, value);
+}
+
+/** Gets the seed of the random choices; the default is 1. */
+quint32 ProjectGenerator::seed() const
+{
+   return data->seed;
+}
+
+/** Sets the seed of the random choices. */
+void ProjectGenerator::setSeed(quint32 value)
+{
+   data->seed = value;
+}
+
+/** Gets the settings of the generator as JSON object, e.g. to be stored with the results of a benchmark. */
+QJsonObject ProjectGenerator::settings() const
+{
+   QJsonObject json;
+   json["packages"] = data->packages;
+   json["classes"] = data->classes;
+   json["attributes"] = data->attributes;
+   json["operations"] = data->operations;
+   json["templates"] = data->templates;
+   json["links"] = data->links;
+   json["diagrams"] = data->diagrams;
+   json["nodes"] = data->nodes;
+   json["seed"] = (qint64)data->seed;
+   return json;
+}
+
+/** Gets the number of elements created by the last call of generate(). */
+int ProjectGenerator::elementCount() const
+{
+   return data->count;
+}
+
+/** Gets a description of the last error; empty if the last call of generate() was successful. */
+QString ProjectGenerator::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Generates the elements and diagrams and inserts them into a project.
+ *
+ * @param project Project to fill (must not be nullptr).
+ * @return True, if all elements were created and all diagrams saved; otherwise false (see errorString()).
+ */
+bool ProjectGenerator::generate(UmlProject* project)
+{
+   Q_ASSERT(project != nullptr);
+   data->errorString.clear();
+   data->count = 0;
+
+   const QString modelClass = UmlModel::staticMetaObject.className();
+   const QString packageClass = UmlPackage::staticMetaObject.className();
+   const QString classClass = UmlClass::staticMetaObject.className();
+   const QString attributeClass = UmlAttribute::staticMetaObject.className();
+   const QString operationClass = UmlOperation::staticMetaObject.className();
+   const QString diagramClass = UmlDiagram::staticMetaObject.className();
+   const QString linkClasses[] =
+   {
+      UmlGeneralization::staticMetaObject.className(),
+      UmlDependency::staticMetaObject.className(),
+      UmlAssociation::staticMetaObject.className()
+   };
+
+   auto& factory = UmlElementFactory::instance();
+   for (auto className : { modelClass, packageClass, classClass, attributeClass, operationClass, diagramClass,
+      linkClasses[0], linkClasses[1], linkClasses[2] })
+   {
+      if (!factory.isSubscribed(className))
+      {
+         data->errorString = QObject::tr("Element class '%1' is not registered.").arg(className);
+         return false;
+      }
+   }
+
+   auto create = [&](const QString& className, UmlCompositeElement* owner)
+   {
+      auto* elem = project->insertNew(className);
+      owner->append(elem);
+      ++data->count;
+      return elem;
+   };
+
+   std::mt19937 random(data->seed);
+
+   // Containment tree:
+   auto* model = static_cast<UmlModel*>(create(modelClass, project->root()));
+   model->setName("Model");
+
+   QList<UmlPackage*> packages;
+   QList<UmlClass*> classes;
+   for (int pkgIndex = 0; pkgIndex < data->packages; ++pkgIndex)
+   {
+      auto* package = static_cast<UmlPackage*>(create(packageClass, model));
+      package->setName(QString("Package%1").arg(pkgIndex + 1));
+      packages.append(package);
+
+      for (int clsIndex = 0; clsIndex < data->classes; ++clsIndex)
+      {
+         auto* cls = static_cast<UmlClass*>(create(classClass, package));
+         cls->setName(QString("Class%1").arg(classes.size() + 1));
+         classes.append(cls);
+
+         if (clsIndex < data->templates)
+         {
+            auto* parameter = new UmlTemplateParameter();
+            parameter->setName("T");
+            parameter->setType("class");
+            cls->append(parameter);
+         }
+
+         for (int index = 0; index < data->attributes; ++index)
+         {
+            auto* attribute = static_cast<UmlAttribute*>(create(attributeClass, cls));
+            attribute->setName(QString("attribute%1").arg(index + 1));
+            attribute->setVisibility(VisibilityKind::Private);
+            attribute->setType("int");
+         }
+
+         for (int index = 0; index < data->operations; ++index)
+         {
+            auto* operation = static_cast<UmlOperation*>(create(operationClass, cls));
+            operation->setName(QString("operation%1").arg(index + 1));
+            operation->setVisibility(VisibilityKind::Public);
+            operation->setReturnType("void");
+         }
+      }
+   }
+
+   // Links between classes, owned by the package of their source:
+   int classCount = classes.size();
+   QHash<UmlElement*, QList<UmlLink*>> outgoing;
+   for (int source = 0; source < classCount && classCount > 1; ++source)
+   {
+      for (int index = 0; index < data->links; ++index)
+      {
+         int target = (int)(random() % (quint32)(classCount - 1));
+         if (target >= source) ++target;
+
+         int kind = index % 3;
+         if (kind == 0 && target > source) kind = 1;
+
+         auto* link = static_cast<UmlLink*>(create(linkClasses[kind], packages[source / data->classes]));
+         link->setSource(classes[source]);
+         link->setTarget(classes[target]);
+         outgoing[classes[source]].append(link);
+      }
+   }
+
+   // Diagrams showing consecutive classes and the links between them:
+   int nodeCount = qMin(data->nodes, classCount);
+   int columns = qCeil(qSqrt(nodeCount));
+   for (int diaIndex = 0; diaIndex < data->diagrams; ++diaIndex)
+   {
+      auto* diagram = static_cast<UmlDiagram*>(create(diagramClass, packages[diaIndex % packages.size()]));
+      diagram->setName(QString("Diagram%1").arg(diaIndex + 1));
+      diagram->setKind(DiagramKind::Class);
+      if (!diagram->open())
+      {
+         data->errorString = diagram->errorString();
+         diagram->close();
+         return false;
+      }
+
+      int first = classCount > 0 ? (int)(random() % (quint32)classCount) : 0;
+      QHash<UmlElement*, DiaNode*> shown;
+      for (int index = 0; index < nodeCount; ++index)
+      {
+         auto* cls = classes[(first + index) % classCount];
+         auto* node = diagram->addNode(cls);
+         node->setPos(QPointF((index % columns) * KGridX, (index / columns) * KGridY));
+         shown.insert(cls, node);
+      }
+
+      for (auto iter = shown.cbegin(); iter != shown.cend(); ++iter)
+      {
+         for (auto* link : outgoing.value(iter.key()))
+         {
+            if (!shown.contains(link->target())) continue;
+
+            auto* edge = diagram->addEdge(link);
+            edge->setShape1(iter.value());
+            edge->setShape2(shown.value(link->target()));
+         }
+      }
+
+      bool saved = diagram->save();
+      if (!saved) data->errorString = diagram->errorString();
+      diagram->close();
+      if (!saved) return false;
+   }
+
+   return true;
+}
@@ -0,0 +1,82 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectGenerator.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class ProjectGenerator.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+class UmlProject;
+
+class ProjectGenerator final
+{
+public: // Constructors
+   ProjectGenerator();
+   ~ProjectGenerator();
+
+public: // Properties
+   int packages() const;
+   void setPackages(int value);
+
+   int classes() const;
+   void setClasses(int value);
+
+   int attributes() const;
+   void setAttributes(int value);
+
+   int operations() const;
+   void setOperations(int value);
+
+   int templates() const;
+   void setTemplates(int value);
+
+   int links() const;
+   void setLinks(int value);
+
+   int diagrams() const;
+   void setDiagrams(int value);
+
+   int nodes() const;
+   void setNodes(int value);
+
+   quint32 seed() const;
+   void setSeed(quint32 value);
+
+   QJsonObject settings() const;
+
+   int elementCount() const;
+   QString errorString() const;
+
+public: // Methods
+   bool generate(UmlProject* project);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -0,0 +1,429 @@
+//---------------------------------------------------------------------------------------------------------------------
+// RenderBenchmark.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class RenderBenchmark.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "RenderBenchmark.h"
+#include "AllocationCounter.h"
+#include "ProjectGenerator.h"
+
+#include "Viraqucha.h"
+#include "Tracer.h"
+
+#include "AssociationShape.h"
+#include "ClassifierShape.h"
+#include "CommentShape.h"
+#include "DependencyShape.h"
+#include "DiagramScene.h"
+#include "GeneralizationShape.h"
+#include "LinkShape.h"
+#include "PrimitiveTypeShape.h"
+#include "RealizationShape.h"
+#include "TemplateBox.h"
+
+#include "UmlDiagram.h"
+#include "UmlProject.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QJsonArray>
+#include <QMap>
+#include <QObject>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QVector>
+
+/**
+ * @class RenderBenchmark
+ * @brief The RenderBenchmark class measures how long painting diagrams takes.
+ * @since 0.2.0
+ * @ingroup Benchmarks
+ *
+ * The RenderBenchmark class generates a project with the settings of generator() in folder(), builds a DiagramScene
+ * for each of its diagrams and renders it into a QImage of viewSize() the way a view would, without a display:
+ * - For each of the zoomLevels() it renders frames() frames of the area around the center of the diagram and reports
+ *   the average time per frame, the frames per second and the allocations per frame (see AllocationCounter). One frame
+ *   per zoom level is rendered before measuring, so caches of the shapes are filled (see DiagramScene::isCaching()).
+ *   The Tracer counters per frame - items painted, texts measured, text cache hits, reroutes - are reported as well;
+ *   they are the numbers the performance HUD of DiagramView shows for a frame.
+ * - For each class of shapes - ClassifierShape, EdgeShape and its subclasses, TemplateBox and so on - it paints all
+ *   shapes of the class frames() times one by one at zoom level 1, bypassing any caches, and reports the time and
+ *   allocations per paint.
+ *
+ * The results are collected in a JSON object (see results()) so that they can be stored and compared by scripts:
+ * ~~~{.json}
+ * {
+ *    "benchmark": "render",
+ *    "version": "0.2.0",
+ *    "timestamp": "2026-10-18T10:00:00Z",
+ *    "settings": { "packages": 10, "classes": 20, ..., "frames": 10, "width": 1280, "height": 800, "caching": false },
+ *    "diagrams": 10,
+ *    "items": 731,
+ *    "zoomLevels": [ { "zoom": 0.25, "frames": 100, "msPerFrame": 8.9, "fps": 112.4, "allocsPerFrame": 1520,
+ *                      "paintedItemsPerFrame": 731, "textMeasurementsPerFrame": 0, ... }, ... ],
+ *    "shapes": [ { "class": "ClassifierShape", "paints": 5000, "usPerPaint": 41.2, "allocsPerPaint": 6.1 }, ... ]
+ * }
+ * ~~~
+ * The benchmark requires a QApplication object; the benchmark program uses the offscreen platform plugin.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const QString KProjectName = "RenderBenchmark";
+
+/** Time, allocations and Tracer counters summed up over a number of paints or frames. */
+struct Measure
+{
+   qint64  count = 0;
+   qint64  nsecs = 0;
+   quint64 allocations = 0;
+   qint64  counters[Tracer::CounterCount] = {};
+};
+
+struct RenderBenchmark::Data
+{
+   Data()
+   : zoomLevels({ 0.25, 0.5, 1.0, 2.0 })
+   , frames(10)
+   , viewSize(1280, 800)
+   , caching(false)
+   {
+   }
+
+   ProjectGenerator       generator;
+   QString                folder;
+   QList<double>          zoomLevels;
+   int                    frames;
+   QSize                  viewSize;
+   bool                   caching;
+   QVector<Measure>       zoomMeasures;
+   QMap<QString, Measure> shapeMeasures;
+   QJsonObject            results;
+   QString                errorString;
+};
+
+/** Gets the name of the class of a shape; subclasses are tested before their base classes. */
+static QString shapeClass(QGraphicsItem* item)
+{
+   if (dynamic_cast<TemplateBox*>(item) != nullptr)         return "TemplateBox";
+   if (dynamic_cast<ClassifierShape*>(item) != nullptr)     return "ClassifierShape";
+   if (dynamic_cast<PrimitiveTypeShape*>(item) != nullptr)  return "PrimitiveTypeShape";
+   if (dynamic_cast<CommentShape*>(item) != nullptr)        return "CommentShape";
+   if (dynamic_cast<AssociationShape*>(item) != nullptr)    return "AssociationShape";
+   if (dynamic_cast<GeneralizationShape*>(item) != nullptr) return "GeneralizationShape";
+   if (dynamic_cast<RealizationShape*>(item) != nullptr)    return "RealizationShape";
+   if (dynamic_cast<DependencyShape*>(item) != nullptr)     return "DependencyShape";
+   if (dynamic_cast<LinkShape*>(item) != nullptr)           return "LinkShape";
+   if (dynamic_cast<EdgeShape*>(item) != nullptr)           return "EdgeShape";
+   if (dynamic_cast<NodeShape*>(item) != nullptr)           return "NodeShape";
+   return "QGraphicsItem";
+}
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the RenderBenchmark class. */
+RenderBenchmark::RenderBenchmark()
+: data(new Data())
+{
+}
+
+RenderBenchmark::~RenderBenchmark()
+{
+   delete data;
+}
+
+/** Gets the generator of the project rendered; change its settings to change the size of the diagrams. */
+ProjectGenerator& RenderBenchmark::generator() const
+{
+   return data->generator;
+}
+
+/** Gets the folder in which the project is created. */
+QString RenderBenchmark::folder() const
+{
+   return data->folder;
+}
+
+/** Sets the folder in which the project is created; it must exist and must not contain a project of the same name. */
+void RenderBenchmark::setFolder(const QString& value)
+{
+   data->folder = value;
+}
+
+/** Gets the zoom levels at which frames are rendered; the default is 0.25, 0.5, 1 and 2. */
+QList<double> RenderBenchmark::zoomLevels() const
+{
+   return data->zoomLevels;
+}
+
+/** Sets the zoom levels at which frames are rendered; levels not greater than zero are ignored. */
+void RenderBenchmark::setZoomLevels(const QList<double>& value)
+{
+   data->zoomLevels.clear();
+   for (double zoom : value)
+   {
+      if (zoom > 0.0) data->zoomLevels.append(zoom);
+   }
+}
+
+/** Gets the number of frames rendered per diagram and zoom level; the default is 10. */
+int RenderBenchmark::frames() const
+{
+   return data->frames;
+}
+
+/** Sets the number of frames rendered per diagram and zoom level (at least 1). */
+void RenderBenchmark::setFrames(int value)
+{
+   data->frames = qMax(1, value);
+}
+
+/** Gets the size of the images rendered in pixels; the default is 1280 x 800. */
+QSize RenderBenchmark::viewSize() const
+{
+   return data->viewSize;
+}
+
+/** Sets the size of the images rendered in pixels. */
+void RenderBenchmark::setViewSize(const QSize& value)
+{
+   data->viewSize = value.expandedTo(QSize(1, 1));
+}
+
+/** Gets a value indicating whether the shapes cache their painting in pixmaps; the default is false. */
+bool RenderBenchmark::isCaching() const
+{
+   return data->caching;
+}
+
+/** Sets a value indicating whether the shapes cache their painting in pixmaps (see DiagramScene::setCaching()). */
+void RenderBenchmark::setCaching(bool value)
+{
+   data->caching = value;
+}
+
+/** Gets the results of the last call of run(). */
+QJsonObject RenderBenchmark::results() const
+{
+   return data->results;
+}
+
+/** Gets a description of the last error; empty if the last call of run() was successful. */
+QString RenderBenchmark::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Generates the project and renders all of its diagrams.
+ *
+ * @return True, if the project could be generated; otherwise false (see errorString()).
+ */
+bool RenderBenchmark::run()
+{
+   auto& gen = data->generator;
+   data->errorString.clear();
+   data->zoomMeasures = QVector<Measure>(data->zoomLevels.size());
+   data->shapeMeasures.clear();
+
+   QJsonObject settings = gen.settings();
+   settings["frames"] = data->frames;
+   settings["width"] = data->viewSize.width();
+   settings["height"] = data->viewSize.height();
+   settings["caching"] = data->caching;
+
+   data->results = QJsonObject();
+   data->results["benchmark"] = "render";
+   data->results["version"] = Viraqucha::KProgramVersion.toString();
+   data->results["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+   data->results["settings"] = settings;
+
+   UmlProject project;
+   if (!project.create(data->folder, KProjectName))
+   {
+      data->errorString = QObject::tr("Cannot create project '%1' in folder '%2'.").arg(KProjectName)
+         .arg(data->folder);
+   }
+   else if (!gen.generate(&project))
+   {
+      data->errorString = gen.errorString();
+   }
+
+   if (!data->errorString.isEmpty())
+   {
+      data->results["error"] = data->errorString;
+      project.dispose();
+      return false;
+   }
+
+   int diagrams = 0, items = 0;
+   for (auto* elem : project.elements())
+   {
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram == nullptr) continue;
+
+      // The scene opens the diagram and closes it again when deleted:
+      DiagramScene scene(diagram, nullptr);
+      scene.setVirtualized(false);
+      scene.setCaching(data->caching);
+      if (scene.diagramRect().isEmpty()) continue;
+
+      ++diagrams;
+      items += scene.items().size();
+      renderFrames(scene);
+      paintShapes(scene);
+   }
+
+   project.dispose();
+
+   QJsonArray zoomLevels;
+   for (int index = 0; index < data->zoomLevels.size(); ++index)
+   {
+      const Measure& measure = data->zoomMeasures[index];
+      double msecs = measure.nsecs / 1.0e6;
+
+      QJsonObject entry;
+      entry["zoom"] = data->zoomLevels[index];
+      entry["frames"] = measure.count;
+      entry["msPerFrame"] = measure.count > 0 ? msecs / measure.count : 0.0;
+      entry["fps"] = msecs > 0.0 ? measure.count * 1000.0 / msecs : 0.0;
+      entry["allocsPerFrame"] = measure.count > 0 ? (double)measure.allocations / measure.count : 0.0;
+      for (int counter = 0; counter < Tracer::CounterCount; ++counter)
+      {
+         QString key = QString(Tracer::counterName(Tracer::Counter(counter))) + "PerFrame";
+         entry[key] = measure.count > 0 ? (double)measure.counters[counter] / measure.count : 0.0;
+      }
+      zoomLevels.append(entry);
+   }
+
+   QJsonArray shapes;
+   for (auto iter = data->shapeMeasures.cbegin(); iter != data->shapeMeasures.cend(); ++iter)
+   {
+      const Measure& measure = iter.value();
+
+      QJsonObject entry;
+      entry["class"] = iter.key();
+      entry["paints"] = measure.count;
+      entry["usPerPaint"] = measure.nsecs / 1.0e3 / measure.count;
+      entry["allocsPerPaint"] = (double)measure.allocations / measure.count;
+      shapes.append(entry);
+   }
+
+   data->results["diagrams"] = diagrams;
+   data->results["items"] = items;
+   data->results["zoomLevels"] = zoomLevels;
+   data->results["shapes"] = shapes;
+   return true;
+}
+
+/** Renders frames() frames of the center of a scene at each of the zoom levels. */
+void RenderBenchmark::renderFrames(DiagramScene& scene)
+{
+   QImage image(data->viewSize, QImage::Format_ARGB32_Premultiplied);
+   QPointF center = scene.diagramRect().center();
+   QElapsedTimer timer;
+
+   for (int index = 0; index < data->zoomLevels.size(); ++index)
+   {
+      QRectF source(QPointF(), QSizeF(data->viewSize) / data->zoomLevels[index]);
+      source.moveCenter(center);
+
+      Measure& measure = data->zoomMeasures[index];
+      for (int frame = -1; frame < data->frames; ++frame)
+      {
+         image.fill(Qt::white);
+         QPainter painter(&image);
+         painter.setRenderHint(QPainter::Antialiasing);
+
+         qint64 counters[Tracer::CounterCount];
+         for (int counter = 0; counter < Tracer::CounterCount; ++counter)
+         {
+            counters[counter] = Tracer::value(Tracer::Counter(counter));
+         }
+
+         quint64 allocations = AllocationCounter::count();
+         timer.start();
+         scene.render(&painter, QRectF(image.rect()), source);
+         qint64 nsecs = timer.nsecsElapsed();
+
+         // Frame -1 fills the caches and is not measured:
+         if (frame < 0) continue;
+         measure.count++;
+         measure.nsecs += nsecs;
+         measure.allocations += AllocationCounter::count() - allocations;
+         for (int counter = 0; counter < Tracer::CounterCount; ++counter)
+         {
+            measure.counters[counter] += Tracer::value(Tracer::Counter(counter)) - counters[counter];
+         }
+      }
+   }
+}
+
+/** Paints all visible shapes of a scene frames() times one by one, measuring each class of shapes separately. */
+void RenderBenchmark::paintShapes(DiagramScene& scene)
+{
+   QRectF area = scene.diagramRect();
+   QImage image(area.size().toSize().boundedTo(QSize(4096, 4096)).expandedTo(QSize(1, 1)),
+      QImage::Format_ARGB32_Premultiplied);
+   image.fill(Qt::white);
+
+   QPainter painter(&image);
+   painter.setRenderHint(QPainter::Antialiasing);
+   QTransform view = QTransform::fromTranslate(-area.left(), -area.top());
+   QElapsedTimer timer;
+
+   auto items = scene.items();
+   for (int frame = 0; frame < data->frames; ++frame)
+   {
+      for (auto* item : items)
+      {
+         if (!item->isVisible()) continue;
+
+         QStyleOptionGraphicsItem option;
+         option.exposedRect = item->boundingRect();
+
+         painter.save();
+         painter.setTransform(item->sceneTransform() * view);
+
+         quint64 allocations = AllocationCounter::count();
+         timer.start();
+         item->paint(&painter, &option, nullptr);
+         qint64 nsecs = timer.nsecsElapsed();
+
+         painter.restore();
+
+         Measure& measure = data->shapeMeasures[shapeClass(item)];
+         measure.count++;
+         measure.nsecs += nsecs;
+         measure.allocations += AllocationCounter::count() - allocations;
+      }
+   }
+}
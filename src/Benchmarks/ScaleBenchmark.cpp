@@ -0,0 +1,335 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ScaleBenchmark.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ScaleBenchmark.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ScaleBenchmark.h"
+#include "ProjectGenerator.h"
+
+#include "Viraqucha.h"
+
+#include "DiagramScene.h"
+
+#include "INamedElement.h"
+#include "CppGenerator.h"
+#include "UmlClass.h"
+#include "UmlCompositeElement.h"
+#include "UmlDiagram.h"
+#include "UmlProject.h"
+#include "UmlRoot.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QJsonArray>
+#include <QObject>
+#include <QPainter>
+
+/**
+ * @class ScaleBenchmark
+ * @brief The ScaleBenchmark class measures how the basic operations on a project scale with its size.
+ * @since 0.2.0
+ * @ingroup Benchmarks
+ *
+ * The ScaleBenchmark class generates a project with the settings of generator() in folder() and times the following
+ * stages, one after the other:
+ * stage    | measures
+ * -------- | ----------------------------------------------------------------------------------------------------
+ * create   | ProjectGenerator::generate(), i.e. creating the elements through the factory and saving the diagrams
+ * save     | UmlProject::save() of the generated project
+ * txsave   | UmlProject::save() of the generated project again, all elements marked modified, in one ProjectTransaction
+ * load     | UmlProject::load() of the saved project
+ * traverse | a walk over the containment tree of the loaded project reading the names of all elements
+ * generate | CppGenerator::generate() of all classifiers into an empty folder
+ * regen    | CppGenerator::generate() again after changing the comment of one class
+ * open     | UmlDiagram::open() and UmlDiagram::close() of all diagrams
+ * render   | building a DiagramScene for each diagram and rendering it offscreen into a QImage
+ * delete   | UmlProject::dispose() of the loaded project
+ *
+ * The results are collected in a JSON object (see results()) so that they can be stored and compared by scripts:
+ * ~~~{.json}
+ * {
+ *    "benchmark": "scale",
+ *    "version": "0.2.0",
+ *    "timestamp": "2026-10-18T10:00:00Z",
+ *    "settings": { "packages": 10, "classes": 20, ... },
+ *    "elements": 2011,
+ *    "named": 2011,
+ *    "stages": [ { "name": "create", "ms": 41.7, "count": 2011 }, ... ]
+ * }
+ * ~~~
+ * Stage render requires a QApplication object; the benchmark program uses the offscreen platform plugin, so no
+ * display is needed.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const QString KProjectName = "ScaleBenchmark";
+static const int     KImageExtent = 2048; ///< Maximum width and height of the images rendered.
+
+struct ScaleBenchmark::Data
+{
+   Data()
+   : rendering(true)
+   {
+   }
+
+   ProjectGenerator generator;
+   QString          folder;
+   bool             rendering;
+   QJsonArray       stages;
+   QJsonObject      results;
+   QString          errorString;
+};
+
+/** Collects the diagrams of a project. */
+static QList<UmlDiagram*> diagramsOf(UmlProject& project)
+{
+   QList<UmlDiagram*> result;
+   for (auto* elem : project.elements())
+   {
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram != nullptr) result.append(diagram);
+   }
+
+   return result;
+}
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the ScaleBenchmark class. */
+ScaleBenchmark::ScaleBenchmark()
+: data(new Data())
+{
+}
+
+ScaleBenchmark::~ScaleBenchmark()
+{
+   delete data;
+}
+
+/** Gets the generator of the project measured; change its settings to change the size of the project. */
+ProjectGenerator& ScaleBenchmark::generator() const
+{
+   return data->generator;
+}
+
+/** Gets the folder in which the project is created. */
+QString ScaleBenchmark::folder() const
+{
+   return data->folder;
+}
+
+/** Sets the folder in which the project is created; it must exist and must not contain a project of the same name. */
+void ScaleBenchmark::setFolder(const QString& value)
+{
+   data->folder = value;
+}
+
+/** Gets a value indicating whether stage render is run; the default is true. */
+bool ScaleBenchmark::isRendering() const
+{
+   return data->rendering;
+}
+
+/** Sets a value indicating whether stage render is run. */
+void ScaleBenchmark::setRendering(bool value)
+{
+   data->rendering = value;
+}
+
+/** Gets the results of the last call of run(); the stages finished are included even if run() failed. */
+QJsonObject ScaleBenchmark::results() const
+{
+   return data->results;
+}
+
+/** Gets a description of the last error; empty if the last call of run() was successful. */
+QString ScaleBenchmark::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Runs all stages of the benchmark.
+ *
+ * @return True, if all stages succeeded; otherwise false (see errorString()).
+ */
+bool ScaleBenchmark::run()
+{
+   auto& gen = data->generator;
+   data->errorString.clear();
+   data->stages = QJsonArray();
+
+   data->results = QJsonObject();
+   data->results["benchmark"] = "scale";
+   data->results["version"] = Viraqucha::KProgramVersion.toString();
+   data->results["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+   data->results["settings"] = gen.settings();
+
+   QElapsedTimer timer;
+   QString filename = data->folder + QDir::separator() + KProjectName + QDir::separator() + KProjectName + ".uprj";
+
+   // Stages create and save work on the generated project:
+   {
+      UmlProject project;
+      timer.start();
+      if (!project.create(data->folder, KProjectName))
+      {
+         return fail(QObject::tr("Cannot create project '%1' in folder '%2'.").arg(KProjectName).arg(data->folder),
+            &project);
+      }
+
+      if (!gen.generate(&project)) return fail(gen.errorString(), &project);
+      record("create", timer.nsecsElapsed(), gen.elementCount());
+      data->results["elements"] = project.count();
+
+      timer.start();
+      if (!project.save(filename)) return fail(project.errorString(), &project);
+      record("save", timer.nsecsElapsed(), project.count());
+
+      project.isTransactional(true);
+      for (auto* elem : project.elements()) project.markModified(elem);
+      timer.start();
+      if (!project.save(filename)) return fail(project.errorString(), &project);
+      record("txsave", timer.nsecsElapsed(), project.count());
+
+      project.dispose();
+   }
+
+   // All other stages work on the loaded project:
+   UmlProject project;
+   timer.start();
+   if (!project.load(filename)) return fail(project.errorString(), &project);
+   record("load", timer.nsecsElapsed(), project.count());
+
+   timer.start();
+   int visited = 0, named = 0;
+   QList<UmlElement*> pending = { project.root() };
+   while (!pending.isEmpty())
+   {
+      auto* elem = pending.takeLast();
+      ++visited;
+
+      auto* namedElem = dynamic_cast<INamedElement*>(elem);
+      if (namedElem != nullptr && !namedElem->name().isEmpty()) ++named;
+
+      auto* composite = dynamic_cast<UmlCompositeElement*>(elem);
+      if (composite != nullptr) pending.append(composite->elements());
+   }
+   record("traverse", timer.nsecsElapsed(), visited);
+   data->results["named"] = named;
+
+   {
+      CppGenerator codegen(&project);
+      QDir(codegen.outputFolder()).removeRecursively();
+      timer.start();
+      if (!codegen.generate()) return fail(codegen.errorString(), &project);
+      record("generate", timer.nsecsElapsed(), codegen.generatedCount());
+
+      UmlClass* changed = nullptr;
+      for (auto* elem : project.elements())
+      {
+         changed = dynamic_cast<UmlClass*>(elem);
+         if (changed != nullptr) break;
+      }
+
+      if (changed != nullptr) changed->setComment(changed->comment() + " Changed by the benchmark.");
+      timer.start();
+      if (!codegen.generate()) return fail(codegen.errorString(), &project);
+      record("regen", timer.nsecsElapsed(), codegen.generatedCount() + codegen.unchangedCount());
+   }
+
+   auto diagrams = diagramsOf(project);
+   timer.start();
+   for (auto* diagram : diagrams)
+   {
+      if (!diagram->open())
+      {
+         diagram->close();
+         return fail(diagram->errorString(), &project);
+      }
+
+      diagram->close();
+   }
+   record("open", timer.nsecsElapsed(), diagrams.size());
+
+   if (data->rendering)
+   {
+      timer.start();
+      for (auto* diagram : diagrams)
+      {
+         // The scene opens the diagram and closes it again when deleted:
+         DiagramScene scene(diagram, nullptr);
+         scene.setVirtualized(false);
+
+         QRectF source = scene.diagramRect();
+         if (source.isEmpty()) continue;
+
+         double scale = qMin(1.0, KImageExtent / qMax(source.width(), source.height()));
+         QImage image((source.size() * scale).toSize().expandedTo(QSize(1, 1)), QImage::Format_ARGB32_Premultiplied);
+         image.fill(Qt::white);
+
+         QPainter painter(&image);
+         painter.setRenderHint(QPainter::Antialiasing);
+         scene.render(&painter, QRectF(image.rect()), source);
+      }
+      record("render", timer.nsecsElapsed(), diagrams.size());
+   }
+
+   timer.start();
+   int count = project.count();
+   project.dispose();
+   record("delete", timer.nsecsElapsed(), count);
+
+   return true;
+}
+
+/** Records an error, disposes the project and returns false. */
+bool ScaleBenchmark::fail(const QString& error, UmlProject* project)
+{
+   data->errorString = error;
+   data->results["stages"] = data->stages;
+   data->results["error"] = error;
+   project->dispose();
+   return false;
+}
+
+/** Records the time needed by a stage in milliseconds and the number of items processed. */
+void ScaleBenchmark::record(const QString& stage, qint64 nsecs, int count)
+{
+   QJsonObject entry;
+   entry["name"] = stage;
+   entry["ms"] = nsecs / 1.0e6;
+   entry["count"] = count;
+   data->stages.append(entry);
+   data->results["stages"] = data->stages;
+}
@@ -0,0 +1,202 @@
+//---------------------------------------------------------------------------------------------------------------------
+// main.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Main function of the ViraquchaBench benchmark program.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "Viraqucha.h"
+#include "ProjectGenerator.h"
+#include "RenderBenchmark.h"
+#include "ScaleBenchmark.h"
+
+#include "UmlCommon.h"
+#include "UmlClassifiers.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+/**
+ * @defgroup Benchmarks
+ * Implements the benchmark program of ViraquchaUML.
+ *
+ * The benchmark program generates synthetic projects of configurable size (see class ProjectGenerator) and measures
+ * how long operations on them take. Usage:
+ * ~~~
+ * ViraquchaBench [scale|render] [--packages n] [--classes n] [--attributes n] [--operations n] [--templates n]
+ *                [--links n] [--diagrams n] [--nodes n] [--seed n] [--folder path] [--output file]
+ *                [--no-render] [--zoom levels] [--frames n] [--size WxH] [--caching]
+ * ~~~
+ * Benchmark "scale" (the default) times the basic operations on a project like loading and saving (see class
+ * ScaleBenchmark); option --no-render skips rendering the diagrams. Benchmark "render" measures painting the diagrams
+ * at the comma separated zoom levels given (see class RenderBenchmark).
+ *
+ * The results are written as JSON to the given file or to the standard output, so that they can be stored and
+ * compared with the results of earlier versions. The project is generated in a temporary folder which is removed
+ * afterwards unless option --folder is given. The program uses the offscreen platform plugin unless another one is
+ * requested by environment variable QT_QPA_PLATFORM, so it runs on build servers without a display. The exit code is 0
+ * on success and 1 if the benchmark failed.
+ */
+
+int main(int argc, char *argv[])
+{
+   Q_INIT_RESOURCE(GuiResources);
+
+   if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+
+   QApplication app(argc, argv);
+   QCoreApplication::setOrganizationName(Viraqucha::KOrgaName);
+   QCoreApplication::setOrganizationDomain(Viraqucha::KOrgaDomain);
+   QCoreApplication::setApplicationName("ViraquchaBench");
+   QCoreApplication::setApplicationVersion(Viraqucha::KProgramVersion.toString());
+
+   ProjectGenerator defaults;
+   auto sizeOption = [](const char* name, const char* description, int value)
+   {
+      return QCommandLineOption(name, QCoreApplication::translate("main", description), "n", QString::number(value));
+   };
+
+   QCommandLineOption packagesOption = sizeOption("packages", "Number of packages.", defaults.packages());
+   QCommandLineOption classesOption = sizeOption("classes", "Number of classes per package.", defaults.classes());
+   QCommandLineOption attributesOption = sizeOption("attributes", "Number of attributes per class.",
+      defaults.attributes());
+   QCommandLineOption operationsOption = sizeOption("operations", "Number of operations per class.",
+      defaults.operations());
+   QCommandLineOption templatesOption = sizeOption("templates", "Number of template classes per package.",
+      defaults.templates());
+   QCommandLineOption linksOption = sizeOption("links", "Number of links per class.", defaults.links());
+   QCommandLineOption diagramsOption = sizeOption("diagrams", "Number of diagrams.", defaults.diagrams());
+   QCommandLineOption nodesOption = sizeOption("nodes", "Number of nodes per diagram.", defaults.nodes());
+   QCommandLineOption seedOption = sizeOption("seed", "Seed of the random choices.", (int)defaults.seed());
+   QCommandLineOption folderOption("folder",
+      QCoreApplication::translate("main", "Folder to generate the project in; kept after the run."), "path");
+   QCommandLineOption outputOption(QStringList() << "o" << "output",
+      QCoreApplication::translate("main", "File to write the results to instead of the standard output."), "file");
+   QCommandLineOption noRenderOption("no-render", QCoreApplication::translate("main", "Skip stage render (scale)."));
+   QCommandLineOption zoomOption("zoom",
+      QCoreApplication::translate("main", "Comma separated zoom levels (render)."), "levels", "0.25,0.5,1,2");
+   QCommandLineOption framesOption = sizeOption("frames", "Number of frames per diagram and zoom level (render).", 10);
+   QCommandLineOption sizeOfViewOption("size",
+      QCoreApplication::translate("main", "Size of the images rendered (render)."), "WxH", "1280x800");
+   QCommandLineOption cachingOption("caching",
+      QCoreApplication::translate("main", "Let the shapes cache their painting (render)."));
+
+   QCommandLineParser parser;
+   parser.setApplicationDescription(QCoreApplication::translate("main", "Benchmark program of %1.")
+      .arg(Viraqucha::KProgramName));
+   parser.addHelpOption();
+   parser.addVersionOption();
+   parser.addPositionalArgument("benchmark", QCoreApplication::translate("main", "Benchmark to run: scale, render"),
+      "[benchmark]");
+   parser.addOptions({ packagesOption, classesOption, attributesOption, operationsOption, templatesOption,
+      linksOption, diagramsOption, nodesOption, seedOption, folderOption, outputOption, noRenderOption, zoomOption,
+      framesOption, sizeOfViewOption, cachingOption });
+   parser.process(app);
+
+   QString name = parser.positionalArguments().value(0, "scale");
+   if (parser.positionalArguments().size() > 1 || (name != "scale" && name != "render"))
+   {
+      parser.showHelp(1);
+   }
+
+   initCommon();
+   initClassifiers();
+
+   QTextStream err(stderr);
+   QTemporaryDir tempDir;
+   if (!parser.isSet(folderOption) && !tempDir.isValid())
+   {
+      err << QCoreApplication::translate("main", "Cannot create a temporary folder.") << endl;
+      return 1;
+   }
+
+   QString folder = parser.isSet(folderOption) ? parser.value(folderOption) : tempDir.path();
+   auto configure = [&](ProjectGenerator& gen)
+   {
+      gen.setPackages(parser.value(packagesOption).toInt());
+      gen.setClasses(parser.value(classesOption).toInt());
+      gen.setAttributes(parser.value(attributesOption).toInt());
+      gen.setOperations(parser.value(operationsOption).toInt());
+      gen.setTemplates(parser.value(templatesOption).toInt());
+      gen.setLinks(parser.value(linksOption).toInt());
+      gen.setDiagrams(parser.value(diagramsOption).toInt());
+      gen.setNodes(parser.value(nodesOption).toInt());
+      gen.setSeed(parser.value(seedOption).toUInt());
+   };
+
+   bool success = false;
+   QJsonObject results;
+   if (name == "render")
+   {
+      QList<double> zoomLevels;
+      for (auto level : parser.value(zoomOption).split(',', QString::SkipEmptyParts))
+      {
+         zoomLevels.append(level.toDouble());
+      }
+
+      QStringList size = parser.value(sizeOfViewOption).split('x');
+      RenderBenchmark benchmark;
+      configure(benchmark.generator());
+      benchmark.setFolder(folder);
+      benchmark.setZoomLevels(zoomLevels);
+      benchmark.setFrames(parser.value(framesOption).toInt());
+      benchmark.setViewSize(QSize(size.value(0).toInt(), size.value(1).toInt()));
+      benchmark.setCaching(parser.isSet(cachingOption));
+
+      success = benchmark.run();
+      if (!success) err << benchmark.errorString() << endl;
+      results = benchmark.results();
+   }
+   else
+   {
+      ScaleBenchmark benchmark;
+      configure(benchmark.generator());
+      benchmark.setFolder(folder);
+      benchmark.setRendering(!parser.isSet(noRenderOption));
+
+      success = benchmark.run();
+      if (!success) err << benchmark.errorString() << endl;
+      results = benchmark.results();
+   }
+
+   QByteArray json = QJsonDocument(results).toJson(QJsonDocument::Indented);
+   if (parser.isSet(outputOption))
+   {
+      QFile file(parser.value(outputOption));
+      if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(json) != json.size())
+      {
+         err << file.errorString() << endl;
+         return 1;
+      }
+   }
+   else
+   {
+      QTextStream(stdout) << json;
+   }
+
+   return success ? 0 : 1;
+}
@@ -71,32 +71,30 @@ AssociationShape::~AssociationShape()
 /**
  * Draws an arrow or a diamond at the start (first line segment) of the polyline of the shape.
  *
- * @param painter QPainter object needed for drawing
  * @param line Line segment where to draw the arrow or diamond
  */
-void AssociationShape::drawLineStart(QPainter* painter, const QLineF& line)
+void AssociationShape::makeLineStart(const QLineF& line)
 {
    if (_link->sourceEnd().aggregation() != AggregationKind::None)
    {
-      drawDiamond(painter, line, _link->sourceEnd().aggregation() == AggregationKind::Composite);
+      makeDiamond(line, _link->sourceEnd().aggregation() == AggregationKind::Composite);
    }
    else if (_link->isDirected())
    {
-      drawArrow(painter, line, false);
+      makeArrow(line, false);
    }
 }
 
 /**
  * Draws an arrow at the end (last line segment) of the polyline of the shape.
  *
- * @param painter QPainter object needed for drawing
  * @param line Line segment where to draw the arrow
  */
-void AssociationShape::drawLineEnd(QPainter* painter, const QLineF& line)
+void AssociationShape::makeLineEnd(const QLineF& line)
 {
    if (_link->isDirected())
    { 
-      drawArrow(painter, line, false);
+      makeArrow(line, false);
    }
 }
 
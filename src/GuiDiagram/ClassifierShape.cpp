@@ -31,6 +31,7 @@
 #include "Compartment.h"
 #include "DiaNode.h"
 #include "TextBox.h"
+#include "Tracer.h"
 #include "ITemplatableElement.h"
 
 #include "UmlElement.h"
@@ -68,7 +69,8 @@ ClassifierShape::ClassifierShape(QGraphicsItem* parent, DiaNode* node)
    Q_ASSERT(_classifier != nullptr);
 
    _templateBox = new TemplateBox(this, node, _font, _linePen, _textPen);
-   _templateBox->setVisible(_classifier->isTemplated());
+   computeSize(_classifier->isTemplated());
+   updateTemplateBox();
 }
 
 ClassifierShape::~ClassifierShape()
@@ -85,6 +87,31 @@ UmlElement* ClassifierShape::element() const
    return _classifier;
 }
 
+/**
+ * Refreshes the shape after the classifier was changed.
+ *
+ * Updates the compartments, recomputes the size (including space for template parameters) and the template box. The
+ * function must be called whenever the classifier or one of its attributes or operations was changed, since paint()
+ * only draws what was computed here.
+ */
+void ClassifierShape::refresh()
+{
+   prepareGeometryChange();
+   diaNode()->update();
+   computeSize(_classifier->isTemplated());
+   updateTemplateBox();
+   updateEdges();
+   Shape::refresh();
+}
+
+/** Passes the text box size to the template box and shows it if the classifier is templated. */
+void ClassifierShape::updateTemplateBox()
+{
+   _templateBox->setTextBoxSize(textBoxSize());
+   _templateBox->setVisible(_classifier->isTemplated());
+   _templateBox->refresh();
+}
+
 /**
  * Paints the classifier shape.
  *
@@ -94,13 +121,11 @@ UmlElement* ClassifierShape::element() const
  */
 void ClassifierShape::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+   TraceSpan span("ClassifierShape::paint", "paint");
+   Tracer::count(Tracer::PaintedItems);
    Q_UNUSED(option);
    Q_UNUSED(widget);
 
-   computeSize(_classifier->isTemplated());
-   _templateBox->setTextBoxSize(textBoxSize());
-   _templateBox->setVisible(_classifier->isTemplated());
-   
    double x1 = -(nodeSize().width() / 2.0);
    double x2 = -x1;
    double y1 = -(nodeSize().height() / 2.0);
@@ -45,7 +45,11 @@ public: // Constructors
 public: // Properties
    UmlElement* element() const override;
 
+public: // Methods
+   void refresh() override;
+
 protected: // Methods
+   void updateTemplateBox();
    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
 
 private: // Attributes
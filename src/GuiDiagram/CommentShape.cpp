@@ -27,6 +27,8 @@
 //---------------------------------------------------------------------------------------------------------------------
 #include "CommentShape.h"
 
+#include "Tracer.h"
+
 #include <QPainter>
 #include <QPolygonF>
 #include <QSizeF>
@@ -74,6 +76,12 @@ UmlElement* CommentShape::element() const
    return _element;
 }
 
+/** Refreshes the shape after the comment was changed. The size of a comment is set by the user and kept. */
+void CommentShape::refresh()
+{
+   Shape::refresh();
+}
+
 /**
  * Paints the CommentShape object.
  *
@@ -83,6 +91,8 @@ UmlElement* CommentShape::element() const
  */
 void CommentShape::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+   TraceSpan span("CommentShape::paint", "paint");
+   Tracer::count(Tracer::PaintedItems);
    Q_UNUSED(option);
    Q_UNUSED(widget);
 
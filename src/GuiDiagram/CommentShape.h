@@ -45,6 +45,7 @@ public: // Properties
    UmlElement* element() const override;
    
 public: // Methods
+   void refresh() override;
    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
 
 private: // Attributes
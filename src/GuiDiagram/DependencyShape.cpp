@@ -67,24 +67,21 @@ DependencyShape::~DependencyShape()
 /**
  * Overwritten to do nothing - this function is unused.
  *
- * @param painter This parameter is unused
  * @param line This parameter is unused
  */
-void DependencyShape::drawLineStart(QPainter* painter, const QLineF& line)
+void DependencyShape::makeLineStart(const QLineF& line)
 {
-   Q_UNUSED(painter);
    Q_UNUSED(line);
 }
 
 /**
  * Overwritten to draw an arrow at the end of the line.
  *
- * @param painter QPainter object needed for drawing
  * @param line Line receiving the arrow
  */
-void DependencyShape::drawLineEnd(QPainter* painter, const QLineF& line)
+void DependencyShape::makeLineEnd(const QLineF& line)
 {
-   drawArrow(painter, line, false);
+   makeArrow(line, false);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
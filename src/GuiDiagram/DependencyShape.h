@@ -41,8 +41,8 @@ public:
    virtual ~DependencyShape();
 
 protected: // Methods
-   void drawLineStart(QPainter* painter, const QLineF& line) override;
-   void drawLineEnd(QPainter* painter, const QLineF& line) override;
+   void makeLineStart(const QLineF& line) override;
+   void makeLineEnd(const QLineF& line) override;
 };
 
 class DependencyShapeBuilder : public IShapeBuilder
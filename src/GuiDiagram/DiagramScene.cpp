@@ -33,6 +33,7 @@
 
 #include "DiaEdge.h"
 #include "DiaNode.h"
+#include "MemoryUsage.h"
 #include "NameBuilder.h"
 #include "UmlCompositeElement.h"
 #include "UmlElement.h"
@@ -42,6 +43,8 @@
 
 #include <QGraphicsSceneDragDropEvent>
 #include <QMimeData>
+#include <QPixmapCache>
+#include <QSet>
 #include <QUuid>
 
 /**
@@ -62,7 +65,18 @@
  * - LinkElements: Inserts a new UmlLink object (+ DiaEdge + Shape objects) and connects two UmlElement objects with
  *   each other using a &quot;rubber line&quot;.
  * 
- * The size of the diagram scene is currently set to a maximum width and height of 5000 points each.
+ * The size of the diagram scene is currently set to a maximum width and height of 5000 points each. Larger diagrams
+ * extend the scene to the area covered by their nodes.
+ *
+ * Diagrams with KVirtualThreshold nodes or more are virtualized: the scene only creates shapes for nodes and edges
+ * intersecting the visible area (see setVisibleArea()) plus KVirtualMargin and releases them again when they leave
+ * twice that margin. Everything off-screen is represented by the geometry stored in the DiaNode and DiaEdge objects,
+ * so neither graphics items nor text measurements are needed for it. Selected shapes and the shape grabbing the mouse
+ * are never released.
+ *
+ * Shapes may cache their painting in pixmaps, see setCaching(). The pixmaps share the application wide QPixmapCache,
+ * whose size can be limited with setCacheLimit(). Since cached shapes are not painted again, refresh() must be called
+ * whenever an element shown in the diagram was changed.
  */
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -82,6 +96,8 @@ DiagramScene::DiagramScene(UmlDiagram* diagram, QMenu* contextMenu)
 , _rubberLine(nullptr)
 , _linePen(QColor(Qt::black))
 , _contextMenu(contextMenu)
+, _virtualized(false)
+, _caching(false)
 {
    Q_ASSERT(_diagram != nullptr);
    setSceneRect(QRectF(0.0, 0.0, 5000.0, 5000.0));
@@ -91,7 +107,19 @@ DiagramScene::DiagramScene(UmlDiagram* diagram, QMenu* contextMenu)
 
    if (_diagram->open())
    {
-      ShapeFactory::instance().buildScene(this, _diagram);
+      _virtualized = _diagram->nodes().size() >= KVirtualThreshold;
+      if (_virtualized)
+      {
+         // Shapes are materialized as soon as a view reports its visible area. Measure the nodes nevertheless, so that
+         // the model geometry used for everything off-screen is accurate:
+         ShapeFactory::instance().measureNodes(_diagram->nodes());
+         QRectF area = diagramRect() + QMarginsF(KVirtualMargin, KVirtualMargin, KVirtualMargin, KVirtualMargin);
+         setSceneRect(sceneRect().united(area));
+      }
+      else
+      {
+         ShapeFactory::instance().buildScene(this, _diagram);
+      }
    }
 }
 
@@ -130,6 +158,345 @@ void DiagramScene::setEditMode(EditMode value)
     _editMode = value;
 }
 
+/** Returns true if the scene only holds shapes for the visible area; false otherwise. */
+bool DiagramScene::isVirtualized() const
+{
+   return _virtualized;
+}
+
+/**
+ * Switches virtualization on or off.
+ *
+ * Switching it off materializes the shapes of all nodes and edges of the diagram, which is needed e.g. for rendering
+ * the complete diagram into an image. Switching it on releases all shapes outside of the visible area again.
+ * @param value True: virtualizes the scene; false: shows all shapes.
+ */
+void DiagramScene::setVirtualized(bool value)
+{
+   if (_virtualized != value)
+   {
+      _virtualized = value;
+      updateShapes();
+   }
+}
+
+/** Gets the area of the scene currently visible in the view. */
+QRectF DiagramScene::visibleArea() const
+{
+   return _visibleArea;
+}
+
+/**
+ * Sets the area of the scene currently visible in the view.
+ *
+ * The view showing the scene must call this function whenever it is scrolled or resized. If the scene is virtualized,
+ * shapes entering the area are created and shapes far away from it are deleted.
+ * @param value Visible area in scene coordinates.
+ */
+void DiagramScene::setVisibleArea(const QRectF& value)
+{
+   _visibleArea = value;
+
+   if (_virtualized)
+   {
+      updateShapes();
+   }
+}
+
+/** Returns true if the shapes of the scene cache their painting in pixmaps; false otherwise. */
+bool DiagramScene::isCaching() const
+{
+   return _caching;
+}
+
+/**
+ * Switches pixmap caching of all shapes on or off.
+ *
+ * Caching is off by default. Shapes added to the scene later take over the setting (see Shape::itemChange()).
+ * @param value True: shapes cache their painting; false: shapes are painted on every expose event.
+ */
+void DiagramScene::setCaching(bool value)
+{
+   _caching = value;
+
+   for (QGraphicsItem* item : items())
+   {
+      auto* shape = dynamic_cast<Shape*>(item);
+      if (shape != nullptr) shape->setCaching(value);
+   }
+}
+
+/** Gets the maximum size of the pixmap cache shared by all scenes in kilobytes. */
+int DiagramScene::cacheLimit()
+{
+   return QPixmapCache::cacheLimit();
+}
+
+/**
+ * Sets the maximum size of the pixmap cache shared by all scenes.
+ *
+ * If the limit is exceeded, the least recently used pixmaps are dropped and repainted when needed.
+ * @param kilobytes Maximum size in kilobytes.
+ */
+void DiagramScene::setCacheLimit(int kilobytes)
+{
+   QPixmapCache::setCacheLimit(kilobytes);
+}
+
+/** Gets the area covered by all nodes of the diagram, computed from model geometry only. */
+QRectF DiagramScene::diagramRect() const
+{
+   QRectF result;
+   for (DiaNode* node : _diagram->nodes())
+   {
+      result |= modelRect(node);
+   }
+
+   return result;
+}
+
+/**
+ * Gets the bounding rectangle of a DiaShape object without needing a graphics item for it.
+ *
+ * Nodes are centered around their position like NodeShape objects. Nodes that have never been measured are assumed to
+ * be KDefaultWidth x KDefaultHeight. Edges cover both of their ends and all of their routing points.
+ * @param shape DiaShape object. May be null.
+ * @return Bounding rectangle in scene coordinates.
+ */
+QRectF DiagramScene::modelRect(DiaShape* shape) const
+{
+   if (shape == nullptr) return QRectF();
+
+   auto* node = dynamic_cast<DiaNode*>(shape);
+   if (node != nullptr)
+   {
+      QSizeF size = node->size();
+      if (size.isEmpty())
+      {
+         size = QSizeF(KDefaultWidth, KDefaultHeight);
+      }
+
+      return QRectF(node->pos() - QPointF(size.width() / 2.0, size.height() / 2.0), size);
+   }
+
+   auto* edge = dynamic_cast<DiaEdge*>(shape);
+   if (edge != nullptr)
+   {
+      QRectF result = modelRect(edge->shape1()) | modelRect(edge->shape2());
+      for (const QPointF& point : edge->points())
+      {
+         result |= QRectF(point, QSizeF(1.0, 1.0));
+      }
+
+      return result;
+   }
+
+   return QRectF(shape->pos(), QSizeF(1.0, 1.0));
+}
+
+/**
+ * Creates the shape of a DiaShape object unless it already exists.
+ *
+ * Edge shapes need the shapes at both of their ends, so these are materialized first.
+ * @param shape DiaShape object. May be null.
+ * @return The Shape object or nullptr if no shape could be built.
+ */
+Shape* DiagramScene::materialize(DiaShape* shape)
+{
+   if (shape == nullptr) return nullptr;
+   if (shape->itemData() != nullptr) return static_cast<Shape*>(shape->itemData());
+
+   Shape* item = nullptr;
+   auto*  edge = dynamic_cast<DiaEdge*>(shape);
+   if (edge != nullptr)
+   {
+      if (materialize(edge->shape1()) != nullptr && materialize(edge->shape2()) != nullptr)
+      {
+         item = ShapeFactory::instance().buildShape(edge);
+      }
+   }
+   else
+   {
+      auto* node = dynamic_cast<DiaNode*>(shape);
+      if (node != nullptr)
+      {
+         item = ShapeFactory::instance().buildShape(node);
+      }
+   }
+
+   if (item != nullptr)
+   {
+      item->setContextMenu(_contextMenu);
+      addItem(item);
+   }
+
+   return item;
+}
+
+/**
+ * Creates and releases shapes according to the visible area.
+ *
+ * Shapes are created for all nodes and edges within the visible area plus KVirtualMargin. Existing shapes are kept as
+ * long as they are within twice that margin, so that panning back and forth does not rebuild them all the time. If the
+ * scene is not virtualized, shapes are created for all nodes and edges.
+ */
+void DiagramScene::updateShapes()
+{
+   QList<DiaShape*> shapes;
+   for (DiaNode* node : _diagram->nodes()) shapes.append(node);
+   for (DiaEdge* edge : _diagram->edges()) shapes.append(edge);
+
+   if (!_virtualized)
+   {
+      for (DiaShape* shape : shapes) materialize(shape);
+      return;
+   }
+
+   double m = KVirtualMargin;
+   QRectF area = _visibleArea.adjusted(-m, -m, m, m);
+   QRectF keep = _visibleArea.adjusted(-2.0 * m, -2.0 * m, 2.0 * m, 2.0 * m);
+
+   // Collect all shapes needed including the ends of all edges needed:
+   QSet<DiaShape*> needed;
+   QList<DiaShape*> pending;
+   for (DiaShape* shape : shapes)
+   {
+      auto* item = static_cast<Shape*>(shape->itemData());
+      bool  hit  = modelRect(shape).intersects(item != nullptr ? keep : area);
+      if (item != nullptr && (item->isSelected() || item == mouseGrabberItem())) hit = true;
+      if (hit) pending.append(shape);
+   }
+
+   while (!pending.isEmpty())
+   {
+      DiaShape* shape = pending.takeLast();
+      if (shape == nullptr || needed.contains(shape)) continue;
+      needed.insert(shape);
+
+      auto* edge = dynamic_cast<DiaEdge*>(shape);
+      if (edge != nullptr)
+      {
+         pending.append(edge->shape1());
+         pending.append(edge->shape2());
+      }
+   }
+
+   // Release edges before nodes, since edge shapes refer to the shapes at their ends:
+   for (int index = shapes.size() - 1; index >= 0; --index)
+   {
+      auto* item = static_cast<Shape*>(shapes[index]->itemData());
+      if (item != nullptr && !needed.contains(shapes[index]))
+      {
+         removeItem(item);
+         delete item;
+      }
+   }
+
+   for (DiaShape* shape : shapes)
+   {
+      if (needed.contains(shape)) materialize(shape);
+   }
+}
+
+/**
+ * Rebuilds the shapes of all nodes and edges from the diagram data.
+ *
+ * Called after the diagram data was modified as a whole, e.g. by an automatic layout. In a virtualized scene only the
+ * shapes within the visible area are built again.
+ */
+void DiagramScene::rebuild()
+{
+   releaseShapes();
+   if (_virtualized)
+   {
+      ShapeFactory::instance().measureNodes(_diagram->nodes());
+   }
+
+   QRectF area = diagramRect() + QMarginsF(KVirtualMargin, KVirtualMargin, KVirtualMargin, KVirtualMargin);
+   setSceneRect(sceneRect().united(area));
+   updateShapes();
+}
+
+/**
+ * Deletes the shapes of all nodes and edges.
+ *
+ * Must be called before nodes or edges are removed from the diagram by other means than the scene, since shapes refer
+ * to them. Call rebuild() afterwards.
+ */
+void DiagramScene::releaseShapes()
+{
+   QList<DiaShape*> shapes;
+   for (DiaNode* node : _diagram->nodes()) shapes.append(node);
+   for (DiaEdge* edge : _diagram->edges()) shapes.append(edge);
+
+   // Release edges before nodes, since edge shapes refer to the shapes at their ends:
+   for (int index = shapes.size() - 1; index >= 0; --index)
+   {
+      auto* item = static_cast<Shape*>(shapes[index]->itemData());
+      if (item != nullptr)
+      {
+         removeItem(item);
+         delete item;
+      }
+   }
+}
+
+/**
+ * Refreshes the shapes showing a changed UmlElement object.
+ *
+ * Nodes showing the element or one of its owners are refreshed, since e.g. a changed attribute changes the
+ * compartments of its classifier. Edges showing the element are refreshed as well. Shapes not materialized in a
+ * virtualized scene are skipped, they are built from the current model when they become visible.
+ * @param elem The changed UmlElement object.
+ */
+void DiagramScene::refresh(UmlElement* elem)
+{
+   if (elem == nullptr) return;
+
+   QSet<UmlElement*> changed;
+   for (UmlElement* current = elem; current != nullptr; current = current->owner())
+   {
+      changed.insert(current);
+   }
+
+   for (DiaNode* node : _diagram->nodes())
+   {
+      auto* shape = static_cast<Shape*>(node->itemData());
+      if (shape != nullptr && changed.contains(node->element())) shape->refresh();
+   }
+
+   for (DiaEdge* edge : _diagram->edges())
+   {
+      auto* shape = static_cast<Shape*>(edge->itemData());
+      if (shape != nullptr && edge->link() == elem) shape->refresh();
+   }
+}
+
+/**
+ * Adds the estimated memory used by the graphics items of the scene to a MemoryUsage object.
+ *
+ * Each item counts its object and KItemPrivateSize bytes of private data. Items caching their painting count 4 bytes
+ * per pixel of their bounding rectangle at 100% zoom; since all caches share QPixmapCache, the sum is limited to
+ * cacheLimit(). The nodes and edges of the diagram are not included, they are measured with their UmlDiagram.
+ * @param usage MemoryUsage object receiving the sizes as graphics memory.
+ */
+void DiagramScene::measure(MemoryUsage& usage) const
+{
+   qint64 items = 0;
+   qint64 pixmaps = 0;
+   for (QGraphicsItem* item : this->items())
+   {
+      items += (dynamic_cast<Shape*>(item) != nullptr ? sizeof(Shape) : sizeof(QGraphicsItem)) + KItemPrivateSize;
+      if (item->cacheMode() != QGraphicsItem::NoCache)
+      {
+         QRectF rect = item->boundingRect();
+         pixmaps += qint64(rect.width() * rect.height()) * 4;
+      }
+   }
+
+   usage.graphics += sizeof(DiagramScene) + items + qMin(pixmaps, qint64(cacheLimit()) * 1024);
+}
+
 /**
  * Handles the DragEnter event of the Drag & Drop mechanism.
  * 
@@ -32,8 +32,11 @@
 #include <QMenu>
 #include <QPersistentModelIndex>
 
+class DiaShape;
+class Shape;
 class UmlDiagram;
 class UmlElement;
+struct MemoryUsage;
 
 class DiagramScene : public QGraphicsScene
 {
@@ -41,6 +44,13 @@ class DiagramScene : public QGraphicsScene
    ///@cond
    typedef QGraphicsScene super;
    ///@endcond
+public: // Constants
+   static constexpr int    KVirtualThreshold = 500;   ///< Number of nodes from which on a scene is virtualized.
+   static constexpr double KVirtualMargin    = 400.0; ///< Margin around the visible area where shapes are materialized.
+   static constexpr double KDefaultWidth     = 120.0; ///< Width assumed for nodes that have never been measured.
+   static constexpr double KDefaultHeight    = 80.0;  ///< Height assumed for nodes that have never been measured.
+   static constexpr int    KItemPrivateSize  = 320;   ///< Estimated size of the private data of a QGraphicsItem.
+
 public: // Constructors
    DiagramScene(UmlDiagram* diagram, QMenu* contextMenu);
    virtual ~DiagramScene();
@@ -58,7 +68,26 @@ public: // Properties
    void setClassName(QString className);
    void setEditMode(EditMode mode);
 
+   bool isVirtualized() const;
+   void setVirtualized(bool value);
+
+   QRectF visibleArea() const;
+   void setVisibleArea(const QRectF& value);
+
+   QRectF diagramRect() const;
+
+   bool isCaching() const;
+   void setCaching(bool value);
+
+   static int cacheLimit();
+   static void setCacheLimit(int kilobytes);
+
 public: // Methods
+   void rebuild();
+   void releaseShapes();
+   void refresh(UmlElement* elem);
+   void measure(MemoryUsage& usage) const;
+
    void dragEnterEvent(QGraphicsSceneDragDropEvent* event) override;
    void dragMoveEvent(QGraphicsSceneDragDropEvent* event) override;
    void dropEvent(QGraphicsSceneDragDropEvent* event) override;
@@ -67,6 +96,11 @@ public: // Methods
    void mouseMoveEvent(QGraphicsSceneMouseEvent* event) override;
    void mouseReleaseEvent(QGraphicsSceneMouseEvent* event) override;
 
+private:
+   QRectF modelRect(DiaShape* shape) const;
+   Shape* materialize(DiaShape* shape);
+   void updateShapes();
+
 signals:
    void elementInserted(UmlElement* elem);
    void insertAborted();
@@ -79,6 +113,9 @@ private: // Attributes
    QGraphicsLineItem* _rubberLine;
    QPen               _linePen;
    QMenu*             _contextMenu;
+   bool               _virtualized;
+   bool               _caching;
+   QRectF             _visibleArea;
    ///@endcond
 };
 
@@ -0,0 +1,298 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DiagramView.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class DiagramView.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "DiagramView.h"
+#include "DiagramScene.h"
+
+#include <QDateTime>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QJsonArray>
+#include <QPainter>
+#include <QPaintEvent>
+
+/**
+ * @class DiagramView
+ * @brief Extends the QGraphicsView class by a performance HUD.
+ * @since 0.2.0
+ * @ingroup GuiDiagram
+ *
+ * The DiagramView class shows a DiagramScene and measures each frame it paints: the time needed for painting and the
+ * work counted by the Tracer counters - items painted, texts measured, edges routed (see Tracer::Counter). The
+ * benchmarks read the same counters, so numbers seen in the view can be compared with benchmark results.
+ *
+ * If the HUD (head-up display) is visible, the measurements of the last frame are drawn over the top left corner of
+ * the viewport, together with the average and maximum frame time of the last KFrameHistory frames. The hit rates of
+ * the caches are derived from the counters:
+ * - the text cache hit rate from texts measured and text sizes found in the cache of Shape::textRect();
+ * - the pixmap cache hit rate from items exposed and items painted, since shapes cached in pixmaps are not painted
+ *   again (see DiagramScene::setCaching()). Items exposed are those intersecting the region painted, which is only
+ *   a part of the viewport if a single shape changed. The rate is only shown if the scene caches.
+ *
+ * The measurements can be saved for later analysis, see snapshot().
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static QString percentage(qint64 part, qint64 total)
+{
+   return total > 0 ? QString("%1 %").arg(100.0 * part / total, 0, 'f', 1) : QString("-");
+}
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Construction
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the DiagramView class.
+ *
+ * @param parent A parent widget.
+ */
+DiagramView::DiagramView(QWidget* parent)
+: super(parent)
+, _hudVisible(false)
+, _frameCount(0)
+{
+   for (int index = 0; index < Tracer::CounterCount; ++index)
+   {
+      _counters[index] = Tracer::value(Tracer::Counter(index));
+   }
+}
+
+DiagramView::~DiagramView()
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Gets a value indicating whether the performance HUD is drawn over the viewport. */
+bool DiagramView::isHudVisible() const
+{
+   return _hudVisible;
+}
+
+/** Shows or hides the performance HUD. */
+void DiagramView::setHudVisible(bool value)
+{
+   if (_hudVisible == value) return;
+   _hudVisible = value;
+   viewport()->update();
+}
+
+/** Gets the number of frames painted since the view was created. */
+int DiagramView::frameCount() const
+{
+   return _frameCount;
+}
+
+/** Gets the measurements of the last KFrameHistory frames at most, the oldest frame first. */
+QVector<DiagramView::Frame> DiagramView::frames() const
+{
+   return _frames;
+}
+
+/**
+ * Takes a snapshot of the measurements for storing them in a file:
+ * ~~~{.json}
+ * {
+ *    "timestamp": "2026-10-18T10:00:00Z",
+ *    "width": 1280, "height": 800, "zoom": 1.0,
+ *    "items": 731, "caching": false, "virtualized": true,
+ *    "frameCount": 4711, "msPerFrame": 3.9, "maxMsPerFrame": 8.1,
+ *    "counters": { "paintedItems": 120566, "textMeasurements": 2310, "textCacheHits": 40321, "reroutes": 820 },
+ *    "frames": [ { "ms": 4.2, "exposedItems": 134, "paintedItems": 120, "textMeasurements": 0, ... }, ... ]
+ * }
+ * ~~~
+ * Object "counters" contains the values of the Tracer counters, each element of array "frames" the measurements of
+ * a frame (see frames()).
+ * @return A JSON object.
+ */
+QJsonObject DiagramView::snapshot() const
+{
+   QJsonObject result;
+   result["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+   result["width"] = viewport()->width();
+   result["height"] = viewport()->height();
+   result["zoom"] = transform().m11();
+
+   auto* diaScene = dynamic_cast<DiagramScene*>(scene());
+   if (diaScene != nullptr)
+   {
+      result["items"] = diaScene->items().size();
+      result["caching"] = diaScene->isCaching();
+      result["virtualized"] = diaScene->isVirtualized();
+   }
+
+   QJsonObject counters;
+   for (int index = 0; index < Tracer::CounterCount; ++index)
+   {
+      auto counter = Tracer::Counter(index);
+      counters[Tracer::counterName(counter)] = Tracer::value(counter);
+   }
+
+   qint64 total = 0, maximum = 0;
+   QJsonArray frames;
+   for (const Frame& frame : _frames)
+   {
+      total += frame.nsecs;
+      maximum = qMax(maximum, frame.nsecs);
+
+      QJsonObject entry;
+      entry["ms"] = frame.nsecs / 1.0e6;
+      entry["exposedItems"] = frame.exposedItems;
+      for (int index = 0; index < Tracer::CounterCount; ++index)
+      {
+         entry[Tracer::counterName(Tracer::Counter(index))] = frame.counters[index];
+      }
+      frames.append(entry);
+   }
+
+   result["frameCount"] = _frameCount;
+   result["msPerFrame"] = _frames.isEmpty() ? 0.0 : total / 1.0e6 / _frames.size();
+   result["maxMsPerFrame"] = maximum / 1.0e6;
+   result["counters"] = counters;
+   result["frames"] = frames;
+   return result;
+}
+
+/**
+ * Paints the scene and measures the frame, then draws the performance HUD if visible.
+ *
+ * Items painted are counted while painting. All other counters are taken since the previous frame: edges are routed
+ * and texts are measured when shapes change, i.e. before the frame showing the change is painted.
+ * @param event The paint event.
+ */
+void DiagramView::paintEvent(QPaintEvent* event)
+{
+   qint64 painted = Tracer::value(Tracer::PaintedItems);
+   qint64 start = Tracer::timestamp();
+   {
+      TraceSpan span("DiagramView::paint", "paint");
+      super::paintEvent(event);
+   }
+
+   Frame frame;
+   frame.nsecs = Tracer::timestamp() - start;
+   frame.exposedItems = items(event->region().boundingRect()).size();
+   for (int index = 0; index < Tracer::CounterCount; ++index)
+   {
+      qint64 value = Tracer::value(Tracer::Counter(index));
+      frame.counters[index] = value - _counters[index];
+      _counters[index] = value;
+   }
+   frame.counters[Tracer::PaintedItems] = _counters[Tracer::PaintedItems] - painted;
+
+   if (_frames.size() >= KFrameHistory) _frames.removeFirst();
+   _frames.append(frame);
+   ++_frameCount;
+
+   if (_hudVisible) drawHud();
+}
+
+/**
+ * Scrolls the contents of the viewport.
+ *
+ * The HUD stays at its place, so the whole viewport must be painted again if it is visible.
+ * @param dx Horizontal distance scrolled.
+ * @param dy Vertical distance scrolled.
+ */
+void DiagramView::scrollContentsBy(int dx, int dy)
+{
+   super::scrollContentsBy(dx, dy);
+   if (_hudVisible) viewport()->update();
+}
+
+/** Draws the performance HUD over the top left corner of the viewport. */
+void DiagramView::drawHud()
+{
+   const int KPadding = 6;
+
+   QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+   QFontMetrics metrics(font);
+   QStringList lines = hudLines();
+
+   int width = 0;
+   for (const QString& line : lines)
+   {
+      width = qMax(width, metrics.boundingRect(line).width());
+   }
+
+   QRect rect(KPadding, KPadding, width + 2 * KPadding, lines.size() * metrics.lineSpacing() + 2 * KPadding);
+   QPainter painter(viewport());
+   painter.setFont(font);
+   painter.fillRect(rect, QColor(0, 0, 0, 170));
+   painter.setPen(Qt::white);
+
+   int y = rect.top() + KPadding + metrics.ascent();
+   for (const QString& line : lines)
+   {
+      painter.drawText(rect.left() + KPadding, y, line);
+      y += metrics.lineSpacing();
+   }
+}
+
+/** Gets the lines of text shown by the performance HUD. */
+QStringList DiagramView::hudLines() const
+{
+   QStringList lines;
+   if (_frames.isEmpty()) return lines;
+
+   const Frame& last = _frames.last();
+   qint64 total = 0, maximum = 0;
+   for (const Frame& frame : _frames)
+   {
+      total += frame.nsecs;
+      maximum = qMax(maximum, frame.nsecs);
+   }
+
+   double average = total / 1.0e6 / _frames.size();
+   qint64 painted = last.counters[Tracer::PaintedItems];
+   qint64 measured = last.counters[Tracer::TextMeasurements];
+   qint64 hits = last.counters[Tracer::TextCacheHits];
+
+   lines << tr("Frame:    %1 ms (avg %2 ms, max %3 ms)").arg(last.nsecs / 1.0e6, 0, 'f', 2)
+      .arg(average, 0, 'f', 2).arg(maximum / 1.0e6, 0, 'f', 2);
+   lines << tr("Rate:     %1 fps over %2 frames").arg(average > 0.0 ? 1000.0 / average : 0.0, 0, 'f', 1)
+      .arg(_frames.size());
+   lines << tr("Painted:  %1 of %2 exposed items").arg(painted).arg(last.exposedItems);
+
+   auto* diaScene = dynamic_cast<DiagramScene*>(scene());
+   if (diaScene != nullptr && diaScene->isCaching())
+   {
+      qint64 cached = qMax<qint64>(0, last.exposedItems - painted);
+      lines << tr("Pixmaps:  %1 cache hits").arg(percentage(cached, last.exposedItems));
+   }
+
+   lines << tr("Texts:    %1 measured, %2 cache hits").arg(measured).arg(percentage(hits, hits + measured));
+   lines << tr("Reroutes: %1").arg(last.counters[Tracer::Reroutes]);
+   return lines;
+}
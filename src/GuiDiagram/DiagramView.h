@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DiagramView.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class DiagramView.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "Tracer.h"
+
+#include <QGraphicsView>
+#include <QJsonObject>
+#include <QVector>
+
+class DiagramView : public QGraphicsView
+{
+   Q_OBJECT
+   ///@cond
+   typedef QGraphicsView super;
+   ///@endcond
+public: // Constants
+   static constexpr int KFrameHistory = 120; ///< Number of frames kept for the performance HUD and snapshots.
+
+public: // Types
+   /** Measurements of a single frame painted by the view. */
+   struct Frame
+   {
+      Frame()
+      : nsecs(0)
+      , exposedItems(0)
+      , counters()
+      {}
+
+      qint64 nsecs;                          ///< Time needed for painting the frame in nanoseconds.
+      int    exposedItems;                   ///< Items intersecting the region painted.
+      qint64 counters[Tracer::CounterCount]; ///< Differences of the Tracer counters, see paintEvent().
+   };
+
+public: // Constructors
+   explicit DiagramView(QWidget* parent = nullptr);
+   virtual ~DiagramView();
+
+public: // Properties
+   bool isHudVisible() const;
+   void setHudVisible(bool value);
+
+   int frameCount() const;
+   QVector<Frame> frames() const;
+
+public: // Methods
+   QJsonObject snapshot() const;
+
+protected:
+   void paintEvent(QPaintEvent* event) override;
+   void scrollContentsBy(int dx, int dy) override;
+
+private:
+   void drawHud();
+   QStringList hudLines() const;
+
+private: // Attributes
+   ///@cond
+   bool           _hudVisible;
+   int            _frameCount;
+   QVector<Frame> _frames;
+   qint64         _counters[Tracer::CounterCount];
+   ///@endcond
+};
@@ -28,11 +28,12 @@
 #include "EdgeShape.h"
 
 #include "Label.h"
+#include "Tracer.h"
 #include "UmlLink.h"
 
 #include <qmath.h>
-#include <QFontMetricsF>
 #include <QPainter>
+#include <QPainterPathStroker>
 
 /**
  * @class EdgeShape
@@ -47,12 +48,17 @@
  * Ending style as well as line style can be set in the constructor of a derived class using functions setEndingStyle()
  * and setLineStyle(). These styles are used for drawing the line and for optimization (ending style).
  *
- * The paint() function is implemented such, that it draws a polyline according to the RoutingKind set at the DiaEdge
- * object first. Then it calls abstract functions drawLineStart() and drawLineEnd() to draw the arrows at the start and
- * end of the polyline respectively. These functions must be implemented by derived classes to draw suitable arrows or
- * line endings (e.g. the diamond of an UML association). After drawing polyline and line endings, it draws the text
- * boxes for name, multiplicity and attributes and finally - if selected - the selection boxes (small rectangles at
- * each end of the polyline).
+ * All geometry of the edge is computed once per geometry change by updateGeometry(): the polyline according to the
+ * RoutingKind set at the DiaEdge object, the ornaments at its start and end, the rectangles of the text boxes for name,
+ * multiplicity and attributes, the shape used for hit testing and the bounding rectangle. The ornaments are made by
+ * the abstract functions makeLineStart() and makeLineEnd(), which must be implemented by derived classes to add
+ * suitable arrows or line endings (e.g. the diamond of an UML association) using makeArrow() and makeDiamond().
+ *
+ * The paint() function then only draws what was computed: polyline, ornaments, text boxes and - if selected - the
+ * selection boxes (small rectangles at each point of the polyline). Since boundingRect() and shape() are exact, the
+ * BSP index of the scene only needs to be touched if the geometry actually changes. updateGeometry() is called on
+ * every position update, by refresh() and whenever line or ending style are set. Derived classes must call
+ * setEndingStyle() in their constructor, since the ornaments cannot be made before they are constructed.
  */
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -69,6 +75,8 @@
 EdgeShape::EdgeShape(QGraphicsItem* parent, DiaEdge* edge)
 : super(parent, edge)
 , _edge(edge)
+, _style(NoArrows)
+, _hidden(false)
 {
    Q_ASSERT(_edge != nullptr);
    _edge->setItemData(static_cast<void*>(this));
@@ -114,38 +122,16 @@ DiaEdge* EdgeShape::diaEdge() const
    return _edge;
 }
 
-/** Gets the bounding rectangle of the edge shape. */
+/** Gets the bounding rectangle of the edge shape, including labels and selection boxes. */
 QRectF EdgeShape::boundingRect() const
 {
-   double extra = (_linePen.width() + 30) / 2.0;
-   QLineF temp(_line.first(), _line.last());
-   return QRectF(
-      temp.p1(), 
-      QSizeF(temp.p2().x() - temp.p1().x(), temp.p2().y() - temp.p1().y())).normalized().adjusted(-extra, -extra, extra, extra);
-   //return shape().controlPointRect() + QMarginsF(50.0, 50.0, 50.0, 50.0);
+   return _bounds;
 }
 
-/** Gets the shape of the edge shape as a painter path. */
+/** Gets the exact shape of the edge shape (line, ornaments and labels) as a painter path. */
 QPainterPath EdgeShape::shape() const
 {
-   /*
-   QPainterPath path;
-   path.addPolygon(_line);
-   path.addPolygon(_arrow);
-
-   if (diaEdge() != nullptr)
-   {
-      auto boxes = diaEdge()->labels();
-      if (boxes.size() == 5)
-      {
-         path.addText(findMidPoint(), _font, boxes[0]->text());
-      }
-   }
-
-   QPainterPathStroker stroker(_linePen);
-   return stroker.createStroke(path);
-   */
-   return super::shape();
+   return _shapePath;
 }
 
 /** Gets the ending style of the edge shape. */
@@ -158,6 +144,7 @@ EdgeShape::EndingStyle EdgeShape::endingStyle() const
 void EdgeShape::setEndingStyle(EdgeShape::EndingStyle value)
 {
    _style = value;
+   updateGeometry();
 }
 
 /** Gets the line style of the edge shape. */
@@ -182,6 +169,7 @@ QPolygonF EdgeShape::line() const
 void EdgeShape::setLine(QPolygonF value)
 {
    _line = value;
+   updateGeometry();
 }
 
 /** Handles the itemChange event. */
@@ -199,6 +187,8 @@ void EdgeShape::updatePosition()
 {
    if (diaEdge() != nullptr)
    {
+      TraceSpan span("EdgeShape::route", "routing");
+      Tracer::count(Tracer::Reroutes);
       switch (diaEdge()->routing())
       {
       case RoutingKind::Auto:
@@ -212,52 +202,72 @@ void EdgeShape::updatePosition()
          makeDirectLine();
          break;
       }
+
+      updateGeometry();
    }
 }
 
+/** Refreshes the shape after the link was changed: recomputes ornaments and labels. */
+void EdgeShape::refresh()
+{
+   updateGeometry();
+   super::refresh();
+}
+
 /**
  * Paints the edge shape.
  *
+ * Only draws the geometry computed by updateGeometry().
  * @param painter QPainter object needed for painting.
  * @param option This parameter is unused.
  * @param widget This parameter is unused.
  */
 void EdgeShape::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+   TraceSpan span("EdgeShape::paint", "paint");
+   Tracer::count(Tracer::PaintedItems);
    Q_UNUSED(option);
    Q_UNUSED(widget);
 
    // Don't even try to draw a line between colliding nodes!
-   if (_items[0] != _items[1] && _items[0]->collidesWithItem(_items[1])) return;
+   if (_hidden) return;
 
-   // Draw line and line endings:
+   // Draw line and line endings, the latter always solid:
    painter->setPen(_linePen);
    painter->setBrush(_brush);
    painter->drawPolyline(_line);
-   if (_style == EndingStyle::ArrowAtStart || _style == EndingStyle::ArrowAtBoth)
-   {
-      drawLineStart(painter, QLineF(_line[0], _line[1]));
-   }
-   if (_style == EndingStyle::ArrowAtEnd || _style == EndingStyle::ArrowAtBoth)
+
+   QPen solidPen(_linePen);
+   solidPen.setStyle(Qt::SolidLine);
+   painter->setPen(solidPen);
+   for (const Ornament& ornament : _ornaments)
    {
-      drawLineEnd(painter, QLineF(_line[_line.length() - 1], _line[_line.length() - 2]));
+      painter->setBrush(ornament.filled ? _solidBrush : _brush);
+      if (ornament.closed)
+      {
+         painter->drawPolygon(ornament.polygon);
+      }
+      else
+      {
+         painter->drawPolyline(ornament.polygon);
+      }
    }
 
    // Draw text boxes at each end and in the middle of the line:
-   auto boxes = diaEdge()->labels();
-   if (boxes.size() == 5)
+   painter->setFont(_font);
+   painter->setPen(_textPen);
+   for (int index = 0; index < _labelRects.size(); ++index)
    {
-      QFontMetricsF metrics(_font);
-      drawCenterBox(painter, metrics, boxes[0]->text());
-      drawMuliplicityBox(painter, metrics, 0, boxes[1]->text());
-      drawAttributeBox(painter, metrics, 0, boxes[2]->text());
-      drawMuliplicityBox(painter, metrics, 1, boxes[3]->text());
-      drawAttributeBox(painter, metrics, 1, boxes[4]->text());
+      if (!_labelRects[index].isEmpty())
+      {
+         painter->drawText(_labelRects[index], Qt::AlignLeft, _labelTexts[index]);
+      }
    }
 
    // Draw small rectangles around each point of the line if selected:
    if (isSelected())
    {
+      painter->setPen(solidPen);
       painter->setBrush(Qt::white);
       for (const QPointF& point : _line)
       {
@@ -266,6 +276,70 @@ void EdgeShape::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
    }
 }
 
+/**
+ * Computes all geometry of the edge from its polyline: visibility, ornaments, label rectangles, shape and bounding
+ * rectangle. Must be called whenever the polyline, the style or the link was changed.
+ */
+void EdgeShape::updateGeometry()
+{
+   prepareGeometryChange();
+   _ornaments.clear();
+   _labelRects.clear();
+   _labelTexts.clear();
+
+   // Lines between colliding nodes are not drawn at all:
+   _hidden = _line.size() < 2 || (_items[0] != _items[1] && _items[0]->collidesWithItem(_items[1]));
+
+   QPainterPath path;
+   if (!_hidden)
+   {
+      if (_style == EndingStyle::ArrowAtStart || _style == EndingStyle::ArrowAtBoth)
+      {
+         makeLineStart(QLineF(_line[0], _line[1]));
+      }
+      if (_style == EndingStyle::ArrowAtEnd || _style == EndingStyle::ArrowAtBoth)
+      {
+         makeLineEnd(QLineF(_line[_line.length() - 1], _line[_line.length() - 2]));
+      }
+
+      auto boxes = _edge != nullptr ? _edge->labels() : QVector<Label*>();
+      if (boxes.size() == KLabelCount)
+      {
+         for (auto* box : boxes) _labelTexts.append(box->text());
+         _labelRects.append(makeCenterBox(_labelTexts[0]));
+         _labelRects.append(makeMultiplicityBox(0, _labelTexts[1]));
+         _labelRects.append(makeAttributeBox(0, _labelTexts[2]));
+         _labelRects.append(makeMultiplicityBox(1, _labelTexts[3]));
+         _labelRects.append(makeAttributeBox(1, _labelTexts[4]));
+      }
+
+      path.addPolygon(_line);
+      for (const Ornament& ornament : _ornaments)
+      {
+         path.addPolygon(ornament.polygon);
+      }
+   }
+
+   // The shape is the stroked line plus the labels, wide enough to be hit easily:
+   QPainterPathStroker stroker;
+   stroker.setWidth(qMax(_linePen.widthF(), KHitWidth));
+   _shapePath = stroker.createStroke(path);
+   for (const QRectF& rect : _labelRects)
+   {
+      if (!rect.isEmpty()) _shapePath.addRect(rect);
+   }
+
+   // The bounding rectangle also contains the selection boxes:
+   _bounds = _shapePath.boundingRect();
+   for (const QPointF& point : _line)
+   {
+      _bounds |= QRectF(point.x() - KSBSize2, point.y() - KSBSize2, KSBSize, KSBSize);
+   }
+
+   double extra = _linePen.widthF();
+   _bounds.adjust(-extra, -extra, extra, extra);
+}
+
 /**
  * Makes a direct line between the two nodes attached but does not draw it.
  * 
@@ -347,42 +421,35 @@ void EdgeShape::updateCustomLine()
 }
 
 /**
- * Draws the center text box containing name and stereotype of the edge.
+ * Computes the rectangle of the center text box containing name and stereotype of the edge.
  * 
- * @param painter
- * @param metrics
- * @param text
+ * @param text Text of the box.
+ * @return Rectangle in item coordinates; empty if there is no text.
  */
-void EdgeShape::drawCenterBox(QPainter* painter, QFontMetricsF& metrics, QString text)
+QRectF EdgeShape::makeCenterBox(const QString& text) const
 {
-   if (_line.length() > 1)
-   {
-      auto pos = findMidPoint();
-      auto rect = metrics.boundingRect(QRectF(0.0, 0.0, 10.0, 10.0), Qt::AlignLeft, text);
-      painter->drawText(
-         pos.x() - rect.width() / 2.0,
-         pos.y() - rect.height() - 5.0,
-         rect.width(),
-         rect.height(),
-         Qt::AlignLeft,
-         text);
-   }
+   if (text.isEmpty() || _line.length() < 2) return QRectF();
+
+   auto pos = findMidPoint();
+   auto rect = textRect(_font, text);
+   return QRectF(pos.x() - rect.width() / 2.0, pos.y() - rect.height() - 5.0, rect.width(), rect.height());
 }
 
 /**
- * Draws a multiplicity box at one end of the edge.
+ * Computes the rectangle of a multiplicity box at one end of the edge.
  * 
  * The multiplicity box contains the multiplicity (0, 1 or many) information of an association.
- * @param painter A QPainter object needed for drawing.
- * @param metrics Font metrics needed to render the text.
- * @param item Number of the item at which the multiplicity box shall be drawn (0 or 1).
- * @param text Text to be rendered.
+ * @param item Number of the item at which the multiplicity box shall be placed (0 or 1).
+ * @param text Text of the box.
+ * @return Rectangle in item coordinates; empty if there is no text.
  */
-void EdgeShape::drawMuliplicityBox(QPainter* painter, QFontMetricsF& metrics, int item, QString text)
+QRectF EdgeShape::makeMultiplicityBox(int item, const QString& text)
 {
+   if (text.isEmpty()) return QRectF();
+
    int     side = 0;
-   QPointF pos = computeIntersection(_items[item], &side, true);
-   QRectF  rect = metrics.boundingRect(QRectF(0.0, 0.0, 10.0, 10.0), Qt::AlignLeft, text);
+   QPointF pos = mapFromScene(computeIntersection(_items[item], &side, true));
+   QRectF  rect = textRect(_font, text);
 
    // Move text box according to side number:
    switch (side)
@@ -401,37 +468,32 @@ void EdgeShape::drawMuliplicityBox(QPainter* painter, QFontMetricsF& metrics, in
          break;
    }
    
-   painter->drawText(pos.x(), pos.y(), rect.width() + 5.0, rect.height() + 5.0, Qt::AlignLeft, text);
+   return QRectF(pos.x(), pos.y(), rect.width() + 5.0, rect.height() + 5.0);
 }
 
 /**
- * Draws the attribute box at one end of the line.
+ * Computes the rectangle of the attribute box at one end of the line.
  *
  * This function is currently not implemented.
- * @param painter
- * @param metrics
  * @param item
  * @param text
  */
-void EdgeShape::drawAttributeBox(QPainter* painter, QFontMetricsF& metrics, int item, QString text)
+QRectF EdgeShape::makeAttributeBox(int item, const QString& text)
 {
-   Q_UNUSED(painter);
-   Q_UNUSED(metrics);
    Q_UNUSED(item);
    Q_UNUSED(text);
-   // TODO: Draw the attribute box
+   // TODO: Compute the attribute box
+   return QRectF();
 }
 
 /** 
- * Draws an opened or closed arrow at one end of a given line.
+ * Adds an opened or closed arrow at one end of a given line to the ornaments.
  *
- * If drawn closed, the arrow is automatically filled with the fill color set at the DiaShape object attached to
- * this object.
- * @param painter QPainter object needed for drawing.
+ * If closed, the arrow is filled with the fill color set at the DiaShape object attached to this object.
  * @param line Line to attach the arrow to.
  * @param closed True, if the arrow shall be drawn closed, false otherwise.
  */
-void EdgeShape::drawArrow(QPainter* painter, const QLineF& line, bool closed)
+void EdgeShape::makeArrow(const QLineF& line, bool closed)
 {
    double angle1, angle2;
    computeAngles(line, angle1, angle2);
@@ -439,48 +501,35 @@ void EdgeShape::drawArrow(QPainter* painter, const QLineF& line, bool closed)
    QPointF arrowP1 = line.p1() + QPointF(sin(angle1) * KArrowSize, cos(angle1) * KArrowSize);
    QPointF arrowP2 = line.p1() + QPointF(sin(angle2) * KArrowSize, cos(angle2) * KArrowSize);
 
-   _arrow.clear();
-   _arrow << arrowP1 << line.p1() << arrowP2;
-
-   auto saved = _linePen.style();
-   _linePen.setStyle(Qt::SolidLine);
-   painter->setPen(_linePen);
-   if (closed)
-   { 
-      painter->drawPolygon(_arrow);
-   }
-   else
-   {
-      painter->drawPolyline(_arrow);
-   }
-   _linePen.setStyle(saved);
+   Ornament arrow;
+   arrow.polygon << arrowP1 << line.p1() << arrowP2;
+   arrow.closed = closed;
+   arrow.filled = false;
+   _ornaments.append(arrow);
 }
 
 /**
- * Draws a circle at one end of a given line.
+ * Adds a circle at one end of a given line to the ornaments.
  * 
  * The circle is filled with the fill color set at the DiaShape object attached to this object.
- * @param painter QPainter object needed for drawing.
  * @param line Line to attach the arrow to.
  * @param crossed If true, draws a cross into the circle.
  */
-void EdgeShape::drawCircle(QPainter* painter, const QLineF& line, bool crossed)
+void EdgeShape::makeCircle(const QLineF& line, bool crossed)
 {
-   Q_UNUSED(painter);
    Q_UNUSED(line);
    Q_UNUSED(crossed);
-   // TODO: Draw the circle
+   // TODO: Make the circle
 }
 
 /**
- * Draws a filled or unfilled diamond at one end of a given line.
+ * Adds a filled or unfilled diamond at one end of a given line to the ornaments.
  *
  * The diamond is filled either with the fill color or the line color of the DiaShape object attached to this object.
- * @param painter QPainter object needed for drawing.
  * @param line Line to attach the arrow to.
  * @param filled True, if the arrow shall be filled with the line color; false if it shall be filled with the fill color.
  */
-void EdgeShape::drawDiamond(QPainter* painter, const QLineF& line, bool filled)
+void EdgeShape::makeDiamond(const QLineF& line, bool filled)
 {
    double angle1, angle2;
    computeAngles(line, angle1, angle2);
@@ -490,16 +539,11 @@ void EdgeShape::drawDiamond(QPainter* painter, const QLineF& line, bool filled)
    QPointF arrowP2 = arrowP1 + tempPt;
    QPointF arrowP3 = line.p1() + tempPt;
 
-   _arrow.clear();
-   _arrow << line.p1() << arrowP1 << arrowP2 << arrowP3;
-
-   if (filled) painter->setBrush(_solidBrush);
-   
-   savePenStyle();
-   _linePen.setStyle(Qt::SolidLine);
-   painter->setPen(_linePen);
-   painter->drawPolygon(_arrow);
-   restorePenStyle();
+   Ornament diamond;
+   diamond.polygon << line.p1() << arrowP1 << arrowP2 << arrowP3;
+   diamond.closed = true;
+   diamond.filled = filled;
+   _ornaments.append(diamond);
 }
 
 void EdgeShape::aboutToDestroy()
@@ -516,7 +560,7 @@ void EdgeShape::aboutToDestroy()
  * @param angle1
  * @param angle2
  */
-void EdgeShape::computeAngles(const QLineF& line, double& angle1, double& angle2)
+void EdgeShape::computeAngles(const QLineF& line, double& angle1, double& angle2) const
 {
    double angle0 = std::atan2(-line.dy(), line.dx());
    angle1 = angle0 + KPi13;
@@ -31,7 +31,9 @@
 #include "DiaEdge.h"
 
 #include <qmath.h>
+#include <QPainterPath>
 #include <QPolygonF>
+#include <QVector>
 
 class UmlElement;
 
@@ -47,6 +49,16 @@ protected:
    const double KArrowSize = 12.0;
    const double KPi13 = M_PI / 3.0;
    const double KPi23 = 2.0 * M_PI / 3.0;
+   const double KHitWidth = 6.0;   ///< Minimum width of the line when testing for mouse hits.
+   const int    KLabelCount = 5;   ///< Number of labels of an edge (name, multiplicity and attribute at each end).
+
+   /** Arrow, diamond or other ornament at an end of the line, in item coordinates. */
+   struct Ornament
+   {
+      QPolygonF polygon; ///< Points of the ornament.
+      bool      closed;  ///< True: draws a polygon; false: draws a polyline.
+      bool      filled;  ///< True: fills with the line color; false: fills with the fill color.
+   };
 
 public:
    EdgeShape(QGraphicsItem* parent, DiaEdge* edge);
@@ -71,6 +83,7 @@ public: // Properties
 public: // Methods
    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
    void updatePosition();
+   void refresh() override;
 
 protected:
    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
@@ -78,22 +91,23 @@ protected:
    void makeDirectLine();
    void makeAutoRoute();
    void updateCustomLine();
+   void updateGeometry();
 
-   void drawCenterBox(QPainter* painter, QFontMetricsF& metrics, QString text);
-   void drawMuliplicityBox(QPainter* painter, QFontMetricsF& metrics, int item, QString text);
-   void drawAttributeBox(QPainter* painter, QFontMetricsF& metrics, int item, QString text);
+   QRectF makeCenterBox(const QString& text) const;
+   QRectF makeMultiplicityBox(int item, const QString& text);
+   QRectF makeAttributeBox(int item, const QString& text);
    
-   void drawArrow(QPainter* painter, const QLineF& line, bool closed);
-   void drawCircle(QPainter* painter, const QLineF& line, bool crossed);
-   void drawDiamond(QPainter* painter, const QLineF& line, bool filled);
+   void makeArrow(const QLineF& line, bool closed);
+   void makeCircle(const QLineF& line, bool crossed);
+   void makeDiamond(const QLineF& line, bool filled);
 
-   virtual void drawLineStart(QPainter* painter, const QLineF& line) = 0;
-   virtual void drawLineEnd(QPainter* painter, const QLineF& line) = 0;
+   virtual void makeLineStart(const QLineF& line) = 0;
+   virtual void makeLineEnd(const QLineF& line) = 0;
 
    void aboutToDestroy() override;
    
 private:
-   void computeAngles(const QLineF& line, double& angle1, double& angle2);
+   void computeAngles(const QLineF& line, double& angle1, double& angle2) const;
    QPointF computeIntersection(QGraphicsItem* item, int* side = nullptr, bool margin = false);
    int findNearestCorner(QGraphicsItem* item, QPointF pos);
    QPointF findMidPoint() const;
@@ -103,12 +117,17 @@ private:
    
 private: // Attributes
    ///@cond
-   DiaEdge*       _edge;
-   QPolygonF      _arrow;
-   QPolygonF      _line;
-   QGraphicsItem* _items[2];
-   EndingStyle    _style;
-   QBrush         _solidBrush;
+   DiaEdge*          _edge;
+   QPolygonF         _line;
+   QGraphicsItem*    _items[2];
+   EndingStyle       _style;
+   QBrush            _solidBrush;
+   bool              _hidden;
+   QVector<Ornament> _ornaments;
+   QVector<QRectF>   _labelRects;
+   QStringList       _labelTexts;
+   QPainterPath      _shapePath;
+   QRectF            _bounds;
    ///@endcond
 };
 
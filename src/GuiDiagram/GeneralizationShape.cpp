@@ -72,12 +72,10 @@ GeneralizationShape::~GeneralizationShape()
  * Draws an arrow at the start (first line segment) of the polyline of the shape.
  *
  * This function is unused.
- * @param painter This parameter is unused
  * @param line This parameter is unused
  */
-void GeneralizationShape::drawLineStart(QPainter* painter, const QLineF& line)
+void GeneralizationShape::makeLineStart(const QLineF& line)
 {
-   Q_UNUSED(painter);
    Q_UNUSED(line);
 }
 
@@ -85,13 +83,12 @@ void GeneralizationShape::drawLineStart(QPainter* painter, const QLineF& line)
  * Draws an arrow at the end (last line segment) of the polyline of the shape.
  *
  * This implementation draws a closed arrow at the last line segment of the polyline of the shape by calling function
- * drawArrow() of the base class.
- * @param painter QPainter object needed for drawing
+ * makeArrow() of the base class.
  * @param line The last line segment of the polygon of the edge shape
  */
-void GeneralizationShape::drawLineEnd(QPainter* painter, const QLineF& line)
+void GeneralizationShape::makeLineEnd(const QLineF& line)
 {
-   drawArrow(painter, line, true);
+   makeArrow(line, true);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -32,6 +32,7 @@
 #include "CommentShape.h"
 #include "DependencyShape.h"
 #include "DiagramScene.h"
+#include "DiagramView.h"
 #include "EdgeShape.h"
 #include "GeneralizationShape.h"
 #include "IShapeBuilder.h"
@@ -32,7 +32,7 @@ DESTDIR  = ../../bin
 CONFIG  += qt c++17 static
 DEFINES += BUILD_STATIC
 
-QT          += widgets
+QT          += widgets concurrent
 MOC_DIR     += ./moc
 OBJECTS_DIR += ./obj
 RCC_DIR     += ./moc
@@ -50,6 +50,7 @@ HEADERS += \
     CommentShape.h \
     DependencyShape.h \
     DiagramScene.h \
+    DiagramView.h \
     EdgeShape.h \
     GeneralizationShape.h \
     IShapeBuilder.h \
@@ -67,6 +68,7 @@ SOURCES += \
     CommentShape.cpp \
     DependencyShape.cpp \
     DiagramScene.cpp \
+    DiagramView.cpp \
     EdgeShape.cpp \
     GeneralizationShape.cpp \
     LinkShape.cpp \
@@ -66,24 +66,20 @@ LinkShape::~LinkShape()
 /**
  * Overwritten to do nothing - this function is unused.
  *
- * @param painter This parameter is unused
  * @param line This parameter is unused
  */
-void LinkShape::drawLineStart(QPainter* painter, const QLineF& line)
+void LinkShape::makeLineStart(const QLineF& line)
 {
-   Q_UNUSED(painter);
    Q_UNUSED(line);
 }
 
 /**
  * Overwritten to do nothing - this function is unused.
  *
- * @param painter This parameter is unused
  * @param line This parameter is unused
  */
-void LinkShape::drawLineEnd(QPainter* painter, const QLineF& line)
+void LinkShape::makeLineEnd(const QLineF& line)
 {
-   Q_UNUSED(painter);
    Q_UNUSED(line);
 }
 
@@ -32,7 +32,6 @@
 #include "TextBox.h"
 #include "UmlElement.h"
 
-#include <QFontMetricsF>
 
 /**
  * @class NodeShape
@@ -51,6 +50,10 @@
  * The DiaNode's size and position is set automatically on construction of this class and each time when calling 
  * function computeSize(). The function also computes the size of a text box using font metrics of the currently used
  * font and sets property textBoxSize() accordingly.
+ *
+ * Text sizes are measured through Shape::textRect(), which remembers the sizes measured so far. Since measure() and
+ * textRect() are thread-safe, the ShapeFactory measures all nodes of a diagram in parallel before building its scene,
+ * so that constructing and painting the shapes afterwards rarely needs font metrics at all.
  */
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -66,12 +69,12 @@
 NodeShape::NodeShape(QGraphicsItem* parent, DiaNode* node)
 : super(parent, node)
 , _node(node)
-, _padding(5.0)
+, _padding(KDefaultPadding)
 {
    Q_ASSERT(_node != nullptr);
    // Property DiaNode::itemData() must be set in derived classes!
 
-   // Set the size of the node to the computed size:
+   // Set the size of the node to the computed size. The compartments were already filled by the diagram:
    computeSize(false);
    setPos(_node->pos());
    setFlag(QGraphicsItem::ItemIsMovable, true);
@@ -163,63 +166,58 @@ QVariant NodeShape::itemChange(GraphicsItemChange change, const QVariant& value)
    if (change == ItemPositionHasChanged)
    {
       _node->setPos(value.toPointF());
-      
-      auto edges = _node->edges();
-      for (DiaEdge* edge : edges)
-      {
-         auto shape = static_cast<EdgeShape*>(edge->itemData());
-         if (shape != nullptr) shape->updatePosition();
-      }
+      updateEdges();
    }
 
    return super::itemChange(change, value);
 }
 
 /**
- * Draws a selection frame around the shape using the bounding rectangle of the shape.
- * 
- * @param painter QPainter instance needed for drawing.
+ * Refreshes the shape after the UmlElement object displayed was changed.
+ *
+ * Updates the compartments of the DiaNode object, recomputes the size of the shape and moves the ends of all edges
+ * attached, since they depend on the size.
  */
-void NodeShape::drawSelectionFrame(QPainter* painter)
+void NodeShape::refresh()
 {
-   QRectF selectFrame = boundingRect();
-   selectFrame += QMarginsF(KSFMargin, KSFMargin, KSFMargin, KSFMargin);
-   _linePen.setStyle(Qt::DashDotLine);
-   painter->setPen(_linePen);
-   painter->setBrush(Qt::NoBrush);
-   painter->drawRect(selectFrame);
-   
-   QRectF sizingBox;
-   sizingBox.setX(selectFrame.x() + selectFrame.width() - KSBSize2);
-   sizingBox.setY(selectFrame.y() + selectFrame.height() - KSBSize2);
-   sizingBox.setWidth(KSBSize);
-   sizingBox.setHeight(KSBSize);
-   _linePen.setStyle(Qt::SolidLine);
-   painter->setPen(_linePen);
-   painter->setBrush(Qt::white);
-   painter->drawRect(sizingBox);
+   prepareGeometryChange();
+   _node->update();
+   computeSize(false);
+   updateEdges();
+   super::refresh();
+}
+
+/** Updates the positions of all edge shapes attached to this node. */
+void NodeShape::updateEdges()
+{
+   auto edges = _node->edges();
+   for (DiaEdge* edge : edges)
+   {
+      auto shape = static_cast<EdgeShape*>(edge->itemData());
+      if (shape != nullptr) shape->updatePosition();
+   }
 }
 
 /**
- * Computes the size of the shape including compartments and text sizes.
+ * Computes the size of a node from the texts in its compartments.
  *
- * The function  sets property size of the DiaNode instance to the computed size if the computed size differs from the
- * size of the DiaNode instance. It also sets property textBoxSize which provides the size of a single text box in a
- * compartment.
- * 
- * @param templated True: adds some space for template parameters to the height of the shape; false otherwise.
+ * The function neither updates the compartments nor changes the node, so it may be called for several nodes at the
+ * same time from different threads.
+ * @param node DiaNode object to be measured.
+ * @param templated True: adds some space for template parameters to the height of the node; false otherwise.
+ * @param padding Padding inside the node.
+ * @param textBoxSize Receives the size of a single text box in a compartment. May be null.
+ * @return The overall size of the node.
  */
-void NodeShape::computeSize(bool templated)
+QSizeF NodeShape::measure(DiaNode* node, bool templated, double padding, QSizeF* textBoxSize)
 {
+   Q_ASSERT(node != nullptr);
+
    QString text;
    int x = 0, c = 0;
-   bool save1 = _font.bold();
-   bool save2 = _font.italic();
-
-   _node->update();
 
    // Find longest text in compartments first:
-   auto comps = _node->compartments();
+   auto comps = node->compartments();
    for (int i = 0; i < comps.size(); ++i)
    {
       if (comps[i]->isHidden()) continue;
@@ -239,25 +237,66 @@ void NodeShape::computeSize(bool templated)
    }
 
    // Compute size of the rectangle needed to paint the text:
-   _font.setBold(true);
-   _font.setItalic(true);
-   QFontMetricsF metrics(_font);
-   QRectF rect = metrics.boundingRect(QRectF(0.0, 0.0, 10.0, 10.0), AlignmentFlag::AlignLeft, text);
-   _font.setBold(save1);
-   _font.setItalic(save2);
+   QFont font(node->fontFamily(), node->fontSize());
+   font.setBold(true);
+   font.setItalic(true);
+   double height = 0.0;
+   QRectF rect = textRect(font, text, &height);
 
    // Compute overall height and width of the shape's rectangle:
-   double oh = (x * (metrics.height() + _padding)) + c * 2.0 * _padding - metrics.height();
-   double ow = rect.width() + 2.0 * _padding;
+   double oh = (x * (height + padding)) + c * 2.0 * padding - height;
+   double ow = rect.width() + 2.0 * padding;
    auto ovs = QSizeF(ow, oh);
    auto tbs = QSizeF(rect.width(), rect.height());
 
    // Add a little bit more space if template parameters must be drawn:
    if (templated)
    {
-      ovs.setHeight(ovs.height() + tbs.height() + _padding);
+      ovs.setHeight(ovs.height() + tbs.height() + padding);
    }
+
+   if (textBoxSize != nullptr) *textBoxSize = tbs;
+   return ovs;
+}
+
+/**
+ * Draws a selection frame around the shape using the bounding rectangle of the shape.
+ * 
+ * @param painter QPainter instance needed for drawing.
+ */
+void NodeShape::drawSelectionFrame(QPainter* painter)
+{
+   QRectF selectFrame = boundingRect();
+   selectFrame += QMarginsF(KSFMargin, KSFMargin, KSFMargin, KSFMargin);
+   _linePen.setStyle(Qt::DashDotLine);
+   painter->setPen(_linePen);
+   painter->setBrush(Qt::NoBrush);
+   painter->drawRect(selectFrame);
    
+   QRectF sizingBox;
+   sizingBox.setX(selectFrame.x() + selectFrame.width() - KSBSize2);
+   sizingBox.setY(selectFrame.y() + selectFrame.height() - KSBSize2);
+   sizingBox.setWidth(KSBSize);
+   sizingBox.setHeight(KSBSize);
+   _linePen.setStyle(Qt::SolidLine);
+   painter->setPen(_linePen);
+   painter->setBrush(Qt::white);
+   painter->drawRect(sizingBox);
+}
+
+/**
+ * Computes the size of the shape including compartments and text sizes.
+ *
+ * The function sets property size of the DiaNode instance to the computed size and property textBoxSize which
+ * provides the size of a single text box in a compartment. It does not update the compartments, call
+ * DiaNode::update() before if the UmlElement object may have changed.
+ * 
+ * @param templated True: adds some space for template parameters to the height of the shape; false otherwise.
+ */
+void NodeShape::computeSize(bool templated)
+{
+   QSizeF tbs;
+   QSizeF ovs = measure(_node, templated, _padding, &tbs);
    setNodeSize(ovs);
    setTextBoxSize(tbs);
 }
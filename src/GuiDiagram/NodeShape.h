@@ -30,6 +30,7 @@
 #include "Shape.h"
 #include "DiaNode.h"
 
+#include <QFont>
 #include <QSizeF>
 #include <QRectF>
 #include <QPainter>
@@ -40,6 +41,9 @@ class UmlElement;
 class NodeShape : public Shape
 {
    typedef Shape super;   
+public: // Constants
+   static constexpr double KDefaultPadding = 5.0; ///< Default padding inside the shape.
+
 public: // Constructors
    NodeShape(QGraphicsItem* parent, DiaNode* node);
    virtual ~NodeShape();
@@ -62,10 +66,14 @@ public: // Properties
 
 public: // Methods
    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
+   void refresh() override;
+
+   static QSizeF measure(DiaNode* node, bool templated, double padding = KDefaultPadding, QSizeF* textBoxSize = nullptr);
 
 protected:
    virtual void drawSelectionFrame(QPainter* painter);
    virtual void computeSize(bool templated = false);
+   void updateEdges();
 
 private: // Attributes
    DiaNode* _node;
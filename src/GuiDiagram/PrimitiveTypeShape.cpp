@@ -29,6 +29,7 @@
 
 #include "DiaNode.h"
 #include "SignatureTools.h"
+#include "Tracer.h"
 #include "UmlPrimitiveType.h"
 
 #include <QPainter>
@@ -58,6 +59,7 @@ PrimitiveTypeShape::PrimitiveTypeShape(QGraphicsItem* parent, DiaNode* node)
    Q_ASSERT(_element != nullptr);
    
    _keyword = makeAnnotation(_element->keywords(), "");
+   computeSize();
 }
 
 PrimitiveTypeShape::~PrimitiveTypeShape()
@@ -69,12 +71,20 @@ UmlElement* PrimitiveTypeShape::element() const
    return _element;
 }
 
+/** Refreshes the shape after the primitive type was changed: updates keywords and size. */
+void PrimitiveTypeShape::refresh()
+{
+   _keyword = makeAnnotation(_element->keywords(), "");
+   super::refresh();
+}
+
 void PrimitiveTypeShape::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+   TraceSpan span("PrimitiveTypeShape::paint", "paint");
+   Tracer::count(Tracer::PaintedItems);
    Q_UNUSED(option);
    Q_UNUSED(widget);
 
-   computeSize();
    double x = -(nodeSize().width() / 2.0);
    double y = -(nodeSize().height() / 2.0);
    double w = nodeSize().width();
@@ -95,6 +105,7 @@ void PrimitiveTypeShape::paint(QPainter* painter, const QStyleOptionGraphicsItem
    painter->setFont(_font);
    y += textBoxSize().height() + padding();
    painter->drawText(x, y, textBoxSize().width(), textBoxSize().height(), AlignmentFlag::AlignCenter, _element->name());
+   _font.setBold(false);
 
    // Draw selection frame around the shape:
    if (isSelected()) drawSelectionFrame(painter);
@@ -108,15 +119,14 @@ void PrimitiveTypeShape::computeSize(bool templated)
       text = _keyword;
    }
    
-   _font.setBold(true);
-   _font.setItalic(true);
-   QFontMetricsF metrics(_font);
-   QRectF rect = metrics.boundingRect(QRectF(0.0, 0.0, 10.0, 10.0), AlignmentFlag::AlignCenter, text);
-   _font.setBold(false);
-   _font.setItalic(false);
+   QFont font(_font);
+   font.setBold(true);
+   font.setItalic(true);
+   double height = 0.0;
+   QRectF rect = textRect(font, text, &height);
 
    // Compute overall height and width of the shape's rectangle:
-   double oh = 2 * (metrics.height() + padding()) + padding();
+   double oh = 2 * (height + padding()) + padding();
    double ow = rect.width() + 2.0 * padding();
    setNodeSize(QSizeF(ow, oh));
    setTextBoxSize(QSizeF(rect.width(), rect.height()));
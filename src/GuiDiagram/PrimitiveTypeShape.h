@@ -44,6 +44,9 @@ public: // Constructors
 public: // Properties
    UmlElement* element() const override;
 
+public: // Methods
+   void refresh() override;
+
 protected: // Methods
    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
    void computeSize(bool templated = false) override;
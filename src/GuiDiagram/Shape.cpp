@@ -26,9 +26,15 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "Shape.h"
+#include "DiagramScene.h"
+#include "MemoryUsage.h"
+#include "Tracer.h"
 
+#include <QFontMetricsF>
 #include <QGraphicsScene>
 #include <QGraphicsSceneContextMenuEvent>
+#include <QHash>
+#include <QReadWriteLock>
 
 /**
  * @class Shape
@@ -38,8 +44,23 @@
  *
  * The Shape class is the abstract base class of all diagram shapes of ViraquchaUML. It provides properties needed by
  * all diagram shapes.
+ *
+ * Shapes can cache their painting in a pixmap (QGraphicsItem::DeviceCoordinateCache), so that repainting them while
+ * panning or rubber-band selecting is a simple blit. Caching is switched on per DiagramScene, see
+ * DiagramScene::setCaching(); shapes larger than KMaxCacheArea are never cached. Since paint() is not called for a
+ * cached shape, the cache must be invalidated whenever the picture changes: style changes of the DiaShape object are
+ * handled by styleChanged(), content changes of the UmlElement object must be announced by calling refresh().
  */
 
+//---------------------------------------------------------------------------------------------------------------------
+// Internal data
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+struct TextEntry { QRectF rect; double height; };
+static QReadWriteLock            textLock;
+static QHash<QString, TextEntry> textCache;
+/// @endcond
+
 //---------------------------------------------------------------------------------------------------------------------
 // Construction
 //---------------------------------------------------------------------------------------------------------------------
@@ -53,20 +74,14 @@
 Shape::Shape(QGraphicsItem* parent, DiaShape* shape)
 : super(parent)
 , _shape(shape)
+, _contextMenu(nullptr)
+, _caching(false)
 {
    Q_ASSERT(_shape != nullptr);
    _shape->subscribe(this);
    
-   _brush.setColor(QColor(shape->fillColor()));
    _brush.setStyle(Qt::SolidPattern);
-   
-   _font.setFamily(shape->fontFamily());
-   _font.setPointSize(shape->fontSize());
-
-   _linePen.setWidthF(shape->penWidth());
-   _linePen.setColor(shape->lineColor());
-    
-   _textPen.setColor(shape->textColor());
+   applyStyle();
 
    setFlag(QGraphicsItem::ItemIsSelectable, true);
    setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
@@ -75,6 +90,8 @@ Shape::Shape(QGraphicsItem* parent, DiaShape* shape)
 
 Shape::~Shape()
 {
+   // Mark the DiaShape object as not being shown any more:
+   _shape->setItemData(nullptr);
    _shape->unsubscribe(this);
 }
 
@@ -100,6 +117,108 @@ void Shape::setContextMenu(QMenu* value)
    _contextMenu = value;
 }
 
+/** Returns true if the shape caches its painting in a pixmap; false otherwise. */
+bool Shape::isCaching() const
+{
+   return _caching;
+}
+
+/**
+ * Switches pixmap caching of the shape and its child items on or off.
+ *
+ * @param value True: caches the painting unless the shape is larger than KMaxCacheArea; false: no caching.
+ */
+void Shape::setCaching(bool value)
+{
+   _caching = value;
+   updateCacheMode();
+}
+
+/**
+ * Refreshes the shape after the UmlElement object displayed was changed.
+ *
+ * The base implementation repaints the shape, which also invalidates its cache. Derived classes recompute their
+ * content and size first.
+ */
+void Shape::refresh()
+{
+   updateCacheMode();
+   update();
+}
+
+/**
+ * Handles itemChange events.
+ *
+ * Takes over the caching setting of the DiagramScene object the shape was added to.
+ * @param change Kind of change.
+ * @param value Value of the change.
+ * @returns A QVariant value.
+ */
+QVariant Shape::itemChange(GraphicsItemChange change, const QVariant& value)
+{
+   if (change == ItemSceneHasChanged)
+   {
+      auto* diaScene = dynamic_cast<DiagramScene*>(scene());
+      setCaching(diaScene != nullptr && diaScene->isCaching());
+   }
+
+   return super::itemChange(change, value);
+}
+
+/**
+ * Gets the bounding rectangle of a text drawn with a given font.
+ *
+ * Measured sizes are remembered, so measuring the same text with the same font again is a cheap lookup. The function
+ * is thread-safe. At most KMaxCachedTexts sizes are remembered; the cache is emptied if that number is exceeded.
+ * @param font Font used for drawing the text.
+ * @param text Text to be measured.
+ * @param lineHeight Receives the height of a line drawn with the font. May be null.
+ * @return Bounding rectangle of the text, left aligned at position (0, 0).
+ */
+QRectF Shape::textRect(const QFont& font, const QString& text, double* lineHeight)
+{
+   QString key = font.key() + QChar('\n') + text;
+   {
+      QReadLocker locker(&textLock);
+      auto iter = textCache.constFind(key);
+      if (iter != textCache.constEnd())
+      {
+         Tracer::count(Tracer::TextCacheHits);
+         if (lineHeight != nullptr) *lineHeight = iter->height;
+         return iter->rect;
+      }
+   }
+
+   Tracer::count(Tracer::TextMeasurements);
+   QFontMetricsF metrics(font);
+   TextEntry entry;
+   entry.rect = metrics.boundingRect(QRectF(0.0, 0.0, 10.0, 10.0), Qt::AlignLeft, text);
+   entry.height = metrics.height();
+   {
+      QWriteLocker locker(&textLock);
+      if (textCache.size() >= KMaxCachedTexts) textCache.clear();
+      textCache.insert(key, entry);
+   }
+
+   if (lineHeight != nullptr) *lineHeight = entry.height;
+   return entry.rect;
+}
+
+/**
+ * Adds the memory used by the text sizes remembered by textRect() to a MemoryUsage object.
+ *
+ * @param usage MemoryUsage object receiving the sizes as graphics memory.
+ */
+void Shape::measureTextCache(MemoryUsage& usage)
+{
+   QReadLocker locker(&textLock);
+   usage.graphics += MemoryUsage::sizeOf(textCache);
+   for (auto iter = textCache.cbegin(); iter != textCache.cend(); ++iter)
+   {
+      usage.graphics += MemoryUsage::sizeOf(iter.key());
+   }
+}
+
 /** Saves line and text pen styles. */
 void Shape::savePenStyle()
 {
@@ -114,6 +233,40 @@ void Shape::restorePenStyle()
    _textPen.setStyle(_savedText);
 }
 
+/** Takes over the style properties of the DiaShape object into brushes, fonts and pens. */
+void Shape::applyStyle()
+{
+   _brush.setColor(QColor(_shape->fillColor()));
+   _font.setFamily(_shape->fontFamily());
+   _font.setPointSize(_shape->fontSize());
+   _linePen.setWidthF(_shape->penWidth());
+   _linePen.setColor(_shape->lineColor());
+   _textPen.setColor(_shape->textColor());
+}
+
+/** Sets the cache mode of the shape and its child items according to property caching and the size of the shape. */
+void Shape::updateCacheMode()
+{
+   QRectF rect = boundingRect();
+   bool   fits = rect.width() * rect.height() <= KMaxCacheArea;
+   auto   mode = _caching && fits ? DeviceCoordinateCache : NoCache;
+   if (cacheMode() == mode) return;
+
+   setCacheMode(mode);
+   for (QGraphicsItem* child : childItems())
+   {
+      child->setCacheMode(mode);
+   }
+}
+
+/** Called by the DiaShape object if a style property was changed: takes over the new style and refreshes. */
+void Shape::styleChanged()
+{
+   prepareGeometryChange();
+   applyStyle();
+   refresh();
+}
+
 /** Called by the DiaNode object if destroyed, removes the shape from the diagram scene and deletes itself. */
 void Shape::aboutToDestroy()
 {
@@ -37,6 +37,7 @@
 #include <QPen>
 
 class UmlElement;
+struct MemoryUsage;
 
 class Shape : public QGraphicsItem, public IShapeObserver
 {
@@ -47,6 +48,8 @@ public: // Constants
    const double KSFMargin = 5.0;           ///< Margin for the selection frame.
    const double KSBSize   = 7.0;           ///< Size (width and height) of the sizing box.
    const double KSBSize2  = KSBSize / 2.0; ///< Half the size of the sizing box.
+   static constexpr double KMaxCacheArea = 1024.0 * 1024.0; ///< Maximum area of a shape to be cached in a pixmap.
+   static constexpr int    KMaxCachedTexts = 20000; ///< Maximum number of text sizes remembered by textRect().
 
 public: // Constructors
     Shape(QGraphicsItem* parent, DiaShape* shape);
@@ -59,10 +62,22 @@ public: // Properties
    QMenu* contextMenu() const;
    void setContextMenu(QMenu* value);
 
+   bool isCaching() const;
+   void setCaching(bool value);
+
+public: // Methods
+   virtual void refresh();
+   static QRectF textRect(const QFont& font, const QString& text, double* lineHeight = nullptr);
+   static void measureTextCache(MemoryUsage& usage);
+   QVariant itemChange(GraphicsItemChange change, const QVariant& value) override;
+
 protected: // Methods
    void savePenStyle();
    void restorePenStyle();
+   void applyStyle();
+   void updateCacheMode();
    void aboutToDestroy() override;
+   void styleChanged() override;
    void contextMenuEvent(QGraphicsSceneContextMenuEvent* event) override;
 
 protected: // Attributes
@@ -77,5 +92,6 @@ protected: // Attributes
 private:
    ///@cond
    QMenu*       _contextMenu;
+   bool         _caching;
    ///@endcond
 };
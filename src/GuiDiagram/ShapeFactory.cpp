@@ -38,12 +38,15 @@
 #include "RealizationShape.h"
 #include "IShapeBuilder.h"
 
+#include "ITemplatableElement.h"
+#include "Tracer.h"
 #include "UmlCommon.h"
 #include "UmlClassifiers.h"
 
 #include <QList>
 #include <QListIterator>
 #include <QMapIterator>
+#include <QtConcurrent/QtConcurrentMap>
 
 /**
  * @class ShapeFactory
@@ -145,6 +148,11 @@ void ShapeFactory::buildScene(DiagramScene* scene, UmlDiagram* diagram)
 {
    Q_ASSERT(scene != nullptr);
    Q_ASSERT(diagram != nullptr);
+   TraceSpan span("ShapeFactory::buildScene", "scene");
+   span.setDetail(diagram->name());
+
+   // Measure all nodes up front, the shapes then find their text sizes already computed:
+   measureNodes(diagram->nodes());
 
    QListIterator<DiaNode*> nodes(diagram->nodes());
    while (nodes.hasNext())
@@ -169,6 +177,28 @@ void ShapeFactory::buildScene(DiagramScene* scene, UmlDiagram* diagram)
    }
 }
 
+/**
+ * Measures the texts of a list of nodes in parallel and sets the sizes of the nodes.
+ *
+ * The text sizes are remembered by Shape::textRect(), so the shapes built for the nodes afterwards do not need to
+ * measure them again. Nodes without compartments (e.g. comments) keep their size. The compartments of the nodes must
+ * have been filled before, which UmlDiagram::open() does.
+ * @param nodes List of DiaNode objects to be measured.
+ */
+void ShapeFactory::measureNodes(const QList<DiaNode*>& nodes)
+{
+   TraceSpan span("ShapeFactory::measureNodes", "scene");
+   QList<DiaNode*> list(nodes);
+   QtConcurrent::blockingMap(list, [](DiaNode* node)
+   {
+      if (node->compartments().isEmpty()) return;
+
+      auto* elem = dynamic_cast<ITemplatableElement*>(node->element());
+      bool  templated = elem != nullptr && elem->isTemplated();
+      node->setSize(NodeShape::measure(node, templated));
+   });
+}
+
 /**
  * Finds an IShapeBuilder object for a given class name.
  *
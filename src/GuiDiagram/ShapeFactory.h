@@ -28,6 +28,7 @@
 #pragma once
 
 #include <QGraphicsItem>
+#include <QList>
 #include <QMap>
 #include <QString>
 
@@ -57,6 +58,7 @@ public: // Methods
    Shape* buildShape(DiaEdge* edge);
    Shape* buildShape(DiaNode* node);
    void buildScene(DiagramScene* scene, UmlDiagram* diagram);
+   void measureNodes(const QList<DiaNode*>& nodes);
 
 private:
    IShapeBuilder* find(const QString& className);
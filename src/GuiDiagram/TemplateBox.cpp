@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "TemplateBox.h"
+#include "Tracer.h"
 #include "UmlElement.h"
 #include "UmlTemplateParameter.h"
 
@@ -101,15 +102,13 @@ QRectF TemplateBox::boundingRect() const
  */
 void TemplateBox::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
 {
+   TraceSpan span("TemplateBox::paint", "paint");
+   Tracer::count(Tracer::PaintedItems);
    Q_UNUSED(option);
    Q_UNUSED(widget);
    
    if (_element->isTemplated())
    {
-      // Compute size of template box and position it relative to the parent shape:
-      computeSize();
-      setPos(10, -_node->size().height() / 2.0 - _size.height() + _textBoxSize.height());      
-      
       // Draw a filled rectangle surrounded by a dashed line using line pen and fill color:
       _linePen.setStyle(Qt::DashLine);
       painter->setPen(_linePen);
@@ -138,6 +137,23 @@ void TemplateBox::paint(QPainter* painter, const QStyleOptionGraphicsItem* optio
    }
 }
 
+/**
+ * Recomputes size and position of the template box after the template parameters or the size of the parent shape
+ * were changed. Must be called by the parent shape, paint() only draws.
+ */
+void TemplateBox::refresh()
+{
+   prepareGeometryChange();
+   if (_element->isTemplated())
+   {
+      // Compute size of template box and position it relative to the parent shape:
+      computeSize();
+      setPos(10, -_node->size().height() / 2.0 - _size.height() + _textBoxSize.height());
+   }
+
+   update();
+}
+
 /** Computes the size of the template box. */
 void TemplateBox::computeSize()
 {
@@ -154,6 +170,7 @@ void TemplateBox::computeSize()
    // Compute width and height of the template box using font metrics of the text found above:
    _font.setBold(true);
    _font.setItalic(true);
+   Tracer::count(Tracer::TextMeasurements);
    QFontMetricsF metrics(_font);
    QRectF rect = metrics.boundingRect(QRectF(0.0, 0.0, 10.0, 10.0), AlignmentFlag::AlignLeft, text);
    _size.setWidth(rect.width() + 2.0 * _padding);
@@ -49,6 +49,7 @@ public: // Properties
    QRectF boundingRect() const override;
 
 public: // Methods
+   void refresh();
    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
    
 private:
@@ -181,7 +181,7 @@ QVariant ProjectTreeModel::data(const QModelIndex& index, int role) const
  * This concrete implementation of the function only uses the Qt::EditRole to set the name of the UML element stored
  * at the given index to the value passed in (i.e. the value is assumed to be a string containing the name entered by
  * the user). All other roles are ignored.
- * Emits the dataChanged() signal if the data was successfully set and then returns true.
+ * Renaming is done by function rename(), so renaming a type also updates all references to it.
  * @param index Model index under which the UML element is stored in the project tree.
  * @param value Value to be set, in this case the name entered by the user.
  * @param role Role of the data to be set.
@@ -194,13 +194,9 @@ bool ProjectTreeModel::setData(const QModelIndex& index, const QVariant& value,
       QString name = value.toString();
       if (name == "") return false;
 
-      INamedElement* named = dynamic_cast<INamedElement*>(getElement(index));
-      if (named == nullptr) return false;
       if (role == Qt::EditRole)
       {
-         named->setName(name);
-         emit dataChanged(index, index);
-         return true;
+         return rename(getElement(index), name);
       }
    }
 
@@ -302,14 +298,16 @@ bool ProjectTreeModel::insertRow(int position, const QModelIndex& parent, UmlEle
       {
          // Append at the end of the parent, do not update tree!
          owner->append(element);
-         project->isModified(true);
+         project->markModified(owner);
+         project->markModified(element);
          return true;
       }
 
       beginInsertRows(parent, position, position);
       owner->insert(position, element);
       endInsertRows();
-      project->isModified(true);
+      project->markModified(owner);
+      project->markModified(element);
       return true;
    }
 
@@ -338,7 +336,8 @@ bool ProjectTreeModel::insertRow(const QModelIndex& parent, UmlElement* element)
       {
          // Append at the end of the parent, do not update tree!
          owner->append(element);
-         project->isModified(true);
+         project->markModified(owner);
+         project->markModified(element);
          return true;
       }
 
@@ -346,7 +345,8 @@ bool ProjectTreeModel::insertRow(const QModelIndex& parent, UmlElement* element)
       beginInsertRows(parent, pos, pos);
       owner->insert(pos, element);
       endInsertRows();
-      project->isModified(true);
+      project->markModified(owner);
+      project->markModified(element);
       return true;
    }
 
@@ -385,7 +385,8 @@ bool ProjectTreeModel::insertRow(const QModelIndex& parent, QString className, Q
    {
       // Append at the end of the parent, do not update tree!
       owner->append(element);
-      project->isModified(true);
+      project->markModified(owner);
+      project->markModified(element);
       return true;
    }
 
@@ -393,7 +394,8 @@ bool ProjectTreeModel::insertRow(const QModelIndex& parent, QString className, Q
    beginInsertRows(parent, pos, pos);
    owner->insert(pos, element);
    endInsertRows();
-   project->isModified(true);
+   project->markModified(owner);
+   project->markModified(element);
    return true;
 }
 
@@ -416,7 +418,7 @@ bool ProjectTreeModel::removeRow(const QModelIndex& index)
       beginRemoveRows(index.parent(), pos, pos);
       removeRecursive(elem);
       endRemoveRows();
-      project->isModified(true);
+      project->markModified(owner);
       return true;
    }
    
@@ -468,7 +470,7 @@ bool ProjectTreeModel::moveRow(const QModelIndex &index, bool down)
       beginMoveRows(index.parent(), pos, pos, index.parent(), pos + 2);
       owner->moveDown(elem);
       endMoveRows();
-      _root->project()->isModified(true);
+      _root->project()->markModified(owner);
       return true;
    }
    else
@@ -477,13 +479,73 @@ bool ProjectTreeModel::moveRow(const QModelIndex &index, bool down)
       beginMoveRows(index.parent(), pos, pos, index.parent(), pos - 1);
       owner->moveUp(elem);
       endMoveRows();
-      _root->project()->isModified(true);
+      _root->project()->markModified(owner);
       return true;
    }
 
    return false;
 }
 
+/**
+ * Renames an UML element.
+ *
+ * If the element is a type (a classifier or a primitive type), all attributes, operations and templates referencing
+ * it are updated as well, provided the project accepts the new name (see UmlProject::canRenameType()). Otherwise only
+ * the element itself is renamed and signal referencesKept() tells that the references still use the old name.
+ * Emits signal renamed() after renaming, which allows recording the change as a single undoable command.
+ * @param element UML element to be renamed. Must implement INamedElement.
+ * @param name New name of the UML element.
+ * @returns true if the element was renamed; false otherwise.
+ */
+bool ProjectTreeModel::rename(UmlElement* element, QString name)
+{
+   auto* named = dynamic_cast<INamedElement*>(element);
+   if (named == nullptr || name.isEmpty() || named->name() == name) return false;
+
+   QString oldName = named->name();
+   bool isType = dynamic_cast<UmlClassifier*>(element) != nullptr || dynamic_cast<UmlPrimitiveType*>(element) != nullptr;
+   bool refactor = isType && getProject()->canRenameType(oldName, name);
+
+   applyRename(element, name, refactor);
+   emit renamed(element, oldName, name, refactor);
+   if (isType && !refactor) emit referencesKept(oldName, name);
+   return true;
+}
+
+/**
+ * Renames an UML element without emitting signal renamed().
+ *
+ * Used by rename() and by the undo command recording the renaming. Emits dataChanged() for the element and for all
+ * elements whose type references were modified.
+ * @param element UML element to be renamed. Must implement INamedElement.
+ * @param name New name of the UML element.
+ * @param refactor If true, type references to the old name are renamed as well.
+ */
+void ProjectTreeModel::applyRename(UmlElement* element, QString name, bool refactor)
+{
+   auto* named = dynamic_cast<INamedElement*>(element);
+   if (named == nullptr) return;
+
+   QString oldName = named->name();
+   named->setName(name);
+
+   auto* project = getProject();
+   project->markModified(element);
+
+   QList<UmlElement*> changed;
+   if (refactor)
+   {
+      changed = project->renameType(oldName, name);
+   }
+   changed.prepend(element);
+
+   for (auto* elem : changed)
+   {
+      auto index = indexOf(elem);
+      if (index.isValid()) emit dataChanged(index, index);
+   }
+}
+
 /** 
  * Gets the UML element stored under a specified model index as a UmlCompositeElement object. 
  * 
@@ -61,11 +61,18 @@ public: // Methods
    bool removeRow(const QModelIndex& parent, UmlElement* element);
    bool moveRow(const QModelIndex& index, bool down);
 
+   bool rename(UmlElement* element, QString name);
+   void applyRename(UmlElement* element, QString name, bool refactor);
+
    UmlCompositeElement* getComposite(const QModelIndex& index) const;
    UmlElement* getElement(const QModelIndex& index) const;
    UmlPackage* getPackage(const QModelIndex& index) const;
    UmlProject* getProject() const { return _root->project(); }
 
+signals:
+   void renamed(UmlElement* element, QString oldName, QString newName, bool refactor);
+   void referencesKept(QString oldName, QString newName);
+
 private:
    void removeRecursive(UmlElement* elem);
 
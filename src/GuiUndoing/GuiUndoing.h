@@ -32,6 +32,7 @@
 #include "InsertCommand.h"
 #include "MoveCommand.h"
 #include "RemoveCommand.h"
+#include "RenameCommand.h"
 #include "UndoCommand.h"
 
 /**
@@ -49,6 +49,7 @@ HEADERS += \
     InsertCommand.h \
     MoveCommand.h \
     RemoveCommand.h \
+    RenameCommand.h \
     UndoCommand.h
 
 SOURCES += \ 
@@ -56,4 +57,5 @@ SOURCES += \
     InsertCommand.cpp \
     MoveCommand.cpp \
     RemoveCommand.cpp \
+    RenameCommand.cpp \
     UndoCommand.cpp
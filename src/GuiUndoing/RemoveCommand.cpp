@@ -70,3 +70,11 @@ void RemoveCommand::undo()
    loadProperties(_properties);
    _model.insertRow(_parent, element());
 }
+
+/** Adds the estimated memory used by the command including the saved properties of the element. */
+void RemoveCommand::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.undo += sizeof(RemoveCommand) - sizeof(UndoCommand);
+   if (_properties.capacity() > 0) usage.undo += MemoryUsage::KArrayHeader + _properties.capacity() + 1;
+}
@@ -45,6 +45,7 @@ public:
 public:
    void redo() override;
    void undo() override;
+   void measure(MemoryUsage& usage) const override;
    
 private:
    ProjectTreeModel&     _model;
@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------------------------------------------------
+// RenameCommand.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class RenameCommand.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "RenameCommand.h"
+
+/**
+ * @class RenameCommand
+ * @brief The RenameCommand class implements a rename command for UmlElement objects.
+ * @since 0.2.0
+ * @ingroup GuiUndoing
+ *
+ * The RenameCommand class records the renaming of an UML element done by ProjectTreeModel::rename(). If the element
+ * is a type, the renaming includes all type references rewritten in attributes, operations and templates, so the 
+ * whole refactoring is undone and redone in one step. 
+ *
+ * The command is created after the renaming has been applied (see signal ProjectTreeModel::renamed()). Therefore the 
+ * first call of redo(), issued by QUndoStack::push(), does nothing.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the RenameCommand class.
+ * @param element UmlElement object renamed.
+ * @param model Project tree model containing the element.
+ * @param oldName Name of the element before renaming.
+ * @param newName Name of the element after renaming.
+ * @param refactor True if type references were renamed as well.
+ */
+RenameCommand::RenameCommand(UmlElement* element, ProjectTreeModel& model, QString oldName, QString newName, 
+   bool refactor)
+: super(element, model.getProject())
+, _model(model)
+, _oldName(oldName)
+, _newName(newName)
+, _refactor(refactor)
+, _applied(true)
+{
+   setText(QObject::tr("Rename %1 to %2").arg(oldName).arg(newName));
+}
+
+RenameCommand::~RenameCommand()
+{
+}
+
+/** Renames the UmlElement object to the new name. */
+void RenameCommand::redo()
+{
+   if (_applied)
+   {
+      _applied = false;
+      return;
+   }
+
+   _model.applyRename(element(), _newName, _refactor);
+}
+
+/** Renames the UmlElement object back to the old name. */
+void RenameCommand::undo()
+{
+   _model.applyRename(element(), _oldName, _refactor);
+}
+
+/** Adds the estimated memory used by the command including the old and the new name. */
+void RenameCommand::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.undo += sizeof(RenameCommand) - sizeof(UndoCommand);
+   usage.undo += MemoryUsage::sizeOf(_oldName) + MemoryUsage::sizeOf(_newName);
+}
@@ -93,6 +93,18 @@ void UndoCommand::setNeighborId(QUuid value)
    _neighborId = value;
 }
 
+/**
+ * Adds the estimated memory used by the command to a MemoryUsage object.
+ *
+ * The element of the command is not included, it is measured with the project as long as it is part of it.
+ * Derived classes keeping additional data should override this function and call the base class implementation.
+ * @param usage MemoryUsage object receiving the sizes as undo memory.
+ */
+void UndoCommand::measure(MemoryUsage& usage) const
+{
+   usage.undo += sizeof(UndoCommand) + MemoryUsage::sizeOf(_className) + MemoryUsage::sizeOf(text());
+}
+
 /** Saves properties of the element to a byte array. */
 void UndoCommand::saveProperties(QByteArray& array)
 {
@@ -29,6 +29,7 @@
 
 #include "UmlElement.h"
 #include "UmlProject.h"
+#include "MemoryUsage.h"
 
 #include <QByteArray>
 #include <QString>
@@ -50,6 +51,8 @@ public:
    QUuid neighborId() const;
    void setNeighborId(QUuid value);
 
+   virtual void measure(MemoryUsage& usage) const;
+
 protected:
    void saveProperties(QByteArray& array);
    void loadProperties(QByteArray& array);
@@ -27,6 +27,7 @@
 
 TEMPLATE = subdirs
 SUBDIRS  = \
+    Benchmarks \
     GuiCommon \
     GuiDiagram \
     GuiProject \
@@ -34,12 +35,20 @@ SUBDIRS  = \
     GuiUndoing \
     UmlCommon \
     UmlClassifiers \
+    UmlLayout \
+    UmlValidation \
+    ViraquchaCli \
     ViraquchaUML
 
+Benchmarks.depends = GuiCommon GuiDiagram GuiProject GuiResources UmlCommon UmlClassifiers
+
 GuiDiagram.depends = GuiProject GuiResources UmlCommon UmlClassifiers
 GuiProject.depends = GuiResources UmlCommon UmlClassifiers
 GuiUndoing.depends = GuiProject UmlCommon UmlClassifiers
 
 UmlClassifiers.depends = UmlCommon
+UmlLayout.depends = UmlCommon UmlClassifiers
+UmlValidation.depends = UmlCommon UmlClassifiers
 
-ViraquchaUML.depends = GuiCommon GuiProject GuiResources GuiUndoing UmlCommon UmlClassifiers
+ViraquchaCli.depends = UmlCommon UmlClassifiers UmlLayout UmlValidation
+ViraquchaUML.depends = GuiCommon GuiProject GuiResources GuiUndoing UmlCommon UmlClassifiers UmlLayout UmlValidation
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "AssociationEnd.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "UmlAttribute.h"
 #include "PropertyStrings.h"
 
@@ -338,6 +339,19 @@ void AssociationEnd::clear()
    data->qualifiers.clear();
 }
 
+/**
+ * Adds the strings and containers of the association end to a MemoryUsage object.
+ *
+ * The association end itself is part of the Data struct of its association, see UmlAssociation::measure().
+ * @param usage MemoryUsage object to be added to.
+ */
+void AssociationEnd::measure(MemoryUsage& usage) const
+{
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype) + MemoryUsage::sizeOf(data->type);
+   usage.containers += MemoryUsage::sizeOf(data->qualifiers);
+}
+
 /**
  * Serializes the association end to a JSON file.
  *
@@ -34,6 +34,7 @@
 
 class UmlAttribute;
 class UmlProject;
+struct MemoryUsage;
 
 class UMLCLASSIFIERS_EXPORT AssociationEnd : public IProperty
 {
@@ -101,6 +102,7 @@ public: // Methods
    void clear();
 
    void serialize(QJsonObject& json, bool read, int version, UmlProject* project);
+   void measure(MemoryUsage& usage) const;
 
 private: // Attributes
    struct Data;
@@ -0,0 +1,865 @@
+//---------------------------------------------------------------------------------------------------------------------
+// CppGenerator.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class CppGenerator.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "CppGenerator.h"
+
+#include "UmlAttribute.h"
+#include "UmlClass.h"
+#include "UmlDatatype.h"
+#include "UmlEnumeration.h"
+#include "UmlGeneralization.h"
+#include "UmlInterface.h"
+#include "UmlLiteral.h"
+#include "UmlOperation.h"
+#include "UmlParameter.h"
+#include "UmlRealization.h"
+
+#include "../UmlCommon/ErrorTools.h"
+#include "../UmlCommon/FileFingerprint.h"
+#include "../UmlCommon/JsonWriter.h"
+#include "../UmlCommon/Tracer.h"
+#include "../UmlCommon/TypeIndex.h"
+#include "../UmlCommon/UmlLink.h"
+#include "../UmlCommon/UmlModel.h"
+#include "../UmlCommon/UmlProject.h"
+#include "../UmlCommon/UmlRoot.h"
+#include "../UmlCommon/UmlTemplateParameter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QPair>
+#include <QSaveFile>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+
+/**
+ * @class CppGenerator
+ * @brief The CppGenerator class generates C++ header and source files from the classifiers of a project.
+ * @since 0.2.0
+ * @ingroup UmlClassifiers
+ *
+ * CppGenerator writes a header file for each class, interface, data type and enumeration owned by a package, if the
+ * language of the classifier is C++ or not set. Packages become subfolders of outputFolder(), models are left out.
+ * Since types are referenced by name in ViraquchaUML, no namespaces are generated; headers of other classifiers are
+ * included by their path relative to outputFolder(), which therefore has to be on the include path.
+ *
+ * Generalizations and realizations become public base classes, interfaces become classes with pure virtual operations
+ * only, data types become structs and enumerations scoped enums. Nested classifiers are declared inside their owner.
+ * Attributes with an upper multiplicity above 1 become std::vector members, static attributes inline variables. A
+ * source file is written for classifiers with operations, holding stubs of the operations with their code; the
+ * operations of templated classifiers are defined in the header instead.
+ *
+ * Generation is incremental: each classifier gets a key hashed from its serialized content and that of its children,
+ * the names of its base classifiers, the paths of its files, the headers of all classifiers generated and the
+ * generator version. Only classifiers whose key differs from the key recorded by the last run or whose files are
+ * missing are rendered, in parallel on the global thread pool, and only files whose content hash differs are
+ * written. Keys, hashes and file names are recorded in a manifest in outputFolder(), so files of classifiers removed
+ * or renamed since the last run are removed as well. Adding, removing or renaming a classifier renders all
+ * classifiers again, since their includes may change. Files changed by hand are not detected; delete the manifest to
+ * write all files again.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+/** Files generated for a classifier by the last run, as recorded in the manifest. */
+struct ManifestEntry
+{
+   QByteArray  key;    // Hash of the content the files were rendered from
+   QByteArray  hash;   // Hash of the files rendered
+   QStringList files;
+};
+
+/** A classifier to be generated with the paths of its files relative to the output folder. */
+struct CodeUnit
+{
+   CodeUnit()
+   : classifier(nullptr)
+   {}
+
+   UmlClassifier* classifier;
+   QString        header;
+   QString        source;
+};
+
+/** Result of generating the files of a classifier. */
+struct CodeResult
+{
+   CodeResult()
+   : written(false)
+   {}
+
+   QUuid         id;
+   ManifestEntry entry;
+   bool          written;
+   QString       errorString;
+};
+
+/** Renders the declarations and definitions of a classifier. Used by one thread only. */
+struct CodeWriter
+{
+   CodeWriter(const QHash<QString, QString>* headers, const QString& ownHeader)
+   : headers(headers)
+   , ownHeader(ownHeader)
+   , inlineBodies(false)
+   {
+   }
+
+   const QHash<QString, QString>* headers;      // Headers of the classifiers generated by name
+   QString                        ownHeader;
+   QString                        header;       // Declarations written to the header file
+   QString                        source;       // Definitions written to the source file
+   QSet<QString>                  stdIncludes;
+   QSet<QString>                  includes;
+   bool                           inlineBodies;
+
+   QString typeName(const QString& type, const QString& fallback);
+   QString typeOf(const QString& type, const IMultiplicityElement& elem, const QString& fallback);
+   QString parameters(UmlOperation* op, bool withDefaults);
+   QString body(UmlOperation* op, const QString& indent, bool returns);
+
+   void writeClassifier(UmlClassifier* cls, const QString& indent, const QString& scope);
+   void writeEnumeration(UmlEnumeration* enumeration, const QString& indent);
+   void writeOperation(UmlOperation* op, const QString& clsName, const QString& indent, const QString& scope,
+                       bool pure);
+   void writeAttribute(UmlAttribute* attr, const QString& indent);
+};
+
+/** Generates the files of a classifier on a thread of the pool; see CppGenerator::generate(). */
+struct GenerateUnit
+{
+   typedef CodeResult result_type;
+
+   GenerateUnit(const QHash<QString, QString>* headers, const QHash<QUuid, ManifestEntry>* manifest, QString folder,
+                QByteArray headersKey)
+   : headers(headers)
+   , manifest(manifest)
+   , folder(folder)
+   , headersKey(headersKey)
+   {
+   }
+
+   CodeResult operator()(const CodeUnit& unit) const;
+
+   const QHash<QString, QString>*       headers;
+   const QHash<QUuid, ManifestEntry>*   manifest;
+   QString                              folder;
+   QByteArray                           headersKey; // Hash of the headers of all classifiers generated
+};
+
+struct CppGenerator::Data
+{
+   Data()
+   : project(nullptr)
+   , generated(0)
+   , unchanged(0)
+   , removed(0)
+   {}
+
+   UmlProject*                 project;
+   QString                     outputFolder;
+   QString                     manifestFolder; // Output folder the manifest was read from
+   QHash<QUuid, ManifestEntry> manifest;
+   int                         generated;
+   int                         unchanged;
+   int                         removed;
+   QString                     errorString;
+};
+/// @endcond
+
+const QString KManifestFile     = "codegen.json";
+const int     KManifestVersion  = 2;
+const int     KGeneratorVersion = 1; // Increment if the code rendered changes, so all files are rendered again
+const QString KCppLanguage      = "C++";
+const QString KIndent           = "   ";
+
+/** Type names of the project and of UML replaced by C++ types. */
+const QHash<QString, QString> KCppTypes = {
+   { "string", "std::string" }, { "uint", "unsigned int" }, { "ulong", "unsigned long" },
+   { "ushort", "unsigned short" }, { "Boolean", "bool" }, { "Integer", "int" }, { "Real", "double" },
+   { "String", "std::string" }, { "UnlimitedNatural", "unsigned int" }
+};
+
+/** C++ types passed by value instead of by const reference. */
+const QSet<QString> KValueTypes = {
+   "bool", "char", "double", "float", "int", "long", "short", "unsigned int", "unsigned long", "unsigned short"
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Converts a name to a C++ identifier by replacing all characters not allowed. */
+static QString identifier(const QString& name)
+{
+   QString result;
+   for (QChar ch : name.trimmed()) result.append(ch.isLetterOrNumber() || ch == '_' ? ch : QChar('_'));
+   if (result.isEmpty() || result[0].isDigit()) result.prepend('_');
+   return result;
+}
+
+/** Gets the C++ name of an operation; destructors and operators keep their special characters. */
+static QString operationName(UmlOperation* op)
+{
+   QString name = op->name().trimmed();
+   if (name.startsWith("operator")) return name;
+   if (name.startsWith('~')) return "~" + identifier(name.mid(1));
+   return identifier(name);
+}
+
+/** Gets the classifier if it is generated, i.e. a class, interface, data type or enumeration. */
+static UmlClassifier* generatedClassifier(UmlElement* elem)
+{
+   auto* cls = dynamic_cast<UmlClassifier*>(elem);
+   if (cls == nullptr || cls->name().trimmed().isEmpty()) return nullptr;
+   if (!cls->language().isEmpty() && cls->language() != KCppLanguage) return nullptr;
+
+   if (dynamic_cast<UmlClass*>(cls) != nullptr || dynamic_cast<UmlInterface*>(cls) != nullptr ||
+       dynamic_cast<UmlDatatype*>(cls) != nullptr || dynamic_cast<UmlEnumeration*>(cls) != nullptr)
+   {
+      return cls;
+   }
+
+   return nullptr;
+}
+
+/** Gets the visibility of a member in C++, which knows no package visibility. */
+static VisibilityKind cppVisibility(VisibilityKind kind)
+{
+   return kind == VisibilityKind::Protected || kind == VisibilityKind::Private ? kind : VisibilityKind::Public;
+}
+
+/** Writes the access specifier of a section before its first member. */
+static void writeLabel(QString& out, const QString& indent, VisibilityKind kind, bool& written)
+{
+   if (written) return;
+   if (!out.endsWith("{\n")) out += "\n";
+   out += indent + (kind == VisibilityKind::Public ? "public:\n" : kind == VisibilityKind::Protected ?
+      "protected:\n" : "private:\n");
+   written = true;
+}
+
+/** Writes a comment as documentation comment. */
+static void writeComment(QString& out, const QString& indent, const QString& comment)
+{
+   QString text = comment.trimmed().replace("*/", "* /");
+   if (text.isEmpty()) return;
+
+   auto lines = text.split('\n');
+   if (lines.size() == 1)
+   {
+      out += indent + "/** " + text + " */\n";
+      return;
+   }
+
+   out += indent + "/**\n";
+   for (auto& line : lines)
+   {
+      QString row = line.trimmed();
+      out += indent + (row.isEmpty() ? " *\n" : " * " + row + "\n");
+   }
+   out += indent + " */\n";
+}
+
+/** Gets the template head of a templated element, or an empty string. */
+static QString templateHead(const QList<UmlTemplateParameter*>& params)
+{
+   if (params.isEmpty()) return QString();
+
+   QStringList list;
+   for (auto* par : params)
+   {
+      QString type = par->type().trimmed();
+      if (type.isEmpty() || type == "class") type = "typename";
+
+      QString entry = type + " " + identifier(par->name());
+      if (!par->defaultValue().trimmed().isEmpty()) entry += " = " + par->defaultValue().trimmed();
+      list.append(entry);
+   }
+
+   return "template<" + list.join(", ") + ">";
+}
+
+/** Appends the content the files of a classifier are rendered from: an element, its base classifiers and children. */
+static void appendContent(UmlElement* elem, QByteArray& content)
+{
+   QJsonObject json;
+   elem->serialize(json, false, KFileVersion);
+   content += JsonWriter::toCanonical(json) + '\0';
+
+   for (auto* link : elem->links())
+   {
+      if (link->source() != elem || link->target() == nullptr) continue;
+      if (dynamic_cast<UmlGeneralization*>(link) == nullptr && dynamic_cast<UmlRealization*>(link) == nullptr) continue;
+
+      auto* general = dynamic_cast<INamedElement*>(link->target());
+      if (general != nullptr) content += general->name().toUtf8() + '\0';
+   }
+
+   if (auto* composite = dynamic_cast<UmlCompositeElement*>(elem))
+   {
+      for (auto* child : composite->elements()) appendContent(child, content);
+   }
+}
+
+/** Writes a file, creating its folder if needed. The file is replaced only if it was written completely. */
+static bool writeFile(const QString& filename, const QByteArray& content, QString& error)
+{
+   if (!QDir().mkpath(QFileInfo(filename).path()))
+   {
+      error = QString(KFileWriteError).arg(filename).arg("Cannot create folder");
+      return false;
+   }
+
+   QSaveFile file(filename);
+   if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(content) != content.size() ||
+       !file.commit())
+   {
+      error = QString(KFileWriteError).arg(filename).arg(file.errorString());
+      return false;
+   }
+
+   return true;
+}
+
+/** Gets the C++ name of a type and records the includes it needs. */
+QString CodeWriter::typeName(const QString& type, const QString& fallback)
+{
+   QString name = type.trimmed();
+   if (name.isEmpty()) return fallback;
+
+   name = KCppTypes.value(name, name);
+   if (name.contains("std::string")) stdIncludes.insert("string");
+
+   for (auto& ident : TypeIndex::split(name))
+   {
+      QString path = headers->value(ident);
+      if (!path.isEmpty() && path != ownHeader) includes.insert(path);
+   }
+
+   return name;
+}
+
+/** Gets the C++ type of a typed element; elements with an upper multiplicity above 1 become vectors. */
+QString CodeWriter::typeOf(const QString& type, const IMultiplicityElement& elem, const QString& fallback)
+{
+   QString name = typeName(type, fallback);
+   if (elem.upper() <= 1 || name == "void") return name;
+
+   stdIncludes.insert("vector");
+   return QString("std::vector<%1>").arg(name);
+}
+
+/** Gets the parameter list of an operation. */
+QString CodeWriter::parameters(UmlOperation* op, bool withDefaults)
+{
+   QStringList list;
+   for (auto* par : op->parameter())
+   {
+      if (par->direction() == ParameterDirectionKind::Return) continue;
+
+      QString type = typeOf(par->type(), *par, "int");
+      if (par->direction() == ParameterDirectionKind::Out || par->direction() == ParameterDirectionKind::InOut)
+      {
+         type += "&";
+      }
+      else if (!KValueTypes.contains(type) && !type.endsWith('*') && !type.endsWith('&'))
+      {
+         type = "const " + type + "&";
+      }
+
+      QString entry = type + " " + identifier(par->name());
+      if (withDefaults && !par->defaultValue().trimmed().isEmpty()) entry += " = " + par->defaultValue().trimmed();
+      list.append(entry);
+   }
+
+   return list.join(", ");
+}
+
+/** Gets the body of an operation: its code, or a stub returning a default value. */
+QString CodeWriter::body(UmlOperation* op, const QString& indent, bool returns)
+{
+   QString text = indent + "{\n";
+   QString code = op->initCode().trimmed();
+   if (!code.isEmpty())
+   {
+      for (auto& line : code.split('\n'))
+      {
+         QString row = line;
+         while (!row.isEmpty() && row.at(row.size() - 1).isSpace()) row.chop(1);
+         text += row.isEmpty() ? "\n" : indent + KIndent + row + "\n";
+      }
+   }
+   else if (returns)
+   {
+      text += indent + KIndent + "return {};\n";
+   }
+
+   return text + indent + "}\n";
+}
+
+/** Writes the declaration of a classifier to the header and the definitions of its operations to the source. */
+void CodeWriter::writeClassifier(UmlClassifier* cls, const QString& indent, const QString& scope)
+{
+   if (auto* enumeration = dynamic_cast<UmlEnumeration*>(cls))
+   {
+      writeEnumeration(enumeration, indent);
+      return;
+   }
+
+   QString name = identifier(cls->name());
+   QString qualified = scope.isEmpty() ? name : scope + "::" + name;
+   bool isInterface = dynamic_cast<UmlInterface*>(cls) != nullptr;
+   bool wasInline = inlineBodies;
+   inlineBodies = inlineBodies || cls->isTemplated();
+
+   QStringList bases;
+   for (auto* link : cls->links())
+   {
+      if (link->source() != cls || link->target() == nullptr) continue;
+      if (dynamic_cast<UmlGeneralization*>(link) == nullptr && dynamic_cast<UmlRealization*>(link) == nullptr) continue;
+
+      auto* general = dynamic_cast<INamedElement*>(link->target());
+      if (general != nullptr && !general->name().trimmed().isEmpty())
+      {
+         bases.append("public " + typeName(general->name(), QString()));
+      }
+   }
+
+   writeComment(header, indent, cls->comment());
+   QString head = templateHead(cls->templateParameter());
+   if (!head.isEmpty()) header += indent + head + "\n";
+   header += indent + (dynamic_cast<UmlDatatype*>(cls) != nullptr ? "struct " : "class ") + name;
+   if (cls->isFinal() || cls->isLeaf()) header += " final";
+   if (!bases.isEmpty()) header += " : " + bases.join(", ");
+   header += "\n" + indent + "{\n";
+
+   QString inner = indent + KIndent;
+   auto operations = cls->operations();
+   auto attributes = cls->attributes();
+   for (auto kind : { VisibilityKind::Public, VisibilityKind::Protected, VisibilityKind::Private })
+   {
+      bool labelled = false;
+      if (kind == VisibilityKind::Public && (isInterface || cls->isAbstract()))
+      {
+         bool hasDestructor = false;
+         for (auto* op : operations) hasDestructor = hasDestructor || operationName(op) == "~" + name;
+         if (!hasDestructor)
+         {
+            writeLabel(header, indent, kind, labelled);
+            header += inner + "virtual ~" + name + "() = default;\n";
+         }
+      }
+
+      for (auto* elem : cls->elements())
+      {
+         auto* nested = generatedClassifier(elem);
+         if (nested == nullptr || cppVisibility(nested->visibility()) != kind) continue;
+
+         writeLabel(header, indent, kind, labelled);
+         writeClassifier(nested, inner, qualified);
+      }
+
+      for (auto* op : operations)
+      {
+         if (cppVisibility(op->visibility()) != kind) continue;
+
+         writeLabel(header, indent, kind, labelled);
+         writeOperation(op, name, inner, qualified, isInterface);
+      }
+
+      for (auto* attr : attributes)
+      {
+         if (cppVisibility(attr->visibility()) != kind) continue;
+
+         writeLabel(header, indent, kind, labelled);
+         writeAttribute(attr, inner);
+      }
+   }
+
+   header += indent + "};\n";
+   inlineBodies = wasInline;
+}
+
+/** Writes an enumeration as scoped enum. */
+void CodeWriter::writeEnumeration(UmlEnumeration* enumeration, const QString& indent)
+{
+   writeComment(header, indent, enumeration->comment());
+   header += indent + "enum class " + identifier(enumeration->name()) + "\n" + indent + "{\n";
+
+   auto literals = enumeration->literals();
+   for (int index = 0; index < literals.size(); ++index)
+   {
+      header += QString("%1%2%3 = %4%5\n").arg(indent, KIndent, identifier(literals[index]->symbol()))
+         .arg(literals[index]->number()).arg(index + 1 < literals.size() ? "," : "");
+   }
+
+   header += indent + "};\n";
+}
+
+/** Writes the declaration of an operation and - unless it is pure virtual - its definition. */
+void CodeWriter::writeOperation(UmlOperation* op, const QString& clsName, const QString& indent,
+                                const QString& scope, bool pure)
+{
+   QString name = operationName(op);
+   bool special = name == clsName || name == "~" + clsName;
+   QString returnType = special ? QString() : typeOf(op->returnType(), *op, "void");
+   bool returns = !special && returnType != "void";
+   bool isVirtual = pure || op->isAbstract();
+   bool isInline = inlineBodies || op->isTemplated();
+
+   writeComment(header, indent, op->comment());
+   QString head = templateHead(op->templateParameter());
+   if (!head.isEmpty()) header += indent + head + "\n";
+
+   QString declaration = indent + (isVirtual ? "virtual " : "") + (special ? "" : returnType + " ") + name + "(" +
+      parameters(op, true) + ")";
+   if (isVirtual)
+   {
+      header += declaration + " = 0;\n";
+   }
+   else if (isInline)
+   {
+      header += declaration + "\n" + body(op, indent, returns);
+   }
+   else
+   {
+      header += declaration + ";\n";
+
+      if (!source.isEmpty()) source += "\n";
+      writeComment(source, QString(), op->comment());
+      source += (special ? "" : returnType + " ") + scope + "::" + name + "(" + parameters(op, false) + ")\n" +
+         body(op, QString(), returns);
+   }
+}
+
+/** Writes the declaration of an attribute; static attributes become inline variables. */
+void CodeWriter::writeAttribute(UmlAttribute* attr, const QString& indent)
+{
+   writeComment(header, indent, attr->comment());
+
+   QString text = indent;
+   if (attr->isStatic()) text += "static inline ";
+   if (attr->isReadOnly()) text += "const ";
+   text += typeOf(attr->type(), *attr, "int") + " " + identifier(attr->name());
+
+   QString value = attr->defaultValue().trimmed();
+   if (!value.isEmpty()) text += " = " + value;
+   header += text + ";\n";
+}
+
+/**
+ * Renders the files of a classifier if its key differs from the key in the manifest or a file is missing, and writes
+ * them if their hash differs from the hash in the manifest.
+ */
+CodeResult GenerateUnit::operator()(const CodeUnit& unit) const
+{
+   CodeResult result;
+   result.id = unit.classifier->identifier();
+
+   QByteArray content = QByteArray::number(KGeneratorVersion) + '\0' + headersKey + '\0' + unit.header.toUtf8() +
+      '\0';
+   appendContent(unit.classifier, content);
+   QByteArray key = FileFingerprint::hashOf(content);
+
+   auto previous = manifest->value(result.id);
+   bool exists = !previous.files.isEmpty() && previous.files.first() == unit.header;
+   for (auto& file : previous.files) exists = exists && QFileInfo::exists(folder + "/" + file);
+   if (exists && previous.key == key)
+   {
+      result.entry = previous;
+      return result;
+   }
+
+   CodeWriter writer(headers, unit.header);
+   writer.writeClassifier(unit.classifier, QString(), QString());
+
+   QString banner = QString("// Generated by ViraquchaUML from %1 '%2'.\n"
+      "// Changes are overwritten the next time the code is generated.\n\n")
+      .arg(unit.classifier->className()).arg(unit.classifier->name());
+
+   QString header = banner + "#pragma once\n";
+   auto stdIncludes = writer.stdIncludes.values();
+   auto includes = writer.includes.values();
+   std::sort(stdIncludes.begin(), stdIncludes.end());
+   std::sort(includes.begin(), includes.end());
+   if (!stdIncludes.isEmpty() || !includes.isEmpty()) header += "\n";
+   for (auto& include : stdIncludes) header += "#include <" + include + ">\n";
+   for (auto& include : includes) header += "#include \"" + include + "\"\n";
+
+   QByteArray headerText = (header + "\n" + writer.header).toUtf8();
+   QByteArray sourceText;
+   if (!writer.source.isEmpty())
+   {
+      sourceText = (banner + "#include \"" + unit.header + "\"\n\n" + writer.source).toUtf8();
+   }
+
+   result.entry.key = key;
+   result.entry.files.append(unit.header);
+   if (!sourceText.isEmpty()) result.entry.files.append(unit.source);
+   result.entry.hash = FileFingerprint::hashOf(result.entry.files.join('\n').toUtf8() + '\0' + headerText + '\0' +
+      sourceText);
+
+   if (exists && previous.hash == result.entry.hash) return result;
+
+   result.written = writeFile(folder + "/" + unit.header, headerText, result.errorString) &&
+      (sourceText.isEmpty() || writeFile(folder + "/" + unit.source, sourceText, result.errorString));
+   return result;
+}
+
+/** Reads a manifest, which is empty if the file does not exist or cannot be read. */
+static QHash<QUuid, ManifestEntry> readManifest(const QString& filename)
+{
+   QHash<QUuid, ManifestEntry> result;
+   QFile file(filename);
+   if (!file.open(QIODevice::ReadOnly)) return result;
+
+   auto json = QJsonDocument::fromJson(file.readAll()).object();
+   if (json["version"].toInt() != KManifestVersion) return result;
+
+   auto classifiers = json["classifiers"].toObject();
+   for (auto iter = classifiers.constBegin(); iter != classifiers.constEnd(); ++iter)
+   {
+      auto value = iter.value().toObject();
+      ManifestEntry entry;
+      entry.key = QByteArray::fromHex(value["key"].toString().toLatin1());
+      entry.hash = QByteArray::fromHex(value["hash"].toString().toLatin1());
+      for (auto file : value["files"].toArray()) entry.files.append(file.toString());
+      result.insert(QUuid(iter.key()), entry);
+   }
+
+   return result;
+}
+
+/** Writes a manifest. */
+static bool writeManifest(const QString& filename, const QHash<QUuid, ManifestEntry>& manifest, QString& error)
+{
+   QJsonObject classifiers;
+   for (auto iter = manifest.constBegin(); iter != manifest.constEnd(); ++iter)
+   {
+      QJsonObject value;
+      value["key"] = QString::fromLatin1(iter.value().key.toHex());
+      value["hash"] = QString::fromLatin1(iter.value().hash.toHex());
+      value["files"] = QJsonArray::fromStringList(iter.value().files);
+      classifiers[iter.key().toString()] = value;
+   }
+
+   QJsonObject json;
+   json["version"] = KManifestVersion;
+   json["classifiers"] = classifiers;
+   return writeFile(filename, QJsonDocument(json).toJson(), error);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the CppGenerator class. */
+CppGenerator::CppGenerator(UmlProject* project)
+: data(new Data())
+{
+   data->project = project;
+}
+
+/** Destroys the CppGenerator object. */
+CppGenerator::~CppGenerator()
+{
+   delete data;
+}
+
+/** Gets the project generated. */
+UmlProject* CppGenerator::project() const
+{
+   return data->project;
+}
+
+/** Gets the folder the files are generated in; by default subfolder "cpp" of the code folder of the project. */
+QString CppGenerator::outputFolder() const
+{
+   if (!data->outputFolder.isEmpty() || data->project->codeFolder().isEmpty()) return data->outputFolder;
+   return data->project->codeFolder() + "/cpp";
+}
+
+/** Sets the folder the files are generated in. */
+void CppGenerator::setOutputFolder(const QString& value)
+{
+   data->outputFolder = value;
+}
+
+/** Gets the number of classifiers whose files were written by the last run. */
+int CppGenerator::generatedCount() const
+{
+   return data->generated;
+}
+
+/** Gets the number of classifiers whose files were up to date in the last run. */
+int CppGenerator::unchangedCount() const
+{
+   return data->unchanged;
+}
+
+/** Gets the number of files of removed or renamed classifiers removed by the last run. */
+int CppGenerator::removedCount() const
+{
+   return data->removed;
+}
+
+/** Gets a description of the error that occurred during the last run. */
+QString CppGenerator::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Generates the files of all classifiers changed since the last run.
+ *
+ * The manifest of the output folder is read by the first run only; later runs of the same object compare with the
+ * keys and hashes kept in memory, so a run after a single change costs the hashing of all classifiers and the
+ * rendering and writing of the classifier changed. Classifiers whose files would have the same path as the files of
+ * another classifier are not generated and reported as error.
+ * @returns true if all files were written; otherwise false (see errorString()).
+ */
+bool CppGenerator::generate()
+{
+   TraceSpan span("CppGenerator::generate");
+   data->errorString.clear();
+   data->generated = data->unchanged = data->removed = 0;
+
+   QString folder = outputFolder();
+   if (folder.isEmpty())
+   {
+      data->errorString = QObject::tr("No output folder given and the project has not been saved.");
+      return false;
+   }
+
+   if (data->manifestFolder != folder)
+   {
+      data->manifest = readManifest(folder + "/" + KManifestFile);
+      data->manifestFolder = folder;
+   }
+
+   // Collect the classifiers of all packages with the paths of their files:
+   QList<CodeUnit> units;
+   QHash<QString, QString> headers;
+   QHash<QString, UmlClassifier*> paths;
+   QList<QPair<UmlCompositeElement*, QString>> pending;
+   pending.append({ data->project->root(), QString() });
+   while (!pending.isEmpty())
+   {
+      auto current = pending.takeFirst();
+      for (auto* elem : current.first->elements())
+      {
+         if (auto* pkg = dynamic_cast<UmlPackage*>(elem))
+         {
+            bool isModel = dynamic_cast<UmlModel*>(pkg) != nullptr;
+            pending.append({ pkg, isModel ? current.second : current.second + identifier(pkg->name()) + "/" });
+         }
+         else if (auto* cls = generatedClassifier(elem))
+         {
+            CodeUnit unit;
+            unit.classifier = cls;
+            unit.header = current.second + identifier(cls->name()) + ".h";
+            unit.source = current.second + identifier(cls->name()) + ".cpp";
+            if (paths.contains(unit.header))
+            {
+               // Names differing in characters not allowed in C++ only, like "Foo Bar" and "Foo_Bar":
+               if (data->errorString.isEmpty())
+               {
+                  data->errorString = QObject::tr("Classifiers '%1' and '%2' are both generated to file %3.")
+                     .arg(paths.value(unit.header)->name()).arg(cls->name()).arg(unit.header);
+               }
+               continue;
+            }
+
+            paths.insert(unit.header, cls);
+            if (!headers.contains(cls->name().trimmed())) headers.insert(cls->name().trimmed(), unit.header);
+            units.append(unit);
+         }
+      }
+   }
+
+   auto names = headers.keys();
+   std::sort(names.begin(), names.end());
+   QByteArray headersText;
+   for (auto& name : names) headersText += name.toUtf8() + '\0' + headers.value(name).toUtf8() + '\0';
+
+   auto results = QtConcurrent::blockingMapped<QList<CodeResult>>(units,
+      GenerateUnit(&headers, &data->manifest, folder, FileFingerprint::hashOf(headersText)));
+
+   QHash<QUuid, ManifestEntry> manifest;
+   QSet<QString> files;
+   for (auto& result : results)
+   {
+      if (!result.errorString.isEmpty())
+      {
+         // Keep the files of the last run, the classifier is generated again by the next run:
+         if (data->errorString.isEmpty()) data->errorString = result.errorString;
+         if (data->manifest.contains(result.id))
+         {
+            auto entry = data->manifest.value(result.id);
+            entry.key.clear();
+            entry.hash.clear();
+            manifest.insert(result.id, entry);
+            for (auto& file : entry.files) files.insert(file);
+         }
+         continue;
+      }
+
+      if (result.written) ++data->generated; else ++data->unchanged;
+      manifest.insert(result.id, result.entry);
+      for (auto& file : result.entry.files) files.insert(file);
+   }
+
+   for (auto& entry : data->manifest)
+   {
+      for (auto& file : entry.files)
+      {
+         if (!files.contains(file) && QFile::remove(folder + "/" + file)) ++data->removed;
+      }
+   }
+
+   bool changed = data->generated > 0 || data->removed > 0 || manifest.size() != data->manifest.size() ||
+      !data->errorString.isEmpty();
+   data->manifest = manifest;
+   QString error;
+   if (changed && !writeManifest(folder + "/" + KManifestFile, manifest, error) && data->errorString.isEmpty())
+   {
+      data->errorString = error;
+   }
+
+   span.setDetail(QString("%1 classifier(s), %2 written").arg(units.size()).arg(data->generated));
+   return data->errorString.isEmpty();
+}
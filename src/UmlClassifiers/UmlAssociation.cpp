@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlAssociation.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "AssociationEnd.h"
 #include "PropertyStrings.h"
 
@@ -98,6 +99,7 @@ QString UmlAssociation::name() const
 /** Sets the name of the association. */
 void UmlAssociation::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -174,6 +176,17 @@ QVector<Label*> UmlAssociation::labels()
    return result;
 }
 
+/** Adds the estimated memory used by the association to a MemoryUsage object, see UmlElement::measure(). */
+void UmlAssociation::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype);
+   data->sourceEnd.measure(usage);
+   data->targetEnd.measure(usage);
+}
+
 /**
  * Serializes properties of the UmlAssociation instance to a JSON file.
  *
@@ -74,6 +74,7 @@ public: // Properties
 
 public: // Methods
    void update(int index, Label* label) override;
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
@@ -26,11 +26,13 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlAttribute.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "PropertyStrings.h"
 #include "SignatureChars.h"
 #include "SignatureTools.h"
 
 #include "../UmlCommon/PropertyStrings.h"
+#include "../UmlCommon/TypeIndex.h"
 
 #include <QTextStream>
 
@@ -128,6 +130,7 @@ QString UmlAttribute::name() const
 /** Sets the name of the attribute. */
 void UmlAttribute::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -308,7 +311,24 @@ QString UmlAttribute::type() const
 /** Sets the (data)type of the attribute. */
 void UmlAttribute::setType(QString value)
 {
+   if (data->type == value) return;
    data->type = value;
+   updateTypeIndex();
+}
+
+/** Gets the type of the attribute as the only type referenced by the attribute, see class TypeIndex. */
+QStringList UmlAttribute::typeReferences() const
+{
+   return QStringList(data->type);
+}
+
+/** Renames a type in the type of the attribute, see UmlProject::renameType(). */
+bool UmlAttribute::renameTypeReference(QString oldName, QString newName)
+{
+   QString type = TypeIndex::replace(data->type, oldName, newName);
+   if (type == data->type) return false;
+   setType(type);
+   return true;
 }
 
 /** Gets the default value of the attribute. */
@@ -354,6 +374,16 @@ QString UmlAttribute::toString() const
    return signature();
 }
 
+/** Adds the estimated memory used by the attribute to a MemoryUsage object, see UmlElement::measure(). */
+void UmlAttribute::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype) + MemoryUsage::sizeOf(data->type) +
+      MemoryUsage::sizeOf(data->defaultValue);
+}
+
 /**
  * Serializes properties of the UmlAttribute object to a JSON file.
  *
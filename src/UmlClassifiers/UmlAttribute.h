@@ -94,6 +94,8 @@ public: // Properties
 
    QString type() const override;
    void setType(QString value) override;
+   QStringList typeReferences() const override;
+   bool renameTypeReference(QString oldName, QString newName) override;
 
    QString defaultValue() const;
    void setDefaultValue(QString value);
@@ -101,6 +103,9 @@ public: // Properties
    QString signature() const;
    QString toString() const override;
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 protected: // Methods
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
 
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlClass.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "PropertyStrings.h"
 
 /**
@@ -121,6 +122,13 @@ void UmlClass::isActive(bool value)
    data->isActive = value;
 }
 
+/** Adds the estimated memory used by the class to a MemoryUsage object, see UmlElement::measure(). */
+void UmlClass::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+}
+
 /**
  * Serializes properties of the UmlClass object to a JSON file.
  *
@@ -53,6 +53,9 @@ public: // Properties
    bool isActive() const;
    void isActive(bool value);
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 protected: // Methods
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
 
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlClassifier.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "PropertyStrings.h"
 
 #include "../UmlCommon/Compartment.h"
@@ -33,6 +34,7 @@
 #include "../UmlCommon/SignatureChars.h"
 #include "../UmlCommon/SignatureTools.h"
 #include "../UmlCommon/TextBox.h"
+#include "../UmlCommon/TypeIndex.h"
 #include "../UmlCommon/UmlTemplateBinding.h"
 #include "../UmlCommon/UmlTemplateParameter.h"
 
@@ -104,6 +106,8 @@ UmlClassifier::UmlClassifier(QUuid id)
 
 UmlClassifier::~UmlClassifier()
 {
+   // Do not touch the type index here, the project may already be gone:
+   for (auto& param : data->templParams) param->setOwner(nullptr);
    delete data;
 }
 
@@ -116,6 +120,7 @@ QString UmlClassifier::name() const
 /** Sets the name of the classifier. */
 void UmlClassifier::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -236,6 +241,36 @@ bool UmlClassifier::isTemplated() const
    return data->templParams.size() != 0;
 }
 
+/**
+ * Gets the types of the template parameter of the classifier.
+ *
+ * Types of attributes and operations are not included, they are referenced by the attributes and operations 
+ * themselves. See also class TypeIndex.
+ */
+QStringList UmlClassifier::typeReferences() const
+{
+   QStringList list;
+   for (auto& param : data->templParams) list.append(param->type());
+   return list;
+}
+
+/** Renames a type in the types of the template parameter of the classifier, see UmlProject::renameType(). */
+bool UmlClassifier::renameTypeReference(QString oldName, QString newName)
+{
+   bool result = false;
+   for (auto& param : data->templParams)
+   {
+      QString type = TypeIndex::replace(param->type(), oldName, newName);
+      if (type != param->type())
+      {
+         param->setType(type);
+         result = true;
+      }
+   }
+
+   return result;
+}
+
 /** Gets a value indicating whether the classifier is abstract. */
 bool UmlClassifier::isAbstract() const
 {
@@ -277,7 +312,7 @@ void UmlClassifier::isLeaf(bool value)
  *
  * A classifier has at least three compartments: name, attributes and operations. On creation of the vector, all
  * compartments are visible by default. Note that each compartment can - and should - be identified by its name
- * when implementing function update()!
+ * when implementing function update()! The compartments are returned empty, they are filled by DiaNode::update().
  */
 QVector<Compartment*> UmlClassifier::compartments()
 {
@@ -285,11 +320,6 @@ QVector<Compartment*> UmlClassifier::compartments()
    comps[0] = new Compartment("name");
    comps[1] = new Compartment("attributes");
    comps[2] = new Compartment("operations");
-   for (int index = 0; index < comps.length(); ++index)
-   {
-      update(index, comps[index]);
-   }
-
    return comps;
 }
 
@@ -324,23 +354,28 @@ void UmlClassifier::append(UmlTemplateParameter* par)
 {
    if (par != nullptr)
    {
+      par->setOwner(this);
       data->templParams.append(UmlTemplateParameterPtr(par));
+      updateTypeIndex();
    }
 }
 
 /** Removes a template parameter from the classifier. */
 void UmlClassifier::remove(UmlTemplateParameter* par)
 {
-   if (par != nullptr)
+   if (par != nullptr && data->templParams.removeOne(UmlTemplateParameterPtr(par)))
    {
-      data->templParams.removeOne(UmlTemplateParameterPtr(par));
+      par->setOwner(nullptr);
+      updateTypeIndex();
    }
 }
 
 /** Clears all template parameter from the classifier. */
 void UmlClassifier::clearTemplate()
 {
+   for (auto& param : data->templParams) param->setOwner(nullptr);
    data->templParams.clear();
+   updateTypeIndex();
 }
 
 /**
@@ -355,6 +390,17 @@ void UmlClassifier::dispose(bool disposing)
    super::dispose(disposing);
 }
 
+/** Adds the estimated memory used by the classifier to a MemoryUsage object, see UmlElement::measure(). */
+void UmlClassifier::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype) + MemoryUsage::sizeOf(data->language);
+   usage.containers += MemoryUsage::sizeOf(data->templParams);
+   for (auto& par : data->templParams) par->measure(usage);
+}
+
 /**
  * Serializes properties of the UmlClassifier object to a JSON file.
  *
@@ -379,6 +425,7 @@ void UmlClassifier::serialize(QJsonObject& json, bool read, bool flat, int versi
       // Template parameter:
       {
          auto array = json[KPropTemplParam].toArray();
+         if (!data->templParams.isEmpty()) clearTemplate();
          for (int index = 0; index < array.size(); ++index)
          {
             auto* par = new UmlTemplateParameter();
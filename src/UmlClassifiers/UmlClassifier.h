@@ -76,6 +76,9 @@ public: // Properties
    QList<UmlTemplateParameter*> templateParameter() const override;
    bool isTemplated() const override;
 
+   QStringList typeReferences() const override;
+   bool renameTypeReference(QString oldName, QString newName) override;
+
    bool isAbstract() const;
    void isAbstract(bool value);
 
@@ -98,6 +101,7 @@ public: // Methods
    void update(int index, Compartment* comp) override;
 
    QString toString() const override;
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void dispose(bool disposing) override;
@@ -27,6 +27,7 @@
 
 #include "umlclassifiers_global.h"
 
+#include "CppGenerator.h"
 #include "UmlAssociation.h"
 #include "UmlAttribute.h"
 #include "UmlClassifier.h"
@@ -42,6 +43,8 @@
 #include "UmlPrimitiveType.h"
 #include "UmlRealization.h"
 #include "UmlSignal.h"
+#include "XmiExporter.h"
+#include "XmiImporter.h"
 
 /**
  * @defgroup UmlClassifiers
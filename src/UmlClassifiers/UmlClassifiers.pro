@@ -26,6 +26,7 @@
 #---------------------------------------------------------------------------------------------------------------------
 
 QT      -= gui
+QT      += concurrent
 TEMPLATE = lib
 VERSION  = 1.0.0
 TARGET   = UmlClassifiers
@@ -52,6 +53,7 @@ HEADERS += \
     AggregationKind.h \
     AssociationEnd.h \
     CallConcurrencyKind.h \
+    CppGenerator.h \
     IProperty.h \
     UmlLiteral.h \
     ParameterDirectionKind.h \
@@ -73,10 +75,14 @@ HEADERS += \
     UmlPort.h \
     UmlPrimitiveType.h \
     UmlRealization.h \
-    UmlSignal.h
+    UmlSignal.h \
+    XmiExporter.h \
+    XmiImporter.h \
+    XmiStrings.h
 
 SOURCES += \
     AssociationEnd.cpp \
+    CppGenerator.cpp \
     UmlLiteral.cpp \
     UmlAssociation.cpp \
     UmlAttribute.cpp \
@@ -93,7 +99,9 @@ SOURCES += \
     UmlPort.cpp \
     UmlPrimitiveType.cpp \
     UmlRealization.cpp \
-    UmlSignal.cpp
+    UmlSignal.cpp \
+    XmiExporter.cpp \
+    XmiImporter.cpp
 
 DISTFILES += \
     UmlClassifiers.pri
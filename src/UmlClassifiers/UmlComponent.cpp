@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlComponent.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "PropertyStrings.h"
 
 #include "../UmlCommon/UmlKeywords.h"
@@ -115,6 +116,13 @@ void UmlComponent::isDirectlyInstantiated(bool value)
    data->isDirectlyInstantiated = value;
 }
 
+/** Adds the estimated memory used by the component to a MemoryUsage object, see UmlElement::measure(). */
+void UmlComponent::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+}
+
 /**
  * Serializes properties of the UmlComponent object to a JSON file.
  *
@@ -52,6 +52,9 @@ public: // Properties
    bool isDirectlyInstantiated() const;
    void isDirectlyInstantiated(bool value);
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 protected: // Methods
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
 
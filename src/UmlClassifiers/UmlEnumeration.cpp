@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlEnumeration.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "UmlLiteral.h"
 #include "PropertyStrings.h"
 
@@ -163,7 +164,6 @@ QVector<Compartment*> UmlEnumeration::compartments()
 
    // Insert compartment "literals" before compartment "attributes":
    comps.insert(1, new Compartment("literals"));
-   update(1, comps[1]);
    return comps;
 }
 
@@ -186,6 +186,15 @@ void UmlEnumeration::update(int index, Compartment* comp)
    }
 }
 
+/** Adds the estimated memory used by the enumeration to a MemoryUsage object, see UmlElement::measure(). */
+void UmlEnumeration::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.containers += MemoryUsage::sizeOf(data->literals);
+   for (auto* literal : data->literals) literal->measure(usage);
+}
+
 /**
  * Serializes properties of the UmlEnumeration object to a JSON file.
  *
@@ -201,6 +210,7 @@ void UmlEnumeration::serialize(QJsonObject& json, bool read, bool flat, int vers
    if (read)
    { 
       array = json[KPropLiterals].toArray();
+      if (!data->literals.isEmpty()) clearLiterals();
       for (int index = 0; index < array.count(); ++index)
       {
          auto obj = array[index].toObject();
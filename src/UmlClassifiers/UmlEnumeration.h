@@ -56,6 +56,7 @@ public: // Methods
 
    QVector<Compartment*> compartments() override;
    void update(int index, Compartment* comp) override;
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
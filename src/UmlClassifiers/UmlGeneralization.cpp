@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlGeneralization.h"
+#include "../UmlCommon/MemoryUsage.h"
 
 #include "../UmlCommon/PropertyStrings.h"
 
@@ -90,6 +91,7 @@ QString UmlGeneralization::name() const
 /** Sets the name of the generalization. */
 void UmlGeneralization::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -129,6 +131,15 @@ void UmlGeneralization::setStereotype(QString value)
    data->stereotype = value;
 }
 
+/** Adds the estimated memory used by the generalization to a MemoryUsage object, see UmlElement::measure(). */
+void UmlGeneralization::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype);
+}
+
 /**
  * Serializes properties of the UmlGeneralization object to a JSON file.
  * 
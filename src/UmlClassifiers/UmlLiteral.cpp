@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlLiteral.h"
+#include "../UmlCommon/MemoryUsage.h"
 
 /**
  * @class UmlLiteral
@@ -105,3 +106,10 @@ void UmlLiteral::setSymbol(QString value)
 {
    data->symbol = value;
 }
+
+/** Adds the estimated memory used by the literal to a MemoryUsage object. */
+void UmlLiteral::measure(MemoryUsage& usage) const
+{
+   usage.objects += sizeof(UmlLiteral) + sizeof(Data);
+   usage.strings += MemoryUsage::sizeOf(data->symbol);
+}
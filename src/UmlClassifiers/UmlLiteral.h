@@ -29,6 +29,8 @@
 
 #include <QString>
 
+struct MemoryUsage;
+
 class UmlLiteral
 {
 public:
@@ -43,6 +45,8 @@ public:
    QString symbol() const;
    void setSymbol(QString value);
 
+   void measure(MemoryUsage& usage) const;
+
 public:
    /// @cond
    struct Data;
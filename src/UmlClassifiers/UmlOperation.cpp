@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlOperation.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "PropertyStrings.h"
 #include "SignatureChars.h"
 #include "SignatureTools.h"
@@ -33,6 +34,7 @@
 #include "../UmlCommon/UmlTemplateBinding.h"
 #include "../UmlCommon/UmlTemplateParameter.h"
 #include "../UmlCommon/PropertyStrings.h"
+#include "../UmlCommon/TypeIndex.h"
 
 #include <QJsonArray>
 #include <QTextStream>
@@ -110,8 +112,9 @@ UmlOperation::UmlOperation(QUuid id)
 
 UmlOperation::~UmlOperation()
 {
-   clearParameter();
-   clearTemplate();
+   // Do not touch the type index here, the project may already be gone:
+   for (auto& param : data->parameter) param->setOwner(nullptr);
+   for (auto& param : data->templParams) param->setOwner(nullptr);
    delete data;
 }
 
@@ -133,6 +136,7 @@ QString UmlOperation::name() const
  */
 void UmlOperation::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -336,7 +340,9 @@ QString UmlOperation::returnType() const
  */
 void UmlOperation::setReturnType(QString value)
 {
+   if (data->returnType == value) return;
    data->returnType = value;
+   updateTypeIndex();
 }
 
 /**
@@ -353,6 +359,59 @@ QList<UmlParameter*> UmlOperation::parameter() const
    return list;
 }
 
+/**
+ * Gets the types referenced by the operation.
+ *
+ * This includes the return type as well as the types of all parameters and template parameters. See also class 
+ * TypeIndex.
+ */
+QStringList UmlOperation::typeReferences() const
+{
+   QStringList list(data->returnType);
+   for (auto& param : data->parameter) list.append(param->type());
+   for (auto& param : data->templParams) list.append(param->type());
+   return list;
+}
+
+/**
+ * Renames a type in the return type and in the types of all parameters and template parameters of the operation.
+ *
+ * See UmlProject::renameType().
+ */
+bool UmlOperation::renameTypeReference(QString oldName, QString newName)
+{
+   bool result = false;
+   QString type = TypeIndex::replace(data->returnType, oldName, newName);
+   if (type != data->returnType)
+   {
+      data->returnType = type;
+      result = true;
+   }
+
+   for (auto& param : data->parameter)
+   {
+      type = TypeIndex::replace(param->type(), oldName, newName);
+      if (type != param->type())
+      {
+         param->setType(type);
+         result = true;
+      }
+   }
+
+   for (auto& param : data->templParams)
+   {
+      type = TypeIndex::replace(param->type(), oldName, newName);
+      if (type != param->type())
+      {
+         param->setType(type);
+         result = true;
+      }
+   }
+
+   if (result) updateTypeIndex();
+   return result;
+}
+
 /**
  * Gets the signature of the operation.
  */
@@ -411,7 +470,9 @@ void UmlOperation::append(UmlParameter* par)
 {
    if (par != nullptr)
    {
+      par->setOwner(this);
       data->parameter.append(UmlParameterPtr(par));
+      updateTypeIndex();
    }
 }
 
@@ -420,9 +481,10 @@ void UmlOperation::append(UmlParameter* par)
  */
 void UmlOperation::remove(UmlParameter* par)
 {
-   if (par != nullptr)
+   if (par != nullptr && data->parameter.removeOne(UmlParameterPtr(par)))
    {
-      data->parameter.removeOne(UmlParameterPtr(par));
+      par->setOwner(nullptr);
+      updateTypeIndex();
    }
 }
 
@@ -450,7 +512,9 @@ UmlParameter* UmlOperation::findParameter(QString name)
  */
 void UmlOperation::clearParameter()
 {
+   for (auto& param : data->parameter) param->setOwner(nullptr);
    data->parameter.clear();
+   updateTypeIndex();
 }
 
 /**
@@ -461,7 +525,9 @@ void UmlOperation::append(UmlTemplateParameter* par)
 {
    if (par != nullptr)
    {
+      par->setOwner(this);
       data->templParams.append(UmlTemplateParameterPtr(par));
+      updateTypeIndex();
    }
 }
 
@@ -471,9 +537,10 @@ void UmlOperation::append(UmlTemplateParameter* par)
  */
 void UmlOperation::remove(UmlTemplateParameter* par)
 {
-   if (par != nullptr)
+   if (par != nullptr && data->templParams.removeOne(UmlTemplateParameterPtr(par)))
    {
-      data->templParams.removeOne(UmlTemplateParameterPtr(par));
+      par->setOwner(nullptr);
+      updateTypeIndex();
    }
 }
 
@@ -482,7 +549,21 @@ void UmlOperation::remove(UmlTemplateParameter* par)
  */
 void UmlOperation::clearTemplate()
 {
+   for (auto& param : data->templParams) param->setOwner(nullptr);
    data->templParams.clear();
+   updateTypeIndex();
+}
+
+/** Adds the estimated memory used by the operation to a MemoryUsage object, see UmlElement::measure(). */
+void UmlOperation::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->initCode) + MemoryUsage::sizeOf(data->returnType);
+   usage.containers += MemoryUsage::sizeOf(data->parameter) + MemoryUsage::sizeOf(data->templParams);
+   for (auto& par : data->parameter) par->measure(usage);
+   for (auto& par : data->templParams) par->measure(usage);
 }
 
 /**
@@ -514,6 +595,7 @@ void UmlOperation::serialize(QJsonObject& json, bool read, bool flat, int versio
       // Operation parameter:
       {
          auto array = json[KPropParameter].toArray();
+         if (!data->parameter.isEmpty()) clearParameter();
          for (int index = 0; index < array.size(); ++index)
          {
             auto* par = new UmlParameter();
@@ -526,6 +608,7 @@ void UmlOperation::serialize(QJsonObject& json, bool read, bool flat, int versio
       // Template parameter:
       {
          auto array = json[KPropTemplParam].toArray();
+         if (!data->templParams.isEmpty()) clearTemplate();
          for (int index = 0; index < array.size(); ++index)
          {
             auto* par = new UmlTemplateParameter();
@@ -93,6 +93,8 @@ public: // Properties
    void setReturnType(QString value);
 
    QList<UmlParameter*> parameter() const;
+   QStringList typeReferences() const override;
+   bool renameTypeReference(QString oldName, QString newName) override;
    QString signature() const;
    QString toString() const override;
 
@@ -107,6 +109,7 @@ public: // Methods
    void append(UmlTemplateParameter* par) override;
    void remove(UmlTemplateParameter* par) override;
    void clearTemplate() override;
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
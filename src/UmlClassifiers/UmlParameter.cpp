@@ -26,10 +26,12 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlParameter.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "SignatureChars.h"
 #include "PropertyStrings.h"
 
 #include "../UmlCommon/PropertyStrings.h"
+#include "../UmlCommon/UmlElement.h"
 
 #include <QTextStream>
 
@@ -56,6 +58,7 @@ struct UmlParameter::Data
    , isUnique(false)
    , lower(1)
    , upper(1)
+   , owner(nullptr)
    {}
 
    QString                 name;
@@ -70,6 +73,7 @@ struct UmlParameter::Data
    bool                    isUnique;
    quint32                 lower;
    quint32                 upper;
+   UmlElement*             owner;
    QAtomicInteger<quint32> refCount;
 };
 /// @endcond
@@ -213,7 +217,27 @@ QString UmlParameter::type() const
  */
 void UmlParameter::setType(QString value)
 {
+   if (data->type == value) return;
    data->type = value;
+   if (data->owner != nullptr) data->owner->updateTypeIndex();
+}
+
+/**
+ * Gets the operation owning the parameter.
+ *
+ * The owner is set automatically when appending the parameter to an operation.
+ */
+UmlElement* UmlParameter::owner() const
+{
+   return data->owner;
+}
+
+/**
+ * Sets the operation owning the parameter.
+ */
+void UmlParameter::setOwner(UmlElement* value)
+{
+   data->owner = value;
 }
 
 bool UmlParameter::isOrdered() const
@@ -274,6 +298,14 @@ QString UmlParameter::signature() const
    return result;
 }
 
+/** Adds the estimated memory used by the parameter to a MemoryUsage object. */
+void UmlParameter::measure(MemoryUsage& usage) const
+{
+   usage.objects += sizeof(UmlParameter) + sizeof(Data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->defaultValue) + MemoryUsage::sizeOf(data->type);
+}
+
 /**
  * Serializes properties of the UmlParameter instance to a JSON file.
  *
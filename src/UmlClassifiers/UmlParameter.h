@@ -36,6 +36,9 @@
 #include "../UmlCommon/IMultiplicityElement.h"
 #include "../UmlCommon/ISerializable.h"
 
+class UmlElement;
+struct MemoryUsage;
+
 class UMLCLASSIFIERS_EXPORT UmlParameter : public IMultiplicityElement, public ISerializable
 {
 public: // Constructors
@@ -67,6 +70,9 @@ public: // Properties
    QString type() const;
    void setType(QString value);
 
+   UmlElement* owner() const;
+   void setOwner(UmlElement* value);
+
    bool isOrdered() const override;
    void isOrdered(bool value) override;
 
@@ -87,6 +93,7 @@ public: // Methods
    void incRefCount();
    void decRefCount();
    quint32 refCount() const;
+   void measure(MemoryUsage& usage) const;
 
 public: // Attributes
    ///@cond
@@ -26,9 +26,11 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlPort.h"
+#include "../UmlCommon/MemoryUsage.h"
 #include "PropertyStrings.h"
 
 #include "../UmlCommon/PropertyStrings.h"
+#include "../UmlCommon/TypeIndex.h"
 
 /**
  * @class UmlPort
@@ -117,6 +119,7 @@ QString UmlPort::name() const
 
 void UmlPort::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -267,7 +270,24 @@ QString UmlPort::type() const
 
 void UmlPort::setType(QString value)
 {
+   if (data->type == value) return;
    data->type = value;
+   updateTypeIndex();
+}
+
+/** Gets the type of the port as the only type referenced by the port, see class TypeIndex. */
+QStringList UmlPort::typeReferences() const
+{
+   return QStringList(data->type);
+}
+
+/** Renames a type in the type of the port, see UmlProject::renameType(). */
+bool UmlPort::renameTypeReference(QString oldName, QString newName)
+{
+   QString type = TypeIndex::replace(data->type, oldName, newName);
+   if (type == data->type) return false;
+   setType(type);
+   return true;
 }
 
 bool UmlPort::isBehavior() const
@@ -300,6 +320,16 @@ void UmlPort::isService(bool value)
    data->isService = value;
 }
 
+/** Adds the estimated memory used by the port to a MemoryUsage object, see UmlElement::measure(). */
+void UmlPort::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype) + MemoryUsage::sizeOf(data->type) +
+      MemoryUsage::sizeOf(data->defaultValue);
+}
+
 void UmlPort::serialize(QJsonObject& json, bool read, bool flat, int version)
 {
    super::serialize(json, read, flat, version);
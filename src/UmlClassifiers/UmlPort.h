@@ -94,6 +94,8 @@ public: // Properties
 
    QString type() const override;
    void setType(QString value) override;
+   QStringList typeReferences() const override;
+   bool renameTypeReference(QString oldName, QString newName) override;
 
    bool isBehavior() const;
    void isBehavior(bool value);
@@ -104,6 +106,9 @@ public: // Properties
    bool isService() const;
    void isService(bool value);
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 protected: // Methods
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
 
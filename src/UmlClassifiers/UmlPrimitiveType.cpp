@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlPrimitiveType.h"
+#include "../UmlCommon/MemoryUsage.h"
 
 #include "../UmlCommon/PropertyStrings.h"
 #include "../UmlCommon/SignatureTools.h"
@@ -107,6 +108,7 @@ QString UmlPrimitiveType::name() const
 /** Sets the name of the primitive type. */
 void UmlPrimitiveType::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -134,6 +136,14 @@ void UmlPrimitiveType::setVisibility(VisibilityKind value)
    data->visibility = value;
 }
 
+/** Adds the estimated memory used by the primitive type to a MemoryUsage object, see UmlElement::measure(). */
+void UmlPrimitiveType::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment);
+}
+
 /**
  * Serializes properties of the UmlPrimitiveType instance to a JSON file.
  *
@@ -58,6 +58,7 @@ public: // Properties
 
 public: // Methods
    QString toString() const override;
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
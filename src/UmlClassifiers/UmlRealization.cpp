@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlRealization.h"
+#include "../UmlCommon/MemoryUsage.h"
 
 #include "../UmlCommon/PropertyStrings.h"
 
@@ -88,6 +89,7 @@ QString UmlRealization::name() const
 
 void UmlRealization::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -121,6 +123,15 @@ void UmlRealization::setStereotype(QString value)
    data->stereotype = value;
 }
 
+/** Adds the estimated memory used by the realization to a MemoryUsage object, see UmlElement::measure(). */
+void UmlRealization::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype);
+}
+
 void UmlRealization::serialize(QJsonObject& json, bool read, bool flat, int version)
 {
    super::serialize(json, read, flat, version);
@@ -60,6 +60,9 @@ public: // Properties
    QString stereotype() const override;
    void setStereotype(QString value) override;
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 protected: // Methods
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
 
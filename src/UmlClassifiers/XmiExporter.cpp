@@ -0,0 +1,597 @@
+//---------------------------------------------------------------------------------------------------------------------
+// XmiExporter.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class XmiExporter.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "XmiExporter.h"
+#include "XmiStrings.h"
+
+#include "UmlAssociation.h"
+#include "AssociationEnd.h"
+#include "UmlAttribute.h"
+#include "UmlClass.h"
+#include "UmlComponent.h"
+#include "UmlDatatype.h"
+#include "UmlEnumeration.h"
+#include "UmlGeneralization.h"
+#include "UmlInterface.h"
+#include "UmlLiteral.h"
+#include "UmlOperation.h"
+#include "UmlParameter.h"
+#include "UmlPrimitiveType.h"
+#include "UmlRealization.h"
+#include "UmlSignal.h"
+
+#include "../UmlCommon/ErrorTools.h"
+#include "../UmlCommon/Tracer.h"
+#include "../UmlCommon/UmlDependency.h"
+#include "../UmlCommon/UmlModel.h"
+#include "../UmlCommon/UmlProject.h"
+#include "../UmlCommon/UmlRoot.h"
+
+#include <QHash>
+#include <QMap>
+#include <QSaveFile>
+#include <QXmlStreamWriter>
+
+/**
+ * @class XmiExporter
+ * @brief The XmiExporter class writes the model of a project to an XMI file.
+ * @since 0.2.0
+ * @ingroup UmlClassifiers
+ *
+ * XMI is the exchange format of the UML specification. XmiExporter writes the models and packages of a project in
+ * XMI 2.5 for UML 2.5.1, so other UML tools can read them. The file is written element by element with a
+ * QXmlStreamWriter, without building a document in memory.
+ *
+ * The following elements are exported: models, packages, classes, interfaces, data types, enumerations, signals,
+ * components and primitive types, their attributes, operations and literals, associations, generalizations,
+ * realizations and dependencies. Diagrams, comment elements and other elements are not exported.
+ *
+ * The identifiers of the XMI file are derived from the identifiers of the elements, so XmiImporter restores them.
+ * Types in ViraquchaUML are names: a type name is exported as reference to the classifier of that name, as reference
+ * to a primitive type of UML (e.g. "String"), or else as reference to a primitive type written at the end of the
+ * file, e.g. for the primitive types of the programming language ("int").
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+/** State of writing one XMI file. */
+struct ExportContext
+{
+   ExportContext()
+   : count(0)
+   {}
+
+   QXmlStreamWriter                             writer;
+   QHash<QString, QUuid>                        types;           // Classifiers and primitive types by name
+   QMultiHash<UmlElement*, UmlGeneralization*>  generalizations; // Generalizations by specific element
+   QMap<QString, QString>                       unresolved;      // Type names not found, by their XMI identifier
+   int                                          count;
+
+   void startElement(const QString& tag, const QString& type, const QString& id);
+   void writeNamed(const INamedElement& named);
+   void writeComment(const QString& id, const QString& comment);
+   void writeBool(const QString& name, bool value, bool defaultValue = false);
+   QString typeRef(const QString& name);
+   void writeTypeHref(const QString& name);
+   void writeMultiplicity(const QString& id, const IMultiplicityElement& elem);
+   void writeDefault(const QString& id, const QString& value);
+
+   void writeElement(UmlElement* elem, const QString& tag);
+   void writePackage(UmlPackage* pkg, const QString& tag);
+   void writeClassifier(UmlClassifier* cls, const QString& type, const QString& tag);
+   void writeProperty(const QString& tag, const QString& id, const IProperty& prop, const QString& association,
+                      const UmlElement* typeElement = nullptr, const QString& defaultValue = QString());
+   void writeOperation(UmlOperation* op);
+   void writeAssociation(UmlAssociation* assoc, const QString& tag);
+   void writeDependency(UmlLink* link, const QString& type, const QString& tag);
+};
+
+struct XmiExporter::Data
+{
+   Data()
+   : project(nullptr)
+   , count(0)
+   {}
+
+   UmlProject* project;
+   int         count;
+   QString     errorString;
+};
+/// @endcond
+
+/** Primitive types defined by UML, referenced by their URI instead of being written to the file. */
+const QStringList KUmlPrimitives = { "Boolean", "Integer", "Real", "String", "UnlimitedNatural" };
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Converts an identifier to an XMI identifier. XMI identifiers must not start with a digit. */
+static QString toXmiId(const QUuid& id)
+{
+   return "_" + id.toString().mid(1, 36);
+}
+
+/** Gets the name of a visibility in XMI, or an empty string if the visibility is undefined. */
+static QString toString(VisibilityKind kind)
+{
+   switch (kind)
+   {
+   case VisibilityKind::Public:    return "public";
+   case VisibilityKind::Protected: return "protected";
+   case VisibilityKind::Private:   return "private";
+   case VisibilityKind::Package:   return "package";
+   default:                        return QString();
+   }
+}
+
+/** Gets the name of a parameter direction in XMI, or an empty string if the direction is undefined. */
+static QString toString(ParameterDirectionKind kind)
+{
+   switch (kind)
+   {
+   case ParameterDirectionKind::In:     return "in";
+   case ParameterDirectionKind::InOut:  return "inout";
+   case ParameterDirectionKind::Out:    return "out";
+   case ParameterDirectionKind::Return: return "return";
+   default:                             return QString();
+   }
+}
+
+/** Gets the UML metaclass of a classifier, or an empty string if it is not exported. */
+static QString classifierType(UmlClassifier* cls)
+{
+   if (dynamic_cast<UmlInterface*>(cls) != nullptr) return KUmlInterface;
+   if (dynamic_cast<UmlEnumeration*>(cls) != nullptr) return KUmlEnumeration;
+   if (dynamic_cast<UmlDatatype*>(cls) != nullptr) return KUmlDataType;
+   if (dynamic_cast<UmlSignal*>(cls) != nullptr) return KUmlSignal;
+   if (dynamic_cast<UmlComponent*>(cls) != nullptr) return KUmlComponent;
+   if (dynamic_cast<UmlClass*>(cls) != nullptr) return KUmlClass;
+   return QString();
+}
+
+/** Starts an element: a root element of the file if no tag is given, otherwise an element typed by xmi:type. */
+void ExportContext::startElement(const QString& tag, const QString& type, const QString& id)
+{
+   if (tag.isEmpty())
+   {
+      writer.writeStartElement(KUmlNamespace, type);
+   }
+   else
+   {
+      writer.writeStartElement(tag);
+      writer.writeAttribute(KXmiNamespace, KXmiType, "uml:" + type);
+   }
+
+   writer.writeAttribute(KXmiNamespace, KXmiId, id);
+}
+
+/** Writes the name and the visibility of a named element. */
+void ExportContext::writeNamed(const INamedElement& named)
+{
+   writer.writeAttribute(KXmiName, named.name());
+   QString visibility = toString(named.visibility());
+   if (!visibility.isEmpty()) writer.writeAttribute(KXmiVisibility, visibility);
+}
+
+/** Writes the comment of an element as owned comment. */
+void ExportContext::writeComment(const QString& id, const QString& comment)
+{
+   if (comment.isEmpty()) return;
+
+   startElement(KXmiOwnedComment, KUmlComment, id + "_comment");
+   writer.writeTextElement(KXmiBody, comment);
+   writer.writeEndElement();
+}
+
+/** Writes a boolean attribute unless it has its default value. */
+void ExportContext::writeBool(const QString& name, bool value, bool defaultValue)
+{
+   if (value != defaultValue) writer.writeAttribute(name, value ? "true" : "false");
+}
+
+/**
+ * Gets the XMI identifier of the type with the given name. Names not found in the project are noted to be written
+ * as primitive types at the end of the file.
+ * @returns The identifier, or an empty string if no type is given or the type is a primitive type of UML.
+ */
+QString ExportContext::typeRef(const QString& name)
+{
+   if (name.isEmpty()) return QString();
+
+   auto found = types.constFind(name);
+   if (found != types.constEnd()) return toXmiId(*found);
+   if (KUmlPrimitives.contains(name)) return QString();
+
+   QString id = toXmiId(QUuid::createUuidV5(KXmiIdNamespace, name));
+   unresolved.insert(id, name);
+   return id;
+}
+
+/** Writes the reference to a primitive type of UML, if the type is one. */
+void ExportContext::writeTypeHref(const QString& name)
+{
+   if (types.contains(name) || !KUmlPrimitives.contains(name)) return;
+
+   writer.writeEmptyElement(KXmiType);
+   writer.writeAttribute(KXmiHref, KUmlPrimitiveTypes + "#" + name);
+}
+
+/** Writes the lower and upper bound of a multiplicity. */
+void ExportContext::writeMultiplicity(const QString& id, const IMultiplicityElement& elem)
+{
+   writer.writeEmptyElement(KXmiLowerValue);
+   writer.writeAttribute(KXmiNamespace, KXmiType, "uml:" + KUmlLiteralInteger);
+   writer.writeAttribute(KXmiNamespace, KXmiId, id + "_lower");
+   writer.writeAttribute(KXmiValue, QString::number(elem.lower()));
+
+   writer.writeEmptyElement(KXmiUpperValue);
+   writer.writeAttribute(KXmiNamespace, KXmiType, "uml:" + KUmlUnlimited);
+   writer.writeAttribute(KXmiNamespace, KXmiId, id + "_upper");
+   writer.writeAttribute(KXmiValue, elem.upper() == KUnlimited ? QString("*") : QString::number(elem.upper()));
+}
+
+/** Writes a default value as string literal. */
+void ExportContext::writeDefault(const QString& id, const QString& value)
+{
+   if (value.isEmpty()) return;
+
+   writer.writeEmptyElement(KXmiDefaultValue);
+   writer.writeAttribute(KXmiNamespace, KXmiType, "uml:" + KUmlLiteralString);
+   writer.writeAttribute(KXmiNamespace, KXmiId, id + "_default");
+   writer.writeAttribute(KXmiValue, value);
+}
+
+/** Writes an element of a package. Elements not exported are skipped. */
+void ExportContext::writeElement(UmlElement* elem, const QString& tag)
+{
+   if (auto* pkg = dynamic_cast<UmlPackage*>(elem))
+   {
+      writePackage(pkg, tag);
+   }
+   else if (auto* cls = dynamic_cast<UmlClassifier*>(elem))
+   {
+      QString type = classifierType(cls);
+      if (!type.isEmpty()) writeClassifier(cls, type, tag);
+   }
+   else if (auto* prim = dynamic_cast<UmlPrimitiveType*>(elem))
+   {
+      QString id = toXmiId(prim->identifier());
+      startElement(tag, KUmlPrimitiveType, id);
+      writeNamed(*prim);
+      writeComment(id, prim->comment());
+      writer.writeEndElement();
+      ++count;
+   }
+   else if (auto* assoc = dynamic_cast<UmlAssociation*>(elem))
+   {
+      writeAssociation(assoc, tag);
+   }
+   else if (auto* real = dynamic_cast<UmlRealization*>(elem))
+   {
+      writeDependency(real, KUmlRealization, tag);
+   }
+   else if (auto* dep = dynamic_cast<UmlDependency*>(elem))
+   {
+      writeDependency(dep, dep->keywords() == "use" ? KUmlUsage : KUmlDependency, tag);
+   }
+
+   // Generalizations are written by their specific classifiers.
+}
+
+/** Writes a package or model and its elements. */
+void ExportContext::writePackage(UmlPackage* pkg, const QString& tag)
+{
+   QString id = toXmiId(pkg->identifier());
+   startElement(tag, dynamic_cast<UmlModel*>(pkg) != nullptr ? KUmlModel : KUmlPackage, id);
+   writeNamed(*pkg);
+   if (!pkg->uri().isEmpty()) writer.writeAttribute(KXmiURI, pkg->uri());
+   writeComment(id, pkg->comment());
+   ++count;
+
+   for (auto* elem : pkg->elements()) writeElement(elem, KXmiPackagedElement);
+   writer.writeEndElement();
+}
+
+/** Writes a classifier with its generalizations, attributes, operations, literals and nested classifiers. */
+void ExportContext::writeClassifier(UmlClassifier* cls, const QString& type, const QString& tag)
+{
+   QString id = toXmiId(cls->identifier());
+   startElement(tag, type, id);
+   writeNamed(*cls);
+   writeBool(KXmiIsAbstract, cls->isAbstract());
+   writeBool(KXmiIsLeaf, cls->isLeaf() || cls->isFinal());
+   writeComment(id, cls->comment());
+   ++count;
+
+   for (auto* gen : generalizations.values(cls))
+   {
+      if (gen->target() == nullptr) continue;
+
+      QString genId = toXmiId(gen->identifier());
+      startElement(KXmiGeneralization, KUmlGeneralization, genId);
+      writer.writeAttribute(KXmiGeneral, toXmiId(gen->target()->identifier()));
+      writeComment(genId, gen->comment());
+      writer.writeEndElement();
+      ++count;
+   }
+
+   for (auto* attr : cls->attributes())
+   {
+      writeProperty(KXmiOwnedAttribute, toXmiId(attr->identifier()), *attr, QString(), nullptr, attr->defaultValue());
+      ++count;
+   }
+
+   for (auto* op : cls->operations()) writeOperation(op);
+
+   if (auto* enumeration = dynamic_cast<UmlEnumeration*>(cls))
+   {
+      int index = 0;
+      for (auto* literal : enumeration->literals())
+      {
+         writer.writeEmptyElement(KXmiOwnedLiteral);
+         writer.writeAttribute(KXmiNamespace, KXmiType, "uml:" + KUmlEnumLiteral);
+         writer.writeAttribute(KXmiNamespace, KXmiId, QString("%1_literal%2").arg(id).arg(index++));
+         writer.writeAttribute(KXmiName, literal->symbol());
+      }
+   }
+
+   for (auto* elem : cls->elements())
+   {
+      if (dynamic_cast<UmlClassifier*>(elem) != nullptr) writeElement(elem, KXmiNestedClass);
+   }
+
+   writer.writeEndElement();
+}
+
+/**
+ * Writes an attribute or association end.
+ * @param typeElement Element typing an association end; attributes are typed by the name of their type.
+ */
+void ExportContext::writeProperty(const QString& tag, const QString& id, const IProperty& prop,
+                                  const QString& association, const UmlElement* typeElement,
+                                  const QString& defaultValue)
+{
+   startElement(tag, KUmlProperty, id);
+   writeNamed(prop);
+   writeBool(KXmiIsStatic, prop.isStatic());
+   writeBool(KXmiIsReadOnly, prop.isReadOnly());
+   writeBool(KXmiIsDerived, prop.isDerived());
+   writeBool(KXmiIsDerivedUnion, prop.isDerivedUnion());
+   writeBool(KXmiIsOrdered, prop.isOrdered());
+   writeBool(KXmiIsUnique, prop.isUnique(), true);
+   writeBool(KXmiIsID, prop.isID());
+   if (prop.aggregation() == AggregationKind::Shared) writer.writeAttribute(KXmiAggregation, "shared");
+   if (prop.aggregation() == AggregationKind::Composite) writer.writeAttribute(KXmiAggregation, "composite");
+   if (!association.isEmpty()) writer.writeAttribute(KXmiAssociation, association);
+
+   QString type = typeElement != nullptr ? toXmiId(typeElement->identifier()) : typeRef(prop.type());
+   if (!type.isEmpty()) writer.writeAttribute(KXmiType, type);
+
+   writeComment(id, prop.comment());
+   if (typeElement == nullptr) writeTypeHref(prop.type());
+   writeMultiplicity(id, prop);
+   writeDefault(id, defaultValue);
+   writer.writeEndElement();
+}
+
+/** Writes an operation with its parameters. The return type is written as parameter of direction "return". */
+void ExportContext::writeOperation(UmlOperation* op)
+{
+   QString id = toXmiId(op->identifier());
+   startElement(KXmiOwnedOperation, KUmlOperation, id);
+   writeNamed(*op);
+   writeBool(KXmiIsAbstract, op->isAbstract());
+   writeComment(id, op->comment());
+   ++count;
+
+   int index = 0;
+   for (auto* par : op->parameter())
+   {
+      QString parId = QString("%1_parameter%2").arg(id).arg(index++);
+      startElement(KXmiOwnedParameter, KUmlParameter, parId);
+      writer.writeAttribute(KXmiName, par->name());
+      QString direction = toString(par->direction());
+      if (!direction.isEmpty()) writer.writeAttribute(KXmiDirection, direction);
+      QString type = typeRef(par->type());
+      if (!type.isEmpty()) writer.writeAttribute(KXmiType, type);
+
+      writeComment(parId, par->comment());
+      writeTypeHref(par->type());
+      writeMultiplicity(parId, *par);
+      writeDefault(parId, par->defaultValue());
+      writer.writeEndElement();
+   }
+
+   if (!op->returnType().isEmpty())
+   {
+      startElement(KXmiOwnedParameter, KUmlParameter, id + "_return");
+      writer.writeAttribute(KXmiDirection, "return");
+      QString type = typeRef(op->returnType());
+      if (!type.isEmpty()) writer.writeAttribute(KXmiType, type);
+
+      writeTypeHref(op->returnType());
+      writer.writeEndElement();
+   }
+
+   writer.writeEndElement();
+}
+
+/** Writes an association. Both ends are owned by the association and typed by the elements linked. */
+void ExportContext::writeAssociation(UmlAssociation* assoc, const QString& tag)
+{
+   if (assoc->source() == nullptr || assoc->target() == nullptr) return;
+
+   QString id = toXmiId(assoc->identifier());
+   QString sourceId = id + "_source";
+   QString targetId = id + "_target";
+   startElement(tag, KUmlAssociation, id);
+   writeNamed(*assoc);
+   writeBool(KXmiIsDerived, assoc->isDerived());
+   writer.writeAttribute(KXmiMemberEnd, sourceId + " " + targetId);
+   writeComment(id, assoc->comment());
+   writeProperty(KXmiOwnedEnd, sourceId, assoc->sourceEnd(), id, assoc->source());
+   writeProperty(KXmiOwnedEnd, targetId, assoc->targetEnd(), id, assoc->target());
+   writer.writeEndElement();
+   ++count;
+}
+
+/** Writes a dependency, usage or realization from its source (client) to its target (supplier). */
+void ExportContext::writeDependency(UmlLink* link, const QString& type, const QString& tag)
+{
+   if (link->source() == nullptr || link->target() == nullptr) return;
+
+   QString id = toXmiId(link->identifier());
+   startElement(tag, type, id);
+   auto* named = dynamic_cast<INamedElement*>(link);
+   if (named != nullptr) writeNamed(*named);
+   writer.writeAttribute(KXmiClient, toXmiId(link->source()->identifier()));
+   writer.writeAttribute(KXmiSupplier, toXmiId(link->target()->identifier()));
+   if (named != nullptr) writeComment(id, named->comment());
+   writer.writeEndElement();
+   ++count;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the XmiExporter class. */
+XmiExporter::XmiExporter(UmlProject* project)
+: data(new Data())
+{
+   data->project = project;
+}
+
+/** Destroys the XmiExporter object. */
+XmiExporter::~XmiExporter()
+{
+   delete data;
+}
+
+/** Gets the project exported. */
+UmlProject* XmiExporter::project() const
+{
+   return data->project;
+}
+
+/** Gets the number of elements written by the last export, including attributes, operations and relationships. */
+int XmiExporter::exportedCount() const
+{
+   return data->count;
+}
+
+/** Gets a description of the error that occurred during the last export. */
+QString XmiExporter::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Writes the project to an XMI file. The file is replaced only if it was written completely.
+ *
+ * @param filename Name of the XMI file including path.
+ * @returns true if successful; otherwise false.
+ */
+bool XmiExporter::write(QString filename)
+{
+   QSaveFile file(filename);
+   if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+   {
+      data->errorString = QString(KFileWriteError).arg(filename).arg(file.errorString());
+      return false;
+   }
+
+   if (!write(&file)) return false;
+   if (!file.commit())
+   {
+      data->errorString = QString(KFileWriteError).arg(filename).arg(file.errorString());
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Writes the project as XMI to a device.
+ *
+ * @param device Device opened for writing.
+ * @returns true if successful; otherwise false.
+ */
+bool XmiExporter::write(QIODevice* device)
+{
+   TraceSpan span("XmiExporter::write");
+   data->errorString.clear();
+   data->count = 0;
+
+   ExportContext context;
+   for (auto* elem : data->project->elements())
+   {
+      if (dynamic_cast<UmlClassifier*>(elem) != nullptr || dynamic_cast<UmlPrimitiveType*>(elem) != nullptr)
+      {
+         QString name = dynamic_cast<INamedElement*>(elem)->name();
+         if (!context.types.contains(name)) context.types.insert(name, elem->identifier());
+      }
+      else if (auto* gen = dynamic_cast<UmlGeneralization*>(elem))
+      {
+         if (gen->source() != nullptr) context.generalizations.insert(gen->source(), gen);
+      }
+   }
+
+   auto& writer = context.writer;
+   writer.setDevice(device);
+   writer.setAutoFormatting(true);
+   writer.setAutoFormattingIndent(1);
+   writer.writeStartDocument();
+   writer.writeNamespace(KXmiNamespace, "xmi");
+   writer.writeNamespace(KUmlNamespace, "uml");
+   writer.writeStartElement(KXmiNamespace, KXmiRoot);
+
+   for (auto* elem : data->project->root()->elements()) context.writeElement(elem, QString());
+
+   for (auto iter = context.unresolved.cbegin(); iter != context.unresolved.cend(); ++iter)
+   {
+      writer.writeEmptyElement(KUmlNamespace, KUmlPrimitiveType);
+      writer.writeAttribute(KXmiNamespace, KXmiId, iter.key());
+      writer.writeAttribute(KXmiName, iter.value());
+   }
+
+   writer.writeEndElement();
+   writer.writeEndDocument();
+   data->count = context.count;
+   span.setDetail(QString("%1 element(s)").arg(data->count));
+
+   if (writer.hasError())
+   {
+      data->errorString = QString(KFileWriteError).arg("XMI").arg(device->errorString());
+      return false;
+   }
+
+   return true;
+}
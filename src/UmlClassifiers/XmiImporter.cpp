@@ -0,0 +1,840 @@
+//---------------------------------------------------------------------------------------------------------------------
+// XmiImporter.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class XmiImporter.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "XmiImporter.h"
+#include "XmiStrings.h"
+
+#include "UmlAssociation.h"
+#include "AssociationEnd.h"
+#include "UmlAttribute.h"
+#include "UmlClass.h"
+#include "UmlComponent.h"
+#include "UmlDatatype.h"
+#include "UmlEnumeration.h"
+#include "UmlGeneralization.h"
+#include "UmlInterface.h"
+#include "UmlLiteral.h"
+#include "UmlOperation.h"
+#include "UmlParameter.h"
+#include "UmlPrimitiveType.h"
+#include "UmlRealization.h"
+#include "UmlSignal.h"
+
+#include "../UmlCommon/ErrorTools.h"
+#include "../UmlCommon/Tracer.h"
+#include "../UmlCommon/UmlDependency.h"
+#include "../UmlCommon/UmlModel.h"
+#include "../UmlCommon/UmlProject.h"
+#include "../UmlCommon/UmlRoot.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QXmlStreamReader>
+
+/**
+ * @class XmiImporter
+ * @brief The XmiImporter class reads the model of an XMI file into a project.
+ * @since 0.2.0
+ * @ingroup UmlClassifiers
+ *
+ * XmiImporter reads XMI files of other UML tools - XMI 2.5 as well as older versions like XMI 2.1 - and adds the
+ * models and packages found to a project. The subset imported matches the one written by XmiExporter; other elements
+ * are skipped and counted by skippedCount().
+ *
+ * Files may be very large, so they are read with a QXmlStreamReader in two passes instead of being loaded as a
+ * document:
+ * 1. The first pass collects the names of all classifiers by their XMI identifiers. Types in ViraquchaUML are names,
+ *    so attributes and parameters typed by a classifier defined later in the file get their type names in the second
+ *    pass right away.
+ * 2. The second pass creates the elements. Relationships may refer to elements defined later in the file; they are
+ *    noted and created after the pass.
+ *
+ * Memory therefore grows with the number of classifiers and relationships imported, not with the size of the file.
+ * Identifiers of elements are derived from their XMI identifiers, so importing the same file into two projects gives
+ * the same identifiers. Elements whose identifiers are already used by the project get new ones.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+/** Typed element read from XMI: an attribute, association end or parameter. */
+struct XmiProperty
+{
+   XmiProperty()
+   : visibility(VisibilityKind::Undefined)
+   , aggregation(AggregationKind::None)
+   , lower(1)
+   , upper(1)
+   , isStatic(false)
+   , isReadOnly(false)
+   , isDerived(false)
+   , isDerivedUnion(false)
+   , isOrdered(false)
+   , isUnique(true)
+   , isID(false)
+   {}
+
+   QString         id;
+   QString         name;
+   QString         comment;
+   QString         type;
+   QString         association;
+   QString         direction;
+   QString         defaultValue;
+   VisibilityKind  visibility;
+   AggregationKind aggregation;
+   quint32         lower;
+   quint32         upper;
+   bool            isStatic;
+   bool            isReadOnly;
+   bool            isDerived;
+   bool            isDerivedUnion;
+   bool            isOrdered;
+   bool            isUnique;
+   bool            isID;
+};
+
+/** Relationship read from XMI, created after all elements were read. */
+struct XmiLink
+{
+   XmiLink()
+   : visibility(VisibilityKind::Undefined)
+   , isDerived(false)
+   , owner(nullptr)
+   {}
+
+   QString              type;
+   QString              id;
+   QString              name;
+   QString              comment;
+   QString              client;
+   QString              supplier;
+   QStringList          memberEnds;
+   VisibilityKind       visibility;
+   bool                 isDerived;
+   UmlCompositeElement* owner;
+};
+
+/** State of reading one XMI file. */
+struct ImportContext
+{
+   ImportContext()
+   : project(nullptr)
+   , topLevel(nullptr)
+   , wrapper(nullptr)
+   , imported(0)
+   , skipped(0)
+   {}
+
+   QXmlStreamReader            reader;
+   UmlProject*                 project;
+   UmlCompositeElement*        topLevel;   // Owner of the elements at the root of the file
+   UmlModel*                   wrapper;    // Model receiving the elements other than models read into the root
+   QString                     modelName;  // Name of the wrapper model
+   QSet<QString>               primitives; // Primitive types of the project, not created as elements
+   QHash<QString, QString>     typeNames;  // Names of classifiers by XMI identifier, from the first pass
+   QHash<QString, QUuid>       remapped;   // Identifiers changed since they are used by the project already
+   QHash<QString, XmiProperty> ends;       // Association ends by XMI identifier
+   QList<XmiLink>              links;
+   int                         imported;
+   int                         skipped;
+
+   QString xmiValue(const QString& name) const;
+   QString value(const QString& name) const;
+   QString umlType() const;
+   QString reference();
+   QUuid uuidOf(const QString& xmiId) const;
+   QUuid newUuid(const QString& xmiId);
+   void insert(UmlElement* elem, UmlCompositeElement* owner);
+
+   void indexTypes();
+   void readContent(UmlCompositeElement* owner);
+   void readElement(UmlCompositeElement* owner);
+   void readClassifier(UmlClassifier* cls, const QString& xmiId);
+   void readOperation(UmlOperation* op);
+   void readRelationship(XmiLink& link);
+   XmiProperty readProperty();
+   QString readComment();
+   void resolveLinks();
+};
+
+struct XmiImporter::Data
+{
+   Data()
+   : project(nullptr)
+   , imported(0)
+   , skipped(0)
+   {}
+
+   UmlProject* project;
+   int         imported;
+   int         skipped;
+   QString     errorString;
+};
+/// @endcond
+
+/** Metaclasses of the classifiers imported, by the classes created for them. */
+const QStringList KClassifierTypes = { KUmlClass, KUmlInterface, KUmlDataType, KUmlEnumeration, KUmlSignal,
+                                       KUmlComponent };
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Parses a visibility of XMI. */
+static VisibilityKind toVisibility(const QString& value)
+{
+   if (value == "public") return VisibilityKind::Public;
+   if (value == "protected") return VisibilityKind::Protected;
+   if (value == "private") return VisibilityKind::Private;
+   if (value == "package") return VisibilityKind::Package;
+   return VisibilityKind::Undefined;
+}
+
+/** Parses a parameter direction of XMI. A parameter without direction is an input parameter. */
+static ParameterDirectionKind toDirection(const QString& value)
+{
+   if (value == "inout") return ParameterDirectionKind::InOut;
+   if (value == "out") return ParameterDirectionKind::Out;
+   if (value == "return") return ParameterDirectionKind::Return;
+   return ParameterDirectionKind::In;
+}
+
+/** Creates the classifier of a metaclass. */
+static UmlClassifier* createClassifier(const QString& type, QUuid id)
+{
+   if (type == KUmlInterface) return new UmlInterface(id);
+   if (type == KUmlDataType) return new UmlDatatype(id);
+   if (type == KUmlEnumeration) return new UmlEnumeration(id);
+   if (type == KUmlSignal) return new UmlSignal(id);
+   if (type == KUmlComponent) return new UmlComponent(id);
+   return new UmlClass(id);
+}
+
+/** Copies the properties read from XMI to an attribute or association end. */
+static void apply(const XmiProperty& prop, IProperty& target)
+{
+   target.setName(prop.name);
+   target.setComment(prop.comment);
+   target.setVisibility(prop.visibility);
+   target.setType(prop.type);
+   target.setAggregation(prop.aggregation);
+   target.setLower(prop.lower);
+   target.setUpper(prop.upper);
+   target.isStatic(prop.isStatic);
+   target.isReadOnly(prop.isReadOnly);
+   target.isDerived(prop.isDerived);
+   target.isDerivedUnion(prop.isDerivedUnion);
+   target.isOrdered(prop.isOrdered);
+   target.isUnique(prop.isUnique);
+   target.isID(prop.isID);
+}
+
+/** Gets the value of an attribute of the XMI namespace of the current element, of any version of XMI. */
+QString ImportContext::xmiValue(const QString& name) const
+{
+   for (auto& attr : reader.attributes())
+   {
+      if (attr.name() == name && attr.namespaceUri().contains("XMI")) return attr.value().toString();
+   }
+
+   return QString();
+}
+
+/** Gets the value of an attribute without namespace of the current element. */
+QString ImportContext::value(const QString& name) const
+{
+   return reader.attributes().value(QString(), name).toString();
+}
+
+/** Gets the UML metaclass of the current element, e.g. "Class", or an empty string if it is no UML element. */
+QString ImportContext::umlType() const
+{
+   QString type = xmiValue(KXmiType);
+   if (type.isEmpty() && reader.namespaceUri().contains("UML")) return reader.name().toString();
+   return type.mid(type.indexOf(':') + 1);
+}
+
+/**
+ * Reads a reference given as element, e.g. <general xmi:idref="..."/> or <type href="file.xmi#id"/>.
+ * @returns The identifier referenced, for references to other files the fragment of the URI.
+ */
+QString ImportContext::reference()
+{
+   QString ref = xmiValue(KXmiIdRef);
+   if (ref.isEmpty()) ref = value(KXmiHref).section('#', -1);
+   reader.skipCurrentElement();
+   return ref;
+}
+
+/** Gets the identifier of the element with an XMI identifier, which need not exist yet. */
+QUuid ImportContext::uuidOf(const QString& xmiId) const
+{
+   auto found = remapped.constFind(xmiId);
+   if (found != remapped.constEnd()) return *found;
+
+   // Identifiers written by XmiExporter are UUIDs prefixed by an underscore:
+   QString text = xmiId.startsWith('_') ? xmiId.mid(1) : xmiId;
+   QUuid id(text.startsWith('{') ? text : "{" + text + "}");
+   return id.isNull() ? QUuid::createUuidV5(KXmiIdNamespace, xmiId) : id;
+}
+
+/** Gets the identifier of a new element, a new one if the identifier is used by the project already. */
+QUuid ImportContext::newUuid(const QString& xmiId)
+{
+   if (xmiId.isEmpty()) return QUuid::createUuid();
+
+   QUuid id = uuidOf(xmiId);
+   UmlElement* existing = nullptr;
+   if (project->find(id, &existing))
+   {
+      id = QUuid::createUuid();
+      remapped.insert(xmiId, id);
+   }
+
+   return id;
+}
+
+/** 
+ * Adds a new element to the project and to its owner.
+ *
+ * The root of the project only accepts models, all other elements read into it are added to a new model instead.
+ */
+void ImportContext::insert(UmlElement* elem, UmlCompositeElement* owner)
+{
+   if (owner == project->root() && dynamic_cast<UmlModel*>(elem) == nullptr)
+   {
+      if (wrapper == nullptr)
+      {
+         wrapper = new UmlModel();
+         wrapper->setName(modelName);
+         insert(wrapper, owner);
+      }
+
+      owner = wrapper;
+   }
+
+   project->insert(elem);
+   owner->append(elem);
+   ++imported;
+}
+
+/** First pass: collects the names of all classifiers and primitive types by their XMI identifiers. */
+void ImportContext::indexTypes()
+{
+   TraceSpan span("XmiImporter::indexTypes");
+   while (!reader.atEnd())
+   {
+      if (reader.readNext() != QXmlStreamReader::StartElement) continue;
+
+      QString type = umlType();
+      if (!KClassifierTypes.contains(type) && type != KUmlPrimitiveType) continue;
+
+      QString id = xmiValue(KXmiId);
+      if (!id.isEmpty()) typeNames.insert(id, value(KXmiName));
+   }
+
+   span.setDetail(QString("%1 type(s)").arg(typeNames.size()));
+}
+
+/** Reads the children of the current element into a package or classifier. */
+void ImportContext::readContent(UmlCompositeElement* owner)
+{
+   while (reader.readNextStartElement())
+   {
+      if (reader.name() == KXmiOwnedComment)
+      {
+         auto* named = dynamic_cast<INamedElement*>(owner);
+         QString comment = readComment();
+         if (named != nullptr) named->setComment(comment);
+      }
+      else if (reader.name() == KXmiPackagedElement || reader.name() == KXmiNestedClass ||
+               reader.namespaceUri().contains("UML"))
+      {
+         readElement(owner);
+      }
+      else
+      {
+         reader.skipCurrentElement();
+      }
+   }
+}
+
+/** Reads the current element into its owner. */
+void ImportContext::readElement(UmlCompositeElement* owner)
+{
+   QString type = umlType();
+   QString xmiId = xmiValue(KXmiId);
+   QString name = value(KXmiName);
+   auto visibility = toVisibility(value(KXmiVisibility));
+
+   if (type == KUmlModel || type == KUmlPackage)
+   {
+      auto* pkg = type == KUmlModel ? new UmlModel(newUuid(xmiId)) : new UmlPackage(newUuid(xmiId));
+      pkg->setName(name);
+      pkg->setVisibility(visibility);
+      pkg->setUri(value(KXmiURI));
+      insert(pkg, owner);
+      readContent(pkg);
+   }
+   else if (KClassifierTypes.contains(type))
+   {
+      auto* cls = createClassifier(type, newUuid(xmiId));
+      cls->setName(name);
+      cls->setVisibility(visibility);
+      cls->isAbstract(value(KXmiIsAbstract) == "true");
+      cls->isLeaf(value(KXmiIsLeaf) == "true");
+      insert(cls, owner);
+      readClassifier(cls, xmiId);
+   }
+   else if (type == KUmlPrimitiveType)
+   {
+      // Primitive types of the programming language are known to the project by name, and primitive types at the
+      // root of the file - like those written by XmiExporter for unresolved type names - only name types:
+      if (!primitives.contains(name) && owner != topLevel)
+      {
+         auto* prim = new UmlPrimitiveType(newUuid(xmiId));
+         prim->setName(name);
+         prim->setVisibility(visibility);
+         insert(prim, owner);
+      }
+
+      reader.skipCurrentElement();
+   }
+   else if (type == KUmlAssociation || type == KUmlDependency || type == KUmlUsage || type == KUmlRealization ||
+            type == KUmlInterfaceReal)
+   {
+      XmiLink link;
+      link.type = type;
+      link.id = xmiId;
+      link.name = name;
+      link.visibility = visibility;
+      link.isDerived = value(KXmiIsDerived) == "true";
+      link.client = value(KXmiClient).section(' ', 0, 0);
+      link.supplier = value(KXmiSupplier).section(' ', 0, 0);
+      link.memberEnds = value(KXmiMemberEnd).split(' ', QString::SkipEmptyParts);
+      link.owner = owner;
+      readRelationship(link);
+      links.append(link);
+   }
+   else
+   {
+      if (!type.isEmpty()) ++skipped;
+      reader.skipCurrentElement();
+   }
+}
+
+/** Reads the features and relationships of a classifier. */
+void ImportContext::readClassifier(UmlClassifier* cls, const QString& xmiId)
+{
+   int literals = 0;
+   while (reader.readNextStartElement())
+   {
+      QString tag = reader.name().toString();
+      if (tag == KXmiOwnedAttribute)
+      {
+         auto prop = readProperty();
+         if (!prop.association.isEmpty())
+         {
+            // Navigable association ends are owned by classifiers:
+            ends.insert(prop.id, prop);
+            continue;
+         }
+
+         auto* attr = new UmlAttribute(newUuid(prop.id));
+         apply(prop, *attr);
+         attr->setDefaultValue(prop.defaultValue);
+         insert(attr, cls);
+      }
+      else if (tag == KXmiOwnedOperation)
+      {
+         auto* op = new UmlOperation(newUuid(xmiValue(KXmiId)));
+         op->setName(value(KXmiName));
+         op->setVisibility(toVisibility(value(KXmiVisibility)));
+         op->isAbstract(value(KXmiIsAbstract) == "true");
+         insert(op, cls);
+         readOperation(op);
+      }
+      else if (tag == KXmiOwnedLiteral)
+      {
+         auto* enumeration = dynamic_cast<UmlEnumeration*>(cls);
+         if (enumeration != nullptr) enumeration->append(new UmlLiteral(literals++, value(KXmiName)));
+         reader.skipCurrentElement();
+      }
+      else if (tag == KXmiGeneralization || tag == KXmiInterfaceReal)
+      {
+         XmiLink link;
+         link.type = tag == KXmiGeneralization ? KUmlGeneralization : KUmlInterfaceReal;
+         link.id = xmiValue(KXmiId);
+         link.client = xmiId;
+         link.supplier = value(tag == KXmiGeneralization ? KXmiGeneral : KXmiContract);
+         link.owner = cls->owner();
+         readRelationship(link);
+         links.append(link);
+      }
+      else if (tag == KXmiOwnedComment)
+      {
+         cls->setComment(readComment());
+      }
+      else if (tag == KXmiNestedClass)
+      {
+         readElement(cls);
+      }
+      else
+      {
+         reader.skipCurrentElement();
+      }
+   }
+}
+
+/** Reads the parameters and the comment of an operation. */
+void ImportContext::readOperation(UmlOperation* op)
+{
+   while (reader.readNextStartElement())
+   {
+      if (reader.name() == KXmiOwnedParameter)
+      {
+         auto prop = readProperty();
+         auto direction = toDirection(prop.direction);
+         if (direction == ParameterDirectionKind::Return)
+         {
+            op->setReturnType(prop.type);
+            continue;
+         }
+
+         auto* par = new UmlParameter();
+         par->setName(prop.name);
+         par->setComment(prop.comment);
+         par->setType(prop.type);
+         par->setDirection(direction);
+         par->setDefaultValue(prop.defaultValue);
+         par->setLower(prop.lower);
+         par->setUpper(prop.upper);
+         par->isOrdered(prop.isOrdered);
+         par->isUnique(prop.isUnique);
+         op->append(par);
+      }
+      else if (reader.name() == KXmiOwnedComment)
+      {
+         op->setComment(readComment());
+      }
+      else
+      {
+         reader.skipCurrentElement();
+      }
+   }
+}
+
+/** Reads the children of a relationship: ends, references given as elements and comments. */
+void ImportContext::readRelationship(XmiLink& link)
+{
+   while (reader.readNextStartElement())
+   {
+      QString tag = reader.name().toString();
+      if (tag == KXmiOwnedEnd)
+      {
+         auto prop = readProperty();
+         ends.insert(prop.id, prop);
+         if (!link.memberEnds.contains(prop.id)) link.memberEnds.append(prop.id);
+      }
+      else if (tag == KXmiMemberEnd)
+      {
+         QString ref = reference();
+         if (!link.memberEnds.contains(ref)) link.memberEnds.append(ref);
+      }
+      else if (tag == KXmiClient)
+      {
+         link.client = reference();
+      }
+      else if (tag == KXmiSupplier || tag == KXmiGeneral || tag == KXmiContract)
+      {
+         link.supplier = reference();
+      }
+      else if (tag == KXmiOwnedComment)
+      {
+         link.comment = readComment();
+      }
+      else
+      {
+         reader.skipCurrentElement();
+      }
+   }
+}
+
+/** Reads an attribute, association end or parameter. */
+XmiProperty ImportContext::readProperty()
+{
+   XmiProperty prop;
+   prop.id = xmiValue(KXmiId);
+   prop.name = value(KXmiName);
+   prop.visibility = toVisibility(value(KXmiVisibility));
+   prop.association = value(KXmiAssociation);
+   prop.direction = value(KXmiDirection);
+   prop.isStatic = value(KXmiIsStatic) == "true";
+   prop.isReadOnly = value(KXmiIsReadOnly) == "true";
+   prop.isDerived = value(KXmiIsDerived) == "true";
+   prop.isDerivedUnion = value(KXmiIsDerivedUnion) == "true";
+   prop.isOrdered = value(KXmiIsOrdered) == "true";
+   prop.isUnique = value(KXmiIsUnique) != "false";
+   prop.isID = value(KXmiIsID) == "true";
+
+   QString aggregation = value(KXmiAggregation);
+   if (aggregation == "shared") prop.aggregation = AggregationKind::Shared;
+   if (aggregation == "composite") prop.aggregation = AggregationKind::Composite;
+
+   QString typeId = value(KXmiType);
+   while (reader.readNextStartElement())
+   {
+      QString tag = reader.name().toString();
+      if (tag == KXmiType)
+      {
+         // Types of other files, e.g. the primitive types of UML, are named by the fragment of their URI:
+         bool isHref = !value(KXmiHref).isEmpty();
+         typeId = reference();
+         if (isHref && !typeNames.contains(typeId)) prop.type = typeId;
+      }
+      else if (tag == KXmiLowerValue || tag == KXmiUpperValue)
+      {
+         // Literals without value have the default value 0:
+         QString text = value(KXmiValue);
+         quint32 bound = text == "*" ? KUnlimited : text.toUInt();
+         if (tag == KXmiLowerValue) prop.lower = bound;
+         else prop.upper = bound;
+         reader.skipCurrentElement();
+      }
+      else if (tag == KXmiDefaultValue)
+      {
+         prop.defaultValue = value(KXmiValue);
+         while (reader.readNextStartElement())
+         {
+            if (reader.name() == KXmiBody) prop.defaultValue = reader.readElementText();
+            else reader.skipCurrentElement();
+         }
+      }
+      else if (tag == KXmiOwnedComment)
+      {
+         prop.comment = readComment();
+      }
+      else
+      {
+         reader.skipCurrentElement();
+      }
+   }
+
+   if (prop.type.isEmpty()) prop.type = typeNames.value(typeId);
+   if (!prop.association.isEmpty()) prop.type = typeId; // Ends are resolved by identifier
+   return prop;
+}
+
+/** Reads the body of a comment, given as attribute or as element. */
+QString ImportContext::readComment()
+{
+   QString body = value(KXmiBody);
+   while (reader.readNextStartElement())
+   {
+      if (reader.name() == KXmiBody) body = reader.readElementText();
+      else reader.skipCurrentElement();
+   }
+
+   return body;
+}
+
+/** Creates the relationships read, now that all elements exist. Relationships to unknown elements are skipped. */
+void ImportContext::resolveLinks()
+{
+   TraceSpan span("XmiImporter::resolveLinks");
+   for (auto& link : links)
+   {
+      QString client = link.client, supplier = link.supplier;
+      XmiProperty sourceEnd, targetEnd;
+      if (link.type == KUmlAssociation)
+      {
+         if (link.memberEnds.size() != 2 || !ends.contains(link.memberEnds[0]) || !ends.contains(link.memberEnds[1]))
+         {
+            ++skipped;
+            continue;
+         }
+
+         sourceEnd = ends.take(link.memberEnds[0]);
+         targetEnd = ends.take(link.memberEnds[1]);
+         client = sourceEnd.type;
+         supplier = targetEnd.type;
+      }
+
+      UmlElement* source = nullptr;
+      UmlElement* target = nullptr;
+      if (link.owner == nullptr || client.isEmpty() || supplier.isEmpty() || !project->find(uuidOf(client), &source) ||
+          !project->find(uuidOf(supplier), &target))
+      {
+         ++skipped;
+         continue;
+      }
+
+      UmlLink* result = nullptr;
+      QUuid id = newUuid(link.id);
+      if (link.type == KUmlAssociation)
+      {
+         auto* assoc = new UmlAssociation(id);
+         assoc->isDerived(link.isDerived);
+         sourceEnd.type = typeNames.value(client);
+         targetEnd.type = typeNames.value(supplier);
+         apply(sourceEnd, assoc->sourceEnd());
+         apply(targetEnd, assoc->targetEnd());
+         result = assoc;
+      }
+      else if (link.type == KUmlGeneralization)
+      {
+         result = new UmlGeneralization(id);
+      }
+      else if (link.type == KUmlRealization || link.type == KUmlInterfaceReal)
+      {
+         result = new UmlRealization(id);
+      }
+      else
+      {
+         auto* dep = new UmlDependency(id);
+         if (link.type == KUmlUsage) dep->setKeywords("use");
+         result = dep;
+      }
+
+      auto* named = dynamic_cast<INamedElement*>(result);
+      named->setName(link.name);
+      named->setVisibility(link.visibility);
+      named->setComment(link.comment);
+      result->setSource(source);
+      result->setTarget(target);
+      insert(result, link.owner);
+   }
+
+   span.setDetail(QString("%1 relationship(s)").arg(links.size()));
+   links.clear();
+   ends.clear();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the XmiImporter class. */
+XmiImporter::XmiImporter(UmlProject* project)
+: data(new Data())
+{
+   data->project = project;
+}
+
+/** Destroys the XmiImporter object. */
+XmiImporter::~XmiImporter()
+{
+   delete data;
+}
+
+/** Gets the project imported into. */
+UmlProject* XmiImporter::project() const
+{
+   return data->project;
+}
+
+/** Gets the number of elements created by the last import, including attributes, operations and relationships. */
+int XmiImporter::importedCount() const
+{
+   return data->imported;
+}
+
+/** Gets the number of elements skipped by the last import, since they are not supported or refer to unknown ones. */
+int XmiImporter::skippedCount() const
+{
+   return data->skipped;
+}
+
+/** Gets a description of the error that occurred during the last import. */
+QString XmiImporter::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Reads the models and packages of an XMI file into the project.
+ *
+ * @param filename Name of the XMI file including path.
+ * @param owner Element receiving the models and packages read; the root element of the project if not given. Elements
+ *        other than models read into the root are added to a new model named after the file.
+ * @returns true if successful; false if the file could not be read. Elements read before an error remain in the
+ *          project.
+ */
+bool XmiImporter::read(QString filename, UmlCompositeElement* owner)
+{
+   TraceSpan span("XmiImporter::read");
+   span.setDetail(filename);
+   data->errorString.clear();
+   data->imported = 0;
+   data->skipped = 0;
+
+   QFile file(filename);
+   if (!file.open(QIODevice::ReadOnly))
+   {
+      data->errorString = QString(KFileReadError).arg(filename).arg(file.errorString());
+      return false;
+   }
+
+   ImportContext context;
+   context.project = data->project;
+   context.modelName = QFileInfo(filename).completeBaseName();
+   for (auto& name : data->project->primitiveTypes()) context.primitives.insert(name);
+
+   context.reader.setDevice(&file);
+   context.indexTypes();
+
+   // Second pass:
+   if (!context.reader.hasError() && file.seek(0))
+   {
+      context.reader.setDevice(&file);
+      if (context.reader.readNextStartElement())
+      {
+         context.topLevel = owner != nullptr ? owner : data->project->root();
+         if (context.reader.name() == KXmiRoot) context.readContent(context.topLevel);
+         else context.readElement(context.topLevel);
+      }
+   }
+
+   if (context.reader.hasError())
+   {
+      data->errorString = QString("%1:%2:%3: %4").arg(filename).arg(context.reader.lineNumber())
+         .arg(context.reader.columnNumber()).arg(context.reader.errorString());
+      data->imported = context.imported;
+      return false;
+   }
+
+   context.resolveLinks();
+   data->imported = context.imported;
+   data->skipped = context.skipped;
+   span.setDetail(QString("%1 element(s) imported, %2 skipped").arg(data->imported).arg(data->skipped));
+   return true;
+}
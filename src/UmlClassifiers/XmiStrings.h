@@ -0,0 +1,104 @@
+//---------------------------------------------------------------------------------------------------------------------
+// XmiStrings.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of strings and identifiers used in XMI files.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include <QString>
+#include <QUuid>
+
+const QString KXmiNamespace       = "http://www.omg.org/spec/XMI/20131001";
+const QString KUmlNamespace       = "http://www.omg.org/spec/UML/20161101";
+const QString KUmlPrimitiveTypes  = "http://www.omg.org/spec/UML/20161101/PrimitiveTypes.xmi";
+
+const QString KXmiRoot            = "XMI";
+const QString KXmiId              = "id";
+const QString KXmiIdRef           = "idref";
+const QString KXmiType            = "type";
+const QString KXmiHref            = "href";
+
+const QString KXmiAggregation     = "aggregation";
+const QString KXmiAssociation     = "association";
+const QString KXmiBody            = "body";
+const QString KXmiClient          = "client";
+const QString KXmiContract        = "contract";
+const QString KXmiDefaultValue    = "defaultValue";
+const QString KXmiDirection       = "direction";
+const QString KXmiGeneral         = "general";
+const QString KXmiGeneralization  = "generalization";
+const QString KXmiInterfaceReal   = "interfaceRealization";
+const QString KXmiIsAbstract      = "isAbstract";
+const QString KXmiIsDerived       = "isDerived";
+const QString KXmiIsDerivedUnion  = "isDerivedUnion";
+const QString KXmiIsID            = "isID";
+const QString KXmiIsLeaf          = "isLeaf";
+const QString KXmiIsOrdered       = "isOrdered";
+const QString KXmiIsReadOnly      = "isReadOnly";
+const QString KXmiIsStatic        = "isStatic";
+const QString KXmiIsUnique        = "isUnique";
+const QString KXmiLowerValue      = "lowerValue";
+const QString KXmiMemberEnd       = "memberEnd";
+const QString KXmiName            = "name";
+const QString KXmiNestedClass     = "nestedClassifier";
+const QString KXmiOwnedAttribute  = "ownedAttribute";
+const QString KXmiOwnedComment    = "ownedComment";
+const QString KXmiOwnedEnd        = "ownedEnd";
+const QString KXmiOwnedLiteral    = "ownedLiteral";
+const QString KXmiOwnedOperation  = "ownedOperation";
+const QString KXmiOwnedParameter  = "ownedParameter";
+const QString KXmiPackagedElement = "packagedElement";
+const QString KXmiSupplier        = "supplier";
+const QString KXmiUpperValue      = "upperValue";
+const QString KXmiURI             = "URI";
+const QString KXmiValue           = "value";
+const QString KXmiVisibility      = "visibility";
+
+const QString KUmlAssociation     = "Association";
+const QString KUmlClass           = "Class";
+const QString KUmlComment         = "Comment";
+const QString KUmlComponent       = "Component";
+const QString KUmlDataType        = "DataType";
+const QString KUmlDependency      = "Dependency";
+const QString KUmlEnumeration     = "Enumeration";
+const QString KUmlEnumLiteral     = "EnumerationLiteral";
+const QString KUmlGeneralization  = "Generalization";
+const QString KUmlInterface       = "Interface";
+const QString KUmlInterfaceReal   = "InterfaceRealization";
+const QString KUmlLiteralInteger  = "LiteralInteger";
+const QString KUmlLiteralString   = "LiteralString";
+const QString KUmlUnlimited       = "LiteralUnlimitedNatural";
+const QString KUmlModel           = "Model";
+const QString KUmlOperation       = "Operation";
+const QString KUmlPackage         = "Package";
+const QString KUmlParameter       = "Parameter";
+const QString KUmlPrimitiveType   = "PrimitiveType";
+const QString KUmlProperty        = "Property";
+const QString KUmlRealization     = "Realization";
+const QString KUmlSignal          = "Signal";
+const QString KUmlUsage           = "Usage";
+
+/** Namespace of the identifiers derived from XMI identifiers or type names that are no UUIDs. */
+const QUuid KXmiIdNamespace("{6f0d3c4e-8a41-5b2e-9c7d-1e2f3a4b5c6d}");
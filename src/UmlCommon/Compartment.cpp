@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "Compartment.h"
+#include "MemoryUsage.h"
 #include "TextBox.h"
 
 /**
@@ -197,3 +198,11 @@ void Compartment::clear()
    }
    data->lines.clear();
 }
+
+/** Adds the estimated memory used by the compartment to a MemoryUsage object. */
+void Compartment::measure(MemoryUsage& usage) const
+{
+   usage.diagrams += sizeof(Compartment) + sizeof(Data) + MemoryUsage::sizeOf(data->name) +
+      MemoryUsage::sizeOf(data->lines);
+   for (auto* line : data->lines) line->measure(usage);
+}
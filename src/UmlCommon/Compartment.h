@@ -36,6 +36,7 @@
 using namespace Qt;
 
 class TextBox;
+struct MemoryUsage;
 
 class UMLCOMMON_EXPORT Compartment
 {
@@ -61,6 +62,7 @@ public: // Methods
    void append(TextBox* box);
    void remove(TextBox* box);
    void clear();
+   void measure(MemoryUsage& usage) const;
 
 private: // Attributes
    ///@cond
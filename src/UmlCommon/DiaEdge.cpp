@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "DiaEdge.h"
+#include "MemoryUsage.h"
 
 #include "DiaNode.h"
 #include "ILabelProvider.h"
@@ -209,6 +210,15 @@ void DiaEdge::clear()
    data->labels.clear();
 }
 
+/** Adds the estimated memory used by the edge to a MemoryUsage object, see DiaShape::measure(). */
+void DiaEdge::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.diagrams += sizeof(Data) + sizeof(data) + MemoryUsage::sizeOf(data->points) +
+      MemoryUsage::sizeOf(data->labels);
+   for (auto* label : data->labels) label->measure(usage);
+}
+
 /**
  * Serializes properties of the DiaEdge instance to a JSON file.
  *
@@ -68,6 +68,7 @@ public: // Properties
 public: // Methods
    void clear();
    void serialize(QJsonObject& json, bool read, int version) override;
+   void measure(MemoryUsage& usage) const override;
 
 private: // Attributes
    ///@cond
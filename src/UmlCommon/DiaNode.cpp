@@ -24,6 +24,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "DiaNode.h"
+#include "MemoryUsage.h"
 
 #include "UmlElement.h"
 #include "ICompartmentProvider.h"
@@ -88,8 +89,12 @@ UmlElement* DiaNode::element() const
  * The function also resets the vector of compartments to the compartments provided by the new instance. Note that
  * this will only work if the UmlElement instance implements interface ICompartmentProvider. If it does not, nothing
  * will happen, except that the vector will be reset to nullptr values.
+ *
+ * @param value The UmlElement instance.
+ * @param fill True: fills the compartments with text boxes immediately; false: leaves them empty until update() is
+ *             called, e.g. by UmlDiagram::open() which fills the compartments of all nodes in parallel.
  */
-void DiaNode::setElement(UmlElement* value)
+void DiaNode::setElement(UmlElement* value, bool fill)
 {
    data->element = value;
 
@@ -101,6 +106,7 @@ void DiaNode::setElement(UmlElement* value)
       if (provider != nullptr)
       {
          data->compartments = provider->compartments();
+         if (fill) update();
       }
    }
 }
@@ -147,11 +153,20 @@ void DiaNode::clear()
    data->compartments.clear();
 }
 
+/** Adds the estimated memory used by the node to a MemoryUsage object, see DiaShape::measure(). */
+void DiaNode::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.diagrams += sizeof(Data) + sizeof(data) + MemoryUsage::sizeOf(data->compartments);
+   for (auto* comp : data->compartments) comp->measure(usage);
+}
+
 /**
  * Serializes properties of the DiaNode instance to a JSON file.
  *
  * The function serializes all data in compartments except text boxes, which will be updated from the UmlElement instance
- * associated with this node.
+ * associated with this node. Reading does not fill the compartments; call update() afterwards, as
+ * UmlDiagram::connectShapes() does for all nodes at once.
  *
  * @param json JSON object to be serialized to.
  * @param read True if reading, otherwise writing.
@@ -184,7 +199,6 @@ void DiaNode::serialize(QJsonObject& json, bool read, int version)
                comp->setName(obj[KPropName].toString());
                comp->isHidden(obj[KPropHidden].toBool(false));
                comp->setFlags(obj[KPropFlags].toString("0").toULongLong(&ok, 16));
-               provider->update(index, comp);
             }
          }
       }
@@ -45,7 +45,7 @@ public: // Constructors
 
 public: // Properties
    UmlElement* element() const;
-   void setElement(UmlElement* value);
+   void setElement(UmlElement* value, bool fill = true);
 
    QSizeF size();
    void setSize(const QSizeF& value);
@@ -56,6 +56,7 @@ public: // Properties
 public: // Methods
    void clear();
    void serialize(QJsonObject& json, bool read, int version) override;
+   void measure(MemoryUsage& usage) const override;
 
 private: // Attributes
    ///@cond
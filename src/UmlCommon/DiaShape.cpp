@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "DiaShape.h"
+#include "MemoryUsage.h"
 #include "DiaEdge.h"
 #include "PropertyStrings.h"
 #include "IShapeObserver.h"
@@ -115,7 +116,9 @@ QString DiaShape::fontFamily() const
  */
 void DiaShape::setFontFamily(const QString& value)
 {
+   if (data->fontFamily == value) return;
    data->fontFamily = value;
+   informStyleChanged();
 }
 
 /** Gets the font size. */
@@ -132,7 +135,9 @@ int DiaShape::fontSize() const
  */
 void DiaShape::setFontSize(int value)
 {
+   if (data->fontSize == value) return;
    data->fontSize = value;
+   informStyleChanged();
 }
 
 /** Gets the pen width in pixels. */
@@ -144,7 +149,9 @@ double DiaShape::penWidth() const
 /** Sets the pen width in pixels. */
 void DiaShape::setPenWidth(double value) const
 {
+   if (data->penWidth == value) return;
    data->penWidth = value;
+   informStyleChanged();
 }
 
 /** Gets the background or fill color. */
@@ -162,7 +169,9 @@ uint DiaShape::fillColor() const
  */
 void DiaShape::setFillColor(uint value)
 {
+   if (data->fillColor == value) return;
    data->fillColor = value;
+   informStyleChanged();
 }
 
 /** Gets the line color. */
@@ -180,7 +189,9 @@ uint DiaShape::lineColor() const
  */
 void DiaShape::setLineColor(uint value)
 {
+   if (data->lineColor == value) return;
    data->lineColor = value;
+   informStyleChanged();
 }
 
 /** Gets the text color. */
@@ -197,7 +208,9 @@ uint DiaShape::textColor() const
  */
 void DiaShape::setTextColor(uint value)
 {
+   if (data->textColor == value) return;
    data->textColor = value;
+   informStyleChanged();
 }
 
 /** Gets associated item data. */
@@ -268,6 +281,19 @@ void DiaShape::unsubscribe(IShapeObserver* observer)
    }
 }
 
+/**
+ * Adds the estimated memory used by the shape to a MemoryUsage object.
+ *
+ * Derived classes override this function to add the memory of their own Data struct.
+ * @param usage MemoryUsage object to be added to.
+ */
+void DiaShape::measure(MemoryUsage& usage) const
+{
+   usage.diagrams += sizeof(DiaShape) + sizeof(Data) + MemoryUsage::sizeOf(data->fontFamily) +
+      MemoryUsage::sizeOf(data->edges);
+   usage.observers += MemoryUsage::sizeOf(data->observer);
+}
+
 /**
  * Serializes properties of the DiaShape object to a JSON file.
  *
@@ -324,3 +350,12 @@ void DiaShape::informObserver()
       obs->aboutToDestroy();
    }
 }
+
+/** Informs all observers about a changed style property. */
+void DiaShape::informStyleChanged() const
+{
+   for (IShapeObserver* obs : data->observer)
+   {
+      obs->styleChanged();
+   }
+}
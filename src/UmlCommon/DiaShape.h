@@ -35,6 +35,7 @@
 
 class DiaEdge;
 class IShapeObserver;
+struct MemoryUsage;
 
 class UMLCOMMON_EXPORT DiaShape : public ISerializable
 {
@@ -77,9 +78,11 @@ public: // Methods
    void unsubscribe(IShapeObserver* observer);
 
    void serialize(QJsonObject& json, bool read, int version) override;
+   virtual void measure(MemoryUsage& usage) const;
 
 private:
    void informObserver();
+   void informStyleChanged() const;
 
 private: // Attributes
    /// @cond
@@ -36,5 +36,6 @@
 enum class EventType
 {
    Undefined = 0,  /**< Undefined event */
-   ObjectReleased  /**< Object was released from the project */
+   ObjectReleased, /**< Object was released from the project */
+   ObjectChanged   /**< Object was read again from its file, see UmlProject::reload() */
 };
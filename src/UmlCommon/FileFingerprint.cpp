@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------------------------------------------------
+// FileFingerprint.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of struct FileFingerprint.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "FileFingerprint.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+
+/**
+ * @struct FileFingerprint
+ * @brief The FileFingerprint struct identifies the content of a file read or written by a project.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * UmlProject keeps a fingerprint of each element file and diagram file it reads or writes, so that UmlProject::reload()
+ * can find the files changed outside of the program, e.g. by a pull of a version control system. Comparing size and
+ * time of the last modification is cheap, since both are known from listing the folder. Only files for which one of
+ * them differs are read and compared by the hash of their content (see isChanged()), which skips files touched but
+ * not changed.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Struct implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the FileFingerprint struct, which is not valid until taken from a file. */
+FileFingerprint::FileFingerprint()
+: size(-1)
+, modified(0)
+{
+}
+
+/** Returns true if the fingerprint was taken from a file; otherwise false. */
+bool FileFingerprint::isValid() const
+{
+   return size >= 0;
+}
+
+/**
+ * Returns true if size or time of the last modification of a file differ from the fingerprint; otherwise false.
+ * The content of the file may be unchanged even then.
+ */
+bool FileFingerprint::isStale(const QFileInfo& info) const
+{
+   return !isValid() || info.size() != size || info.lastModified().toMSecsSinceEpoch() != modified;
+}
+
+/**
+ * Returns true if the content of a file differs from the fingerprint; otherwise false.
+ *
+ * @param content Content of the file, read only if isStale() returned true.
+ */
+bool FileFingerprint::isChanged(const QByteArray& content) const
+{
+   return !isValid() || content.size() != size || hashOf(content) != hash;
+}
+
+/**
+ * Takes the fingerprint of a file.
+ *
+ * @param info Information about the file. Must be up to date, i.e. refreshed after writing the file.
+ * @param content Content of the file as read or written.
+ */
+FileFingerprint FileFingerprint::of(const QFileInfo& info, const QByteArray& content)
+{
+   FileFingerprint result;
+   result.size = content.size();
+   result.modified = info.lastModified().toMSecsSinceEpoch();
+   result.hash = hashOf(content);
+   return result;
+}
+
+/**
+ * Takes the fingerprint of a file read in chunks.
+ *
+ * @param info Information about the file.
+ * @param hash MD5 hash all chunks of the file were added to.
+ */
+FileFingerprint FileFingerprint::of(const QFileInfo& info, const QCryptographicHash& hash)
+{
+   FileFingerprint result;
+   result.size = info.size();
+   result.modified = info.lastModified().toMSecsSinceEpoch();
+   result.hash = hash.result();
+   return result;
+}
+
+/** Gets the hash of the content of a file. */
+QByteArray FileFingerprint::hashOf(const QByteArray& content)
+{
+   return QCryptographicHash::hash(content, QCryptographicHash::Md5);
+}
+
+/** Gets the hash of the content of a file read in chunks, or an empty array if the file cannot be read. */
+QByteArray FileFingerprint::hashOfFile(const QString& filename)
+{
+   QFile file(filename);
+   if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+   hash.addData(&file);
+   return hash.result();
+}
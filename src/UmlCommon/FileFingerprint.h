@@ -0,0 +1,56 @@
+//---------------------------------------------------------------------------------------------------------------------
+// FileFingerprint.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of struct FileFingerprint.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QByteArray>
+#include <QFileInfo>
+
+class QCryptographicHash;
+
+struct UMLCOMMON_EXPORT FileFingerprint
+{
+public: // Constructors
+   FileFingerprint();
+
+public: // Attributes
+   qint64     size;     ///< Size of the file in bytes, -1 if unknown.
+   qint64     modified; ///< Time of the last modification in milliseconds since the epoch.
+   QByteArray hash;     ///< MD5 hash of the content of the file.
+
+public: // Methods
+   bool isValid() const;
+   bool isStale(const QFileInfo& info) const;
+   bool isChanged(const QByteArray& content) const;
+
+   static FileFingerprint of(const QFileInfo& info, const QByteArray& content);
+   static FileFingerprint of(const QFileInfo& info, const QCryptographicHash& hash);
+   static QByteArray hashOf(const QByteArray& content);
+   static QByteArray hashOfFile(const QString& filename);
+};
@@ -29,7 +29,7 @@
 
 /**
  * @class IShapeObserver
- * @brief Provides an interface for observing the lifetime of a DiaShape instance.
+ * @brief Provides an interface for observing the lifetime and the style of a DiaShape instance.
  * @since 0.1.0
  * @ingroup UmlCommon
  */
@@ -40,4 +40,7 @@ public:
 
 public:
    virtual void aboutToDestroy() = 0;
+
+   /** Called if a style property (colors, font, pen width) of the DiaShape instance was changed. */
+   virtual void styleChanged() {}
 };
@@ -0,0 +1,529 @@
+//---------------------------------------------------------------------------------------------------------------------
+// JsonReader.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class JsonReader.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "JsonReader.h"
+
+#include <QCryptographicHash>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QVector>
+
+/**
+ * @class JsonReader
+ * @brief The JsonReader class reads JSON token by token from a device or a byte array.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * QJsonDocument::fromJson() needs the whole text and builds the whole document before the first value can be used, so
+ * reading a file holds the text, the document and the objects created from it in memory at the same time. JsonReader
+ * is a pull parser like QXmlStreamReader: readNext() reads the device in chunks and returns one token at a time, so
+ * large files such as diagram files with thousands of shapes are read with little memory. Parts small enough to be
+ * handled as a whole, e.g. a single shape, are read into a QJsonValue by readValue(), unneeded parts are skipped by
+ * skipValue().
+ *
+ * A typical loop over an object looks like this:
+ * @code
+ * if (reader.readNext() == JsonReader::TokenType::BeginObject)
+ * {
+ *    while (reader.readNext() == JsonReader::TokenType::Name)
+ *    {
+ *       QString key = reader.text();
+ *       reader.readNext();
+ *       if (key == "nodes") readNodes(reader); else reader.skipValue();
+ *    }
+ * }
+ * @endcode
+ *
+ * Errors in the text stop the reader: readNext() returns TokenType::Invalid from then on and errorString() tells the
+ * error and its offset. Callers can stop the reader as well by raiseError(), e.g. if the structure is not the one
+ * expected.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+enum class FrameState
+{
+   First,      // Container just begun
+   AfterName,  // Key of an object was read, its value is next
+   AfterValue, // A value was read, a comma or the end of the container is next
+   AfterComma  // A comma was read, a key or a value is next
+};
+
+struct Frame
+{
+   bool       isObject;
+   FrameState state;
+};
+
+struct JsonReader::Data
+{
+   Data()
+   : device(nullptr)
+   , hash(nullptr)
+   , position(0)
+   , consumed(0)
+   , isDone(false)
+   , type(JsonReader::TokenType::NoToken)
+   , number(0.0)
+   , boolean(false)
+   {}
+
+   QIODevice*          device;
+   QCryptographicHash* hash;
+   QByteArray          buffer;          // Chunk read last from the device or whole content
+   int                 position;        // Position of the next character in the buffer
+   qint64              consumed;        // Number of characters of the chunks before the buffer
+   QVector<Frame>      frames;          // Objects and arrays begun but not yet ended
+   bool                isDone;          // The value at the top level was read completely
+   JsonReader::TokenType type;
+   QString             text;
+   double              number;
+   bool                boolean;
+   QString             errorString;
+};
+/// @endcond
+
+const int KChunkSize = 64 * 1024;
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Returns true if a character may be part of a number; the number is validated as a whole afterwards. */
+static bool isNumberChar(int ch)
+{
+   return (ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E';
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the JsonReader class reading from a device.
+ * @param device Device opened for reading.
+ */
+JsonReader::JsonReader(QIODevice* device)
+: data(new Data())
+{
+   data->device = device;
+}
+
+/**
+ * Initializes a new object of the JsonReader class reading from a byte array.
+ * @param content JSON text to be read.
+ */
+JsonReader::JsonReader(const QByteArray& content)
+: data(new Data())
+{
+   data->buffer = content;
+}
+
+/** Destroys the JsonReader object. */
+JsonReader::~JsonReader()
+{
+   delete data;
+}
+
+/** Gets the type of the token read last. */
+JsonReader::TokenType JsonReader::tokenType() const
+{
+   return data->type;
+}
+
+/** Gets the text of the token read last if it is a key or a string; otherwise an empty string. */
+QString JsonReader::text() const
+{
+   return data->text;
+}
+
+/** Gets the value of the token read last if it is a number; otherwise 0. */
+double JsonReader::number() const
+{
+   return data->number;
+}
+
+/** Gets the value of the token read last if it is a boolean; otherwise false. */
+bool JsonReader::boolean() const
+{
+   return data->boolean;
+}
+
+/** Gets the number of characters read so far. */
+qint64 JsonReader::offset() const
+{
+   return data->consumed + data->position;
+}
+
+/** Returns true if the document was read completely or an error occurred; otherwise false. */
+bool JsonReader::atEnd() const
+{
+   return data->type == TokenType::EndDocument || data->type == TokenType::Invalid;
+}
+
+/** Returns true if an error occurred; otherwise false. */
+bool JsonReader::hasError() const
+{
+   return data->type == TokenType::Invalid;
+}
+
+/** Gets a description of the error occurred, including its offset. */
+QString JsonReader::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Sets a hash receiving every chunk read from the device, so the content of a file can be fingerprinted while it is
+ * read. The hash must exist as long as the reader.
+ */
+void JsonReader::setHash(QCryptographicHash* hash)
+{
+   data->hash = hash;
+   if (hash != nullptr && data->device == nullptr) hash->addData(data->buffer);
+}
+
+/**
+ * Reads the next token.
+ * @returns The type of the token read, see also tokenType().
+ */
+JsonReader::TokenType JsonReader::readNext()
+{
+   if (atEnd()) return data->type;
+
+   skipWhitespace();
+   if (data->frames.isEmpty())
+   {
+      if (!data->isDone) return readScalar();
+      if (peek() >= 0) raiseError("Garbage at the end of the document");
+      else setToken(TokenType::EndDocument);
+      return data->type;
+   }
+
+   auto& frame = data->frames.last();
+   int ch = peek();
+   bool isClosing = ch == (frame.isObject ? '}' : ']');
+   if (isClosing && (frame.state == FrameState::First || frame.state == FrameState::AfterValue))
+   {
+      get();
+      setToken(frame.isObject ? TokenType::EndObject : TokenType::EndArray);
+      data->frames.removeLast();
+      if (data->frames.isEmpty()) data->isDone = true;
+      return data->type;
+   }
+
+   if (frame.state == FrameState::AfterValue)
+   {
+      if (ch != ',')
+      {
+         raiseError(frame.isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+         return data->type;
+      }
+
+      get();
+      skipWhitespace();
+      frame.state = FrameState::AfterComma;
+   }
+
+   if (frame.isObject && frame.state != FrameState::AfterName)
+   {
+      QString key;
+      if (peek() != '"' || !readString(key))
+      {
+         if (!hasError()) raiseError("Expected a key");
+         return data->type;
+      }
+
+      skipWhitespace();
+      if (get() != ':')
+      {
+         raiseError("Expected ':'");
+         return data->type;
+      }
+
+      frame.state = FrameState::AfterName;
+      setToken(TokenType::Name);
+      data->text = key;
+      return data->type;
+   }
+
+   frame.state = FrameState::AfterValue;
+   return readScalar();
+}
+
+/**
+ * Reads the value beginning with the token read last as a whole.
+ *
+ * After returning, the token read last is the last token of the value, i.e. the end of an object or array.
+ * @returns The value read, or an undefined value if an error occurred.
+ */
+QJsonValue JsonReader::readValue()
+{
+   switch (data->type)
+   {
+   case TokenType::BeginObject:
+   {
+      QJsonObject object;
+      while (readNext() == TokenType::Name)
+      {
+         QString key = data->text;
+         readNext();
+         object.insert(key, readValue());
+      }
+
+      if (data->type != TokenType::EndObject) return QJsonValue(QJsonValue::Undefined);
+      return object;
+   }
+   case TokenType::BeginArray:
+   {
+      QJsonArray array;
+      for (auto type = readNext(); type != TokenType::EndArray; type = readNext())
+      {
+         if (type == TokenType::Invalid) return QJsonValue(QJsonValue::Undefined);
+         array.append(readValue());
+      }
+
+      return array;
+   }
+   case TokenType::String:
+      return data->text;
+   case TokenType::Number:
+      return data->number;
+   case TokenType::Bool:
+      return data->boolean;
+   case TokenType::Null:
+      return QJsonValue();
+   default:
+      return QJsonValue(QJsonValue::Undefined);
+   }
+}
+
+/** Skips the value beginning with the token read last without building it. */
+void JsonReader::skipValue()
+{
+   int depth = 0;
+   auto type = data->type;
+   while (true)
+   {
+      if (type == TokenType::BeginObject || type == TokenType::BeginArray) ++depth;
+      if (type == TokenType::EndObject || type == TokenType::EndArray) --depth;
+      if (depth <= 0 || type == TokenType::Invalid) return;
+      type = readNext();
+   }
+}
+
+/**
+ * Stops reading because of an error. readNext() returns TokenType::Invalid from then on.
+ * @param message Description of the error, the offset is appended.
+ */
+void JsonReader::raiseError(QString message)
+{
+   if (hasError()) return;
+   data->errorString = QString("%1 at offset %2").arg(message).arg(offset());
+   setToken(TokenType::Invalid);
+}
+
+/** Gets the next character without reading it, or -1 at the end of the text. */
+int JsonReader::peek()
+{
+   if (data->position >= data->buffer.size() && !fill()) return -1;
+   return static_cast<unsigned char>(data->buffer.at(data->position));
+}
+
+/** Reads the next character, or -1 at the end of the text. */
+int JsonReader::get()
+{
+   int ch = peek();
+   if (ch >= 0) ++data->position;
+   return ch;
+}
+
+/** Reads the next chunk from the device. Returns false at the end of the device. */
+bool JsonReader::fill()
+{
+   if (data->device == nullptr) return false;
+
+   data->consumed += data->buffer.size();
+   data->buffer = data->device->read(KChunkSize);
+   data->position = 0;
+   if (data->hash != nullptr) data->hash->addData(data->buffer);
+   return !data->buffer.isEmpty();
+}
+
+void JsonReader::skipWhitespace()
+{
+   for (int ch = peek(); ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r'; ch = peek()) get();
+}
+
+/** Reads a value or the begin of an object or array. */
+JsonReader::TokenType JsonReader::readScalar()
+{
+   int ch = peek();
+   if (data->frames.isEmpty() && ch != '{' && ch != '[') data->isDone = true;
+
+   switch (ch)
+   {
+   case '{':
+   case '[':
+      get();
+      data->frames.append(Frame{ ch == '{', FrameState::First });
+      setToken(ch == '{' ? TokenType::BeginObject : TokenType::BeginArray);
+      return data->type;
+   case '"':
+   {
+      QString text;
+      if (readString(text))
+      {
+         setToken(TokenType::String);
+         data->text = text;
+      }
+      return data->type;
+   }
+   case 't':
+   case 'f':
+   case 'n':
+   {
+      QByteArray word;
+      while (peek() >= 'a' && peek() <= 'z') word.append(static_cast<char>(get()));
+      if (word == "true" || word == "false")
+      {
+         setToken(TokenType::Bool);
+         data->boolean = word == "true";
+      }
+      else if (word == "null")
+      {
+         setToken(TokenType::Null);
+      }
+      else
+      {
+         raiseError(QString("Unknown literal '%1'").arg(QString::fromLatin1(word)));
+      }
+      return data->type;
+   }
+   default:
+      break;
+   }
+
+   QByteArray digits;
+   for (ch = peek(); isNumberChar(ch); ch = peek()) digits.append(static_cast<char>(get()));
+
+   bool ok = false;
+   double value = digits.toDouble(&ok);
+   if (digits.isEmpty() || !ok)
+   {
+      raiseError(ch < 0 ? "Unexpected end of the document" : "Expected a value");
+      return data->type;
+   }
+
+   setToken(TokenType::Number);
+   data->number = value;
+   return data->type;
+}
+
+/** Reads a string including its quotes and resolves its escape sequences. */
+bool JsonReader::readString(QString& result)
+{
+   get(); // Opening quote
+
+   QByteArray bytes;
+   QString    escaped; // UTF-16 code units of \u escapes not yet converted to UTF-8
+   while (true)
+   {
+      int ch = get();
+      if (ch != '\\' && !escaped.isEmpty())
+      {
+         bytes.append(escaped.toUtf8());
+         escaped.clear();
+      }
+
+      if (ch == '"') break;
+      if (ch < 0x20)
+      {
+         raiseError(ch < 0 ? "Unterminated string" : "Control character in string");
+         return false;
+      }
+
+      if (ch != '\\')
+      {
+         bytes.append(static_cast<char>(ch));
+         continue;
+      }
+
+      ch = get();
+      if (ch != 'u' && !escaped.isEmpty())
+      {
+         bytes.append(escaped.toUtf8());
+         escaped.clear();
+      }
+
+      switch (ch)
+      {
+      case '"':  bytes.append('"'); break;
+      case '\\': bytes.append('\\'); break;
+      case '/':  bytes.append('/'); break;
+      case 'b':  bytes.append('\b'); break;
+      case 'f':  bytes.append('\f'); break;
+      case 'n':  bytes.append('\n'); break;
+      case 'r':  bytes.append('\r'); break;
+      case 't':  bytes.append('\t'); break;
+      case 'u':
+      {
+         QByteArray hex;
+         for (int index = 0; index < 4; ++index) hex.append(static_cast<char>(get()));
+
+         bool ok = false;
+         ushort code = hex.toUShort(&ok, 16);
+         if (!ok)
+         {
+            raiseError("Invalid escape sequence");
+            return false;
+         }
+
+         // Surrogate pairs are written as two escapes, both are needed to convert them:
+         escaped.append(QChar(code));
+         break;
+      }
+      default:
+         raiseError("Invalid escape sequence");
+         return false;
+      }
+   }
+
+   result = QString::fromUtf8(bytes);
+   return true;
+}
+
+void JsonReader::setToken(TokenType type)
+{
+   data->type = type;
+   data->text.clear();
+   data->number = 0.0;
+   data->boolean = false;
+}
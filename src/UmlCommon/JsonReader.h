@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------------------------------------------------
+// JsonReader.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class JsonReader.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QByteArray>
+#include <QJsonValue>
+#include <QString>
+
+class QCryptographicHash;
+class QIODevice;
+
+class UMLCOMMON_EXPORT JsonReader final
+{
+public: // Types
+   enum class TokenType
+   {
+      NoToken,     ///< No token was read yet.
+      Invalid,     ///< An error occurred, see errorString().
+      BeginObject, ///< Begin of an object.
+      EndObject,   ///< End of an object.
+      BeginArray,  ///< Begin of an array.
+      EndArray,    ///< End of an array.
+      Name,        ///< Key of the next value of an object, see text().
+      String,      ///< String value, see text().
+      Number,      ///< Number value, see number().
+      Bool,        ///< Boolean value, see boolean().
+      Null,        ///< Null value.
+      EndDocument  ///< The document was read completely.
+   };
+
+public: // Constructors
+   JsonReader(QIODevice* device);
+   JsonReader(const QByteArray& content);
+   JsonReader(JsonReader const&) = delete;
+   void operator=(JsonReader const&) = delete;
+   ~JsonReader();
+
+public: // Properties
+   TokenType tokenType() const;
+   QString text() const;
+   double number() const;
+   bool boolean() const;
+   qint64 offset() const;
+
+   bool atEnd() const;
+   bool hasError() const;
+   QString errorString() const;
+
+   void setHash(QCryptographicHash* hash);
+
+public: // Methods
+   TokenType readNext();
+   QJsonValue readValue();
+   void skipValue();
+   void raiseError(QString message);
+
+private:
+   int peek();
+   int get();
+   bool fill();
+   void skipWhitespace();
+   TokenType readScalar();
+   bool readString(QString& result);
+   void setToken(TokenType type);
+
+private: // Attributes
+   /// @cond
+   struct Data;
+   Data* data;
+   /// @endcond
+};
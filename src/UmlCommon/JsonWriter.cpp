@@ -0,0 +1,336 @@
+//---------------------------------------------------------------------------------------------------------------------
+// JsonWriter.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class JsonWriter.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "JsonWriter.h"
+
+#include <QIODevice>
+#include <QLocale>
+#include <QVector>
+
+#include <cmath>
+
+/**
+ * @class JsonWriter
+ * @brief The JsonWriter class writes JSON in a canonical form straight to a device or buffer.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * The files of a project are kept in version control systems, so the same content must always be written as the same
+ * bytes. JsonWriter writes compact JSON without any whitespace. The keys of objects are written in ascending order,
+ * numbers without fraction are written as integers, all other numbers in their shortest form that reads back to the
+ * same value.
+ *
+ * Objects and arrays are either written value by value without building a QJsonDocument (see beginObject(), name()
+ * and value()), in which case the caller must write the keys of an object in ascending order, or converted as a whole
+ * by toCanonical(). Writes to a device are buffered; call flush() or destroy the writer to write the rest.
+ */
+
+const int KFlushSize = 64 * 1024;
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+struct JsonWriter::Data
+{
+   Data()
+   : device(nullptr)
+   , buffer(nullptr)
+   , hasError(false)
+   , hasName(false)
+   {}
+
+   QIODevice*       device;
+   QByteArray*      buffer;
+   QByteArray       pending;  // Text not yet written to the device
+   QVector<bool>    firsts;   // Per open object or array: true until its first value is written
+   QVector<QString> keys;     // Per open object: the key written last
+   bool             hasError;
+   bool             hasName;  // A key was written, its value is next
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the JsonWriter class writing to a device.
+ * @param device Device opened for writing.
+ */
+JsonWriter::JsonWriter(QIODevice* device)
+: data(new Data())
+{
+   data->device = device;
+   data->pending.reserve(KFlushSize);
+}
+
+/**
+ * Initializes a new object of the JsonWriter class appending to a byte array.
+ * @param buffer Byte array to receive the JSON text.
+ */
+JsonWriter::JsonWriter(QByteArray* buffer)
+: data(new Data())
+{
+   data->buffer = buffer;
+}
+
+/** Writes the rest of the buffered text and destroys the JsonWriter object. */
+JsonWriter::~JsonWriter()
+{
+   flush();
+   delete data;
+}
+
+/** Returns true if writing to the device failed; otherwise false. */
+bool JsonWriter::hasError() const
+{
+   return data->hasError;
+}
+
+/** Begins an object. Its keys must be written in ascending order. */
+void JsonWriter::beginObject()
+{
+   separate();
+   append("{");
+   data->firsts.append(true);
+   data->keys.append(QString());
+}
+
+/** Ends the object begun last. */
+void JsonWriter::endObject()
+{
+   Q_ASSERT(!data->keys.isEmpty() && !data->hasName);
+   data->firsts.removeLast();
+   data->keys.removeLast();
+   append("}");
+}
+
+/** Begins an array. */
+void JsonWriter::beginArray()
+{
+   separate();
+   append("[");
+   data->firsts.append(true);
+   data->keys.append(QString());
+}
+
+/** Ends the array begun last. */
+void JsonWriter::endArray()
+{
+   Q_ASSERT(!data->keys.isEmpty() && !data->hasName);
+   data->firsts.removeLast();
+   data->keys.removeLast();
+   append("]");
+}
+
+/**
+ * Writes the key of the next value of an object.
+ * @param key Key to be written, must be greater than the key written before in the same object.
+ */
+void JsonWriter::name(const QString& key)
+{
+   Q_ASSERT(!data->keys.isEmpty() && !data->hasName);
+   Q_ASSERT(data->firsts.last() || data->keys.last() < key);
+   separate();
+   appendString(key);
+   append(":");
+   data->keys.last() = key;
+   data->hasName = true;
+}
+
+/** Writes a string value. */
+void JsonWriter::value(const QString& text)
+{
+   separate();
+   appendString(text);
+}
+
+/** Writes a number value in its canonical form, see number(). */
+void JsonWriter::value(double number)
+{
+   separate();
+   append(JsonWriter::number(number));
+}
+
+/**
+ * Writes a value of any type. Objects are written with their keys in ascending order, which is the order QJsonObject
+ * keeps them in.
+ */
+void JsonWriter::value(const QJsonValue& json)
+{
+   switch (json.type())
+   {
+   case QJsonValue::Bool:
+      separate();
+      append(json.toBool() ? "true" : "false");
+      break;
+   case QJsonValue::Double:
+      value(json.toDouble());
+      break;
+   case QJsonValue::String:
+      value(json.toString());
+      break;
+   case QJsonValue::Array:
+   {
+      beginArray();
+      auto array = json.toArray();
+      for (auto item : array) value(item);
+      endArray();
+      break;
+   }
+   case QJsonValue::Object:
+   {
+      beginObject();
+      auto object = json.toObject();
+      for (auto iter = object.constBegin(); iter != object.constEnd(); ++iter) write(iter.key(), iter.value());
+      endObject();
+      break;
+   }
+   default:
+      separate();
+      append("null");
+      break;
+   }
+}
+
+/** Writes a key and its value. */
+void JsonWriter::write(const QString& key, const QJsonValue& json)
+{
+   name(key);
+   value(json);
+}
+
+/**
+ * Writes the buffered text to the device.
+ * @returns true if successful, false if an error occurred.
+ */
+bool JsonWriter::flush()
+{
+   if (data->device != nullptr && !data->pending.isEmpty())
+   {
+      if (data->device->write(data->pending) != data->pending.size()) data->hasError = true;
+      data->pending.resize(0);
+   }
+
+   return !data->hasError;
+}
+
+/**
+ * Converts a QJsonObject object to canonical JSON text.
+ * @param object Object to be converted.
+ * @returns Compact JSON text with sorted keys and normalized numbers.
+ */
+QByteArray JsonWriter::toCanonical(const QJsonObject& object)
+{
+   QByteArray result;
+   JsonWriter writer(&result);
+   writer.value(object);
+   return result;
+}
+
+/**
+ * Converts a number to its canonical JSON text.
+ *
+ * Numbers without fraction up to 2^53 are written as integers, so that e.g. 1.0 and 1 are the same text. Negative zero
+ * is written as 0. Numbers which are not finite cannot be represented in JSON and are written as null.
+ */
+QByteArray JsonWriter::number(double value)
+{
+   if (!std::isfinite(value)) return "null";
+   if (value == std::floor(value) && std::fabs(value) <= 9007199254740992.0)
+   {
+      return QByteArray::number(static_cast<qint64>(value));
+   }
+
+   return QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+}
+
+/** Writes the comma separating a value from the one before, unless a key was written before. */
+void JsonWriter::separate()
+{
+   if (data->hasName)
+   {
+      data->hasName = false;
+      return;
+   }
+
+   if (data->firsts.isEmpty()) return;
+   if (!data->firsts.last()) append(",");
+   data->firsts.last() = false;
+}
+
+void JsonWriter::append(const QByteArray& bytes)
+{
+   if (data->buffer != nullptr)
+   {
+      data->buffer->append(bytes);
+      return;
+   }
+
+   data->pending.append(bytes);
+   if (data->pending.size() >= KFlushSize) flush();
+}
+
+/** Writes a string quoted, escaping quotes, backslashes and control characters only. */
+void JsonWriter::appendString(const QString& text)
+{
+   static const char KHexDigits[] = "0123456789abcdef";
+
+   QByteArray bytes;
+   bytes.reserve(text.size() + 2);
+   bytes.append('"');
+   for (auto ch : text.toUtf8())
+   {
+      auto code = static_cast<unsigned char>(ch);
+      switch (code)
+      {
+      case '"':  bytes.append("\\\""); break;
+      case '\\': bytes.append("\\\\"); break;
+      case '\b': bytes.append("\\b"); break;
+      case '\f': bytes.append("\\f"); break;
+      case '\n': bytes.append("\\n"); break;
+      case '\r': bytes.append("\\r"); break;
+      case '\t': bytes.append("\\t"); break;
+      default:
+         if (code < 0x20)
+         {
+            bytes.append("\\u00");
+            bytes.append(KHexDigits[code >> 4]);
+            bytes.append(KHexDigits[code & 0x0F]);
+         }
+         else
+         {
+            bytes.append(ch);
+         }
+         break;
+      }
+   }
+
+   bytes.append('"');
+   append(bytes);
+}
@@ -0,0 +1,77 @@
+//---------------------------------------------------------------------------------------------------------------------
+// JsonWriter.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class JsonWriter.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+class QIODevice;
+
+class UMLCOMMON_EXPORT JsonWriter final
+{
+public: // Constructors
+   JsonWriter(QIODevice* device);
+   JsonWriter(QByteArray* buffer);
+   JsonWriter(JsonWriter const&) = delete;
+   void operator=(JsonWriter const&) = delete;
+   ~JsonWriter();
+
+public: // Properties
+   bool hasError() const;
+
+public: // Methods
+   void beginObject();
+   void endObject();
+   void beginArray();
+   void endArray();
+   void name(const QString& key);
+   void value(const QString& text);
+   void value(double number);
+   void value(const QJsonValue& json);
+   void write(const QString& key, const QJsonValue& json);
+   bool flush();
+
+   static QByteArray toCanonical(const QJsonObject& object);
+   static QByteArray number(double value);
+
+private:
+   void separate();
+   void append(const QByteArray& bytes);
+   void appendString(const QString& text);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "Label.h"
+#include "MemoryUsage.h"
 
 /**
  * @class Label
@@ -74,3 +75,10 @@ void Label::setPosition(QPointF value)
 {
    data->position = value;
 }
+
+/** Adds the estimated memory used by the label to a MemoryUsage object, see TextBox::measure(). */
+void Label::measure(MemoryUsage& usage) const
+{
+   TextBox::measure(usage);
+   usage.diagrams += sizeof(Data) + sizeof(data);
+}
@@ -42,6 +42,9 @@ public: // Properties
    QPointF position() const;
    void setPosition(QPointF value);
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 private: // Attributes
    ///@cond
    struct Data;
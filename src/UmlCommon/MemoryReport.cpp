@@ -0,0 +1,247 @@
+//---------------------------------------------------------------------------------------------------------------------
+// MemoryReport.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class MemoryReport.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "MemoryReport.h"
+#include "UmlElement.h"
+#include "UmlProject.h"
+
+#include <QHash>
+#include <QJsonArray>
+#include <QStringList>
+
+#include <algorithm>
+
+/**
+ * @class MemoryReport
+ * @brief The MemoryReport class collects the memory used by a project class by class.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * A MemoryReport object sums up the estimated memory (see MemoryUsage) of the elements of a project per class name,
+ * so the classes using most of the memory of large projects can be identified. Objects outside of the data model, 
+ * e.g. the scenes of open diagrams or the commands of an undo stack, are added as separate categories by function
+ * add(). The report can be written as a table of plain text or as a JSON object:
+ * ~~~{.c}
+ * MemoryReport report;
+ * report.addProject(project);
+ * std::cout << report.toText(10).toStdString();
+ * ~~~
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+struct MemoryReport::Data
+{
+   QHash<QString, Entry> entries;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+static QJsonObject toJson(const MemoryUsage& usage)
+{
+   QJsonObject result;
+   result.insert("total", usage.total());
+   result.insert("objects", usage.objects);
+   result.insert("strings", usage.strings);
+   result.insert("containers", usage.containers);
+   result.insert("observers", usage.observers);
+   result.insert("diagrams", usage.diagrams);
+   result.insert("graphics", usage.graphics);
+   result.insert("undo", usage.undo);
+   return result;
+}
+
+static QString toRow(QString name, QString count, QStringList values)
+{
+   QString result = name.leftJustified(22, ' ', true) + count.rightJustified(9);
+   for (auto& value : values)
+   {
+      result += value.rightJustified(11);
+   }
+
+   return result;
+}
+
+static QStringList toColumns(const MemoryUsage& usage)
+{
+   return QStringList() 
+      << MemoryReport::formatBytes(usage.total()) << MemoryReport::formatBytes(usage.objects)
+      << MemoryReport::formatBytes(usage.strings) << MemoryReport::formatBytes(usage.containers)
+      << MemoryReport::formatBytes(usage.observers) << MemoryReport::formatBytes(usage.diagrams)
+      << MemoryReport::formatBytes(usage.graphics) << MemoryReport::formatBytes(usage.undo);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new empty MemoryReport object. */
+MemoryReport::MemoryReport()
+: data(new Data)
+{
+}
+
+/** Disposes the MemoryReport object. */
+MemoryReport::~MemoryReport()
+{
+   delete data;
+}
+
+/** Gets the entries of the report ordered by their total memory, biggest first. */
+QList<MemoryReport::Entry> MemoryReport::entries() const
+{
+   auto result = data->entries.values();
+   std::stable_sort(result.begin(), result.end(), [](const Entry& left, const Entry& right)
+   {
+      if (left.usage.total() != right.usage.total()) return left.usage.total() > right.usage.total();
+      return left.name < right.name;
+   });
+
+   return result;
+}
+
+/** Gets the number of objects of all entries. */
+qint64 MemoryReport::count() const
+{
+   qint64 result = 0;
+   for (auto& entry : data->entries)
+   {
+      result += entry.count;
+   }
+
+   return result;
+}
+
+/** Gets the memory used by all entries. */
+MemoryUsage MemoryReport::total() const
+{
+   MemoryUsage result;
+   for (auto& entry : data->entries)
+   {
+      result += entry.usage;
+   }
+
+   return result;
+}
+
+/**
+ * Adds objects to the entry with the given name. The entry is created if it does not exist yet.
+ *
+ * @param name Class name of the objects or name of the category, e.g. "DiagramScene".
+ * @param count Number of objects added.
+ * @param usage Memory used by the objects.
+ */
+void MemoryReport::add(QString name, qint64 count, const MemoryUsage& usage)
+{
+   auto& entry = data->entries[name];
+   entry.name = name;
+   entry.count += count;
+   entry.usage += usage;
+}
+
+/**
+ * Adds the elements of a project class by class, as well as the bookkeeping of the project itself.
+ *
+ * The shapes of diagrams are part of their UmlDiagram entry. They exist only while the diagram is open.
+ * @param project UmlProject object to be measured.
+ */
+void MemoryReport::addProject(UmlProject* project)
+{
+   if (project == nullptr) return;
+
+   for (auto elem : project->elements())
+   {
+      MemoryUsage usage;
+      elem->measure(usage);
+      add(elem->className(), 1, usage);
+   }
+
+   MemoryUsage usage;
+   project->measure(usage);
+   add("UmlProject", 1, usage);
+}
+
+/** Removes all entries from the report. */
+void MemoryReport::clear()
+{
+   data->entries.clear();
+}
+
+/** Converts the report into a JSON object with one object per entry, biggest first, and the totals. */
+QJsonObject MemoryReport::toJson() const
+{
+   QJsonArray array;
+   for (auto& entry : entries())
+   {
+      auto object = ::toJson(entry.usage);
+      object.insert("name", entry.name);
+      object.insert("count", entry.count);
+      array.append(object);
+   }
+
+   QJsonObject result;
+   result.insert("count", count());
+   result.insert("total", ::toJson(total()));
+   result.insert("entries", array);
+   return result;
+}
+
+/**
+ * Converts the report into a table of plain text with one row per entry, biggest first, and a row of totals.
+ *
+ * @param limit Maximum number of entries listed, or 0 to list all entries. The totals always include all entries.
+ */
+QString MemoryReport::toText(int limit) const
+{
+   QStringList lines;
+   lines << toRow("Class", "Count", QStringList() << "Total" << "Objects" << "Strings" << "Containers" << "Observers" 
+                                                  << "Diagrams" << "Graphics" << "Undo");
+
+   auto list = entries();
+   if (limit > 0 && list.size() > limit) list = list.mid(0, limit);
+   for (auto& entry : list)
+   {
+      lines << toRow(entry.name, QString::number(entry.count), toColumns(entry.usage));
+   }
+
+   lines << toRow("Total", QString::number(count()), toColumns(total()));
+   return lines.join('\n') + '\n';
+}
+
+/** Formats a number of bytes with a binary unit, e.g. "1.5 MiB". */
+QString MemoryReport::formatBytes(qint64 bytes)
+{
+   if (bytes < 1024) return QString("%1 B").arg(bytes);
+   if (bytes < 1024 * 1024) return QString("%1 KiB").arg(bytes / 1024.0, 0, 'f', 1);
+   if (bytes < 1024 * 1024 * 1024) return QString("%1 MiB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+   return QString("%1 GiB").arg(bytes / (1024.0 * 1024.0 * 1024.0), 0, 'f', 1);
+}
@@ -0,0 +1,80 @@
+//---------------------------------------------------------------------------------------------------------------------
+// MemoryReport.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class MemoryReport.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+#include "MemoryUsage.h"
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+class UmlProject;
+
+class UMLCOMMON_EXPORT MemoryReport final
+{
+public: // Types
+   /** Memory used by all objects of one class or category. */
+   struct Entry
+   {
+      Entry()
+      : count(0)
+      {}
+
+      QString     name;  ///< Class name of the objects or name of the category.
+      qint64      count; ///< Number of objects.
+      MemoryUsage usage; ///< Memory used by the objects.
+   };
+
+public: // Constructors
+   MemoryReport();
+   MemoryReport(MemoryReport const&) = delete;
+   void operator=(MemoryReport const&) = delete;
+   ~MemoryReport();
+
+public: // Properties
+   QList<Entry> entries() const;
+   qint64 count() const;
+   MemoryUsage total() const;
+
+public: // Methods
+   void add(QString name, qint64 count, const MemoryUsage& usage);
+   void addProject(UmlProject* project);
+   void clear();
+
+   QJsonObject toJson() const;
+   QString toText(int limit = 0) const;
+
+   static QString formatBytes(qint64 bytes);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
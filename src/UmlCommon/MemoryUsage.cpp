@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------------------------------------------------
+// MemoryUsage.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of struct MemoryUsage.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "MemoryUsage.h"
+
+/**
+ * @struct MemoryUsage
+ * @brief The MemoryUsage struct sums up the estimated memory used by objects of ViraquchaUML.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * Elements, shapes and commands add the memory they use to a MemoryUsage object in their measure() functions, split
+ * into categories like strings or containers, so the biggest consumers of a project can be found (see MemoryReport).
+ * The sizes are estimates based on the memory layout of Qt 5 on 64-bit platforms:
+ * - objects count the size of the object and the Data struct of each class implementing it;
+ * - strings, lists, vectors and hashes count their heap memory; implicitly shared data is counted for each owner;
+ * - overhead of the memory allocator is not counted.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Struct implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the MemoryUsage struct with all categories empty. */
+MemoryUsage::MemoryUsage()
+: objects(0)
+, strings(0)
+, containers(0)
+, observers(0)
+, diagrams(0)
+, graphics(0)
+, undo(0)
+{
+}
+
+/** Gets the sum of all categories in bytes. */
+qint64 MemoryUsage::total() const
+{
+   return objects + strings + containers + observers + diagrams + graphics + undo;
+}
+
+/** Adds the memory of another MemoryUsage object category by category. */
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other)
+{
+   objects += other.objects;
+   strings += other.strings;
+   containers += other.containers;
+   observers += other.observers;
+   diagrams += other.diagrams;
+   graphics += other.graphics;
+   undo += other.undo;
+   return *this;
+}
+
+/** Gets the heap memory used by a string; null strings and empty literals use none. */
+qint64 MemoryUsage::sizeOf(const QString& value)
+{
+   if (value.capacity() == 0) return 0;
+   return KArrayHeader + (value.capacity() + 1) * qint64(sizeof(QChar));
+}
+
+/** Gets the heap memory used by a string list including its strings. */
+qint64 MemoryUsage::sizeOf(const QStringList& value)
+{
+   qint64 result = sizeOf(static_cast<const QList<QString>&>(value));
+   for (const QString& item : value)
+   {
+      result += sizeOf(item);
+   }
+
+   return result;
+}
@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------------------------------------------------
+// MemoryUsage.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of struct MemoryUsage.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct UMLCOMMON_EXPORT MemoryUsage
+{
+public: // Constants
+   static constexpr qint64 KArrayHeader = 24; ///< Size of the header of the data shared by strings and vectors.
+   static constexpr qint64 KListHeader  = 16; ///< Size of the header of the data of QList.
+   static constexpr qint64 KHashHeader  = 48; ///< Size of the header of the data of QHash.
+
+public: // Constructors
+   MemoryUsage();
+
+public: // Attributes
+   qint64 objects;    ///< Objects and their pimpl Data structs.
+   qint64 strings;    ///< Characters of strings.
+   qint64 containers; ///< Lists, vectors and hashes, e.g. the children of composite elements and links.
+   qint64 observers;  ///< Lists of observers of elements and shapes.
+   qint64 diagrams;   ///< Nodes and edges of open diagrams including compartments, text boxes and labels.
+   qint64 graphics;   ///< Graphics items of diagram scenes and their pixmap caches.
+   qint64 undo;       ///< Commands on undo stacks including the element data they keep.
+
+public: // Methods
+   qint64 total() const;
+   MemoryUsage& operator+=(const MemoryUsage& other);
+
+   static qint64 sizeOf(const QString& value);
+   static qint64 sizeOf(const QStringList& value);
+   template<class T> static qint64 sizeOf(const QList<T>& value);
+   template<class T> static qint64 sizeOf(const QVector<T>& value);
+   template<class K, class V> static qint64 sizeOf(const QHash<K, V>& value);
+   template<class T> static qint64 sizeOf(const QSet<T>& value);
+};
+
+/**
+ * Gets the heap memory used by a QList, not including memory owned by its items. QList stores items not larger than
+ * a pointer and movable in its array; all other items are allocated one by one, e.g. IntrusivePtr objects.
+ */
+template<class T> qint64 MemoryUsage::sizeOf(const QList<T>& value)
+{
+   if (value.isEmpty()) return 0;
+
+   bool   isNode = QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic;
+   qint64 item = sizeof(void*) + (isNode ? sizeof(T) : 0);
+   return KListHeader + value.size() * item;
+}
+
+/** Gets the heap memory used by a QVector, not including memory owned by its items. */
+template<class T> qint64 MemoryUsage::sizeOf(const QVector<T>& value)
+{
+   return value.capacity() > 0 ? KArrayHeader + value.capacity() * qint64(sizeof(T)) : 0;
+}
+
+/** Gets the heap memory used by a QHash, not including memory owned by its keys and values. */
+template<class K, class V> qint64 MemoryUsage::sizeOf(const QHash<K, V>& value)
+{
+   if (value.capacity() == 0) return 0;
+   return KHashHeader + value.capacity() * qint64(sizeof(void*)) + value.size() * qint64(sizeof(QHashNode<K, V>));
+}
+
+/** Gets the heap memory used by a QSet, not including memory owned by its items. */
+template<class T> qint64 MemoryUsage::sizeOf(const QSet<T>& value)
+{
+   if (value.capacity() == 0) return 0;
+   return KHashHeader + value.capacity() * qint64(sizeof(void*)) + 
+          value.size() * qint64(sizeof(QHashNode<T, QHashDummyValue>));
+}
@@ -26,7 +26,8 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "NameBuilder.h"
-#include "INamedElement.h"
+
+#include <QSet>
 
 /**
  * @class NameBuilder
@@ -35,6 +36,8 @@
  * @ingroup UmlCommon
  *
  * The NameBuilder class creates a unique name for an INamedElement object stored in a UmlCompositeElement object.
+ * If constructed with a UmlCompositeElement object, the name index of the composite is used (see
+ * UmlCompositeElement::uniqueName()), otherwise the names passed in are stored in a hash set.
  */
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -43,8 +46,13 @@
 /// @cond
 struct NameBuilder::Data
 {
-   // A simple list should be fast enough. I do not expect any composite to have more than 10.000 elements!
-   QStringList names;
+   Data()
+   : owner(nullptr)
+   {
+   }
+
+   UmlCompositeElement* owner;
+   QSet<QString>        names;
 };
 /// @endcond
 
@@ -60,28 +68,25 @@ struct NameBuilder::Data
 NameBuilder::NameBuilder(QStringList& names)
 : data(new Data())
 {
-   data->names = names;
+   data->names.reserve(names.count());
+   for (auto name : names)
+   {
+      data->names.insert(name);
+   }
 }
 
 /**
  * Initializes a new object of the NameBuilder class with a UmlCompositeElement object.
  *
- * The constructor creates a list of named elements found in the UmlCompositeElement object provided. The list is used
- * for searching equal names when creating the new name.
+ * The name index of the UmlCompositeElement object provided is used for searching equal names when creating the new
+ * name.
  * @param owner UmlCompositeElement object containing named elements (must not be nullptr)
  */
 NameBuilder::NameBuilder(UmlCompositeElement* owner)
 : data(new Data())
 {
    Q_ASSERT(owner != nullptr);
-   for (auto elem : owner->elements())
-   {
-      auto named = dynamic_cast<INamedElement*>(elem);
-      if (named != nullptr && !data->names.contains(named->name()))
-      {
-         data->names.append(named->name());
-      }
-   }
+   data->owner = owner;
 }
 
 NameBuilder::~NameBuilder()
@@ -93,15 +98,19 @@ NameBuilder::~NameBuilder()
  * Builds a unique name for a named element.
  * 
  * The name is built by adding a postfix number to a base name (like &quot;Class1&quot;, where &quot;Class&quot; is the
- * base name). The postfix number starts at 1 and is increased by 1 until no other named element with the same name can
- * be found in the owner's list of elements.
- * Note that the named element must not be contained in the owner's list of elements, otherwise the function will never
- * return!
+ * base name). The postfix number is increased by 1 until no other named element with the same name can be found in the
+ * owner's list of elements. If the builder was constructed with a UmlCompositeElement object, the search continues
+ * where the previous search for the same base name in the composite ended; otherwise it starts at 1.
  * @param base Name base used to build the name
  * @returns A new unique name for the named element
  */
 QString NameBuilder::build(QString base)
 {
+   if (data->owner != nullptr)
+   {
+      return data->owner->uniqueName(base);
+   }
+
    int count = 1;
    QString form = QString("%1%2");
    QString name = form.arg(base).arg(count);
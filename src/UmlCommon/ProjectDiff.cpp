@@ -0,0 +1,561 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectDiff.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ProjectDiff.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ProjectDiff.h"
+#include "FileFingerprint.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "PropertyStrings.h"
+#include "Tracer.h"
+#include "UmlDiagram.h"
+#include "UmlElement.h"
+#include "UmlProject.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMap>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+
+/**
+ * @class ProjectDiff
+ * @brief The ProjectDiff class compares two versions of a project element by element.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * Comparing the JSON files of two versions of a project line by line hardly tells what changed in the model. 
+ * ProjectDiff compares the versions element by element instead and reports the elements added, removed, modified or
+ * moved to another owner, and for modified elements the properties changed.
+ *
+ * Both versions are read from their files without building UmlElement objects: the element index of the project
+ * files tells which elements exist, and the hashes of the element files - computed on all cores - tell which of them
+ * may have changed. Only those files are parsed and compared property by property, so the cost depends mostly on the
+ * number of changes. Files written with another formatting but the same content are not reported, since their
+ * properties are equal. The new version may also be a project in memory, e.g. to review the changes not yet saved.
+ *
+ * Elements do not know their owners, owners list their elements (see UmlCompositeElement). Moving an element
+ * therefore changes the files of both owners, and moves are found by comparing the element lists of the owners
+ * changed.
+ */
+
+const QString KDiagramsFolder = "diagrams";
+const QString KElementsFolder = "elements";
+const QString KUPRJExt        = ".uprj";
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+/** Version of a project as far as needed for comparing it. */
+struct Snapshot
+{
+   QMap<QUuid, QString>     classes;        // Class names by identifier, from the element index
+   QHash<QUuid, QByteArray> hashes;         // Hashes of the element files
+   QHash<QUuid, QByteArray> shapes;         // Hashes of the diagram files
+   QHash<QUuid, QByteArray> contents;       // Element files of projects in memory
+   QString                  elementsFolder; // Empty for projects in memory
+
+   QJsonObject read(QUuid id) const
+   {
+      if (elementsFolder.isEmpty()) return QJsonDocument::fromJson(contents.value(id)).object();
+
+      QFile file(elementsFolder + "/" + id.toString() + ".json");
+      if (!file.open(QIODevice::ReadOnly)) return QJsonObject();
+      return QJsonDocument::fromJson(file.readAll()).object();
+   }
+};
+
+/** Element read from both versions. */
+struct Comparison
+{
+   QUuid       id;
+   QJsonObject oldJson;
+   QJsonObject newJson;
+};
+
+struct ProjectDiff::Data
+{
+   Data()
+   : compared(0)
+   {}
+
+   QList<ProjectDiff::ElementChange> changes;
+   int                               compared;
+   QString                           errorString;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Finds the project file of a project given by its project file or its folder. */
+static QString findProjectFile(QString path)
+{
+   QFileInfo info(path);
+   if (!info.isDir()) return path;
+
+   auto files = QDir(path).entryList(QStringList() << "*" + KUPRJExt, QDir::Files);
+   return files.size() == 1 ? QDir(path).filePath(files.first()) : QString();
+}
+
+/** Reads the element index of a project file and hashes the element and diagram files on all cores. */
+static bool readSnapshot(QString path, Snapshot& snapshot, QString* error)
+{
+   TraceSpan span("ProjectDiff::readSnapshot");
+   span.setDetail(path);
+
+   QString filename = findProjectFile(path);
+   QFile file(filename);
+   if (filename.isEmpty() || !file.open(QIODevice::ReadOnly))
+   {
+      *error = QString("'%1' is not a project.").arg(path);
+      return false;
+   }
+
+   JsonReader reader(&file);
+   if (reader.readNext() != JsonReader::TokenType::BeginObject) reader.raiseError("Expected a project object");
+   while (reader.readNext() == JsonReader::TokenType::Name)
+   {
+      bool isIndex = reader.text() == KPropElements;
+      reader.readNext();
+      if (!isIndex || reader.tokenType() != JsonReader::TokenType::BeginArray)
+      {
+         reader.skipValue();
+         continue;
+      }
+
+      for (auto type = reader.readNext(); type != JsonReader::TokenType::EndArray; type = reader.readNext())
+      {
+         if (type == JsonReader::TokenType::Invalid) break;
+
+         auto obj = reader.readValue().toObject();
+         QUuid id(obj[KPropIdentifier].toString());
+         if (!id.isNull()) snapshot.classes.insert(id, obj[KPropClass].toString());
+      }
+   }
+
+   if (reader.hasError())
+   {
+      *error = QString("%1: %2").arg(filename).arg(reader.errorString());
+      return false;
+   }
+
+   QString folder = QFileInfo(filename).path();
+   snapshot.elementsFolder = folder + "/" + KElementsFolder;
+
+   auto ids = snapshot.classes.keys();
+   auto elementHashes = QtConcurrent::blockingMapped<QList<QByteArray>>(ids, [&folder](const QUuid& id)
+   {
+      return FileFingerprint::hashOfFile(folder + "/" + KElementsFolder + "/" + id.toString() + ".json");
+   });
+
+   auto diagramHashes = QtConcurrent::blockingMapped<QList<QByteArray>>(ids, [&folder](const QUuid& id)
+   {
+      return FileFingerprint::hashOfFile(folder + "/" + KDiagramsFolder + "/" + id.toString() + ".json");
+   });
+
+   for (int index = 0; index < ids.size(); ++index)
+   {
+      snapshot.hashes.insert(ids[index], elementHashes[index]);
+      if (!diagramHashes[index].isEmpty()) snapshot.shapes.insert(ids[index], diagramHashes[index]);
+   }
+
+   return true;
+}
+
+/**
+ * Serializes the elements of a project in memory as they would be saved. Open diagrams are hashed by their shapes, all
+ * other diagrams by their diagram files.
+ */
+static void readSnapshot(UmlProject* project, Snapshot& snapshot)
+{
+   TraceSpan span("ProjectDiff::readProject");
+
+   for (auto* elem : project->elements())
+   {
+      QJsonObject obj;
+      obj[KPropVersion] = (int)KFileVersion;
+      elem->serialize(obj, false, KFileVersion);
+      auto content = JsonWriter::toCanonical(obj);
+
+      snapshot.classes.insert(elem->identifier(), elem->className());
+      snapshot.hashes.insert(elem->identifier(), QCryptographicHash::hash(content, QCryptographicHash::Md5));
+      snapshot.contents.insert(elem->identifier(), content);
+
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram == nullptr) continue;
+
+      QByteArray hash;
+      if (diagram->isOpen())
+      {
+         QJsonObject shapes;
+         diagram->writeShapes(shapes);
+         hash = QCryptographicHash::hash(JsonWriter::toCanonical(shapes), QCryptographicHash::Md5);
+      }
+      else
+      {
+         hash = FileFingerprint::hashOfFile(diagram->diagramFile());
+      }
+
+      if (!hash.isEmpty()) snapshot.shapes.insert(elem->identifier(), hash);
+   }
+}
+
+/** Adds the changes of a value and - for objects - of its nested values to a list. */
+static void compareValues(QString path, const QJsonValue& oldValue, const QJsonValue& newValue,
+                          QList<ProjectDiff::PropertyChange>& result)
+{
+   if (oldValue == newValue) return;
+
+   if (oldValue.isObject() && newValue.isObject())
+   {
+      auto oldObj = oldValue.toObject();
+      auto newObj = newValue.toObject();
+      auto keys = oldObj.keys() + newObj.keys();
+      std::sort(keys.begin(), keys.end());
+      keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+      for (auto& key : keys)
+      {
+         QString subpath = path.isEmpty() ? key : path + "." + key;
+         compareValues(subpath, oldObj.value(key), newObj.value(key), result);
+      }
+
+      return;
+   }
+
+   result.append(ProjectDiff::PropertyChange{ path, oldValue, newValue });
+}
+
+/** Gets the identifiers of the elements listed by an owner. */
+static QList<QUuid> ownedElements(const QJsonObject& json)
+{
+   QList<QUuid> result;
+   for (auto value : json[KPropElements].toArray()) result.append(QUuid(value.toString()));
+   return result;
+}
+
+/**
+ * Compares two versions of a project.
+ * @param compared Receives the number of elements in any of both versions.
+ * @returns The changes found, sorted by identifier.
+ */
+static QList<ProjectDiff::ElementChange> compareSnapshots(const Snapshot& oldSnap, const Snapshot& newSnap,
+                                                         int* compared)
+{
+   TraceSpan span("ProjectDiff::compare");
+
+   // Elements whose files have equal hashes in both versions did not change:
+   auto all = oldSnap.classes;
+   for (auto iter = newSnap.classes.cbegin(); iter != newSnap.classes.cend(); ++iter)
+   {
+      all.insert(iter.key(), iter.value());
+   }
+
+   *compared = all.size();
+
+   QList<Comparison> jobs;
+   for (auto iter = all.cbegin(); iter != all.cend(); ++iter)
+   {
+      QUuid id = iter.key();
+      if (oldSnap.classes.contains(id) && newSnap.classes.contains(id) &&
+          oldSnap.hashes.value(id) == newSnap.hashes.value(id) && oldSnap.shapes.value(id) == newSnap.shapes.value(id))
+      {
+         continue;
+      }
+
+      jobs.append(Comparison{ id, QJsonObject(), QJsonObject() });
+   }
+
+   // The others are read from both versions on all cores:
+   QtConcurrent::blockingMap(jobs, [&oldSnap, &newSnap](Comparison& job)
+   {
+      if (oldSnap.classes.contains(job.id)) job.oldJson = oldSnap.read(job.id);
+      if (newSnap.classes.contains(job.id)) job.newJson = newSnap.read(job.id);
+   });
+
+   QMap<QUuid, ProjectDiff::ElementChange> changes;
+   QHash<QUuid, QUuid> oldOwners, newOwners;
+   for (auto& job : jobs)
+   {
+      bool inOld = oldSnap.classes.contains(job.id);
+      bool inNew = newSnap.classes.contains(job.id);
+      for (auto& child : ownedElements(job.oldJson)) oldOwners.insert(child, job.id);
+      for (auto& child : ownedElements(job.newJson)) newOwners.insert(child, job.id);
+
+      ProjectDiff::ElementChange change;
+      change.identifier = job.id;
+      change.className = inNew ? newSnap.classes.value(job.id) : oldSnap.classes.value(job.id);
+      change.name = (inNew ? job.newJson : job.oldJson)[KPropName].toString();
+      if (!inOld)
+      {
+         change.kind = ProjectDiff::ChangeKind::Added;
+      }
+      else if (!inNew)
+      {
+         change.kind = ProjectDiff::ChangeKind::Removed;
+      }
+      else
+      {
+         // The file version is not a property of the element:
+         job.oldJson.remove(KPropVersion);
+         job.newJson.remove(KPropVersion);
+         compareValues(QString(), job.oldJson, job.newJson, change.properties);
+         change.isLayoutChanged = oldSnap.shapes.value(job.id) != newSnap.shapes.value(job.id);
+
+         // Files written with another formatting only:
+         if (change.properties.isEmpty() && !change.isLayoutChanged) continue;
+      }
+
+      changes.insert(job.id, change);
+   }
+
+   // Moving an element changes the element lists of its old and its new owner, both were read above:
+   for (auto iter = changes.begin(); iter != changes.end(); ++iter)
+   {
+      iter->oldOwner = oldOwners.value(iter.key());
+      iter->newOwner = newOwners.value(iter.key());
+   }
+
+   for (auto iter = newOwners.cbegin(); iter != newOwners.cend(); ++iter)
+   {
+      QUuid id = iter.key();
+      if (!oldOwners.contains(id) || oldOwners.value(id) == iter.value()) continue;
+      if (!oldSnap.classes.contains(id) || !newSnap.classes.contains(id)) continue;
+
+      auto found = changes.find(id);
+      if (found == changes.end())
+      {
+         ProjectDiff::ElementChange change;
+         change.identifier = id;
+         change.className = newSnap.classes.value(id);
+         change.name = newSnap.read(id)[KPropName].toString();
+         change.kind = ProjectDiff::ChangeKind::Moved;
+         change.oldOwner = oldOwners.value(id);
+         change.newOwner = iter.value();
+         found = changes.insert(id, change);
+      }
+
+      found->isMoved = true;
+   }
+
+   span.setDetail(QString("%1 compared, %2 read, %3 changed").arg(*compared).arg(jobs.size()).arg(changes.size()));
+   return changes.values();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the ProjectDiff class. */
+ProjectDiff::ProjectDiff()
+: data(new Data())
+{
+}
+
+/** Destroys the ProjectDiff object. */
+ProjectDiff::~ProjectDiff()
+{
+   delete data;
+}
+
+/** Gets the changes found by the last comparison, sorted by identifier. */
+QList<ProjectDiff::ElementChange> ProjectDiff::changes() const
+{
+   return data->changes;
+}
+
+/** Gets the number of changes of a kind. */
+int ProjectDiff::count(ChangeKind kind) const
+{
+   return static_cast<int>(std::count_if(data->changes.cbegin(), data->changes.cend(),
+      [kind](const ElementChange& change) { return change.kind == kind; }));
+}
+
+/** Gets the number of elements compared, i.e. of elements in any of both versions. */
+int ProjectDiff::comparedCount() const
+{
+   return data->compared;
+}
+
+/** Gets a description of the error that occurred during the last comparison. */
+QString ProjectDiff::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Compares two versions of a project saved to disk.
+ *
+ * @param oldProject Project file or project folder of the old version.
+ * @param newProject Project file or project folder of the new version.
+ * @returns true if successful; false if a version could not be read.
+ */
+bool ProjectDiff::compare(QString oldProject, QString newProject)
+{
+   setErrorString("");
+   data->changes.clear();
+   Snapshot oldSnap, newSnap;
+   QString error;
+   if (!readSnapshot(oldProject, oldSnap, &error) || !readSnapshot(newProject, newSnap, &error))
+   {
+      setErrorString(error);
+      return false;
+   }
+
+   data->changes = compareSnapshots(oldSnap, newSnap, &data->compared);
+   return true;
+}
+
+/**
+ * Compares a version of a project saved to disk with a project in memory.
+ *
+ * @param oldProject Project file or project folder of the old version, e.g. the project file of the project in memory.
+ * @param newProject Project in memory.
+ * @returns true if successful; false if the old version could not be read.
+ */
+bool ProjectDiff::compare(QString oldProject, UmlProject* newProject)
+{
+   setErrorString("");
+   data->changes.clear();
+   Snapshot oldSnap, newSnap;
+   QString error;
+   if (!readSnapshot(oldProject, oldSnap, &error))
+   {
+      setErrorString(error);
+      return false;
+   }
+
+   readSnapshot(newProject, newSnap);
+   data->changes = compareSnapshots(oldSnap, newSnap, &data->compared);
+   return true;
+}
+
+/** Converts the changes found by the last comparison to a JSON object. */
+QJsonObject ProjectDiff::toJson() const
+{
+   QJsonArray changes;
+   for (auto& change : data->changes)
+   {
+      QJsonArray properties;
+      for (auto& property : change.properties)
+      {
+         QJsonObject obj;
+         obj.insert("path", property.path);
+         if (!property.oldValue.isUndefined()) obj.insert("old", property.oldValue);
+         if (!property.newValue.isUndefined()) obj.insert("new", property.newValue);
+         properties.append(obj);
+      }
+
+      QJsonObject obj;
+      obj.insert("identifier", change.identifier.toString());
+      obj.insert("class", change.className);
+      obj.insert("name", change.name);
+      obj.insert("kind", toString(change.kind));
+      obj.insert("moved", change.isMoved);
+      obj.insert("layout", change.isLayoutChanged);
+      if (!change.oldOwner.isNull()) obj.insert("oldOwner", change.oldOwner.toString());
+      if (!change.newOwner.isNull()) obj.insert("newOwner", change.newOwner.toString());
+      obj.insert("properties", properties);
+      changes.append(obj);
+   }
+
+   QJsonObject result;
+   result.insert("compared", data->compared);
+   result.insert("added", count(ChangeKind::Added));
+   result.insert("removed", count(ChangeKind::Removed));
+   result.insert("modified", count(ChangeKind::Modified));
+   result.insert("moved", count(ChangeKind::Moved));
+   result.insert("changes", changes);
+   return result;
+}
+
+/** Converts the changes found by the last comparison to text, one line per element and property changed. */
+QString ProjectDiff::toText() const
+{
+   auto format = [](const QJsonValue& value)
+   {
+      if (value.isUndefined()) return QString("-");
+
+      QByteArray text;
+      JsonWriter writer(&text);
+      writer.value(value);
+      return QString::fromUtf8(text);
+   };
+
+   QString result;
+   for (auto& change : data->changes)
+   {
+      QString name = change.className;
+      if (!change.name.isEmpty()) name += QString(" '%1'").arg(change.name);
+      result += QString("%1 %2 %3\n").arg(toString(change.kind)).arg(name).arg(change.identifier.toString());
+      if (change.isMoved)
+      {
+         result += QString("   moved from %1 to %2\n").arg(change.oldOwner.toString()).arg(change.newOwner.toString());
+      }
+
+      if (change.isLayoutChanged) result += "   shapes changed\n";
+      for (auto& property : change.properties)
+      {
+         result += QString("   %1: %2 -> %3\n").arg(property.path).arg(format(property.oldValue))
+            .arg(format(property.newValue));
+      }
+   }
+
+   result += QString("%1 added, %2 removed, %3 modified, %4 moved of %5 element(s)\n")
+      .arg(count(ChangeKind::Added)).arg(count(ChangeKind::Removed)).arg(count(ChangeKind::Modified))
+      .arg(count(ChangeKind::Moved)).arg(data->compared);
+   return result;
+}
+
+/** Gets the name of a kind of change. */
+QString ProjectDiff::toString(ChangeKind kind)
+{
+   switch (kind)
+   {
+   case ChangeKind::Added:    return "Added";
+   case ChangeKind::Removed:  return "Removed";
+   case ChangeKind::Modified: return "Modified";
+   case ChangeKind::Moved:    return "Moved";
+   }
+
+   return QString();
+}
+
+/** Sets the error string. */
+void ProjectDiff::setErrorString(QString value)
+{
+   data->errorString = value;
+}
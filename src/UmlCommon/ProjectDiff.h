@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectDiff.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class ProjectDiff.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QString>
+#include <QUuid>
+
+class UmlProject;
+
+class UMLCOMMON_EXPORT ProjectDiff final
+{
+public: // Types
+   /** Kind of change of an element. */
+   enum class ChangeKind
+   {
+      Added,    ///< Element exists in the new version only.
+      Removed,  ///< Element exists in the old version only.
+      Modified, ///< Properties or shapes of the element changed; it may have been moved as well.
+      Moved     ///< Element was moved to another owner, its properties did not change.
+   };
+
+   /** Change of a single property. Properties of nested objects are separated by dots. */
+   struct PropertyChange
+   {
+      QString    path;     ///< Key of the property, e.g. "name" or "multiplicity.lower".
+      QJsonValue oldValue; ///< Value in the old version, undefined if the property was added.
+      QJsonValue newValue; ///< Value in the new version, undefined if the property was removed.
+   };
+
+   /** Change of an element. */
+   struct ElementChange
+   {
+      ElementChange()
+      : kind(ChangeKind::Modified)
+      , isMoved(false)
+      , isLayoutChanged(false)
+      {}
+
+      QUuid                 identifier;      ///< Identifier of the element.
+      QString               className;       ///< Class name of the element.
+      QString               name;            ///< Name of the element, empty if it is not named.
+      ChangeKind            kind;            ///< Kind of the change.
+      bool                  isMoved;         ///< True if the owner of the element changed.
+      bool                  isLayoutChanged; ///< True if the shapes of a diagram changed.
+      QUuid                 oldOwner;        ///< Owner in the old version, if known.
+      QUuid                 newOwner;        ///< Owner in the new version, if known.
+      QList<PropertyChange> properties;      ///< Properties changed, if modified.
+   };
+
+public: // Constructors
+   ProjectDiff();
+   ProjectDiff(ProjectDiff const&) = delete;
+   void operator=(ProjectDiff const&) = delete;
+   ~ProjectDiff();
+
+public: // Properties
+   QList<ElementChange> changes() const;
+   int count(ChangeKind kind) const;
+   int comparedCount() const;
+   QString errorString() const;
+
+public: // Methods
+   bool compare(QString oldProject, QString newProject);
+   bool compare(QString oldProject, UmlProject* newProject);
+
+   QJsonObject toJson() const;
+   QString toText() const;
+
+   static QString toString(ChangeKind kind);
+
+private:
+   void setErrorString(QString value);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -0,0 +1,429 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectJournal.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ProjectJournal.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ProjectJournal.h"
+#include "ErrorTools.h"
+#include "PropertyStrings.h"
+#include "Tracer.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QList>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/**
+ * @class ProjectJournal
+ * @brief The ProjectJournal class implements an append-only journal of the changes of a project.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * Saving a project writes one file per element, which takes too long to be done every minute on big projects. 
+ * Instead, UmlProject writes the elements changed since the last autosave to a journal next to the UPRJ file (see
+ * UmlProject::autosave()). The cost of an autosave therefore depends on the number of changes only.
+ *
+ * The journal is a text file with one record per line. Each line starts with a CRC-16 checksum of the record in
+ * hexadecimal digits, followed by a blank and the record as compact JSON object. Records are written in batches:
+ * - put() records the current properties of an element created or modified, and optionally the shapes of a diagram;
+ * - remove() records that an element was removed from the project;
+ * - commit() writes the records collected so far followed by a commit record containing the properties of the
+ *   project, and flushes the file to the storage device.
+ *
+ * A batch counts only if its commit record was written completely. If the program crashes while writing, the
+ * incomplete batch at the end of the journal is ignored when reading it with fold(). fold() also combines all
+ * batches into an Overlay, i.e. the last state of each element, which UmlProject::load() applies on top of the 
+ * element files to recover the changes made before a crash.
+ *
+ * Function rotate() moves the records to another file, so that file can be folded into the element files in the
+ * background while new records are written to an empty journal (see UmlProject::compact()).
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+struct ProjectJournal::Data
+{
+   QFile             file;
+   QList<QByteArray> pending;
+   QString           errorString;
+};
+/// @endcond
+
+const QString KOpPut    = "put";
+const QString KOpRemove = "remove";
+const QString KOpCommit = "commit";
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Converts a record into a line of the journal, including its checksum and the line feed. */
+static QByteArray toLine(const QJsonObject& record)
+{
+   auto json = QJsonDocument(record).toJson(QJsonDocument::Compact);
+   auto sum  = QByteArray::number(qChecksum(json.constData(), json.size()), 16).rightJustified(4, '0');
+   return sum + ' ' + json + '\n';
+}
+
+/** Converts a line of the journal into a record. Returns false if the line is incomplete or damaged. */
+static bool fromLine(const QByteArray& line, QJsonObject& record)
+{
+   if (!line.endsWith('\n') || line.size() < 7 || line[4] != ' ') return false;
+
+   auto json = line.mid(5, line.size() - 6);
+   bool ok = false;
+   if (line.left(4).toUShort(&ok, 16) != qChecksum(json.constData(), json.size()) || !ok) return false;
+
+   auto doc = QJsonDocument::fromJson(json);
+   if (!doc.isObject()) return false;
+
+   record = doc.object();
+   return true;
+}
+
+/** Flushes a file to the storage device. */
+static bool flushToDisk(QFile& file)
+{
+   if (!file.flush()) return false;
+#ifdef Q_OS_WIN
+   return ::_commit(file.handle()) == 0;
+#else
+   return ::fsync(file.handle()) == 0;
+#endif
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new closed ProjectJournal object. */
+ProjectJournal::ProjectJournal()
+: data(new Data)
+{
+}
+
+/** Disposes the ProjectJournal object. Records not yet committed are lost. */
+ProjectJournal::~ProjectJournal()
+{
+   delete data;
+}
+
+/** Gets the name of the journal file. */
+QString ProjectJournal::fileName() const
+{
+   return data->file.fileName();
+}
+
+/** Returns true if the journal is open for writing; otherwise false. */
+bool ProjectJournal::isOpen() const
+{
+   return data->file.isOpen();
+}
+
+/** Gets the size of the journal file in bytes. */
+qint64 ProjectJournal::size() const
+{
+   return data->file.isOpen() ? data->file.size() : 0;
+}
+
+/** Gets the number of records collected by put() and remove() but not yet committed. */
+int ProjectJournal::pendingCount() const
+{
+   return data->pending.size();
+}
+
+/** Gets a description of the last error occurred. */
+QString ProjectJournal::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Opens a journal file for appending records. The file is created if it does not exist.
+ *
+ * An incomplete batch at the end of the file, e.g. written while the program crashed, is removed. Otherwise fold()
+ * would stop reading there and ignore all batches appended later.
+ * @param filename Name of the journal file including path.
+ * @returns true if successful; otherwise false.
+ */
+bool ProjectJournal::open(QString filename)
+{
+   close();
+   setErrorString("");
+
+   data->file.setFileName(filename);
+   if (!data->file.open(QIODevice::ReadWrite))
+   {
+      setErrorString(QString(KFileWriteError).arg(filename).arg(data->file.errorString()));
+      return false;
+   }
+
+   qint64 committed = 0;
+   while (!data->file.atEnd())
+   {
+      QJsonObject record;
+      if (!fromLine(data->file.readLine(), record)) break;
+      if (record[KPropOperation].toString() == KOpCommit) committed = data->file.pos();
+   }
+
+   if ((committed < data->file.size() && !data->file.resize(committed)) || !data->file.seek(committed))
+   {
+      setErrorString(QString(KFileWriteError).arg(filename).arg(data->file.errorString()));
+      data->file.close();
+      return false;
+   }
+
+   return true;
+}
+
+/** Closes the journal file. Records not yet committed are dropped. */
+void ProjectJournal::close()
+{
+   data->pending.clear();
+   if (data->file.isOpen()) data->file.close();
+}
+
+/**
+ * Records the current properties of an element created or modified.
+ *
+ * @param id Identifier of the element.
+ * @param className Class name of the element needed for creating it on recovery.
+ * @param json Properties of the element as written to its element file.
+ * @param shapes Nodes and edges of a diagram as written to its diagram file (see UmlDiagram::writeShapes()). Empty
+ *        if the element is no diagram or the diagram is not open.
+ */
+void ProjectJournal::put(QUuid id, QString className, const QJsonObject& json, const QJsonObject& shapes)
+{
+   QJsonObject record;
+   record[KPropOperation] = KOpPut;
+   record[KPropIdentifier] = id.toString();
+   record[KPropClass] = className;
+   record[KPropData] = json;
+   if (!shapes.isEmpty()) record[KPropShapes] = shapes;
+   data->pending.append(toLine(record));
+}
+
+/**
+ * Records the removal of an element from the project.
+ *
+ * @param id Identifier of the element.
+ */
+void ProjectJournal::remove(QUuid id)
+{
+   QJsonObject record;
+   record[KPropOperation] = KOpRemove;
+   record[KPropIdentifier] = id.toString();
+   data->pending.append(toLine(record));
+}
+
+/**
+ * Writes the records collected as a batch and flushes the journal file to the storage device.
+ *
+ * Does nothing if neither records were collected nor files were removed.
+ * @param project Properties of the project, e.g. its author.
+ * @param removedFiles Files removed from the project folders since the last commit.
+ * @returns true if successful; otherwise false. The records are kept for the next commit on failure.
+ */
+bool ProjectJournal::commit(const QJsonObject& project, const QStringList& removedFiles)
+{
+   if (data->pending.isEmpty() && removedFiles.isEmpty()) return true;
+   if (!data->file.isOpen())
+   {
+      setErrorString(QString(KFileWriteError).arg(fileName()).arg("journal is not open"));
+      return false;
+   }
+
+   TraceSpan span("ProjectJournal::commit");
+   QJsonObject record = project;
+   record[KPropOperation] = KOpCommit;
+   record[KPropRemovedFiles] = QJsonArray::fromStringList(removedFiles);
+
+   QByteArray batch;
+   for (auto& line : data->pending) batch += line;
+   batch += toLine(record);
+
+   if (data->file.write(batch) != batch.size() || !flushToDisk(data->file))
+   {
+      setErrorString(QString(KFileWriteError).arg(fileName()).arg(data->file.errorString()));
+      return false;
+   }
+
+   Tracer::counter("ProjectJournal::bytes", data->file.size());
+   data->pending.clear();
+   return true;
+}
+
+/**
+ * Moves the committed records of the journal to another file and continues with an empty journal.
+ *
+ * If the other file exists, e.g. because folding it failed before, the records are appended to it.
+ * @param target Name of the file receiving the records.
+ * @returns true if successful; otherwise false.
+ */
+bool ProjectJournal::rotate(QString target)
+{
+   QString filename = fileName();
+   if (!data->file.isOpen())
+   {
+      setErrorString(QString(KFileWriteError).arg(filename).arg("journal is not open"));
+      return false;
+   }
+
+   auto pending = data->pending;
+   data->file.close();
+
+   bool success = true;
+   if (!QFile::exists(target))
+   {
+      success = QFile::rename(filename, target);
+   }
+   else
+   {
+      QFile source(filename);
+      QFile other(target);
+      success = source.open(QIODevice::ReadOnly) && other.open(QIODevice::WriteOnly | QIODevice::Append) &&
+                other.write(source.readAll()) >= 0 && flushToDisk(other);
+      source.close();
+      success = success && source.resize(0);
+   }
+
+   if (!success)
+   {
+      setErrorString(QString(KFileWriteError).arg(target).arg("cannot move the journal"));
+   }
+
+   bool reopened = open(filename);
+   data->pending = pending;
+   return success && reopened;
+}
+
+/**
+ * Drops all records, committed or not. The journal stays open.
+ *
+ * @returns true if successful; otherwise false.
+ */
+bool ProjectJournal::discard()
+{
+   data->pending.clear();
+   if (data->file.isOpen() && (!data->file.resize(0) || !data->file.seek(0)))
+   {
+      setErrorString(QString(KFileWriteError).arg(fileName()).arg(data->file.errorString()));
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Reads the committed batches of a journal file and folds them into an overlay.
+ *
+ * Reading stops at the first incomplete or damaged record; the records of an incomplete batch are ignored. A file
+ * that does not exist contains no batches.
+ * @param filename Name of the journal file.
+ * @param overlay Overlay receiving the batches. Batches already contained are overwritten by newer ones.
+ * @param error Receives a description of the error if reading failed. May be null.
+ * @returns true if successful; false if the file exists but cannot be read.
+ */
+bool ProjectJournal::fold(QString filename, Overlay& overlay, QString* error)
+{
+   if (!QFile::exists(filename)) return true;
+
+   QFile file(filename);
+   if (!file.open(QIODevice::ReadOnly))
+   {
+      if (error != nullptr) *error = QString(KFileReadError).arg(filename).arg(file.errorString());
+      return false;
+   }
+
+   TraceSpan span("ProjectJournal::fold");
+   span.setDetail(filename);
+
+   QList<QJsonObject> batch;
+   while (!file.atEnd())
+   {
+      QJsonObject record;
+      if (!fromLine(file.readLine(), record))
+      {
+         // The records of the incomplete batch at the end of a truncated journal are dropped:
+         Tracer::instant("ProjectJournal::fold", "model", QString("%1: %2 record(s) ignored").arg(filename)
+            .arg(batch.size()));
+         break;
+      }
+
+      if (record[KPropOperation].toString() != KOpCommit)
+      {
+         batch.append(record);
+         continue;
+      }
+
+      for (auto& item : batch)
+      {
+         QUuid id(item[KPropIdentifier].toString());
+         if (item[KPropOperation].toString() == KOpPut)
+         {
+            // Shapes are recorded only if they changed, keep the ones recorded before:
+            auto older = overlay.elements.find(id);
+            if (!item.contains(KPropShapes) && older != overlay.elements.end() && older->contains(KPropShapes))
+            {
+               item[KPropShapes] = older->value(KPropShapes);
+            }
+
+            overlay.elements.insert(id, item);
+            overlay.removed.remove(id);
+         }
+         else
+         {
+            overlay.elements.remove(id);
+            overlay.removed.insert(id);
+         }
+      }
+
+      for (auto value : record.take(KPropRemovedFiles).toArray())
+      {
+         if (!overlay.removedFiles.contains(value.toString())) overlay.removedFiles.append(value.toString());
+      }
+
+      record.remove(KPropOperation);
+      overlay.project = record;
+      overlay.batches++;
+      batch.clear();
+   }
+
+   return true;
+}
+
+/** Sets the error string. */
+void ProjectJournal::setErrorString(QString value)
+{
+   data->errorString = value;
+}
@@ -0,0 +1,90 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectJournal.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class ProjectJournal.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+
+class UMLCOMMON_EXPORT ProjectJournal final
+{
+public: // Types
+   /** State of a project recorded in a journal, folded from its committed batches. */
+   struct Overlay
+   {
+      Overlay()
+      : batches(0)
+      {}
+
+      QHash<QUuid, QJsonObject> elements;     ///< Last record of each element written, see put().
+      QSet<QUuid>               removed;      ///< Identifiers of the elements removed from the project.
+      QJsonObject               project;      ///< Properties of the project written by the last commit().
+      QStringList               removedFiles; ///< Files to be removed from the project folders.
+      int                       batches;      ///< Number of batches folded.
+   };
+
+public: // Constructors
+   ProjectJournal();
+   ProjectJournal(ProjectJournal const&) = delete;
+   void operator=(ProjectJournal const&) = delete;
+   ~ProjectJournal();
+
+public: // Properties
+   QString fileName() const;
+   bool isOpen() const;
+   qint64 size() const;
+   int pendingCount() const;
+   QString errorString() const;
+
+public: // Methods
+   bool open(QString filename);
+   void close();
+
+   void put(QUuid id, QString className, const QJsonObject& json, const QJsonObject& shapes = QJsonObject());
+   void remove(QUuid id);
+   bool commit(const QJsonObject& project, const QStringList& removedFiles);
+
+   bool rotate(QString target);
+   bool discard();
+
+   static bool fold(QString filename, Overlay& overlay, QString* error = nullptr);
+
+private:
+   void setErrorString(QString value);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -0,0 +1,830 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectMerge.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ProjectMerge.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ProjectMerge.h"
+#include "ErrorTools.h"
+#include "FileFingerprint.h"
+#include "JsonWriter.h"
+#include "ProjectTransaction.h"
+#include "PropertyStrings.h"
+#include "Tracer.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMap>
+#include <QSaveFile>
+#include <QSet>
+#include <QStringList>
+#include <QUuid>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+
+/**
+ * @class ProjectMerge
+ * @brief The ProjectMerge class merges two versions of a project derived from a common ancestor.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * Merging concurrent edits of the JSON files line by line easily corrupts the element lists of owners and the ends
+ * of links. ProjectMerge merges the versions "ours" and "theirs" of a project three-way against their common ancestor
+ * "base" instead, on the level of elements, properties and element lists:
+ *
+ * - A property changed on one side only takes the changed value. A property changed on both sides to different
+ *   values is a conflict; the merged version keeps our value and the conflict is reported.
+ * - Lists of identifiers, like the element lists of owners, are merged as lists: elements removed on either side
+ *   are removed, elements added on either side are added. Changing the same list on both sides is no conflict.
+ * - Lists of objects with an identifier - the element index of the project file, the nodes and edges of a diagram
+ *   file - are merged object by object.
+ *
+ * mergeFiles() merges a single element, diagram or project file and can be used as a merge driver of git (see the
+ * command line interface). mergeProjects() merges complete projects and checks the result across files: elements
+ * listed by two owners after both sides moved them, elements listed by an owner but removed and links whose ends
+ * were removed. Like ProjectDiff it hashes all files on all cores and only parses the files changed on any side, so
+ * the cost depends mostly on the number of changes.
+ */
+
+const QString KDiagramsFolder = "diagrams";
+const QString KElementsFolder = "elements";
+const QString KUPRJExt        = ".uprj";
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+/** Version of a project as far as needed for merging it. */
+struct Version
+{
+   QString                  folder;   // Project folder
+   QString                  filename; // Project file
+   QJsonObject              project;  // Content of the project file
+   QMap<QUuid, QString>     classes;  // Class names by identifier, from the element index
+   QHash<QUuid, QByteArray> hashes;   // Hashes of the element files
+   QHash<QUuid, QByteArray> shapes;   // Hashes of the diagram files
+};
+
+/** Element changed on any side, merged on all cores. */
+struct MergeJob
+{
+   MergeJob()
+   : isMerged(false)
+   , hasDiagram(false)
+   {}
+
+   QUuid                          id;
+   bool                           isMerged;          // Merged three-way, not taken from one side
+   bool                           hasDiagram;
+   QJsonObject                    element;           // Merged element file
+   QJsonObject                    diagram;           // Merged diagram file
+   QSet<QString>                  oursElements;      // Element list of the owner in our version
+   QList<ProjectMerge::Conflict>  conflicts;
+};
+
+struct ProjectMerge::Data
+{
+   Data()
+   : merged(0)
+   {}
+
+   QList<ProjectMerge::Conflict> conflicts;
+   int                           merged;
+   QString                       errorString;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+static QJsonValue mergeValues(const QString& path, const QJsonValue& base, const QJsonValue& ours,
+                              const QJsonValue& theirs, const QString& file, QList<ProjectMerge::Conflict>& conflicts);
+
+/** Finds the project file of a project given by its project file or its folder. */
+static QString findProjectFile(QString path)
+{
+   QFileInfo info(path);
+   if (!info.isDir()) return path;
+
+   auto files = QDir(path).entryList(QStringList() << "*" + KUPRJExt, QDir::Files);
+   return files.size() == 1 ? QDir(path).filePath(files.first()) : QString();
+}
+
+/** Reads a JSON file. A file missing or empty - git passes an empty base if both sides added a file - is empty. */
+static bool readJson(const QString& filename, QJsonObject& json, QString* error)
+{
+   json = QJsonObject();
+   QFile file(filename);
+   if (!file.exists()) return true;
+   if (!file.open(QIODevice::ReadOnly))
+   {
+      *error = QString("%1: %2").arg(filename).arg(file.errorString());
+      return false;
+   }
+
+   auto content = file.readAll();
+   if (content.trimmed().isEmpty()) return true;
+
+   QJsonParseError parseError;
+   auto doc = QJsonDocument::fromJson(content, &parseError);
+   if (!doc.isObject())
+   {
+      *error = QString("%1: %2 at offset %3").arg(filename).arg(parseError.errorString()).arg(parseError.offset);
+      return false;
+   }
+
+   json = doc.object();
+   return true;
+}
+
+/** Checks whether a JSON object is the content of a project file rather than of an element or diagram file. */
+static bool isProjectFile(const QJsonObject& json)
+{
+   return json.contains(KPropAuthor) && json.contains(KPropCount);
+}
+
+/** Reads the identifiers of the elements in the index of a project file. */
+static QMap<QUuid, QString> readIndex(const QJsonObject& project)
+{
+   QMap<QUuid, QString> result;
+   for (auto value : project[KPropElements].toArray())
+   {
+      auto obj = value.toObject();
+      QUuid id(obj[KPropIdentifier].toString());
+      if (!id.isNull()) result.insert(id, obj[KPropClass].toString());
+   }
+
+   return result;
+}
+
+/** Reads the project file of a version and hashes its element and diagram files on all cores. */
+static bool readVersion(QString path, Version& version, QString* error)
+{
+   TraceSpan span("ProjectMerge::readVersion");
+   span.setDetail(path);
+
+   version.filename = findProjectFile(path);
+   if (version.filename.isEmpty() || !QFileInfo(version.filename).isFile())
+   {
+      *error = QString("'%1' is not a project.").arg(path);
+      return false;
+   }
+
+   if (!readJson(version.filename, version.project, error)) return false;
+
+   version.folder = QFileInfo(version.filename).path();
+   version.classes = readIndex(version.project);
+
+   const QString& folder = version.folder;
+   auto ids = version.classes.keys();
+   auto elementHashes = QtConcurrent::blockingMapped<QList<QByteArray>>(ids, [&folder](const QUuid& id)
+   {
+      return FileFingerprint::hashOfFile(folder + "/" + KElementsFolder + "/" + id.toString() + ".json");
+   });
+
+   auto diagramHashes = QtConcurrent::blockingMapped<QList<QByteArray>>(ids, [&folder](const QUuid& id)
+   {
+      return FileFingerprint::hashOfFile(folder + "/" + KDiagramsFolder + "/" + id.toString() + ".json");
+   });
+
+   for (int index = 0; index < ids.size(); ++index)
+   {
+      version.hashes.insert(ids[index], elementHashes[index]);
+      if (!diagramHashes[index].isEmpty()) version.shapes.insert(ids[index], diagramHashes[index]);
+   }
+
+   return true;
+}
+
+/** Checks whether all values of a list are strings, e.g. identifiers. */
+static bool isStringList(const QJsonArray& list)
+{
+   return std::all_of(list.begin(), list.end(), [](const QJsonValue& value) { return value.isString(); });
+}
+
+/** Converts a list of strings, optionally collecting its items in a set as well. */
+static QStringList toStringList(const QJsonArray& list, QSet<QString>* items = nullptr)
+{
+   QStringList result;
+   for (auto value : list)
+   {
+      result.append(value.toString());
+      if (items != nullptr) items->insert(value.toString());
+   }
+
+   return result;
+}
+
+/**
+ * Finds the key identifying the objects of lists: all objects must have a string value for the key, and no two
+ * objects of a list the same value.
+ * @returns The key, or an empty string if the lists are no lists of objects with an identifier.
+ */
+static QString findKey(const QJsonArray& base, const QJsonArray& ours, const QJsonArray& theirs)
+{
+   auto hasKey = [](const QJsonArray& list, const QString& key)
+   {
+      QSet<QString> values;
+      for (auto value : list)
+      {
+         auto obj = value.toObject();
+         if (!value.isObject() || !obj[key].isString() || values.contains(obj[key].toString())) return false;
+         values.insert(obj[key].toString());
+      }
+
+      return true;
+   };
+
+   for (auto& key : { KPropIdentifier, KPropElement, KPropLink })
+   {
+      if (hasKey(base, key) && hasKey(ours, key) && hasKey(theirs, key)) return key;
+   }
+
+   return QString();
+}
+
+/** Inserts items of their list into a merged list, each after the item preceding it in their list. */
+static void insertItems(QStringList& result, const QStringList& theirs, const QSet<QString>& skipped)
+{
+   for (int index = 0; index < theirs.size(); ++index)
+   {
+      if (skipped.contains(theirs[index]) || result.contains(theirs[index])) continue;
+
+      int position = 0;
+      for (int previous = index - 1; previous >= 0; --previous)
+      {
+         int found = result.indexOf(theirs[previous]);
+         if (found < 0) continue;
+
+         position = found + 1;
+         break;
+      }
+
+      result.insert(position, theirs[index]);
+   }
+}
+
+/** Merges lists of strings, e.g. element lists: items removed on any side are removed, items added are added. */
+static QJsonArray mergeLists(const QJsonArray& base, const QJsonArray& ours, const QJsonArray& theirs)
+{
+   QSet<QString> baseItems, theirItems;
+   toStringList(base, &baseItems);
+   auto theirList = toStringList(theirs, &theirItems);
+
+   QStringList result;
+   for (auto& item : toStringList(ours))
+   {
+      if (!baseItems.contains(item) || theirItems.contains(item)) result.append(item);
+   }
+
+   insertItems(result, theirList, baseItems);
+   return QJsonArray::fromStringList(result);
+}
+
+/** Merges lists of objects with an identifier object by object. */
+static QJsonArray mergeKeyedLists(const QString& path, const QString& key, const QJsonArray& base,
+                                  const QJsonArray& ours, const QJsonArray& theirs, const QString& file,
+                                  QList<ProjectMerge::Conflict>& conflicts)
+{
+   // Missing objects must be Undefined, not Null, so mergeValues() recognizes them as removed:
+   auto find = [](const QHash<QString, QJsonValue>& items, const QString& id)
+   {
+      return items.contains(id) ? items.value(id) : QJsonValue(QJsonValue::Undefined);
+   };
+
+   auto index = [&key](const QJsonArray& list, QStringList* keys)
+   {
+      QHash<QString, QJsonValue> result;
+      for (auto value : list)
+      {
+         auto id = value.toObject()[key].toString();
+         result.insert(id, value);
+         if (keys != nullptr) keys->append(id);
+      }
+
+      return result;
+   };
+
+   QStringList keys, theirKeys;
+   auto baseItems = index(base, nullptr);
+   auto ourItems = index(ours, &keys);
+   auto theirItems = index(theirs, &theirKeys);
+
+   // Objects removed on one side are decided by mergeValues(), since the other side may have changed them:
+   insertItems(keys, theirKeys, QSet<QString>());
+   for (auto& id : baseItems.keys())
+   {
+      if (!keys.contains(id)) keys.append(id);
+   }
+
+   QJsonArray result;
+   for (auto& id : keys)
+   {
+      QString subpath = QString("%1[%2]").arg(path).arg(id);
+      auto value = mergeValues(subpath, find(baseItems, id), find(ourItems, id), find(theirItems, id), file,
+         conflicts);
+      if (!value.isUndefined()) result.append(value);
+   }
+
+   return result;
+}
+
+/** Merges the values of objects key by key. */
+static QJsonObject mergeObjects(const QString& path, const QJsonObject& base, const QJsonObject& ours,
+                                const QJsonObject& theirs, const QString& file,
+                                QList<ProjectMerge::Conflict>& conflicts)
+{
+   auto keys = base.keys() + ours.keys() + theirs.keys();
+   std::sort(keys.begin(), keys.end());
+   keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+   QJsonObject result;
+   for (auto& key : keys)
+   {
+      QString subpath = path.isEmpty() ? key : path + "." + key;
+      auto value = mergeValues(subpath, base.value(key), ours.value(key), theirs.value(key), file, conflicts);
+      if (!value.isUndefined()) result.insert(key, value);
+   }
+
+   return result;
+}
+
+/**
+ * Merges a value three-way. Undefined values denote values that do not exist in a version.
+ * @returns The merged value; our value if the value is in conflict.
+ */
+static QJsonValue mergeValues(const QString& path, const QJsonValue& base, const QJsonValue& ours,
+                              const QJsonValue& theirs, const QString& file, QList<ProjectMerge::Conflict>& conflicts)
+{
+   if (ours == theirs || theirs == base) return ours;
+   if (ours == base) return theirs;
+
+   if (ours.isObject() && theirs.isObject())
+   {
+      return mergeObjects(path, base.toObject(), ours.toObject(), theirs.toObject(), file, conflicts);
+   }
+
+   if (ours.isArray() && theirs.isArray())
+   {
+      auto baseList = base.toArray();
+      auto ourList = ours.toArray();
+      auto theirList = theirs.toArray();
+      if (isStringList(baseList) && isStringList(ourList) && isStringList(theirList))
+      {
+         return mergeLists(baseList, ourList, theirList);
+      }
+
+      QString key = findKey(baseList, ourList, theirList);
+      if (!key.isEmpty()) return mergeKeyedLists(path, key, baseList, ourList, theirList, file, conflicts);
+   }
+
+   QString reason = "Changed on both sides";
+   if (ours.isUndefined()) reason = "Removed in ours, changed in theirs";
+   else if (theirs.isUndefined()) reason = "Changed in ours, removed in theirs";
+   conflicts.append(ProjectMerge::Conflict{ file, path, reason, base, ours, theirs });
+   return ours;
+}
+
+/** Merges project files. The element count is recomputed and the element index sorted like UmlProject saves it. */
+static QJsonObject mergeProjectFiles(QJsonObject base, QJsonObject ours, QJsonObject theirs, const QString& file,
+                                     QList<ProjectMerge::Conflict>& conflicts)
+{
+   base.remove(KPropCount);
+   ours.remove(KPropCount);
+   theirs.remove(KPropCount);
+   auto result = mergeObjects(QString(), base, ours, theirs, file, conflicts);
+
+   QMap<QString, QJsonValue> sorted;
+   for (auto value : result[KPropElements].toArray())
+   {
+      sorted.insert(value.toObject()[KPropIdentifier].toString(), value);
+   }
+
+   QJsonArray index;
+   for (auto& value : sorted) index.append(value);
+   result[KPropElements] = index;
+   result[KPropCount] = index.size();
+   return result;
+}
+
+/** Merges an element or diagram file of a project, reading only the versions needed. */
+static QJsonObject mergeFile(const QString& relative, const QByteArray& baseHash, const QByteArray& ourHash,
+                             const QByteArray& theirHash, const Version& base, const Version& ours,
+                             const Version& theirs, MergeJob& job, QJsonObject* ourJson = nullptr)
+{
+   QString error;
+   QJsonObject baseObj, ourObj, theirObj;
+   readJson(ours.folder + "/" + relative, ourObj, &error);
+   if (ourJson != nullptr) *ourJson = ourObj;
+   if (ourHash == theirHash || theirHash == baseHash) return ourObj;
+
+   readJson(theirs.folder + "/" + relative, theirObj, &error);
+   if (ourHash == baseHash) return theirObj;
+
+   readJson(base.folder + "/" + relative, baseObj, &error);
+   job.isMerged = true;
+   return mergeObjects(QString(), baseObj, ourObj, theirObj, relative, job.conflicts);
+}
+
+/** Formats a value of a conflict for text output. */
+static QString formatValue(const QJsonValue& value)
+{
+   if (value.isUndefined()) return QString("-");
+
+   QByteArray text;
+   JsonWriter writer(&text);
+   writer.value(value);
+   return QString::fromUtf8(text);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the ProjectMerge class. */
+ProjectMerge::ProjectMerge()
+: data(new Data())
+{
+}
+
+/** Destroys the ProjectMerge object. */
+ProjectMerge::~ProjectMerge()
+{
+   delete data;
+}
+
+/** Gets the conflicts found by the last merge. */
+QList<ProjectMerge::Conflict> ProjectMerge::conflicts() const
+{
+   return data->conflicts;
+}
+
+/** Gets the number of files changed on both sides and therefore merged property by property by the last merge. */
+int ProjectMerge::mergedCount() const
+{
+   return data->merged;
+}
+
+/** Gets a description of the error that occurred during the last merge. */
+QString ProjectMerge::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Merges two versions of a project saved to disk and writes the merged version to a folder.
+ *
+ * Elements removed on one side and changed on the other are removed and reported as conflicts. Files not changed on
+ * any side are copied from our version, unless the output folder is our project folder.
+ *
+ * @param base Project file or project folder of the common ancestor.
+ * @param ours Project file or project folder of our version.
+ * @param theirs Project file or project folder of their version.
+ * @param output Folder receiving the merged project; may be the folder of our version.
+ * @returns true if the project was merged, even if conflicts were found; false if a version could not be read or the
+ *          merged version could not be written.
+ */
+bool ProjectMerge::mergeProjects(QString base, QString ours, QString theirs, QString output)
+{
+   TraceSpan span("ProjectMerge::mergeProjects");
+   setErrorString("");
+   data->conflicts.clear();
+   data->merged = 0;
+
+   Version baseVer, ourVer, theirVer;
+   QString error;
+   if (!readVersion(base, baseVer, &error) || !readVersion(ours, ourVer, &error) ||
+       !readVersion(theirs, theirVer, &error))
+   {
+      setErrorString(error);
+      return false;
+   }
+
+   QString projectName = QFileInfo(ourVer.filename).fileName();
+   auto project = mergeProjectFiles(baseVer.project, ourVer.project, theirVer.project, projectName, data->conflicts);
+   auto merged = readIndex(project);
+
+   // Elements changed on any side are merged on all cores, the others are taken from our version:
+   auto all = baseVer.classes;
+   for (auto iter = ourVer.classes.cbegin(); iter != ourVer.classes.cend(); ++iter) all.insert(iter.key(), *iter);
+   for (auto iter = theirVer.classes.cbegin(); iter != theirVer.classes.cend(); ++iter) all.insert(iter.key(), *iter);
+
+   QList<MergeJob> jobs;
+   QList<QUuid> unchanged, removed;
+   for (auto iter = all.cbegin(); iter != all.cend(); ++iter)
+   {
+      QUuid id = iter.key();
+      auto baseHash = baseVer.hashes.value(id);
+      auto ourHash = ourVer.hashes.value(id);
+      auto theirHash = theirVer.hashes.value(id);
+      bool isElementChanged = ourHash != baseHash || theirHash != baseHash;
+      bool isDiagramChanged = ourVer.shapes.value(id) != baseVer.shapes.value(id) ||
+                              theirVer.shapes.value(id) != baseVer.shapes.value(id);
+
+      if (!merged.contains(id))
+      {
+         removed.append(id);
+         bool inOurs = ourVer.classes.contains(id), inTheirs = theirVer.classes.contains(id);
+         if (baseVer.classes.contains(id) && (inOurs ? ourHash : theirHash) != baseHash && inOurs != inTheirs)
+         {
+            QString relative = KElementsFolder + "/" + id.toString() + ".json";
+            QString reason = inOurs ? "Changed in ours, removed in theirs; the element was removed"
+                                    : "Removed in ours, changed in theirs; the element was removed";
+            data->conflicts.append(Conflict{ relative, QString(), reason, QJsonValue(), QJsonValue(), QJsonValue() });
+         }
+      }
+      else if (isElementChanged || isDiagramChanged)
+      {
+         jobs.append(MergeJob{});
+         jobs.last().id = id;
+      }
+      else
+      {
+         unchanged.append(id);
+      }
+   }
+
+   QtConcurrent::blockingMap(jobs, [&baseVer, &ourVer, &theirVer](MergeJob& job)
+   {
+      QString name = job.id.toString() + ".json";
+      QJsonObject ourJson;
+      job.element = mergeFile(KElementsFolder + "/" + name, baseVer.hashes.value(job.id),
+                              ourVer.hashes.value(job.id), theirVer.hashes.value(job.id), baseVer, ourVer,
+                              theirVer, job, &ourJson);
+      for (auto value : ourJson[KPropElements].toArray()) job.oursElements.insert(value.toString());
+
+      auto baseShapes = baseVer.shapes.value(job.id);
+      auto ourShapes = ourVer.shapes.value(job.id);
+      auto theirShapes = theirVer.shapes.value(job.id);
+      job.hasDiagram = !ourShapes.isEmpty() || !theirShapes.isEmpty();
+      if (job.hasDiagram)
+      {
+         job.diagram = mergeFile(KDiagramsFolder + "/" + name, baseShapes, ourShapes, theirShapes, baseVer, ourVer,
+                                 theirVer, job);
+      }
+   });
+
+   // Check the merged elements across files. Moving an element changes its old and new owner, so all owners whose
+   // element lists changed were merged above:
+   QHash<QString, QList<int>> owners;
+   for (int index = 0; index < jobs.size(); ++index)
+   {
+      auto& job = jobs[index];
+      data->conflicts.append(job.conflicts);
+      if (job.isMerged) data->merged++;
+
+      QString relative = KElementsFolder + "/" + job.id.toString() + ".json";
+      QJsonArray elements;
+      for (auto value : job.element[KPropElements].toArray())
+      {
+         if (!merged.contains(QUuid(value.toString())))
+         {
+            data->conflicts.append(Conflict{ relative, KPropElements, "Listed element was removed; it was unlisted",
+                                             QJsonValue(), value, QJsonValue() });
+            continue;
+         }
+
+         owners[value.toString()].append(index);
+         elements.append(value);
+      }
+
+      if (job.element.contains(KPropElements)) job.element[KPropElements] = elements;
+
+      for (auto& key : { KPropSource, KPropTarget })
+      {
+         if (!job.element.contains(key) || merged.contains(QUuid(job.element[key].toString()))) continue;
+
+         data->conflicts.append(Conflict{ relative, key, "Link end was removed", QJsonValue(), job.element[key],
+                                          QJsonValue() });
+      }
+   }
+
+   for (auto iter = owners.cbegin(); iter != owners.cend(); ++iter)
+   {
+      if (iter->size() < 2) continue;
+
+      // Listed by several owners after both sides moved the element; it stays with our owner:
+      auto found = std::find_if(iter->cbegin(), iter->cend(), [&jobs, &iter](int index)
+      {
+         return jobs[index].oursElements.contains(iter.key());
+      });
+
+      int kept = found != iter->cend() ? *found : iter->first();
+      for (int index : *iter)
+      {
+         if (index == kept) continue;
+
+         auto& job = jobs[index];
+         auto elements = job.element[KPropElements].toArray();
+         for (int pos = elements.size() - 1; pos >= 0; --pos)
+         {
+            if (elements[pos].toString() == iter.key()) elements.removeAt(pos);
+         }
+
+         job.element[KPropElements] = elements;
+         QString reason = QString("Element moved to different owners; it stays with %1")
+            .arg(jobs[kept].id.toString());
+         data->conflicts.append(Conflict{ KElementsFolder + "/" + job.id.toString() + ".json", KPropElements, reason,
+                                          QJsonValue(), QJsonValue(iter.key()), QJsonValue() });
+      }
+   }
+
+   // Write the merged version with a single transaction:
+   QDir().mkpath(output);
+   QString outFolder = QFileInfo(output).absoluteFilePath();
+   bool isInPlace = outFolder == QFileInfo(ourVer.folder).absoluteFilePath();
+   ProjectTransaction transaction(outFolder);
+   if (!transaction.begin())
+   {
+      setErrorString(transaction.errorString());
+      return false;
+   }
+
+   bool success = transaction.write(outFolder + "/" + projectName, JsonWriter::toCanonical(project));
+   for (auto& job : jobs)
+   {
+      QString name = job.id.toString() + ".json";
+      success = success && transaction.write(outFolder + "/" + KElementsFolder + "/" + name,
+                                             JsonWriter::toCanonical(job.element));
+      if (job.hasDiagram && !job.diagram.isEmpty())
+      {
+         success = success && transaction.write(outFolder + "/" + KDiagramsFolder + "/" + name,
+                                                JsonWriter::toCanonical(job.diagram));
+      }
+      else
+      {
+         transaction.remove(outFolder + "/" + KDiagramsFolder + "/" + name);
+      }
+   }
+
+   for (auto& id : removed)
+   {
+      transaction.remove(outFolder + "/" + KElementsFolder + "/" + id.toString() + ".json");
+      transaction.remove(outFolder + "/" + KDiagramsFolder + "/" + id.toString() + ".json");
+   }
+
+   if (!isInPlace)
+   {
+      for (auto& id : unchanged)
+      {
+         for (auto& folder : { KElementsFolder, KDiagramsFolder })
+         {
+            QString relative = folder + "/" + id.toString() + ".json";
+            QFile file(ourVer.folder + "/" + relative);
+            if (!file.open(QIODevice::ReadOnly)) continue;
+
+            success = success && transaction.write(outFolder + "/" + relative, file.readAll());
+         }
+      }
+   }
+
+   if (!success || !transaction.commit())
+   {
+      setErrorString(transaction.errorString());
+      transaction.rollback();
+      return false;
+   }
+
+   span.setDetail(QString("%1 element(s), %2 changed, %3 merged, %4 conflict(s)").arg(all.size()).arg(jobs.size())
+      .arg(data->merged).arg(data->conflicts.size()));
+   return true;
+}
+
+/**
+ * Merges a single element, diagram or project file. Cross-file checks need the complete project and are done by
+ * mergeProjects() only.
+ *
+ * @param base File of the common ancestor. May be missing or empty if both sides added the file.
+ * @param ours File of our version.
+ * @param theirs File of their version.
+ * @param output File receiving the merged version; may be our file.
+ * @returns true if the file was merged, even if conflicts were found; false if a version could not be read or the
+ *          merged version could not be written.
+ */
+bool ProjectMerge::mergeFiles(QString base, QString ours, QString theirs, QString output)
+{
+   setErrorString("");
+   data->conflicts.clear();
+   data->merged = 0;
+
+   QString error;
+   QJsonObject baseObj, ourObj, theirObj;
+   if (!readJson(base, baseObj, &error) || !readJson(ours, ourObj, &error) || !readJson(theirs, theirObj, &error))
+   {
+      setErrorString(error);
+      return false;
+   }
+
+   QString file = QFileInfo(output).fileName();
+   QJsonObject result;
+   if (isProjectFile(ourObj) || isProjectFile(theirObj))
+   {
+      result = mergeProjectFiles(baseObj, ourObj, theirObj, file, data->conflicts);
+   }
+   else
+   {
+      result = mergeObjects(QString(), baseObj, ourObj, theirObj, file, data->conflicts);
+   }
+
+   data->merged = 1;
+
+   auto content = JsonWriter::toCanonical(result);
+   QSaveFile saveFile(output);
+   if (!saveFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || saveFile.write(content) != content.size() ||
+       !saveFile.commit())
+   {
+      setErrorString(QString(KFileWriteError).arg(output).arg(saveFile.errorString()));
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Merges two versions of a JSON object three-way.
+ *
+ * @param base Version of the common ancestor.
+ * @param ours Our version.
+ * @param theirs Their version.
+ * @param file Name of the file reported with conflicts.
+ * @returns The merged version. Conflicts found are appended to conflicts().
+ */
+QJsonObject ProjectMerge::merge(const QJsonObject& base, const QJsonObject& ours, const QJsonObject& theirs,
+                                QString file)
+{
+   return mergeObjects(QString(), base, ours, theirs, file, data->conflicts);
+}
+
+/** Converts the conflicts found by the last merge to a JSON object. */
+QJsonObject ProjectMerge::toJson() const
+{
+   QJsonArray conflicts;
+   for (auto& conflict : data->conflicts)
+   {
+      QJsonObject obj;
+      obj.insert("file", conflict.file);
+      obj.insert("path", conflict.path);
+      obj.insert("reason", conflict.reason);
+      if (!conflict.base.isUndefined()) obj.insert("base", conflict.base);
+      if (!conflict.ours.isUndefined()) obj.insert("ours", conflict.ours);
+      if (!conflict.theirs.isUndefined()) obj.insert("theirs", conflict.theirs);
+      conflicts.append(obj);
+   }
+
+   QJsonObject result;
+   result.insert("merged", data->merged);
+   result.insert("conflicts", conflicts);
+   return result;
+}
+
+/** Converts the conflicts found by the last merge to text, one line per conflict. */
+QString ProjectMerge::toText() const
+{
+   QString result;
+   for (auto& conflict : data->conflicts)
+   {
+      QString location = conflict.path.isEmpty() ? conflict.file : conflict.file + ": " + conflict.path;
+      result += QString("%1: %2\n").arg(location).arg(conflict.reason);
+      if (!conflict.base.isUndefined() || !conflict.ours.isUndefined() || !conflict.theirs.isUndefined())
+      {
+         result += QString("   base %1, ours %2, theirs %3\n").arg(formatValue(conflict.base))
+            .arg(formatValue(conflict.ours)).arg(formatValue(conflict.theirs));
+      }
+   }
+
+   result += QString("%1 file(s) merged, %2 conflict(s)\n").arg(data->merged).arg(data->conflicts.size());
+   return result;
+}
+
+/** Sets the error string. */
+void ProjectMerge::setErrorString(QString value)
+{
+   data->errorString = value;
+}
@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectMerge.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class ProjectMerge.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QString>
+
+class UMLCOMMON_EXPORT ProjectMerge final
+{
+public: // Types
+   /** Conflict found while merging. The merged version keeps the value of "ours". */
+   struct Conflict
+   {
+      QString    file;   ///< Element, diagram or project file the conflict was found in.
+      QString    path;   ///< Key of the property, e.g. "name", "multiplicity.lower" or "nodes[{...}].x".
+      QString    reason; ///< Description of the conflict.
+      QJsonValue base;   ///< Value in the common ancestor, undefined if it did not exist.
+      QJsonValue ours;   ///< Value in our version, undefined if it was removed.
+      QJsonValue theirs; ///< Value in their version, undefined if it was removed.
+   };
+
+public: // Constructors
+   ProjectMerge();
+   ProjectMerge(ProjectMerge const&) = delete;
+   void operator=(ProjectMerge const&) = delete;
+   ~ProjectMerge();
+
+public: // Properties
+   QList<Conflict> conflicts() const;
+   int mergedCount() const;
+   QString errorString() const;
+
+public: // Methods
+   bool mergeProjects(QString base, QString ours, QString theirs, QString output);
+   bool mergeFiles(QString base, QString ours, QString theirs, QString output);
+   QJsonObject merge(const QJsonObject& base, const QJsonObject& ours, const QJsonObject& theirs,
+                     QString file = QString());
+
+   QJsonObject toJson() const;
+   QString toText() const;
+
+private:
+   void setErrorString(QString value);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -0,0 +1,430 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ProjectTransaction.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ProjectTransaction.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ProjectTransaction.h"
+#include "ErrorTools.h"
+#include "PropertyStrings.h"
+#include "Tracer.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#include <windows.h>
+#else
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class ProjectTransaction
+ * @brief The ProjectTransaction class writes a set of project files as one atomic unit.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * Writing each element file through its own QSaveFile costs a temporary file, a rename and on many file systems a
+ * sync per file, which dominates saving projects with thousands of elements. A ProjectTransaction writes the files
+ * into a staging folder inside the project folder instead and makes all of them durable at once:
+ * 1. begin() creates the staging folder;
+ * 2. write() stores the new content of a file in the staging folder, remove() notes a file to be removed;
+ * 3. commit() issues one sync barrier for all staged files, then writes a manifest listing them and renames it into
+ *    place. The rename of the manifest is the commit point of the transaction;
+ * 4. commit() finally moves the staged files to their targets and removes the staging folder.
+ *
+ * If the program crashes before the manifest is in place, the project files have not been touched and the staging
+ * folder is dropped. If it crashes afterwards, recover() completes the transaction by moving the remaining files.
+ * UmlProject::load() calls recover() before reading a project, so a crash never leaves a half-written project.
+ *
+ * On Linux the barrier is a single syncfs() call, on other POSIX systems sync(). Windows has no barrier for a file
+ * system, each staged file is flushed there instead, but the renames still need no flush of their own.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+struct ProjectTransaction::Data
+{
+   Data()
+   : isActive(false)
+   {}
+
+   QString     projectFolder;
+   QString     stagingFolder;
+   QStringList files;   // Staged files relative to the project folder
+   QStringList removed; // Files to be removed relative to the project folder
+   bool        isActive;
+   QString     errorString;
+};
+/// @endcond
+
+const QString KStagingFolder = ".staging";
+const QString KManifestFile  = "manifest.json";
+const QString KManifestTemp  = "manifest.tmp";
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Flushes a file or folder to the storage device. Folders are flushed on POSIX systems only. */
+static bool flushToDisk(QString path)
+{
+#ifdef Q_OS_WIN
+   if (QFileInfo(path).isDir()) return true;
+
+   QFile file(path);
+   return file.open(QIODevice::ReadWrite) && ::_commit(file.handle()) == 0;
+#else
+   int handle = ::open(QFile::encodeName(path).constData(), O_RDONLY);
+   if (handle < 0) return false;
+
+   bool success = ::fsync(handle) == 0;
+   ::close(handle);
+   return success;
+#endif
+}
+
+/** Flushes all files written to the staging folder to the storage device. */
+static bool syncBarrier(QString stagingFolder, const QStringList& files)
+{
+#if defined(Q_OS_LINUX)
+   Q_UNUSED(files);
+   int handle = ::open(QFile::encodeName(stagingFolder).constData(), O_RDONLY);
+   if (handle < 0) return false;
+
+   bool success = ::syncfs(handle) == 0;
+   ::close(handle);
+   return success;
+#elif defined(Q_OS_WIN)
+   for (auto& file : files)
+   {
+      if (!flushToDisk(stagingFolder + "/" + file)) return false;
+   }
+
+   return true;
+#else
+   Q_UNUSED(stagingFolder);
+   Q_UNUSED(files);
+   ::sync();
+   return true;
+#endif
+}
+
+/** Moves a file to another name, replacing an existing file atomically. */
+static bool replaceFile(QString source, QString target)
+{
+#ifdef Q_OS_WIN
+   auto src = QDir::toNativeSeparators(source);
+   auto tgt = QDir::toNativeSeparators(target);
+   return ::MoveFileExW((LPCWSTR)src.utf16(), (LPCWSTR)tgt.utf16(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+   return ::rename(QFile::encodeName(source).constData(), QFile::encodeName(target).constData()) == 0;
+#endif
+}
+
+/** 
+ * Moves the staged files of a committed transaction to their targets and removes the staging folder. 
+ *
+ * Files moved before, e.g. by a commit interrupted by a crash, are skipped.
+ */
+static bool publish(QString projectFolder, QString stagingFolder, const QJsonObject& manifest, QString& error)
+{
+   for (auto value : manifest[KPropFiles].toArray())
+   {
+      QString source = stagingFolder + "/" + value.toString();
+      QString target = projectFolder + "/" + value.toString();
+      if (QFile::exists(source) && !replaceFile(source, target))
+      {
+         error = QString(KFileWriteError).arg(target).arg("cannot replace the file");
+         return false;
+      }
+   }
+
+   for (auto value : manifest[KPropRemovedFiles].toArray())
+   {
+      QFile::remove(projectFolder + "/" + value.toString());
+   }
+
+   // The transaction is complete as soon as the manifest is gone:
+   QFile::remove(stagingFolder + "/" + KManifestFile);
+   QDir(stagingFolder).removeRecursively();
+   return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** 
+ * Initializes a new ProjectTransaction object. 
+ *
+ * @param projectFolder Folder containing the project file.
+ */
+ProjectTransaction::ProjectTransaction(QString projectFolder)
+: data(new Data())
+{
+   data->projectFolder = projectFolder;
+   data->stagingFolder = stagingFolder(projectFolder);
+}
+
+/** Disposes the ProjectTransaction object. A transaction not yet committed is rolled back. */
+ProjectTransaction::~ProjectTransaction()
+{
+   if (data->isActive) rollback();
+   delete data;
+}
+
+/** Gets the folder containing the project file. */
+QString ProjectTransaction::projectFolder() const
+{
+   return data->projectFolder;
+}
+
+/** Gets the folder receiving the staged files. */
+QString ProjectTransaction::stagingFolder() const
+{
+   return data->stagingFolder;
+}
+
+/** Gets the number of files staged. */
+int ProjectTransaction::count() const
+{
+   return data->files.size();
+}
+
+/** Gets a description of the last error occurred. */
+QString ProjectTransaction::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Begins a new transaction. A transaction interrupted before is completed or dropped first, see recover().
+ *
+ * @returns true if successful; otherwise false.
+ */
+bool ProjectTransaction::begin()
+{
+   setErrorString("");
+   data->files.clear();
+   data->removed.clear();
+
+   QString error;
+   if (!recover(data->projectFolder, &error))
+   {
+      setErrorString(error);
+      return false;
+   }
+
+   if (!QDir().mkpath(data->stagingFolder))
+   {
+      setErrorString(QString(KFileWriteError).arg(data->stagingFolder).arg("cannot create the folder"));
+      return false;
+   }
+
+   data->isActive = true;
+   return true;
+}
+
+/**
+ * Stages the new content of a file. The file itself is replaced by commit().
+ *
+ * @param filename Name of the file including path. Must be located in the project folder or one of its subfolders.
+ * @param content New content of the file.
+ * @returns true if successful; otherwise false.
+ */
+bool ProjectTransaction::write(QString filename, const QByteArray& content)
+{
+   QString relative = QDir(data->projectFolder).relativeFilePath(filename);
+   if (!data->isActive || relative.startsWith(".."))
+   {
+      setErrorString(QString(KFileWriteError).arg(filename).arg("file is not part of the transaction"));
+      return false;
+   }
+
+   QString staged = data->stagingFolder + "/" + relative;
+   QDir().mkpath(QFileInfo(staged).path());
+
+   QFile file(staged);
+   if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(content) != content.size())
+   {
+      setErrorString(QString(KFileWriteError).arg(staged).arg(file.errorString()));
+      return false;
+   }
+
+   file.close();
+   data->files.append(relative);
+   data->removed.removeAll(relative);
+   return true;
+}
+
+/**
+ * Notes a file to be removed by commit().
+ *
+ * @param filename Name of the file including path.
+ */
+void ProjectTransaction::remove(QString filename)
+{
+   QString relative = QDir(data->projectFolder).relativeFilePath(filename);
+   if (data->isActive && !relative.startsWith("..") && !data->removed.contains(relative))
+   {
+      data->removed.append(relative);
+   }
+}
+
+/**
+ * Makes the staged files durable with one sync barrier and publishes them.
+ *
+ * @returns true if successful; otherwise false. If the transaction failed before its commit point, the project
+ *          files are unchanged. If it failed afterwards, it is completed by the next begin() or recover().
+ */
+bool ProjectTransaction::commit()
+{
+   if (!data->isActive)
+   {
+      setErrorString(QString(KFileWriteError).arg(data->stagingFolder).arg("no transaction"));
+      return false;
+   }
+
+   TraceSpan span("ProjectTransaction::commit");
+   span.setDetail(QString("%1 file(s)").arg(data->files.size()));
+
+   QJsonObject manifest;
+   manifest[KPropFiles] = QJsonArray::fromStringList(data->files);
+   manifest[KPropRemovedFiles] = QJsonArray::fromStringList(data->removed);
+
+   QString temp = data->stagingFolder + "/" + KManifestTemp;
+   QByteArray content = QJsonDocument(manifest).toJson(QJsonDocument::Compact);
+   QFile file(temp);
+   bool success = syncBarrier(data->stagingFolder, data->files) && file.open(QIODevice::WriteOnly) &&
+                  file.write(content) == content.size();
+   file.close();
+
+   // Renaming the manifest into place is the commit point:
+   success = success && flushToDisk(temp) && replaceFile(temp, data->stagingFolder + "/" + KManifestFile) &&
+             flushToDisk(data->stagingFolder);
+   if (!success)
+   {
+      setErrorString(QString(KFileWriteError).arg(temp).arg("cannot commit the transaction"));
+      rollback();
+      return false;
+   }
+
+   data->isActive = false;
+
+   QString error;
+   if (!publish(data->projectFolder, data->stagingFolder, manifest, error))
+   {
+      setErrorString(error);
+      return false;
+   }
+
+   Tracer::counter("ProjectTransaction::files", data->files.size());
+   data->files.clear();
+   data->removed.clear();
+   return true;
+}
+
+/** Drops all files staged. The project files are not touched. */
+void ProjectTransaction::rollback()
+{
+   data->files.clear();
+   data->removed.clear();
+   data->isActive = false;
+   QDir(data->stagingFolder).removeRecursively();
+}
+
+/**
+ * Gets the staging folder used by the transactions of a project.
+ *
+ * @param projectFolder Folder containing the project file.
+ */
+QString ProjectTransaction::stagingFolder(QString projectFolder)
+{
+   return projectFolder + "/" + KStagingFolder;
+}
+
+/**
+ * Completes or drops a transaction interrupted, e.g. by a crash.
+ *
+ * A transaction which reached its commit point is completed by moving its remaining files; otherwise the staging
+ * folder is removed.
+ * @param projectFolder Folder containing the project file.
+ * @param error Receives a description of the error if completing the transaction failed. May be null.
+ * @returns true if successful or if there was no transaction; otherwise false.
+ */
+bool ProjectTransaction::recover(QString projectFolder, QString* error)
+{
+   QString staging = stagingFolder(projectFolder);
+   if (!QFileInfo(staging).isDir()) return true;
+
+   QFile file(staging + "/" + KManifestFile);
+   if (!file.exists())
+   {
+      QDir(staging).removeRecursively();
+      return true;
+   }
+
+   QString message;
+   if (!file.open(QIODevice::ReadOnly))
+   {
+      message = QString(KFileReadError).arg(file.fileName()).arg(file.errorString());
+      if (error != nullptr) *error = message;
+      return false;
+   }
+
+   QJsonParseError parseError;
+   auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+   file.close();
+   if (!doc.isObject())
+   {
+      message = QString(KFileParseError).arg(file.fileName()).arg(toString(parseError));
+      if (error != nullptr) *error = message;
+      return false;
+   }
+
+   Tracer::instant("ProjectTransaction::recover", "model", projectFolder);
+   if (!publish(projectFolder, staging, doc.object(), message))
+   {
+      if (error != nullptr) *error = message;
+      return false;
+   }
+
+   return true;
+}
+
+/** Sets the error string. */
+void ProjectTransaction::setErrorString(QString value)
+{
+   data->errorString = value;
+}
@@ -38,11 +38,13 @@ const QString KPropComment       = "comment";
 const QString KPropCompartments  = "compartments";
 const QString KPropConstraints   = "constraints";
 const QString KPropCount         = "count";
+const QString KPropData          = "data";
 const QString KPropDefault       = "default";
 const QString KPropDiagramKind   = "diagramkind";
 const QString KPropEdges         = "edges";
 const QString KPropElement       = "element";
 const QString KPropElements      = "elements";
+const QString KPropFiles         = "files";
 const QString KPropFlags         = "flags";
 const QString KPropHidden        = "hidden";
 const QString KPropIdentifier    = "identifier";
@@ -53,7 +55,10 @@ const QString KPropName          = "name";
 const QString KPropNode1         = "node1";
 const QString KPropNode2         = "node2";
 const QString KPropNodes         = "nodes";
+const QString KPropOperation     = "op";
+const QString KPropRemovedFiles  = "removedfiles";
 const QString KPropRouting       = "routing";
+const QString KPropShapes        = "shapes";
 const QString KPropSource        = "source";
 const QString KPropSubstitutions = "substitutions";
 const QString KPropStereotype    = "stereotype";
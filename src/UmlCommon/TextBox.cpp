@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "TextBox.h"
+#include "MemoryUsage.h"
 
 /**
  * @class TextBox
@@ -129,3 +130,14 @@ void TextBox::setAlignment(AlignmentFlag value)
 {
    data->alignment = value;
 }
+
+/**
+ * Adds the estimated memory used by the text box to a MemoryUsage object.
+ *
+ * Derived classes override this function to add the memory of their own Data struct.
+ * @param usage MemoryUsage object to be added to.
+ */
+void TextBox::measure(MemoryUsage& usage) const
+{
+   usage.diagrams += sizeof(TextBox) + sizeof(Data) + MemoryUsage::sizeOf(data->text);
+}
@@ -34,6 +34,8 @@
 #include <QString>
 using namespace Qt;
 
+struct MemoryUsage;
+
 class UMLCOMMON_EXPORT TextBox
 {
 public: // Constructors
@@ -56,6 +58,9 @@ public: // Properties
    AlignmentFlag alignment() const;
    void setAlignment(AlignmentFlag value);
 
+public: // Methods
+   virtual void measure(MemoryUsage& usage) const;
+
 private: // Attributes
    ///@cond
    struct Data;
@@ -0,0 +1,482 @@
+//---------------------------------------------------------------------------------------------------------------------
+// Tracer.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of classes Tracer and TraceSpan.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "Tracer.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <QVector>
+
+#include <atomic>
+
+/**
+ * @class Tracer
+ * @brief The Tracer class records spans, counters and events for profiling and exports them as Chrome trace.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * The Tracer class collects timing information from the instrumented parts of ViraquchaUML - loading and saving
+ * projects and diagrams, building scenes, painting and routing - and writes it in the Trace Event Format understood by
+ * chrome://tracing and https://ui.perfetto.dev (see write()). Code is instrumented with TraceSpan objects measuring
+ * the time until the end of their scope, with counter() for values changing over time and with instant() for single
+ * events:
+ * ~~~{.cpp}
+ * bool UmlProject::load(QString filename)
+ * {
+ *    TraceSpan span("UmlProject::load");
+ *    span.setDetail(filename);
+ *    ...
+ * }
+ * ~~~
+ * Tracing is disabled by default. A disabled tracer costs an atomic read per span, so instrumentation can stay in
+ * the code. Each thread records into its own buffer, so threads of the thread pool do not wait for each other, and
+ * each thread is shown in its own row of the trace.
+ *
+ * Tracing is enabled either programmatically (see setEnabled()) or by setting environment variable VIRAQUCHA_TRACE to
+ * the name of a file: then startFromEnvironment() - called by initCommon() - enables tracing, and the trace is
+ * written to the file when the application quits.
+ *
+ * Besides events, the Tracer class keeps a few counters of work done by diagrams - items painted, texts measured,
+ * edges routed (see Counter). They are always counted, since counting costs a single atomic increment, and only
+ * grow: readers like the performance HUD of DiagramView and the benchmarks take the difference of two values().
+ */
+
+/**
+ * @class TraceSpan
+ * @brief The TraceSpan class measures the time spent in a scope for the Tracer.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * A TraceSpan object takes the time when constructed and records a complete event with Tracer::complete() when
+ * destroyed, provided tracing is enabled at construction. Name and category must be string literals or other strings
+ * living as long as the trace, since only their addresses are stored.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal structs hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const char* KEnvironmentVariable = "VIRAQUCHA_TRACE";
+static const char* KCounterNames[Tracer::CounterCount] =
+{
+   "paintedItems", "textMeasurements", "textCacheHits", "reroutes"
+};
+
+struct TraceEvent
+{
+   const char* name;
+   const char* category;
+   char        phase;    // 'X' = complete, 'C' = counter, 'i' = instant
+   qint64      start;    // nanoseconds since the tracer started
+   qint64      value;    // duration of complete events, value of counters
+   QString     detail;
+};
+
+struct TraceBuffer
+{
+   int                 tid;
+   QString             threadName;
+   QMutex              mutex;
+   QVector<TraceEvent> events;
+};
+
+struct TraceState
+{
+   TraceState()
+   : enabled(false)
+   {
+      clock.start();
+      for (auto& counter : counters) counter.store(0);
+   }
+
+   std::atomic<bool>   enabled;
+   std::atomic<qint64> counters[Tracer::CounterCount];
+   QElapsedTimer       clock;
+   QMutex              mutex;
+   QList<TraceBuffer*> buffers;
+   QString             filename;
+   QString             errorString;
+};
+
+static TraceState& state()
+{
+   static TraceState instance;
+   return instance;
+}
+
+/** Gets the buffer of the calling thread, creating it on first use. */
+static TraceBuffer* buffer()
+{
+   thread_local TraceBuffer* local = nullptr;
+   if (local == nullptr)
+   {
+      auto& s = state();
+      QMutexLocker lock(&s.mutex);
+
+      local = new TraceBuffer();
+      local->tid = s.buffers.size() + 1;
+      local->threadName = QThread::currentThread()->objectName();
+      if (local->threadName.isEmpty())
+      {
+         auto* app = QCoreApplication::instance();
+         bool  isMain = app != nullptr && app->thread() == QThread::currentThread();
+         local->threadName = isMain ? QString("Main") : QString("Thread %1").arg(local->tid);
+      }
+
+      s.buffers.append(local);
+   }
+
+   return local;
+}
+
+static void record(TraceEvent&& event)
+{
+   auto* buf = buffer();
+   QMutexLocker lock(&buf->mutex);
+   buf->events.append(std::move(event));
+}
+
+/** Appends a string to a JSON document, escaping it as needed. */
+static void appendString(QByteArray& json, const QString& value)
+{
+   json += '"';
+   for (QChar ch : value)
+   {
+      switch (ch.unicode())
+      {
+      case '"':  json += "\\\""; break;
+      case '\\': json += "\\\\"; break;
+      case '\n': json += "\\n";  break;
+      case '\r': json += "\\r";  break;
+      case '\t': json += "\\t";  break;
+      default:
+         if (ch.unicode() < 0x20)
+         {
+            json += QString("\\u%1").arg(ch.unicode(), 4, 16, QChar('0')).toLatin1();
+         }
+         else
+         {
+            json += QString(ch).toUtf8();
+         }
+         break;
+      }
+   }
+   json += '"';
+}
+
+static QByteArray microseconds(qint64 nsecs)
+{
+   return QByteArray::number(nsecs / 1000.0, 'f', 3);
+}
+
+/** Writes the trace to a device, one event per line. */
+static void writeTrace(QIODevice& device)
+{
+   auto& s = state();
+   QMutexLocker lock(&s.mutex);
+
+   QByteArray json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+   json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":";
+   appendString(json, QCoreApplication::applicationName());
+   json += "}}";
+
+   for (auto* buf : s.buffers)
+   {
+      QMutexLocker bufLock(&buf->mutex);
+      QByteArray tid = QByteArray::number(buf->tid);
+
+      json += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":";
+      appendString(json, buf->threadName);
+      json += "}}";
+
+      for (const auto& event : buf->events)
+      {
+         json += ",\n{\"name\":\"";
+         json += event.name;
+         json += "\",\"ph\":\"";
+         json += event.phase;
+         json += "\",\"ts\":" + microseconds(event.start) + ",\"pid\":1,\"tid\":" + tid;
+         if (event.category != nullptr)
+         {
+            json += ",\"cat\":\"";
+            json += event.category;
+            json += '"';
+         }
+
+         if (event.phase == 'X') json += ",\"dur\":" + microseconds(event.value);
+         if (event.phase == 'i') json += ",\"s\":\"t\"";
+
+         if (event.phase == 'C')
+         {
+            json += ",\"args\":{\"value\":" + QByteArray::number(event.value) + "}";
+         }
+         else if (!event.detail.isEmpty())
+         {
+            json += ",\"args\":{\"detail\":";
+            appendString(json, event.detail);
+            json += "}";
+         }
+         json += "}";
+
+         // Keep memory bounded for large traces:
+         if (json.size() > 1 << 20)
+         {
+            device.write(json);
+            json.clear();
+         }
+      }
+   }
+
+   json += "\n]}\n";
+   device.write(json);
+}
+
+/** Writes the trace requested by the environment when the application quits. */
+static void writeEnvironmentTrace()
+{
+   auto& s = state();
+   if (!s.filename.isEmpty() && !Tracer::write(s.filename))
+   {
+      qWarning("%s", qPrintable(Tracer::errorString()));
+   }
+}
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class Tracer
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Gets a value indicating whether events are recorded. */
+bool Tracer::isEnabled()
+{
+   return state().enabled.load(std::memory_order_relaxed);
+}
+
+/** Enables or disables recording of events; events recorded before are kept until clear() is called. */
+void Tracer::setEnabled(bool value)
+{
+   state().enabled.store(value, std::memory_order_relaxed);
+}
+
+/** Gets the number of events recorded. */
+int Tracer::eventCount()
+{
+   auto& s = state();
+   QMutexLocker lock(&s.mutex);
+
+   int count = 0;
+   for (auto* buf : s.buffers)
+   {
+      QMutexLocker bufLock(&buf->mutex);
+      count += buf->events.size();
+   }
+
+   return count;
+}
+
+/** Gets the time passed since the tracer was first used in nanoseconds; the time base of all events. */
+qint64 Tracer::timestamp()
+{
+   return state().clock.nsecsElapsed();
+}
+
+/** Gets a description of the last error; empty if the last call of write() was successful. */
+QString Tracer::errorString()
+{
+   auto& s = state();
+   QMutexLocker lock(&s.mutex);
+   return s.errorString;
+}
+
+/** Gets the current value of a counter, i.e. the amount of work counted since the application started. */
+qint64 Tracer::value(Counter counter)
+{
+   Q_ASSERT(counter >= 0 && counter < CounterCount);
+   return state().counters[counter].load(std::memory_order_relaxed);
+}
+
+/** Gets the name of a counter as used in JSON documents, e.g. "paintedItems". */
+const char* Tracer::counterName(Counter counter)
+{
+   Q_ASSERT(counter >= 0 && counter < CounterCount);
+   return KCounterNames[counter];
+}
+
+/** Removes all events recorded. */
+void Tracer::clear()
+{
+   auto& s = state();
+   QMutexLocker lock(&s.mutex);
+   for (auto* buf : s.buffers)
+   {
+      QMutexLocker bufLock(&buf->mutex);
+      buf->events.clear();
+   }
+}
+
+/**
+ * Adds to a counter; thread-safe and cheap enough to be called for every item painted.
+ *
+ * @param counter The counter.
+ * @param value Value to be added.
+ */
+void Tracer::count(Counter counter, qint64 value)
+{
+   Q_ASSERT(counter >= 0 && counter < CounterCount);
+   state().counters[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+/**
+ * Records a complete event, i.e. a span of time. Usually called by TraceSpan.
+ *
+ * @param name Name of the event; must live as long as the trace.
+ * @param category Category of the event; must live as long as the trace.
+ * @param start Start of the span (see timestamp()).
+ * @param duration Duration of the span in nanoseconds.
+ * @param detail Optional detail shown with the event, e.g. the name of a file.
+ */
+void Tracer::complete(const char* name, const char* category, qint64 start, qint64 duration, const QString& detail)
+{
+   if (!isEnabled()) return;
+   record({ name, category, 'X', start, duration, detail });
+}
+
+/**
+ * Records the current value of a counter.
+ *
+ * @param name Name of the counter; must live as long as the trace.
+ * @param value Current value.
+ */
+void Tracer::counter(const char* name, qint64 value)
+{
+   if (!isEnabled()) return;
+   record({ name, nullptr, 'C', timestamp(), value, QString() });
+}
+
+/**
+ * Records an event without duration.
+ *
+ * @param name Name of the event; must live as long as the trace.
+ * @param category Category of the event; must live as long as the trace.
+ * @param detail Optional detail shown with the event.
+ */
+void Tracer::instant(const char* name, const char* category, const QString& detail)
+{
+   if (!isEnabled()) return;
+   record({ name, category, 'i', timestamp(), 0, detail });
+}
+
+/** Gets the events recorded in the Trace Event Format as JSON document. */
+QByteArray Tracer::toJson()
+{
+   QBuffer buf;
+   buf.open(QIODevice::WriteOnly);
+   writeTrace(buf);
+   return buf.data();
+}
+
+/**
+ * Writes the events recorded to a file in the Trace Event Format.
+ *
+ * The file can be opened with chrome://tracing or https://ui.perfetto.dev.
+ * @param filename Name of the file including path.
+ * @return True, if the file was written; otherwise false (see errorString()).
+ */
+bool Tracer::write(const QString& filename)
+{
+   QSaveFile file(filename);
+   bool success = file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+   if (success)
+   {
+      writeTrace(file);
+      success = file.commit();
+   }
+
+   auto& s = state();
+   QMutexLocker lock(&s.mutex);
+   s.errorString = success ? QString() : QString("Cannot write trace file '%1' - %2").arg(filename)
+      .arg(file.errorString());
+   return success;
+}
+
+/**
+ * Enables tracing if environment variable VIRAQUCHA_TRACE names a file; the trace is then written to this file when
+ * the application quits. Called by initCommon(), so a QCoreApplication object must exist.
+ */
+void Tracer::startFromEnvironment()
+{
+   auto& s = state();
+   QString filename = qEnvironmentVariable(KEnvironmentVariable);
+   if (filename.isEmpty() || !s.filename.isEmpty()) return;
+
+   s.filename = filename;
+   setEnabled(true);
+   qAddPostRoutine(writeEnvironmentTrace);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class TraceSpan
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the TraceSpan class, starting the span if tracing is enabled.
+ *
+ * @param name Name of the span; must live as long as the trace.
+ * @param category Category of the span; must live as long as the trace.
+ */
+TraceSpan::TraceSpan(const char* name, const char* category)
+: _name(nullptr)
+, _category(category)
+, _start(0)
+{
+   if (Tracer::isEnabled())
+   {
+      _name = name;
+      _start = Tracer::timestamp();
+   }
+}
+
+/** Ends the span and records it. */
+TraceSpan::~TraceSpan()
+{
+   if (_name != nullptr)
+   {
+      Tracer::complete(_name, _category, _start, Tracer::timestamp() - _start, _detail);
+   }
+}
+
+/** Sets a detail shown with the span, e.g. the name of a file; ignored if tracing is disabled. */
+void TraceSpan::setDetail(const QString& value)
+{
+   if (_name != nullptr) _detail = value;
+}
@@ -0,0 +1,97 @@
+//---------------------------------------------------------------------------------------------------------------------
+// Tracer.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of classes Tracer and TraceSpan.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QByteArray>
+#include <QString>
+
+class UMLCOMMON_EXPORT Tracer final
+{
+public: // Constructors
+   Tracer() = delete;
+
+public: // Types
+   /** Counters of work done by diagrams; counted whether tracing is enabled or not. */
+   enum Counter
+   {
+      PaintedItems = 0, ///< Items painted, i.e. paint() calls not served from a pixmap cache.
+      TextMeasurements, ///< Texts measured using font metrics.
+      TextCacheHits,    ///< Text sizes found in the cache of Shape::textRect().
+      Reroutes,         ///< Routes computed for edges.
+      CounterCount
+   };
+
+public: // Properties
+   static bool isEnabled();
+   static void setEnabled(bool value);
+
+   static int eventCount();
+   static qint64 timestamp();
+   static QString errorString();
+
+   static qint64 value(Counter counter);
+   static const char* counterName(Counter counter);
+
+public: // Methods
+   static void count(Counter counter, qint64 value = 1);
+   static void clear();
+   static void complete(const char* name, const char* category, qint64 start, qint64 duration,
+      const QString& detail = QString());
+   static void counter(const char* name, qint64 value);
+   static void instant(const char* name, const char* category, const QString& detail = QString());
+
+   static QByteArray toJson();
+   static bool write(const QString& filename);
+
+   static void startFromEnvironment();
+};
+
+class UMLCOMMON_EXPORT TraceSpan final
+{
+public: // Constructors
+   TraceSpan(const char* name, const char* category = "model");
+   ~TraceSpan();
+
+   /// @cond
+   TraceSpan(TraceSpan const&) = delete;
+   void operator=(TraceSpan const&) = delete;
+   /// @endcond
+
+public: // Properties
+   void setDetail(const QString& value);
+
+private: // Attributes
+   ///@cond
+   const char* _name;
+   const char* _category;
+   qint64      _start;
+   QString     _detail;
+   ///@endcond
+};
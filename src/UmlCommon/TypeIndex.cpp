@@ -0,0 +1,304 @@
+//---------------------------------------------------------------------------------------------------------------------
+// TypeIndex.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class TypeIndex.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "TypeIndex.h"
+#include "MemoryUsage.h"
+#include "UmlElement.h"
+
+#include <QHash>
+
+/**
+ * @class TypeIndex
+ * @brief The TypeIndex class is a reverse index from type names to the elements using them.
+ * @since 0.2.0
+ * @ingroup UmlCommon
+ *
+ * Attributes, parameters, return types and template parameters store their types as plain strings. To answer the 
+ * question &quot;which members use type X&quot; without visiting every element of the project, UmlProject maintains
+ * an object of this class (see UmlProject::typeIndex()).
+ *
+ * The index is keyed by the identifiers found in the type strings returned by UmlElement::typeReferences(). A type
+ * string like &quot;QList<Customer*>&quot; therefore registers the element under &quot;QList&quot; and 
+ * &quot;Customer&quot;. An element referencing the same identifier several times (e.g. an operation with two 
+ * parameters of the same type) is listed only once per identifier.
+ *
+ * The index is updated incrementally: UmlProject calls update() when an element is inserted or read from a file, and 
+ * the type setters of the data model call UmlElement::updateTypeIndex() for the element they belong to. Each update
+ * costs time proportional to the number of type references of one element, and queries cost time proportional to
+ * the size of their result only.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+struct TypeIndex::Data
+{
+   // Type identifier -> set of elements referencing it:
+   QHash<QString, QHash<UmlElement*, int>> usages;
+
+   // Element -> type identifiers currently registered for it (needed for removing stale entries):
+   QHash<UmlElement*, QStringList> references;
+
+   void insert(UmlElement* elem, const QStringList& types)
+   {
+      for (auto& type : types)
+      {
+         ++usages[type][elem];
+      }
+   }
+
+   void erase(UmlElement* elem, const QStringList& types)
+   {
+      for (auto& type : types)
+      {
+         auto iter = usages.find(type);
+         if (iter == usages.end()) continue;
+
+         auto elemIter = iter->find(elem);
+         if (elemIter != iter->end() && --elemIter.value() <= 0)
+         {
+            iter->erase(elemIter);
+         }
+
+         if (iter->isEmpty())
+         {
+            usages.erase(iter);
+         }
+      }
+   }
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new object of the TypeIndex class. */
+TypeIndex::TypeIndex()
+: data(new Data())
+{
+}
+
+TypeIndex::~TypeIndex()
+{
+   delete data;
+}
+
+/** Gets the count of elements registered in the index. */
+int TypeIndex::count() const
+{
+   return data->references.size();
+}
+
+/** Gets all type identifiers referenced by at least one element. */
+QStringList TypeIndex::types() const
+{
+   return data->usages.keys();
+}
+
+/**
+ * Updates the index entries of an element.
+ *
+ * Reads the current type references of the element and replaces the entries registered before. Elements without any 
+ * type references are removed from the index.
+ * @param elem UmlElement object to be updated. Nullptr is ignored.
+ */
+void TypeIndex::update(UmlElement* elem)
+{
+   if (elem == nullptr) return;
+
+   QStringList types;
+   for (auto& ref : elem->typeReferences())
+   {
+      for (auto& type : split(ref))
+      {
+         if (!types.contains(type)) types.append(type);
+      }
+   }
+
+   auto iter = data->references.find(elem);
+   if (iter != data->references.end())
+   {
+      if (iter.value() == types) return;
+      data->erase(elem, iter.value());
+      data->references.erase(iter);
+   }
+
+   if (!types.isEmpty())
+   {
+      data->insert(elem, types);
+      data->references.insert(elem, types);
+   }
+}
+
+/**
+ * Removes all index entries of an element.
+ *
+ * @param elem UmlElement object to be removed.
+ */
+void TypeIndex::remove(UmlElement* elem)
+{
+   auto iter = data->references.find(elem);
+   if (iter != data->references.end())
+   {
+      data->erase(elem, iter.value());
+      data->references.erase(iter);
+   }
+}
+
+/** Removes all entries from the index. */
+void TypeIndex::clear()
+{
+   data->usages.clear();
+   data->references.clear();
+}
+
+/**
+ * Adds the memory used by the index to a MemoryUsage object.
+ *
+ * @param usage MemoryUsage object receiving the sizes.
+ */
+void TypeIndex::measure(MemoryUsage& usage) const
+{
+   usage.objects += sizeof(TypeIndex) + sizeof(Data);
+   usage.containers += MemoryUsage::sizeOf(data->usages) + MemoryUsage::sizeOf(data->references);
+   for (auto iter = data->usages.cbegin(); iter != data->usages.cend(); ++iter)
+   {
+      usage.strings += MemoryUsage::sizeOf(iter.key());
+      usage.containers += MemoryUsage::sizeOf(iter.value());
+   }
+
+   for (auto& types : data->references)
+   {
+      usage.strings += MemoryUsage::sizeOf(types);
+   }
+}
+
+/**
+ * Checks whether a type is referenced by at least one element.
+ *
+ * @param type Type identifier to be checked, e.g. the name of a classifier.
+ */
+bool TypeIndex::contains(QString type) const
+{
+   return data->usages.contains(type);
+}
+
+/**
+ * Gets the count of elements referencing a type.
+ *
+ * @param type Type identifier, e.g. the name of a classifier.
+ */
+int TypeIndex::usageCount(QString type) const
+{
+   return data->usages.value(type).size();
+}
+
+/**
+ * Gets the elements referencing a type (where-used list).
+ *
+ * The elements returned are the owners of the type strings: attributes, ports and operations for attribute, port, 
+ * parameter and return types as well as classifiers, packages and operations for template parameter types.
+ * @param type Type identifier, e.g. the name of a classifier.
+ * @returns List of referencing elements in no particular order.
+ */
+QList<UmlElement*> TypeIndex::usages(QString type) const
+{
+   auto iter = data->usages.constFind(type);
+   if (iter == data->usages.constEnd()) return QList<UmlElement*>();
+   return iter->keys();
+}
+
+/**
+ * Splits a type string into the identifiers it consists of.
+ *
+ * Identifiers are sequences of letters, digits and underscores; everything else (pointers, references, template
+ * brackets, namespace separators, array bounds) separates them. Identifiers starting with a digit are skipped.
+ * @param type Type string like &quot;std::map<Key, Value*>&quot;.
+ * @returns List of identifiers in order of appearance, e.g. &quot;std&quot;, &quot;map&quot;, &quot;Key&quot; and 
+ *          &quot;Value&quot;.
+ */
+QStringList TypeIndex::split(QString type)
+{
+   QStringList result;
+   int start = -1;
+   for (int index = 0; index <= type.size(); ++index)
+   {
+      bool isIdent = index < type.size() && (type[index].isLetterOrNumber() || type[index] == '_');
+      if (isIdent && start < 0)
+      {
+         start = index;
+      }
+      else if (!isIdent && start >= 0)
+      {
+         if (!type[start].isDigit()) result.append(type.mid(start, index - start));
+         start = -1;
+      }
+   }
+
+   return result;
+}
+
+/**
+ * Replaces an identifier in a type string.
+ *
+ * Only whole identifiers (see split()) are replaced, so replacing &quot;Order&quot; by &quot;Purchase&quot; turns 
+ * &quot;QList<Order*>&quot; into &quot;QList<Purchase*>&quot; but leaves &quot;OrderItem&quot; untouched.
+ * @param type Type string to be modified.
+ * @param oldName Identifier to be replaced.
+ * @param newName Replacement identifier.
+ * @returns The modified type string.
+ */
+QString TypeIndex::replace(QString type, QString oldName, QString newName)
+{
+   if (oldName.isEmpty() || !type.contains(oldName)) return type;
+
+   QString result;
+   int start = -1, last = 0;
+   for (int index = 0; index <= type.size(); ++index)
+   {
+      bool isIdent = index < type.size() && (type[index].isLetterOrNumber() || type[index] == '_');
+      if (isIdent && start < 0)
+      {
+         start = index;
+      }
+      else if (!isIdent && start >= 0)
+      {
+         if (type.midRef(start, index - start) == oldName)
+         {
+            result += type.midRef(last, start - last);
+            result += newName;
+            last = index;
+         }
+         start = -1;
+      }
+   }
+   result += type.midRef(last);
+
+   return result;
+}
@@ -0,0 +1,69 @@
+//---------------------------------------------------------------------------------------------------------------------
+// TypeIndex.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class TypeIndex.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "umlcommon_globals.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+class UmlElement;
+struct MemoryUsage;
+
+class UMLCOMMON_EXPORT TypeIndex final
+{
+public: // Constructors
+   TypeIndex();
+   TypeIndex(TypeIndex const&) = delete;
+   void operator=(TypeIndex const&) = delete;
+   ~TypeIndex();
+
+public: // Properties
+   int count() const;
+   QStringList types() const;
+
+public: // Methods
+   void update(UmlElement* elem);
+   void remove(UmlElement* elem);
+   void clear();
+   void measure(MemoryUsage& usage) const;
+
+   bool contains(QString type) const;
+   int usageCount(QString type) const;
+   QList<UmlElement*> usages(QString type) const;
+
+   static QStringList split(QString type);
+   static QString replace(QString type, QString oldName, QString newName);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
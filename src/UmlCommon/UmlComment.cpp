@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlComment.h"
+#include "MemoryUsage.h"
 #include "PropertyStrings.h"
 
 #include <QJsonObject>
@@ -115,6 +116,14 @@ void UmlComment::setBody(QString value)
    data->body = value;
 }
 
+/** Adds the estimated memory used by the comment to a MemoryUsage object, see UmlElement::measure(). */
+void UmlComment::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->body);
+}
+
 /**
  * Serializes properties of the UmlComment object to a JSON file.
  *
@@ -53,6 +53,7 @@ public: // Properties
 
 public: // Methods
    void serialize(QJsonObject& obj, bool read, int version) override;
+   void measure(MemoryUsage& usage) const override;
 
 private: // Attributes
    ///@cond
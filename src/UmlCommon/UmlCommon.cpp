@@ -108,7 +108,8 @@ public:
 /**
  * Initializes the UmlCommon library.
  * 
- * Call this function once to initialize the library and the factory method creating UmlElement instances.
+ * Call this function once to initialize the library and the factory method creating UmlElement instances. Also
+ * starts tracing if requested by environment variable VIRAQUCHA_TRACE (see Tracer::startFromEnvironment()).
  * @ingroup UmlCommon
  */
 void initCommon()
@@ -126,6 +127,7 @@ void initCommon()
       factory.subscribe(UmlPackage::staticMetaObject.className(), new UmlPackageBuilder());
       factory.subscribe(UmlTemplateBinding::staticMetaObject.className(), new UmlTemplateBindingBuilder());
       factory.subscribe(UmlUsageBuilder::className(), new UmlUsageBuilder());
+      Tracer::startFromEnvironment();
       isInitialized = true;
    }
 }
@@ -51,7 +51,18 @@
 #include "UmlTemplateBinding.h"
 #include "UmlTemplateParameter.h"
 
+#include "FileFingerprint.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "MemoryReport.h"
+#include "MemoryUsage.h"
 #include "NameBuilder.h"
+#include "ProjectDiff.h"
+#include "ProjectJournal.h"
+#include "ProjectMerge.h"
+#include "ProjectTransaction.h"
+#include "Tracer.h"
+#include "TypeIndex.h"
 
 /**
  * @defgroup UmlCommon
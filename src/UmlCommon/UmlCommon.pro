@@ -26,6 +26,7 @@
 #---------------------------------------------------------------------------------------------------------------------
 
 QT      -= gui
+QT      += concurrent
 TEMPLATE = lib
 VERSION  = 1.0.0
 TARGET   = UmlCommon
@@ -54,6 +55,7 @@ HEADERS += \
 ./DiaNode.h \
 ./DiaShape.h \
 ./ErrorTools.h \
+./FileFingerprint.h \
 ./EventType.h \
 ./FormatKind.h \
 ./ICompartmentProvider.h \
@@ -67,13 +69,23 @@ HEADERS += \
 ./IShapeObserver.h \
 ./IStereotypedElement.h \
 ./ITemplatableElement.h \
+./JsonReader.h \
+./JsonWriter.h \
 ./Label.h \
+./MemoryReport.h \
+./MemoryUsage.h \
 ./NameBuilder.h \
+./ProjectDiff.h \
+./ProjectJournal.h \
+./ProjectMerge.h \
+./ProjectTransaction.h \
 ./PropertyStrings.h \
 ./RoutingKind.h \
 ./SignatureChars.h \
 ./SignatureTools.h \
 ./TextBox.h \
+./Tracer.h \
+./TypeIndex.h \
 ./UmlComment.h \
 ./umlcommon_globals.h \
 ./UmlCommon.h \
@@ -100,10 +112,21 @@ SOURCES +=  \
 ./DiaNode.cpp \
 ./DiaShape.cpp \
 ./ErrorTools.cpp \
+./FileFingerprint.cpp \
+./JsonReader.cpp \
+./JsonWriter.cpp \
 ./Label.cpp \
+./MemoryReport.cpp \
+./MemoryUsage.cpp \
 ./NameBuilder.cpp \
+./ProjectDiff.cpp \
+./ProjectJournal.cpp \
+./ProjectMerge.cpp \
+./ProjectTransaction.cpp \
 ./SignatureTools.cpp \
 ./TextBox.cpp \
+./Tracer.cpp \
+./TypeIndex.cpp \
 ./UmlComment.cpp \
 ./UmlCommon.cpp \
 ./UmlCompositeElement.cpp \
@@ -26,10 +26,13 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlCompositeElement.h"
+#include "MemoryUsage.h"
+#include "INamedElement.h"
 #include "UmlLink.h"
 #include "UmlProject.h"
 #include "PropertyStrings.h"
 
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
 
@@ -47,6 +50,11 @@
  * sorted, e.g. when inserting or removing objects. However, it is possible to move objects in the list "up" or "down", 
  * i.e. functions are available with which the arrangement of the objects can be changed.
  *
+ * In addition, each composite keeps a hashed index of the names of its named child elements together with a counter
+ * per base name. The index is built on first use and kept up to date when children are inserted, removed or renamed,
+ * so checking for duplicate names (containsName(), nameCount()) and building new unique names (uniqueName()) do not 
+ * need to scan the list of elements.
+ *
  * Note: Although it is possible to create an object from this class, it is not recommended to do so. Since it is a
  * base class only you should better create objects from derived classes.
  */
@@ -57,7 +65,15 @@
  /// @cond
 struct UmlCompositeElement::Data
 {
+   Data()
+   : namesValid(false)
+   {
+   }
+
    QList<UmlElementPtr> elements;
+   QHash<QString, int>  names;    ///< Number of child elements per name
+   QHash<QString, int>  counters; ///< Next postfix number to be tried per base name
+   bool                 namesValid;
 };
 /// @endcond
 
@@ -124,6 +140,7 @@ void UmlCompositeElement::append(UmlElement* elem)
    {
       elem->setOwner(this);
       data->elements.append(UmlElementPtr(elem));
+      insertName(elem);
    }
 }
 
@@ -146,6 +163,7 @@ void UmlCompositeElement::insert(int pos, UmlElement* elem)
    if (pos > cnt) pos = cnt;
    elem->setOwner(this);
    data->elements.insert(pos, UmlElementPtr(elem));
+   insertName(elem);
 }
 
 /**
@@ -158,6 +176,7 @@ void UmlCompositeElement::remove(UmlElement* elem)
       elem->setOwner(nullptr);
       bool test = data->elements.removeOne(UmlElementPtr(elem));
       Q_ASSERT(test == true);
+      if (test) removeName(elem);
    }
 }
 
@@ -167,6 +186,9 @@ void UmlCompositeElement::remove(UmlElement* elem)
 void UmlCompositeElement::clear()
 {
    data->elements.clear();
+   data->names.clear();
+   data->counters.clear();
+   data->namesValid = true;
 }
 
 /**
@@ -234,6 +256,57 @@ UmlElement* UmlCompositeElement::at(int index)
    return data->elements.at(index).pointee();
 }
 
+/**
+ * Checks whether at least one child element of the composite has a specific name.
+ *
+ * @param name Name to be searched for.
+ */
+bool UmlCompositeElement::containsName(QString name) const
+{
+   buildNames();
+   return data->names.contains(name);
+}
+
+/**
+ * Counts the child elements of the composite having a specific name.
+ *
+ * Use this function for detecting duplicate names: a count greater than 1 means that the name is not unique within
+ * the composite.
+ * @param name Name to be counted.
+ */
+int UmlCompositeElement::nameCount(QString name) const
+{
+   buildNames();
+   return data->names.value(name, 0);
+}
+
+/**
+ * Builds a name not yet used by any child element of the composite.
+ *
+ * The name is built by adding a postfix number to a base name (like &quot;Class1&quot;, where &quot;Class&quot; is the
+ * base name). The search starts at the number found by the previous call for the same base name, so numbers freed by
+ * removing or renaming elements are not reused. The name is not reserved; calling the function twice without adding
+ * an element in between returns the same name.
+ * @param base Name base used to build the name.
+ * @returns A new unique name.
+ */
+QString UmlCompositeElement::uniqueName(QString base)
+{
+   buildNames();
+
+   int number = qMax(1, data->counters.value(base, 1));
+   QString form = QString("%1%2");
+   QString name = form.arg(base).arg(number);
+   while (data->names.contains(name))
+   {
+      ++number;
+      name = form.arg(base).arg(number);
+   }
+
+   data->counters[base] = number;
+   return name;
+}
+
 /**
  * Disposes the composite element.
  *
@@ -246,6 +319,15 @@ void UmlCompositeElement::dispose(bool disposing)
    super::dispose(disposing);
 }
 
+/** Adds the estimated memory used by the composite element to a MemoryUsage object, see UmlElement::measure(). */
+void UmlCompositeElement::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.containers += MemoryUsage::sizeOf(data->elements) + MemoryUsage::sizeOf(data->names) +
+      MemoryUsage::sizeOf(data->counters);
+}
+
 /**
  * Serializes properties of the UmlCompositeElement object to a JSON file.
  *
@@ -262,6 +344,9 @@ void UmlCompositeElement::serialize(QJsonObject& json, bool read, bool flat, int
    {
       if (json.contains(KPropElements))
       {
+         // Reading replaces the elements, so the element can be read again (see UmlProject::reload()):
+         if (!data->elements.isEmpty()) clear();
+
          array = json[KPropElements].toArray();
          for (int index = 0; index < array.size(); ++index)
          {
@@ -291,3 +376,69 @@ void UmlCompositeElement::serialize(QJsonObject& json, bool read, bool flat, int
       }
    }
 }
+
+/** Builds the name index from the list of child elements if it is not valid. */
+void UmlCompositeElement::buildNames() const
+{
+   if (data->namesValid) return;
+
+   data->names.clear();
+   for (auto elem : data->elements)
+   {
+      auto named = dynamic_cast<INamedElement*>(elem.pointee());
+      if (named != nullptr)
+      {
+         ++data->names[named->name()];
+      }
+   }
+
+   data->namesValid = true;
+}
+
+/** Adds the name of a child element to the name index. */
+void UmlCompositeElement::insertName(UmlElement* elem)
+{
+   auto named = dynamic_cast<INamedElement*>(elem);
+   if (data->namesValid && named != nullptr)
+   {
+      ++data->names[named->name()];
+   }
+}
+
+/** Removes the name of a child element from the name index. */
+void UmlCompositeElement::removeName(UmlElement* elem)
+{
+   auto named = dynamic_cast<INamedElement*>(elem);
+   if (data->namesValid && named != nullptr)
+   {
+      auto iter = data->names.find(named->name());
+      if (iter != data->names.end() && --iter.value() <= 0)
+      {
+         data->names.erase(iter);
+      }
+   }
+}
+
+/**
+ * Moves one occurrence of a name in the name index to another name.
+ *
+ * Called by UmlElement::updateNameIndex() whenever a child element is renamed.
+ */
+void UmlCompositeElement::updateName(QString oldName, QString newName)
+{
+   if (!data->namesValid || oldName == newName) return;
+
+   auto iter = data->names.find(oldName);
+   if (iter != data->names.end() && --iter.value() <= 0)
+   {
+      data->names.erase(iter);
+   }
+
+   ++data->names[newName];
+}
+
+/** Marks the name index as invalid; it is rebuilt on next use. */
+void UmlCompositeElement::invalidateNames()
+{
+   data->namesValid = false;
+}
@@ -34,6 +34,7 @@ class UMLCOMMON_EXPORT UmlCompositeElement : public UmlElement
 {
    /// @cond
    typedef UmlElement super;
+   friend class UmlElement;
    /// @endcond
 public: // Constructors
    UmlCompositeElement();
@@ -57,10 +58,22 @@ public: // Methods
    int indexOf(UmlElement* elem);
    UmlElement* at(int index);
 
+   bool containsName(QString name) const;
+   int nameCount(QString name) const;
+   QString uniqueName(QString base);
+   void measure(MemoryUsage& usage) const override;
+
 protected:
    void dispose(bool disposing) override;
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
 
+private: // Methods
+   void buildNames() const;
+   void insertName(UmlElement* elem);
+   void removeName(UmlElement* elem);
+   void updateName(QString oldName, QString newName);
+   void invalidateNames();
+
 private: // Attributes
    /// @cond
    struct Data;
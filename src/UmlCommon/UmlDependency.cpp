@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlDependency.h"
+#include "MemoryUsage.h"
 #include "UmlKeywords.h"
 
 #include "Label.h"
@@ -104,6 +105,7 @@ QString UmlDependency::name() const
 /** Sets the name of the UML dependency. */
 void UmlDependency::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -166,6 +168,15 @@ QVector<Label*> UmlDependency::labels()
    return result;
 }
 
+/** Adds the estimated memory used by the dependency to a MemoryUsage object, see UmlElement::measure(). */
+void UmlDependency::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->stereotype);
+}
+
 /**
  * Serializes properties of the UmlDependency instance to a JSON file.
  *
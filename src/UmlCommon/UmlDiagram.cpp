@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlDiagram.h"
+#include "MemoryUsage.h"
 #include "UmlElement.h"
 #include "UmlLink.h"
 #include "UmlProject.h"
@@ -33,8 +34,13 @@
 #include "DiaEdge.h"
 #include "DiaNode.h"
 #include "ErrorTools.h"
+#include "FileFingerprint.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
 #include "PropertyStrings.h"
+#include "Tracer.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QSaveFile>
 #include <QJsonArray>
@@ -42,6 +48,7 @@
 #include <QListIterator>
 #include <QString>
 #include <QUuid>
+#include <QtConcurrent/QtConcurrentMap>
 
 /**
  * @class UmlDiagram
@@ -103,6 +110,7 @@ struct UmlDiagram::Data
    QList<DiaNode*> nodes;
    QList<DiaEdge*> edges;
    bool            isOpen;
+   QJsonObject     recovered;
    QString         errorString;
 };
 /// @endcond
@@ -164,6 +172,16 @@ bool UmlDiagram::isOpen() const
    return data->isOpen;
 }
 
+/**
+ * Returns true if the diagram is open or holds shapes set by recoverShapes() while closed; otherwise false.
+ *
+ * The shapes of such diagrams are written by writeShapes() and thus by UmlProject::save().
+ */
+bool UmlDiagram::hasShapes() const
+{
+   return data->isOpen || !data->recovered.isEmpty();
+}
+
 /**
  * Gets the name of the diagram.
  */
@@ -177,6 +195,7 @@ QString UmlDiagram::name() const
  */
 void UmlDiagram::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -455,99 +474,175 @@ bool UmlDiagram::open()
    if (data->isOpen) return false;
    setErrorString("");
 
+   TraceSpan span("UmlDiagram::open");
+   span.setDetail(name());
+
+   // Shapes recovered from the journal of the project take precedence over the diagram file:
+   QJsonObject json = data->recovered;
+   data->recovered = QJsonObject();
+
    QString filename = diagramFile();
    QFile diafile(filename);
-   if (diafile.open(QIODevice::ReadOnly))
+   if (json.isEmpty() && diafile.open(QIODevice::ReadOnly))
    {
-      QJsonParseError error;
+      // Diagram files may hold thousands of shapes, they are read shape by shape instead of as a whole document:
+      QCryptographicHash hash(QCryptographicHash::Md5);
+      JsonReader reader(&diafile);
+      reader.setHash(&hash);
 
-      qDebug() << "Reading diagram file '" << filename << "'...";
-      auto doc = QJsonDocument::fromJson(diafile.readAll(), &error);
-      if (doc.isNull())
-      { 
-         setErrorString(QString(KFileParseError).arg(filename).arg(::toString(error)));
+      bool success = readShapes(reader);
+      if (reader.hasError())
+      {
+         setErrorString(QString(KFileParseError).arg(filename).arg(reader.errorString()));
          data->isOpen = true; // Diagram is open but empty!
          return false;
       }
 
-      QMap<DiaEdge*, QPair<QUuid, QUuid>> grid; // Needed for setting the shapes of an edge
-      QMap<QUuid, DiaShape*>              shapes;
-      int                                 index;
- 
-      // Read DiaNodes first:
-      auto json  = doc.object();
-      auto nodes = json[KPropNodes].toArray();
-      for (index = 0; index < nodes.size(); ++index)
+      diafile.close();
+      project()->setFingerprint(filename, FileFingerprint::of(QFileInfo(filename), hash));
+      data->isOpen = true;
+      return success;
+   }
+
+   bool success = json.isEmpty() || readShapes(json);
+   data->isOpen = true;
+   return success;
+}
+
+/**
+ * Creates the nodes and edges of the diagram from a JSON object written by writeShapes().
+ *
+ * @param json JSON object containing the arrays of nodes and edges.
+ * @returns true if successful; false if an edge could not be connected with its nodes.
+ */
+bool UmlDiagram::readShapes(const QJsonObject& json)
+{
+   QMap<DiaEdge*, QPair<QUuid, QUuid>> grid; // Needed for setting the shapes of an edge
+   QMap<QUuid, DiaShape*>              shapes;
+
+   for (auto value : json[KPropNodes].toArray()) readNode(value.toObject(), shapes);
+   for (auto value : json[KPropEdges].toArray()) readEdge(value.toObject(), shapes, grid);
+   return connectShapes(shapes, grid);
+}
+
+/**
+ * Creates the nodes and edges of the diagram from a diagram file read by a JsonReader.
+ *
+ * Only the JSON object of a single shape is built at a time. Keys other than nodes and edges are skipped.
+ * @param reader Reader positioned before the diagram object.
+ * @returns true if successful; false if the file could not be read or an edge could not be connected with its nodes.
+ */
+bool UmlDiagram::readShapes(JsonReader& reader)
+{
+   QMap<DiaEdge*, QPair<QUuid, QUuid>> grid;
+   QMap<QUuid, DiaShape*>              shapes;
+
+   if (reader.readNext() != JsonReader::TokenType::BeginObject) reader.raiseError("Expected a diagram object");
+   while (reader.readNext() == JsonReader::TokenType::Name)
+   {
+      QString key = reader.text();
+      if (reader.readNext() != JsonReader::TokenType::BeginArray || (key != KPropNodes && key != KPropEdges))
       {
-         auto obj = nodes[index].toObject();
-         auto id = QUuid(obj[KPropElement].toString());
-         
-         UmlElement* elem = nullptr;
-         if (project()->find(id, &elem))
-         {
-            elem->observers().append(this);
-            
-            auto* node = new DiaNode();
-            node->setElement(elem);
-            node->serialize(obj, true, KDiagramVersion);
-            
-            shapes.insert(id, node);
-            append(node);
-         }
-         else
-         {
-            qDebug() << "Element " << id.toString() << " was removed, node not created.";
-         }
+         reader.skipValue();
+         continue;
       }
 
-      // Then read DiaEdges...
-      auto edges = json[KPropEdges].toArray();
-      for (index = 0; index < edges.size(); ++index)
+      for (auto type = reader.readNext(); type != JsonReader::TokenType::EndArray; type = reader.readNext())
       {
-         auto obj = edges[index].toObject();
-         auto id = QUuid(obj[KPropLink].toString());
-
-         UmlElement* elem = nullptr;
-         if (project()->find(id, &elem))
-         {
-            elem->observers().append(this);
-            
-            auto* edge = new DiaEdge();
-            edge->setLink(dynamic_cast<UmlLink*>(elem));
-            edge->serialize(obj, true, KDiagramVersion);
-            
-            shapes.insert(id, edge);
-            grid.insert(edge, qMakePair(QUuid(obj[KPropNode1].toString()), QUuid(obj[KPropNode2].toString())));
-            append(edge);
-         }
-         else
-         {
-            qDebug() << "Link " << id.toString() << " was removed, edge not created.";
-         }
+         if (type == JsonReader::TokenType::Invalid) break;
+
+         auto obj = reader.readValue().toObject();
+         if (key == KPropNodes) readNode(obj, shapes);
+         else readEdge(obj, shapes, grid);
       }
+   }
+
+   if (reader.tokenType() != JsonReader::TokenType::EndObject) reader.raiseError("Expected the end of the diagram");
+   if (reader.readNext() != JsonReader::TokenType::EndDocument || reader.hasError())
+   {
+      clear();
+      return false;
+   }
+
+   return connectShapes(shapes, grid);
+}
+
+/** Creates a node of the diagram from its JSON object, unless its element was removed from the project. */
+void UmlDiagram::readNode(const QJsonObject& json, QMap<QUuid, DiaShape*>& shapes)
+{
+   auto id = QUuid(json[KPropElement].toString());
+
+   UmlElement* elem = nullptr;
+   if (project()->find(id, &elem))
+   {
+      elem->observers().append(this);
+
+      auto obj = json;
+      auto* node = new DiaNode();
+      node->setElement(elem, false);
+      node->serialize(obj, true, KDiagramVersion);
+
+      shapes.insert(id, node);
+      append(node);
+   }
+   else
+   {
+      qDebug() << "Element " << id.toString() << " was removed, node not created.";
+   }
+}
+
+/** Creates an edge of the diagram from its JSON object, unless its link was removed from the project. */
+void UmlDiagram::readEdge(const QJsonObject& json, QMap<QUuid, DiaShape*>& shapes,
+                          QMap<DiaEdge*, QPair<QUuid, QUuid>>& grid)
+{
+   auto id = QUuid(json[KPropLink].toString());
+
+   UmlElement* elem = nullptr;
+   if (project()->find(id, &elem))
+   {
+      elem->observers().append(this);
+
+      auto obj = json;
+      auto* edge = new DiaEdge();
+      edge->setLink(dynamic_cast<UmlLink*>(elem));
+      edge->serialize(obj, true, KDiagramVersion);
+
+      shapes.insert(id, edge);
+      grid.insert(edge, qMakePair(QUuid(json[KPropNode1].toString()), QUuid(json[KPropNode2].toString())));
+      append(edge);
+   }
+   else
+   {
+      qDebug() << "Link " << id.toString() << " was removed, edge not created.";
+   }
+}
+
+/**
+ * Fills the compartments of the nodes read and connects the edges read with their nodes.
+ * @returns true if successful; false if an edge could not be connected with its nodes.
+ */
+bool UmlDiagram::connectShapes(const QMap<QUuid, DiaShape*>& shapes, const QMap<DiaEdge*, QPair<QUuid, QUuid>>& grid)
+{
+   // Fill the compartments of all nodes on the thread pool, this is the expensive part of opening diagrams with
+   // many classifiers. Filling a compartment only reads from the model:
+   QtConcurrent::blockingMap(data->nodes, [](DiaNode* node) { node->update(); });
 
-      // ...and connect them with their DiaShapes:
-      for (index = 0; index < data->edges.size(); ++index)
+   // Connect the edges with their DiaShapes:
+   for (int index = 0; index < data->edges.size(); ++index)
+   {
+      auto* edge = data->edges[index];
+      auto  pair = grid.value(edge);
+
+      edge->setShape1(shapes.value(pair.first));
+      edge->setShape2(shapes.value(pair.second));
+      if (edge->shape1() == nullptr || edge->shape2() == nullptr)
       {
-         auto* edge = data->edges[index];
-         auto  pair = grid[edge];
-
-         edge->setShape1(shapes[pair.first]);
-         edge->setShape2(shapes[pair.second]);
-         if (edge->shape1() == nullptr || edge->shape2() == nullptr)
-         {
-            setErrorString("Error connecting edge shape");
-            clear();
-            data->isOpen = true;
-            return false;
-         }
+         setErrorString("Error connecting edge shape");
+         clear();
+         return false;
       }
-
-      qDebug() << "Done.";
-      diafile.close();
    }
 
-   data->isOpen = true;
    return true;
 }
 
@@ -571,48 +666,110 @@ bool UmlDiagram::save()
    if (!data->isOpen) return false;
    setErrorString("");
 
+   TraceSpan span("UmlDiagram::save");
+   span.setDetail(name());
+
    QString   filename = diagramFile();
    QSaveFile diafile(filename);
    if (diafile.open(QIODevice::WriteOnly | QIODevice::Truncate))
    {
-      qDebug() << "Writing diagram file '" << filename << "'...";
       QJsonObject json;
+      writeShapes(json);
 
-      // Add DiaNodes to the JSON file:
-      QJsonArray nodes;
-      for (auto* node : data->nodes)
+      auto content = JsonWriter::toCanonical(json);
+      diafile.write(content);
+      if (diafile.commit())
       {
-         QJsonObject obj;
-         obj[KPropElement] = node->element()->identifier().toString();
-         node->serialize(obj, false, KDiagramVersion);
-         nodes.append(obj);
+         project()->setFingerprint(filename, FileFingerprint::of(QFileInfo(filename), content));
+         return true;
       }
-      json[KPropNodes] = nodes;
+   }
 
-      // Add DiaEdges to the JSON file:
-      QJsonArray edges;
-      for (auto* edge : data->edges)
-      {
-         auto* link = edge->link();
-
-         QJsonObject obj;
-         obj[KPropLink] = link->identifier().toString();
-         obj[KPropNode1] = link->source()->identifier().toString();
-         obj[KPropNode2] = link->target()->identifier().toString();
-         edge->serialize(obj, false, KDiagramVersion);
-         edges.append(obj);
-      }
-      json[KPropEdges] = edges;
+   setErrorString(QString(KFileWriteError).arg(filename).arg(diafile.errorString()));
+   return false;
+}
+
+/**
+ * Reads the nodes and edges of the open diagram again from its diagram file, e.g. after the file was changed by a
+ * version control system (see UmlProject::reload()).
+ *
+ * All shapes are replaced, so views of the diagram must rebuild their items afterwards.
+ * @returns true if successful; false if the diagram is not open or its file cannot be read.
+ */
+bool UmlDiagram::reload()
+{
+   if (!data->isOpen) return false;
+
+   close();
+   return open();
+}
 
-      QJsonDocument doc(json);
-      diafile.write(doc.toJson(QJsonDocument::Compact));
-      diafile.commit();
-      qDebug() << "Done.";
-      return true;
+/**
+ * Writes the nodes and edges of the open diagram to a JSON object, in the format of the diagram file.
+ *
+ * A closed diagram writes the shapes set by recoverShapes(), if any.
+ * @param json JSON object receiving the arrays of nodes and edges.
+ */
+void UmlDiagram::writeShapes(QJsonObject& json) const
+{
+   if (!data->isOpen && !data->recovered.isEmpty())
+   {
+      json = data->recovered;
+      return;
    }
 
-   qDebug() << "Diagram file '" << filename << "' cannot be opened for writing.";
-   return false;
+   // Add DiaNodes to the JSON object:
+   QJsonArray nodes;
+   for (auto* node : data->nodes)
+   {
+      QJsonObject obj;
+      obj[KPropElement] = node->element()->identifier().toString();
+      node->serialize(obj, false, KDiagramVersion);
+      nodes.append(obj);
+   }
+   json[KPropNodes] = nodes;
+
+   // Add DiaEdges to the JSON object:
+   QJsonArray edges;
+   for (auto* edge : data->edges)
+   {
+      auto* link = edge->link();
+
+      QJsonObject obj;
+      obj[KPropLink] = link->identifier().toString();
+      obj[KPropNode1] = link->source()->identifier().toString();
+      obj[KPropNode2] = link->target()->identifier().toString();
+      edge->serialize(obj, false, KDiagramVersion);
+      edges.append(obj);
+   }
+   json[KPropEdges] = edges;
+}
+
+/**
+ * Sets nodes and edges recovered from the journal of the project (see ProjectJournal) or changed while the diagram
+ * was closed.
+ *
+ * The shapes replace the contents of the diagram file the next time the diagram is opened and are written by the next
+ * UmlProject::save(), see hasShapes(). The function does nothing if the diagram is already open.
+ * @param json JSON object containing the arrays of nodes and edges written by writeShapes().
+ */
+void UmlDiagram::recoverShapes(const QJsonObject& json)
+{
+   if (!data->isOpen) data->recovered = json;
+}
+
+/** Adds the estimated memory used by the diagram to a MemoryUsage object, see UmlElement::measure(). */
+void UmlDiagram::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->errorString);
+   usage.containers += MemoryUsage::sizeOf(data->nodes) + MemoryUsage::sizeOf(data->edges);
+
+   // Nodes and edges only exist while the diagram is open:
+   for (auto* node : data->nodes) node->measure(usage);
+   for (auto* edge : data->edges) edge->measure(usage);
 }
 
 /**
@@ -636,7 +793,6 @@ void UmlDiagram::serialize(QJsonObject& json, bool read, bool flat, int version)
       json[KPropName] = data->name;
       json[KPropComment] = data->comment;
       json[KPropDiagramKind] = (int)data->kind;
-      save();
    }
 }
 
@@ -653,6 +809,13 @@ void UmlDiagram::notify(UmlElement* sender, EventType type)
    {
       removeById(sender->identifier());
    }
+   else if (type == EventType::ObjectChanged)
+   {
+      for (auto* node : data->nodes)
+      {
+         if (node->element() == sender) node->update();
+      }
+   }
 }
 
 /** Gets a string representation of the object. */
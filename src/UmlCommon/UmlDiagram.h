@@ -34,8 +34,13 @@
 #include "IElementObserver.h"
 #include "INamedElement.h"
 
+#include <QMap>
+#include <QPair>
+
 class DiaNode;
 class DiaEdge;
+class DiaShape;
+class JsonReader;
 
 class UMLCOMMON_EXPORT UmlDiagram : public UmlElement, public INamedElement, public IElementObserver
 {
@@ -53,6 +58,7 @@ public: // Properties
    QString diagramFile() const;
 
    bool isOpen() const;
+   bool hasShapes() const;
    
    QString name() const override;
    void setName(QString value) override;
@@ -88,10 +94,15 @@ public: // Methods
    bool open();
    void close();
    bool save();
+   bool reload();
+
+   void writeShapes(QJsonObject& json) const;
+   void recoverShapes(const QJsonObject& json);
 
    void notify(UmlElement* sender, EventType type) override;
 
    QString toString() const override;
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void dispose(bool disposing) override;
@@ -100,6 +111,11 @@ protected:
 private:
    void append(DiaNode* node);
    void append(DiaEdge* edge);
+   bool readShapes(const QJsonObject& json);
+   bool readShapes(JsonReader& reader);
+   void readNode(const QJsonObject& json, QMap<QUuid, DiaShape*>& shapes);
+   void readEdge(const QJsonObject& json, QMap<QUuid, DiaShape*>& shapes, QMap<DiaEdge*, QPair<QUuid, QUuid>>& grid);
+   bool connectShapes(const QMap<QUuid, DiaShape*>& shapes, const QMap<DiaEdge*, QPair<QUuid, QUuid>>& grid);
    void setErrorString(QString value);
 
 private: // Attributes
@@ -26,10 +26,13 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlElement.h"
+#include "MemoryUsage.h"
+#include "MemoryUsage.h"
 #include "UmlCompositeElement.h"
 #include "UmlLink.h"
 #include "UmlProject.h"
 #include "PropertyStrings.h"
+#include "TypeIndex.h"
 
 #include <QAtomicInteger>
 #include <QDebug>
@@ -248,6 +251,18 @@ QList<IElementObserver*>& UmlElement::observers() const
    return data->observers;
 }
 
+/**
+ * Gets the type strings referenced by the UmlElement object.
+ *
+ * Elements storing types as strings (attributes, operations, template parameters and the like) override this function
+ * to return them. The result is used to build the where-used index of the project, see class TypeIndex.
+ * @returns An empty list in this base implementation.
+ */
+QStringList UmlElement::typeReferences() const
+{
+   return QStringList();
+}
+
 /**
  * Gets the owner of the UmlElement object.
  *
@@ -282,6 +297,8 @@ void UmlElement::copyTo(UmlElement* other)
       QJsonObject obj;
       serialize(obj, false, true, KFileVersion);
       other->serialize(obj, true, true, KFileVersion);
+      other->updateTypeIndex();
+      if (other->owner() != nullptr) other->owner()->invalidateNames();
    }
 }
 
@@ -354,10 +371,57 @@ bool UmlElement::isLinkedTo(UmlLink* link)
    return false;
 }
 
+/**
+ * Renames a type in all type strings of the UmlElement object.
+ *
+ * Elements overriding typeReferences() must override this function as well. It is called by UmlProject::renameType()
+ * for all elements found in the type index and must update the index after modifying the type strings.
+ * @param oldName Identifier of the type to be renamed.
+ * @param newName New identifier of the type.
+ * @returns True if at least one type string was modified; otherwise false. Always false in this base implementation.
+ */
+bool UmlElement::renameTypeReference(QString oldName, QString newName)
+{
+   Q_UNUSED(oldName);
+   Q_UNUSED(newName);
+   return false;
+}
+
+/**
+ * Updates the entries of the UmlElement object in the type index of its project.
+ *
+ * Must be called whenever a type string returned by typeReferences() changes. Does nothing if the object is not yet 
+ * assigned to a project.
+ */
+void UmlElement::updateTypeIndex()
+{
+   if (project() != nullptr)
+   {
+      project()->typeIndex().update(this);
+   }
+}
+
+/**
+ * Updates the name index of the owner after the UmlElement object has been renamed.
+ *
+ * Must be called by all implementations of INamedElement::setName() before the new name is assigned. Does nothing if
+ * the object is not yet owned by a composite.
+ * @param oldName Name of the object before renaming.
+ * @param newName Name of the object after renaming.
+ */
+void UmlElement::updateNameIndex(QString oldName, QString newName)
+{
+   if (data->owner != nullptr)
+   {
+      data->owner->updateName(oldName, newName);
+   }
+}
+
 /**
  * Serializes properties of the UmlElement object to a QJsonObject.
  *
- * Calls protected function serialize(QJsonObject&, bool, bool, int).
+ * Calls protected function serialize(QJsonObject&, bool, bool, int). After reading, the type index of the project is
+ * updated and the name index of the owner is invalidated.
  * @param json QJsonObject object to be used for serialization.
  * @param read If true: reads from the QJsonObject; otherwise writes to the QJsonObject.
  * @param version Version of the JSON file format.
@@ -365,6 +429,11 @@ bool UmlElement::isLinkedTo(UmlLink* link)
 void UmlElement::serialize(QJsonObject& json, bool read, int version)
 {
    serialize(json, read, false, version);
+   if (read)
+   {
+      updateTypeIndex();
+      if (data->owner != nullptr) data->owner->invalidateNames();
+   }
 }
 
 /**
@@ -412,6 +481,23 @@ QString UmlElement::toString() const
    return className() + " {" + identifier().toString() + "}";
 }
 
+/**
+ * Adds the estimated memory used by the UmlElement object to a MemoryUsage object.
+ *
+ * This base implementation adds the object, its Data struct, its keywords and the lists of links and observers.
+ * Derived classes override this function to add their own Data struct, strings and containers as well as objects
+ * owned by them, e.g. the parameters of operations or the nodes and edges of open diagrams. Child elements of
+ * composite elements are measured on their own, see class MemoryReport.
+ * @param usage MemoryUsage object to be added to.
+ */
+void UmlElement::measure(MemoryUsage& usage) const
+{
+   usage.objects += sizeof(UmlElement) + sizeof(Data);
+   usage.strings += MemoryUsage::sizeOf(data->keywords);
+   usage.containers += MemoryUsage::sizeOf(data->links);
+   usage.observers += MemoryUsage::sizeOf(data->observers);
+}
+
 /**
  * Disposes the UmlElement object.
  *
@@ -36,6 +36,7 @@
 #include <QByteArray>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QUuid>
 
 #ifdef _DEBUG
@@ -47,6 +48,7 @@ void assertClean();
 class UmlCompositeElement;
 class UmlLink;
 class UmlProject;
+struct MemoryUsage;
 
 class UMLCOMMON_EXPORT UmlElement : public ISerializable
 {
@@ -82,6 +84,8 @@ public: // Properties
 
    QList<IElementObserver*>& observers() const;
 
+   virtual QStringList typeReferences() const;
+
 public: // Methods:
    virtual void copyTo(UmlElement* other);
    virtual void copyTo(QByteArray& array);
@@ -91,6 +95,10 @@ public: // Methods:
    void unlink(UmlLink* link);
    bool isLinkedTo(UmlLink* link);
 
+   virtual bool renameTypeReference(QString oldName, QString newName);
+   void updateTypeIndex();
+   void updateNameIndex(QString oldName, QString newName);
+
    void serialize(QJsonObject& json, bool read, int version) override;
 
    void incRefCount();
@@ -98,11 +106,13 @@ public: // Methods:
    quint32 refCount() const;
 
    virtual QString toString() const;
+   virtual void measure(MemoryUsage& usage) const;
+
+   void send(EventType type);
 
 protected:
    virtual void dispose(bool disposing);
    virtual void serialize(QJsonObject& json, bool read, bool flat, int version);
-   void send(EventType type);
 
 private: // Attributes
    ///@cond
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlLink.h"
+#include "MemoryUsage.h"
 #include "UmlElement.h"
 #include "UmlProject.h"
 #include "PropertyStrings.h"
@@ -180,6 +181,13 @@ void UmlLink::dispose(bool disposing)
    super::dispose(disposing);
 }
 
+/** Adds the estimated memory used by the link to a MemoryUsage object, see UmlElement::measure(). */
+void UmlLink::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+}
+
 /**
  * Serializes properties of the UmlLink instance to a JSON file.
  *
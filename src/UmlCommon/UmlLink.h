@@ -58,6 +58,9 @@ public: // Properties
    virtual bool isDirected() const;
    virtual void swap();
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 protected: // Methods
    void dispose(bool disposing) override;
    void serialize(QJsonObject& json, bool read, bool flat, int version) override;
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlModel.h"
+#include "MemoryUsage.h"
 #include "UmlKeywords.h"
 #include "PropertyStrings.h"
 
@@ -102,6 +103,14 @@ void UmlModel::setViewpoint(QString value)
    data->viewpoint = value;
 }
 
+/** Adds the estimated memory used by the model to a MemoryUsage object, see UmlElement::measure(). */
+void UmlModel::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->viewpoint);
+}
+
 /**
  * Serializes properties of the UmlModel instance to a JSON file.
  *
@@ -51,6 +51,9 @@ public: // Properties
    QString viewpoint() const;
    void setViewpoint(QString value);
 
+public: // Methods
+   void measure(MemoryUsage& usage) const override;
+
 protected: // Methods
    void serialize(QJsonObject& obj, bool read, bool flat, int version) override;
 
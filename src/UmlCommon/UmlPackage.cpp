@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlPackage.h"
+#include "MemoryUsage.h"
 #include "UmlDiagram.h"
 #include "UmlLink.h"
 #include "UmlTemplateBinding.h"
@@ -34,6 +35,7 @@
 #include "Compartment.h"
 #include "PropertyStrings.h"
 #include "TextBox.h"
+#include "TypeIndex.h"
 
 #include <QJsonArray>
 
@@ -97,6 +99,7 @@ UmlPackage::UmlPackage(QUuid id)
 
 UmlPackage::~UmlPackage()
 {
+   for (auto& param : data->templParams) param->setOwner(nullptr);
    delete data;
 }
 
@@ -119,6 +122,7 @@ QString UmlPackage::name() const
  */
 void UmlPackage::setName(QString value)
 {
+   updateNameIndex(data->name, value);
    data->name = value;
 }
 
@@ -226,7 +230,9 @@ void UmlPackage::append(UmlTemplateParameter* par)
 {
    if (par != nullptr)
    {
+      par->setOwner(this);
       data->templParams.append(UmlTemplateParameterPtr(par));
+      updateTypeIndex();
    }
 }
 
@@ -236,9 +242,10 @@ void UmlPackage::append(UmlTemplateParameter* par)
  */
 void UmlPackage::remove(UmlTemplateParameter* par)
 {
-   if (par != nullptr)
+   if (par != nullptr && data->templParams.removeOne(UmlTemplateParameterPtr(par)))
    {
-      data->templParams.removeOne(UmlTemplateParameterPtr(par));
+      par->setOwner(nullptr);
+      updateTypeIndex();
    }
 }
 
@@ -247,7 +254,38 @@ void UmlPackage::remove(UmlTemplateParameter* par)
  */
 void UmlPackage::clearTemplate()
 {
+   for (auto& param : data->templParams) param->setOwner(nullptr);
    data->templParams.clear();
+   updateTypeIndex();
+}
+
+/**
+ * Gets the types of the template parameter of the package.
+ *
+ * See also class TypeIndex.
+ */
+QStringList UmlPackage::typeReferences() const
+{
+   QStringList list;
+   for (auto& param : data->templParams) list.append(param->type());
+   return list;
+}
+
+/** Renames a type in the types of the template parameter of the package, see UmlProject::renameType(). */
+bool UmlPackage::renameTypeReference(QString oldName, QString newName)
+{
+   bool result = false;
+   for (auto& param : data->templParams)
+   {
+      QString type = TypeIndex::replace(param->type(), oldName, newName);
+      if (type != param->type())
+      {
+         param->setType(type);
+         result = true;
+      }
+   }
+
+   return result;
 }
 
 /**
@@ -262,6 +300,17 @@ void UmlPackage::dispose(bool disposing)
    super::dispose(disposing);
 }
 
+/** Adds the estimated memory used by the package to a MemoryUsage object, see UmlElement::measure(). */
+void UmlPackage::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->comment) +
+      MemoryUsage::sizeOf(data->uri);
+   usage.containers += MemoryUsage::sizeOf(data->templParams);
+   for (auto& par : data->templParams) par->measure(usage);
+}
+
 /**
  * Serializes properties of the UmlPackage object to a JSON file.
  *
@@ -280,6 +329,7 @@ void UmlPackage::serialize(QJsonObject& json, bool read, bool flat, int version)
       data->uri = json[KPropURI].toString();
 
       auto array = json[KPropTemplParam].toArray();
+      if (!data->templParams.isEmpty()) clearTemplate();
       for (int index = 0; index < array.size(); ++index)
       {
          auto* par = new UmlTemplateParameter();
@@ -73,6 +73,9 @@ public: // Properties
    QList<UmlTemplateParameter*> templateParameter() const override;
    bool isTemplated() const override;
 
+   QStringList typeReferences() const override;
+   bool renameTypeReference(QString oldName, QString newName) override;
+
 public: // Methods
    void append(UmlTemplateParameter* par) override;
    void remove(UmlTemplateParameter* par) override;
@@ -82,6 +85,7 @@ public: // Methods
    void update(int index, Compartment* comp) override;
 
    QString toString() const override;
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void dispose(bool disposing) override;
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlParameterSubstitution.h"
+#include "MemoryUsage.h"
 #include "PropertyStrings.h"
 
 /**
@@ -91,6 +92,13 @@ void UmlParameterSubstitution::setActualParam(QString value)
    data->actualParam = value;
 }
 
+/** Adds the estimated memory used by the parameter substitution to a MemoryUsage object. */
+void UmlParameterSubstitution::measure(MemoryUsage& usage) const
+{
+   usage.objects += sizeof(UmlParameterSubstitution) + sizeof(Data);
+   usage.strings += MemoryUsage::sizeOf(data->templParam) + MemoryUsage::sizeOf(data->actualParam);
+}
+
 /**
  * Serializes properties of the UmlParameterSubstitution instance to a JSON file.
  *
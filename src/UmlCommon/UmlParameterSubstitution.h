@@ -31,6 +31,8 @@
 #include "umlcommon_globals.h"
 #include "ISerializable.h"
 
+struct MemoryUsage;
+
 class UMLCOMMON_EXPORT UmlParameterSubstitution : public ISerializable
 {
 public: // Constructors
@@ -46,6 +48,7 @@ public: // Properties
 
 public: // Methods
    void serialize(QJsonObject& json, bool read, int version) override;
+   void measure(MemoryUsage& usage) const;
 
 private:
    ///@cond
@@ -31,18 +31,36 @@
 #include "UmlLink.h"
 #include "UmlRoot.h"
 #include "ErrorTools.h"
+#include "FileFingerprint.h"
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "MemoryUsage.h"
+#include "ProjectJournal.h"
+#include "ProjectTransaction.h"
 #include "INamedElement.h"
 #include "PropertyStrings.h"
+#include "Tracer.h"
+#include "TypeIndex.h"
+#include "UmlDiagram.h"
 
+#include <QDateTime>
 #include <QDebug>
+#include <QCryptographicHash>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QHash>
 #include <QHashIterator>
+#include <QMap>
 #include <QSaveFile>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <algorithm>
 
 /**
  * @class UmlProject
@@ -145,6 +163,26 @@
  * ~~~
  * After calling dispose(), the project cannot be used any more, all files removed from the project are removed, all
  * elements are diposed and - provided no other objects hold references (intrusive pointers) to them - deleted.
+ *
+ * ### Autosave and recovery
+ *
+ * Function save() serializes all elements to find the files changed and takes too long to be called every minute on
+ * big projects. After calling openJournal(), the project records the elements inserted, removed or marked as
+ * modified (see markModified()) instead, and autosave() appends their current state to a journal next to the UPRJ
+ * file (see ProjectJournal). The cost of autosave() depends on the number of changes only.
+ *
+ * If the program crashes, function load() replays the journal on top of the element files; recoveredCount() then
+ * tells how many autosaves were recovered, and the project is marked as modified. Function compact() autosaves and
+ * folds the journal into the element files and the UPRJ file on a background thread, which makes it a cheap 
+ * alternative to save(). Calling save() discards the journal, since all changes are written to the element files.
+ *
+ * ### Transactional save
+ *
+ * By default, save() replaces each file through its own QSaveFile. If the project is transactional (see
+ * isTransactional()), save() stages the files changed in a ProjectTransaction instead, makes them durable with one
+ * sync barrier and publishes them together. This is faster for big projects, and a crash never leaves a project with
+ * some files written and others not: load() completes or drops an interrupted transaction. The compaction of the
+ * journal always uses a transaction.
  */
 
 const QString KArtifactsFolder = "artifacts";
@@ -153,18 +191,34 @@ const QString KDiagramsFolder  = "diagrams";
 const QString KElementsFolder  = "elements";
 const QString KDirSep          = "/";
 const QString KUPRJExt         = ".uprj";
+const QString KJournalExt      = ".journal";
+const QString KCompactExt      = ".compact";
 const QUuid   KRootIdentifier  = QUuid("{4CD3CF41-E522-4101-B57D-402CD2E8DF50}");
 
  //---------------------------------------------------------------------------------------------------------------------
  // Internal struct hiding implementation details
  //---------------------------------------------------------------------------------------------------------------------
  /// @cond
+/** Result of folding a journal into the files of the project, see compactJournal(). */
+struct Compaction
+{
+   QString                         errorString;
+   QHash<QString, FileFingerprint> written; // Fingerprints of the files written
+   QStringList                     removed; // Files removed
+};
+
 struct UmlProject::Data
 {
    Data() 
    : root(nullptr)
    , isModified(false)
    , isDisposed(false)
+   , journalFiles(0)
+   , recovered(0)
+   , compacting(false)
+   , compactedFiles(0)
+   , changes(0)
+   , transactional(false)
    {}
 
    UmlRoot*                    root;
@@ -181,11 +235,182 @@ struct UmlProject::Data
    QStringList                 primitiveTypes;
    QStringList                 stereoTypes;
    QStringList                 removedFiles;
+   QSet<UmlElement*>           modifiedElements;
+   TypeIndex                   typeIndex;
    bool                        isDisposed;
    QString                     errorString;
+   QString                     fileName;
+   ProjectJournal              journal;
+   QSet<UmlElement*>           journalPending;
+   QSet<QUuid>                 journalRemoved;
+   QHash<QUuid, QByteArray>    journalShapes;
+   int                         journalFiles;
+   int                         recovered;
+   QFuture<Compaction>         compaction;
+   QFutureWatcher<Compaction>  watcher;
+   bool                        compacting;
+   QSet<UmlElement*>           compactedElements; // Elements modified when the running compaction was started
+   int                         compactedFiles;    // Number of removed files folded by the running compaction
+   int                         changes;           // Number of times the project was marked as modified
+   bool                        transactional;
+   QHash<QString, FileFingerprint> fingerprints;
 };
 /// @endcond
 
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Writes the content of a project file in canonical form (see JsonWriter).
+ *
+ * The element index is sorted by identifier, so a project whose elements did not change is written as the same bytes,
+ * regardless of the order the elements are kept in memory.
+ * @param header Properties of the project file except the element index.
+ * @param index Class names of the elements by their identifiers.
+ */
+static QByteArray writeProjectFile(const QJsonObject& header, const QMap<QString, QString>& index)
+{
+   QByteArray content;
+   JsonWriter writer(&content);
+   auto writeIndex = [&writer, &index]()
+   {
+      writer.name(KPropElements);
+      writer.beginArray();
+      for (auto iter = index.cbegin(); iter != index.cend(); ++iter)
+      {
+         writer.beginObject();
+         writer.name(KPropClass);
+         writer.value(iter.value());
+         writer.name(KPropIdentifier);
+         writer.value(iter.key());
+         writer.endObject();
+      }
+      writer.endArray();
+   };
+
+   bool isWritten = false;
+   writer.beginObject();
+   for (auto iter = header.constBegin(); iter != header.constEnd(); ++iter)
+   {
+      if (iter.key() == KPropElements) continue;
+      if (!isWritten && KPropElements < iter.key())
+      {
+         writeIndex();
+         isWritten = true;
+      }
+
+      writer.write(iter.key(), iter.value());
+   }
+
+   if (!isWritten) writeIndex();
+   writer.endObject();
+   return content;
+}
+
+/**
+ * Folds a journal file into the element files, the diagram files and the project file and removes it afterwards. 
+ *
+ * Works on files only and is therefore run on a background thread by UmlProject::compact(). If it fails, the journal
+ * file is kept and folded again by the next compaction or replayed by UmlProject::load().
+ * @returns The fingerprints of the files written and the files removed, or an error description.
+ */
+static Compaction compactJournal(QString journalFile, QString projectFile, QString elementsFolder,
+   QString diagramsFolder)
+{
+   TraceSpan span("UmlProject::compact");
+   span.setDetail(journalFile);
+
+   Compaction result;
+   ProjectJournal::Overlay overlay;
+   if (!ProjectJournal::fold(journalFile, overlay, &result.errorString)) return result;
+
+   ProjectTransaction transaction(QFileInfo(projectFile).path());
+   auto fail = [&result](QString error)
+   {
+      result.errorString = error;
+      result.written.clear();
+      result.removed.clear();
+      return result;
+   };
+
+   auto write = [&transaction, &result](QString name, const QByteArray& content)
+   {
+      FileFingerprint print;
+      print.size = content.size();
+      print.hash = FileFingerprint::hashOf(content);
+      result.written.insert(name, print);
+      return transaction.write(name, content);
+   };
+
+   if (!transaction.begin()) return fail(transaction.errorString());
+
+   for (auto iter = overlay.elements.cbegin(); iter != overlay.elements.cend(); ++iter)
+   {
+      QString name = KDirSep + iter.key().toString() + ".json";
+      auto json = JsonWriter::toCanonical(iter.value()[KPropData].toObject());
+      bool success = write(elementsFolder + name, json);
+      if (success && iter.value().contains(KPropShapes))
+      {
+         json = JsonWriter::toCanonical(iter.value()[KPropShapes].toObject());
+         success = write(diagramsFolder + name, json);
+      }
+
+      if (!success) return fail(transaction.errorString());
+   }
+
+   // Update the list of elements of the project file:
+   QFile prjfile(projectFile);
+   if (!prjfile.open(QIODevice::ReadOnly))
+   {
+      return fail(QString(KFileReadError).arg(projectFile).arg(prjfile.errorString()));
+   }
+
+   QJsonParseError parseError;
+   auto doc = QJsonDocument::fromJson(prjfile.readAll(), &parseError);
+   prjfile.close();
+   if (doc.isNull()) return fail(QString(KFileParseError).arg(projectFile).arg(toString(parseError)));
+
+   QMap<QString, QString> index;
+   auto prj = doc.object();
+   for (auto value : prj[KPropElements].toArray())
+   {
+      QUuid id(value.toObject()[KPropIdentifier].toString());
+      if (overlay.removed.contains(id)) continue;
+      index.insert(id.toString(), value.toObject()[KPropClass].toString());
+   }
+
+   for (auto iter = overlay.elements.cbegin(); iter != overlay.elements.cend(); ++iter)
+   {
+      QString id = iter.key().toString();
+      if (!index.contains(id)) index.insert(id, iter.value()[KPropClass].toString());
+   }
+
+   for (auto key : overlay.project.keys()) prj[key] = overlay.project[key];
+   prj.remove(KPropElements);
+   prj[KPropCount] = index.size();
+   prj[KPropVersion] = (int)KFileVersion;
+   if (!write(projectFile, writeProjectFile(prj, index))) return fail(transaction.errorString());
+
+   for (auto& id : overlay.removed)
+   {
+      result.removed.append(elementsFolder + KDirSep + id.toString() + ".json");
+      result.removed.append(diagramsFolder + KDirSep + id.toString() + ".json");
+   }
+
+   result.removed.append(overlay.removedFiles);
+   for (auto& filename : result.removed) transaction.remove(filename);
+   if (!transaction.commit()) return fail(transaction.errorString());
+
+   for (auto iter = result.written.begin(); iter != result.written.end(); ++iter)
+   {
+      iter->modified = QFileInfo(iter.key()).lastModified().toMSecsSinceEpoch();
+   }
+
+   QFile::remove(journalFile);
+   return result;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 // Class implementation
 //---------------------------------------------------------------------------------------------------------------------
@@ -198,6 +423,11 @@ UmlProject::UmlProject()
 {
    data->root = new UmlRoot(KRootIdentifier);
    insert(data->root);
+
+   connect(&data->watcher, &QFutureWatcher<Compaction>::finished, this, [this]()
+   {
+      if (data->compacting) emit compactionFinished(waitForCompaction());
+   });
 }
 
 UmlProject::~UmlProject()
@@ -361,6 +591,56 @@ bool UmlProject::isModified() const
 void UmlProject::isModified(bool value)
 {
    data->isModified = value;
+   if (value) ++data->changes;
+}
+
+/**
+ * Gets the elements explicitly marked as modified since the last save.
+ *
+ * See function markModified().
+ */
+QList<UmlElement*> UmlProject::modifiedElements() const
+{
+   return data->modifiedElements.values();
+}
+
+/** Returns true if save() writes the files changed in one ProjectTransaction; otherwise false. */
+bool UmlProject::isTransactional() const
+{
+   return data->transactional;
+}
+
+/** 
+ * Sets whether save() writes the files changed in one ProjectTransaction instead of replacing each file on its own.
+ *
+ * @param value true for writing the files changed in one transaction. Default is false.
+ */
+void UmlProject::isTransactional(bool value)
+{
+   data->transactional = value;
+}
+
+/** Returns true if changes of the project are recorded in a journal, see openJournal(); otherwise false. */
+bool UmlProject::isJournaling() const
+{
+   return data->journal.isOpen();
+}
+
+/** Gets the size of the journal in bytes, i.e. the size of the changes autosaved since the last compaction. */
+qint64 UmlProject::journalSize() const
+{
+   return data->journal.size();
+}
+
+/**
+ * Gets the number of autosaves recovered from the journal by load().
+ *
+ * A value greater than zero means that the program ended without saving or discarding the changes of the project,
+ * e.g. because it crashed.
+ */
+int UmlProject::recoveredCount() const
+{
+   return data->recovered;
 }
 
 /** 
@@ -454,6 +734,33 @@ QStringList UmlProject::stereoTypes() const
    return data->stereoTypes;
 }
 
+/**
+ * Gets the where-used index of the types referenced by the elements of the project.
+ *
+ * The index is kept up to date while elements are inserted, removed, loaded or modified. Use it to find all attributes,
+ * operations and templates referencing a type without scanning the whole project:
+ * ~~~{.c}
+ * for (auto* elem : project->typeIndex().usages("Customer"))
+ * {
+ *    // elem is an attribute, operation, port or templated element using type "Customer"...
+ * }
+ * ~~~
+ */
+TypeIndex& UmlProject::typeIndex() const
+{
+   return data->typeIndex;
+}
+
+/** 
+ * Gets the list of files to be removed from the project folders on next saving. 
+ *
+ * See function removeFile().
+ */
+QStringList UmlProject::removedFiles() const
+{
+   return data->removedFiles;
+}
+
 /** Gets the error string if a file IO error was detected. */
 QString UmlProject::errorString() const
 {
@@ -494,6 +801,12 @@ bool UmlProject::insert(UmlElement* elem)
    {
       elem->setProject(this);
       data->elements.insert(elem->identifier(), UmlElementPtr(elem));
+      data->typeIndex.update(elem);
+      if (data->journal.isOpen())
+      {
+         data->journalPending.insert(elem);
+         data->journalRemoved.remove(elem->identifier());
+      }
       return true;
    }
 
@@ -511,7 +824,14 @@ void UmlProject::remove(UmlElement* elem)
    if (elem != nullptr && elem != data->root)
    {
       elem->setProject(nullptr);
+      data->typeIndex.remove(elem);
+      data->modifiedElements.remove(elem);
       data->elements.remove(elem->identifier());
+      if (data->journal.isOpen())
+      {
+         data->journalPending.remove(elem);
+         data->journalRemoved.insert(elem->identifier());
+      }
    }
 }
 
@@ -621,6 +941,8 @@ bool UmlProject::create(QString path, QString name)
  */
 bool UmlProject::load(QString filename)
 {
+   TraceSpan span("UmlProject::load");
+   span.setDetail(filename);
    setErrorString("");
 
    // Skip if it is not a project file and folder:
@@ -630,6 +952,24 @@ bool UmlProject::load(QString filename)
       return false;
    }
 
+   // A save interrupted by a crash is completed or dropped first:
+   QString journalError;
+   if (!ProjectTransaction::recover(data->projectFolder, &journalError))
+   {
+      setErrorString(journalError);
+      return false;
+   }
+
+   // Changes autosaved but neither saved nor discarded, e.g. because the program crashed, are applied on top of the
+   // element files. A journal being compacted when the program ended is older than the current one:
+   ProjectJournal::Overlay overlay;
+   if (!ProjectJournal::fold(filename + KJournalExt + KCompactExt, overlay, &journalError) ||
+       !ProjectJournal::fold(filename + KJournalExt, overlay, &journalError))
+   {
+      setErrorString(journalError);
+      return false;
+   }
+
    // Variables needed to compute the current load in percent:
    int count = 0, current = 1;
    QJsonParseError error;
@@ -638,38 +978,70 @@ bool UmlProject::load(QString filename)
    QFile prjfile(filename);
    if (prjfile.open(QIODevice::ReadOnly))
    {
-      qDebug() << "Start reading project file...";
-      auto doc = QJsonDocument::fromJson(prjfile.readAll(), &error);
-      if (doc.isNull())
+      TraceSpan fileSpan("UmlProject::readProjectFile");
+
+      // The element index is read entry by entry, large projects list many thousands of elements:
+      QCryptographicHash hash(QCryptographicHash::Md5);
+      JsonReader reader(&prjfile);
+      reader.setHash(&hash);
+      if (reader.readNext() != JsonReader::TokenType::BeginObject) reader.raiseError("Expected a project object");
+      while (reader.readNext() == JsonReader::TokenType::Name)
       {
-         setErrorString(QString(KFileParseError).arg(filename).arg(toString(error)));
+         QString key = reader.text();
+         reader.readNext();
+         if (key != KPropElements)
+         {
+            auto value = reader.readValue();
+            if (key == KPropAuthor) data->author = value.toString();
+            else if (key == KPropName) data->name = value.toString();
+            else if (key == KPropComment) data->comment = value.toString();
+            else if (key == KPropCount) count = value.toInt();
+            continue;
+         }
+
+         if (reader.tokenType() != JsonReader::TokenType::BeginArray) reader.raiseError("Expected an element index");
+         for (auto type = reader.readNext(); type != JsonReader::TokenType::EndArray; type = reader.readNext())
+         {
+            if (type == JsonReader::TokenType::Invalid) break;
+
+            // Retreive object and class identifier from the JSON file:
+            auto obj = reader.readValue().toObject();
+            QString name = obj[KPropClass].toString();
+            QUuid ident(obj[KPropIdentifier].toString());
+            if (!ident.isNull() && ident != KRootIdentifier && !overlay.removed.contains(ident))
+            {
+               // Build the element with this information using the factory:
+               insert(UmlElementFactory::instance().build(name, ident));
+            }
+         }
+      }
+
+      if (reader.tokenType() != JsonReader::TokenType::EndObject) reader.raiseError("Expected the end of the project");
+      if (reader.readNext() != JsonReader::TokenType::EndDocument)
+      {
+         setErrorString(QString(KFileParseError).arg(filename).arg(reader.errorString()));
          return false;
       }
 
-      auto obj = doc.object();
-      data->author = obj[KPropAuthor].toString();
-      data->name = obj[KPropName].toString();
-      data->comment = obj[KPropComment].toString();
-      count = obj[KPropCount].toInt();
+      data->fingerprints.insert(filename, FileFingerprint::of(QFileInfo(prjfile), hash));
 
-      auto array = obj[KPropElements].toArray();
-      for (int index = 0; index < array.size(); ++index)
+      // Elements created after the project was saved the last time are known from the journal only:
+      for (auto iter = overlay.elements.cbegin(); iter != overlay.elements.cend(); ++iter)
       {
-         auto obj = array[index].toObject();
-
-         // Retreive object and class identifier from the JSON file:
-         QString name = obj[KPropClass].toString();
-         QUuid ident(obj[KPropIdentifier].toString());
-         if (!ident.isNull() && ident != KRootIdentifier)
+         if (iter.key() != KRootIdentifier && !data->elements.contains(iter.key()))
          {
-            qDebug() << "Inserting new class '" << name << "' into project.";
-            // Build the element with this information using the factory:
-            insert(UmlElementFactory::instance().build(name, ident));
+            insert(UmlElementFactory::instance().build(iter.value()[KPropClass].toString(), iter.key()));
          }
       }
 
+      if (!overlay.project.isEmpty())
+      {
+         data->author = overlay.project[KPropAuthor].toString();
+         data->name = overlay.project[KPropName].toString();
+         data->comment = overlay.project[KPropComment].toString();
+      }
+
       prjfile.close();
-      qDebug() << "Done.";
    }
    else
    {
@@ -686,11 +1058,30 @@ bool UmlProject::load(QString filename)
    {
       iter.next();
 
+      auto recovered = overlay.elements.find(iter.key());
+      if (recovered != overlay.elements.end())
+      {
+         auto obj = recovered.value()[KPropData].toObject();
+         iter.value()->serialize(obj, true, obj[KPropVersion].toInt());
+
+         auto* diagram = dynamic_cast<UmlDiagram*>(iter.value().pointee());
+         if (diagram != nullptr && recovered.value().contains(KPropShapes))
+         {
+            diagram->recoverShapes(recovered.value()[KPropShapes].toObject());
+         }
+
+         data->modifiedElements.insert(iter.value().pointee());
+         ++current;
+         continue;
+      }
+
       QFile objfile(iter.value()->elementFile());
       if (objfile.open(QIODevice::ReadOnly))
       {
-         qDebug() << "Start reading element file...";
-         auto doc = QJsonDocument::fromJson(objfile.readAll(), &error);
+         TraceSpan fileSpan("UmlProject::readElement");
+         fileSpan.setDetail(objfile.fileName());
+         auto content = objfile.readAll();
+         auto doc = QJsonDocument::fromJson(content, &error);
          if (doc.isNull())
          {
             setErrorString(QString(KFileParseError).arg(objfile.fileName()).arg(toString(error)));
@@ -701,12 +1092,12 @@ bool UmlProject::load(QString filename)
          int  ver = obj[KPropVersion].toInt();
          iter.value()->serialize(obj, true, ver);
          objfile.close();
+         data->fingerprints.insert(objfile.fileName(), FileFingerprint::of(QFileInfo(objfile), content));
 
          // Compute percentage and issue signal:
          int percent = (current / count) * 100;
          emit updateProgress(percent);
          ++current;
-         qDebug() << "Done.";
       }
       else
       {
@@ -715,8 +1106,218 @@ bool UmlProject::load(QString filename)
       }
    }
 
-   isModified(false);
-   qDebug() << "Project successfully read.";
+   // Files of elements removed before the program ended are removed on saving:
+   for (auto& id : overlay.removed)
+   {
+      removeFile(data->elementsFolder + KDirSep + id.toString() + ".json");
+      removeFile(data->diagramsFolder + KDirSep + id.toString() + ".json");
+   }
+
+   for (auto& file : overlay.removedFiles) removeFile(file);
+
+   data->fileName = filename;
+   data->recovered = overlay.batches;
+   data->journalFiles = data->removedFiles.size();
+   isModified(overlay.batches > 0);
+   Tracer::counter("UmlProject::elements", data->elements.size());
+   return true;
+}
+
+/**
+ * Reads the files of the project changed outside of the program again, e.g. by a pull of a version control system.
+ *
+ * Compares the project file and the element files with the fingerprints taken when they were read or written the last
+ * time (see FileFingerprint) and reads only the files changed, so the cost depends on the number of changes:
+ * - elements removed from the project file are disposed and removed from the project;
+ * - elements added to the project file are created and read;
+ * - elements whose files changed are read again, and their observers receive EventType::ObjectChanged;
+ * - open diagrams whose diagram files changed read their shapes again (see UmlDiagram::reload()).
+ *
+ * Signal elementReloaded() is emitted for each element removed (before it is disposed), added or read again. The 
+ * project must not be modified, since changes not saved would be overwritten.
+ * @returns true if successful; otherwise false.
+ */
+bool UmlProject::reload()
+{
+   setErrorString("");
+   if (data->fileName.isEmpty())
+   {
+      setErrorString("The project must be loaded or saved before it can be reloaded.");
+      return false;
+   }
+
+   if (data->isModified)
+   {
+      setErrorString("The project has unsaved changes. Save or discard them before reloading the project.");
+      return false;
+   }
+
+   if (!waitForCompaction()) return false;
+
+   TraceSpan span("UmlProject::reload");
+   span.setDetail(data->fileName);
+
+   QString error;
+   if (!ProjectTransaction::recover(data->projectFolder, &error))
+   {
+      setErrorString(error);
+      return false;
+   }
+
+   // Elements are added or removed only if the project file changed:
+   QHash<QUuid, QString> listed;
+   bool relisted = false;
+   QFileInfo prjinfo(data->fileName);
+   if (data->fingerprints.value(data->fileName).isStale(prjinfo))
+   {
+      QFile prjfile(data->fileName);
+      if (!prjfile.open(QIODevice::ReadOnly))
+      {
+         setErrorString(QString(KFileReadError).arg(data->fileName).arg(prjfile.errorString()));
+         return false;
+      }
+
+      auto content = prjfile.readAll();
+      if (data->fingerprints.value(data->fileName).isChanged(content))
+      {
+         QJsonParseError parseError;
+         auto doc = QJsonDocument::fromJson(content, &parseError);
+         if (doc.isNull())
+         {
+            setErrorString(QString(KFileParseError).arg(data->fileName).arg(toString(parseError)));
+            return false;
+         }
+
+         auto obj = doc.object();
+         data->author = obj[KPropAuthor].toString();
+         data->name = obj[KPropName].toString();
+         data->comment = obj[KPropComment].toString();
+         for (auto value : obj[KPropElements].toArray())
+         {
+            QUuid ident(value.toObject()[KPropIdentifier].toString());
+            if (!ident.isNull() && ident != KRootIdentifier)
+            {
+               listed.insert(ident, value.toObject()[KPropClass].toString());
+            }
+         }
+
+         relisted = true;
+      }
+
+      data->fingerprints.insert(data->fileName, FileFingerprint::of(prjinfo, content));
+   }
+
+   QList<UmlElementPtr> removed;
+   QSet<UmlElement*> added;
+   if (relisted)
+   {
+      for (auto iter = data->elements.cbegin(); iter != data->elements.cend(); ++iter)
+      {
+         if (iter.key() != KRootIdentifier && !listed.contains(iter.key())) removed.append(iter.value());
+      }
+
+      // Elements added are created first, so references to them can be resolved when reading other elements:
+      for (auto iter = listed.cbegin(); iter != listed.cend(); ++iter)
+      {
+         if (data->elements.contains(iter.key())) continue;
+
+         auto* elem = UmlElementFactory::instance().build(iter.value(), iter.key());
+         if (elem != nullptr && insert(elem)) added.insert(elem);
+      }
+   }
+
+   // Read the element files changed, listing the folder gives size and time of the last modification of all files:
+   QList<QPair<UmlElement*, QJsonObject>> changed;
+   QDir dir(data->elementsFolder);
+   for (auto& info : dir.entryInfoList(QStringList() << "*.json", QDir::Files))
+   {
+      auto found = data->elements.find(QUuid(info.completeBaseName()));
+      if (found == data->elements.end()) continue;
+
+      auto* elem = found.value().pointee();
+      QString filename = elem->elementFile();
+      auto& print = data->fingerprints[filename];
+      if (!added.contains(elem) && !print.isStale(info)) continue;
+
+      QFile objfile(filename);
+      if (!objfile.open(QIODevice::ReadOnly))
+      {
+         setErrorString(QString(KFileReadError).arg(filename).arg(objfile.errorString()));
+         return false;
+      }
+
+      auto content = objfile.readAll();
+      bool isChanged = added.contains(elem) || print.isChanged(content);
+      print = FileFingerprint::of(info, content);
+      if (!isChanged) continue;
+
+      QJsonParseError parseError;
+      auto doc = QJsonDocument::fromJson(content, &parseError);
+      if (doc.isNull())
+      {
+         setErrorString(QString(KFileParseError).arg(filename).arg(toString(parseError)));
+         return false;
+      }
+
+      changed.append(qMakePair(elem, doc.object()));
+   }
+
+   // Elements removed are released first, so they are not found when reading their owners again:
+   for (auto& elem : removed)
+   {
+      emit elementReloaded(elem.pointee(), true);
+      elem->dispose();
+      recoverFile(elem->elementFile()); // The file is already gone
+      data->fingerprints.remove(elem->elementFile());
+      if (elem->owner() != nullptr) elem->owner()->remove(elem.pointee());
+      remove(elem.pointee());
+   }
+
+   for (auto& item : changed)
+   {
+      item.first->serialize(item.second, true, item.second[KPropVersion].toInt());
+      data->typeIndex.update(item.first);
+   }
+
+   for (auto& item : changed)
+   {
+      item.first->send(EventType::ObjectChanged);
+      emit elementReloaded(item.first, false);
+   }
+
+   // Open diagrams whose diagram files changed read their shapes again:
+   QDir diagrams(data->diagramsFolder);
+   for (auto& info : diagrams.entryInfoList(QStringList() << "*.json", QDir::Files))
+   {
+      auto found = data->elements.find(QUuid(info.completeBaseName()));
+      if (found == data->elements.end()) continue;
+
+      auto* diagram = dynamic_cast<UmlDiagram*>(found.value().pointee());
+      if (diagram == nullptr || !diagram->isOpen()) continue;
+
+      auto print = data->fingerprints.value(diagram->diagramFile());
+      if (!print.isValid() || !print.isStale(info)) continue;
+
+      QFile diafile(diagram->diagramFile());
+      if (diafile.open(QIODevice::ReadOnly) && print.isChanged(diafile.readAll()))
+      {
+         diafile.close();
+         if (!diagram->reload())
+         {
+            setErrorString(diagram->errorString());
+            return false;
+         }
+
+         emit elementReloaded(diagram, false);
+      }
+   }
+
+   // The files are up to date, there is nothing to be recorded in the journal:
+   data->journalPending.clear();
+   data->journalRemoved.clear();
+
+   span.setDetail(QString("%1 changed, %2 removed").arg(changed.size()).arg(removed.size()));
+   Tracer::counter("UmlProject::elements", data->elements.size());
    return true;
 }
 
@@ -731,6 +1332,8 @@ bool UmlProject::load(QString filename)
  */
 bool UmlProject::save(QString filename)
 {
+   TraceSpan span("UmlProject::save");
+   span.setDetail(filename);
    setErrorString("");
 
    // Skip if it is not a project file and folder:
@@ -740,14 +1343,50 @@ bool UmlProject::save(QString filename)
       return false;
    }
 
+   // A compaction running in the background writes the same files:
+   waitForCompaction();
+
    // Variables needed to compute the current save in percent:
    int count = data->elements.size(), current = 1;
 
+   // Files are either replaced one by one or staged and published together:
+   ProjectTransaction transaction(data->projectFolder);
+   if (data->transactional && !transaction.begin())
+   {
+      setErrorString(transaction.errorString());
+      return false;
+   }
+
+   // The fingerprints of the files written are taken when all of them are in place, see reload():
+   QHash<QString, FileFingerprint> written;
+   auto writeFile = [this, &transaction, &written](QString name, const QByteArray& content)
+   {
+      FileFingerprint print;
+      print.size = content.size();
+      print.hash = FileFingerprint::hashOf(content);
+      written.insert(name, print);
+
+      if (data->transactional)
+      {
+         if (transaction.write(name, content)) return true;
+         setErrorString(transaction.errorString());
+         return false;
+      }
+
+      QSaveFile file(name);
+      if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(content) == content.size() &&
+          file.commit())
+      {
+         return true;
+      }
+
+      setErrorString(QString(KFileWriteError).arg(name).arg(file.errorString()));
+      return false;
+   };
+
    // Write the project file down to the folder:
-   QSaveFile prjfile(filename);
-   if (prjfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
    {
-      qDebug() << "Writing project file '" << filename << "'...";
+      TraceSpan fileSpan("UmlProject::writeProjectFile");
       QJsonObject obj;
       obj[KPropAuthor] = data->author;
       obj[KPropName] = data->name;
@@ -755,71 +1394,111 @@ bool UmlProject::save(QString filename)
       obj[KPropCount] = count;
       obj[KPropVersion] = (int)KFileVersion;
 
-      QJsonArray array;
-      QHashIterator<QUuid, UmlElementPtr> iter(data->elements);
-      while (iter.hasNext())
+      QMap<QString, QString> index;
+      for (auto iter = data->elements.cbegin(); iter != data->elements.cend(); ++iter)
       {
-         iter.next();
-
-         QJsonObject obj;
-         obj[KPropClass] = iter.value()->className();
-         obj[KPropIdentifier] = iter.value()->identifier().toString();
-         array.append(obj);
+         index.insert(iter.key().toString(), iter.value()->className());
       }
-      obj[KPropElements] = array;
 
-      QJsonDocument doc(obj);
-      prjfile.write(doc.toJson(QJsonDocument::Compact));
-      prjfile.commit();
-      qDebug() << "Done.";
-   }
-   else
-   {
-      setErrorString(QString(KFileWriteError).arg(filename).arg(prjfile.errorString()));
-      return false;
+      if (!writeFile(filename, writeProjectFile(obj, index))) return false;
    }
 
-   // Now write each element to its own file:
-   QHashIterator<QUuid, UmlElementPtr> iter(data->elements);
-   while (iter.hasNext())
+   // Only the files of elements modified (see markModified()) or new are written, and - since not every change is
+   // reported - files whose content differs from the one read or written the last time:
+   auto isStaged = [this](UmlElement* elem, QString name, const QByteArray& content)
    {
-      iter.next();
+      if (data->modifiedElements.contains(elem) || data->journalPending.contains(elem)) return true;
 
-      QSaveFile objfile(iter.value()->elementFile());
-      if (objfile.open(QIODevice::WriteOnly | QIODevice::Truncate))
-      {
-         qDebug() << "Start writing element file...";
-         QJsonObject obj;
-         obj[KPropVersion] = (int)KFileVersion;
-         iter.value()->serialize(obj, false, KFileVersion);
+      auto print = data->fingerprints.value(name);
+      return print.isChanged(content) || print.isStale(QFileInfo(name));
+   };
 
-         QJsonDocument doc(obj);
-         objfile.write(doc.toJson(QJsonDocument::Compact));
-         objfile.commit();
+   // Now write each element to its own file, in the order of the index to make saving reproducible:
+   auto identifiers = data->elements.keys();
+   std::sort(identifiers.begin(), identifiers.end());
+   for (auto& id : identifiers)
+   {
+      auto* elem = data->elements.value(id).pointee();
 
-         // Compute percentage and issue signal:
-         int percent = (current / count) * 100;
-         emit updateProgress(percent);
-         ++current;
-         qDebug() << "Done.";
+      TraceSpan fileSpan("UmlProject::writeElement");
+      fileSpan.setDetail(elem->elementFile());
+      QJsonObject obj;
+      obj[KPropVersion] = (int)KFileVersion;
+      elem->serialize(obj, false, KFileVersion);
+      auto content = JsonWriter::toCanonical(obj);
+      if (isStaged(elem, elem->elementFile(), content) && !writeFile(elem->elementFile(), content)) return false;
+
+      // Open diagrams and diagrams with shapes changed while closed are written to their diagram files as well:
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram != nullptr && diagram->hasShapes())
+      {
+         QJsonObject shapes;
+         diagram->writeShapes(shapes);
+         content = JsonWriter::toCanonical(shapes);
+         if (isStaged(elem, diagram->diagramFile(), content) && !writeFile(diagram->diagramFile(), content))
+         {
+            return false;
+         }
       }
+
+      // Compute percentage and issue signal:
+      int percent = (current / count) * 100;
+      emit updateProgress(percent);
+      ++current;
    }
 
    // And remove all files of disposed elements:
    for (int index = 0; index < data->removedFiles.count(); ++index)
    { 
       QFile file(data->removedFiles[index]);
-      if (file.exists())
+      if (data->transactional)
       {
-         qDebug() << "Removing file '" << file.fileName() << "'...";
+         transaction.remove(file.fileName());
+      }
+      else if (file.exists())
+      {
+         Tracer::instant("UmlProject::removeFile", "model", file.fileName());
          file.remove();
       }
    }
+
+   if (data->transactional && !transaction.commit())
+   {
+      setErrorString(transaction.errorString());
+      return false;
+   }
+
+   for (auto iter = written.begin(); iter != written.end(); ++iter)
+   {
+      iter->modified = QFileInfo(iter.key()).lastModified().toMSecsSinceEpoch();
+      data->fingerprints.insert(iter.key(), iter.value());
+   }
+
+   for (auto& file : data->removedFiles) data->fingerprints.remove(file);
    data->removedFiles.clear();
+   data->modifiedElements.clear();
+
+   // All changes are written to the element files now, the journal is not needed anymore:
+   if (data->journal.isOpen() && data->journal.fileName() != filename + KJournalExt) data->journal.close();
+
+   // The files are written but the journal still holds their changes - the save is retried with the next one:
+   if (!data->journal.discard())
+   {
+      setErrorString(data->journal.errorString());
+      return false;
+   }
+
+   if (!data->journal.isOpen()) QFile::remove(filename + KJournalExt);
+   QFile::remove(filename + KJournalExt + KCompactExt);
+   data->journalPending.clear();
+   data->journalRemoved.clear();
+   data->journalShapes.clear();
+   data->journalFiles = 0;
+   data->recovered = 0;
+   data->fileName = filename;
 
    isModified(false);
-   qDebug() << "Project successfully written.";
-   return 0;
+   return true;
 }
 
 /**
@@ -829,6 +1508,10 @@ bool UmlProject::save(QString filename)
  */
 void UmlProject::dispose()
 {
+   waitForCompaction();
+   data->journal.close();
+   data->journalPending.clear();
+
    QHashIterator<QUuid, UmlElementPtr> iter(data->elements);
    while (iter.hasNext())
    {
@@ -836,6 +1519,8 @@ void UmlProject::dispose()
       iter.value()->dispose(false);
    }
 
+   data->typeIndex.clear();
+   data->modifiedElements.clear();
    data->elements.clear();
    data->root = nullptr;
    data->isDisposed = true;
@@ -866,6 +1551,294 @@ void UmlProject::recoverFile(QString filename)
    }
 }
 
+/**
+ * Marks an element of the project as modified.
+ *
+ * Also sets the modified flag of the project. save() writes the files of all elements marked as modified and clears
+ * the set of modified elements.
+ * @param elem UmlElement object modified. Must be contained in the project.
+ */
+void UmlProject::markModified(UmlElement* elem)
+{
+   if (elem != nullptr && elem->project() == this)
+   {
+      data->modifiedElements.insert(elem);
+      if (data->journal.isOpen()) data->journalPending.insert(elem);
+      isModified(true);
+   }
+}
+
+/**
+ * Sets the fingerprint of a file of the project, see reload(). 
+ *
+ * Called by elements reading or writing files of their own, e.g. by UmlDiagram for its diagram file.
+ * @param filename Name of the file including path.
+ * @param value Fingerprint of the file as read or written.
+ */
+void UmlProject::setFingerprint(QString filename, const FileFingerprint& value)
+{
+   data->fingerprints.insert(filename, value);
+}
+
+/**
+ * Records the shapes of a diagram with the next autosave() or compact(), if they changed, see UmlDiagram::hasShapes().
+ *
+ * Changes of the shapes of diagrams are not tracked. Thus this function does not mark the project as modified, but
+ * compares the shapes to the ones recorded before when writing the journal.
+ * @param diagram Diagram shown in an editor.
+ */
+void UmlProject::markShapesModified(UmlDiagram* diagram)
+{
+   if (diagram != nullptr && data->journal.isOpen()) data->journalPending.insert(diagram);
+}
+
+/**
+ * Starts recording the changes of the project in a journal next to the project file, see autosave().
+ *
+ * The project must have been loaded or saved before. Changes recovered by load() stay in the journal, new changes are
+ * appended to it.
+ * @returns true if successful; false if the journal cannot be opened.
+ */
+bool UmlProject::openJournal()
+{
+   setErrorString("");
+   if (data->fileName.isEmpty())
+   {
+      setErrorString("The project must be saved before changes can be recorded in a journal.");
+      return false;
+   }
+
+   if (!data->journal.open(data->fileName + KJournalExt))
+   {
+      setErrorString(data->journal.errorString());
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * Stops recording the changes of the project in a journal.
+ *
+ * @param discard If true, the changes autosaved since the last save or compaction are dropped by removing the journal;
+ *        otherwise the journal is kept and replayed by the next load().
+ */
+void UmlProject::closeJournal(bool discard)
+{
+   if (!data->journal.isOpen()) return;
+
+   QString filename = data->journal.fileName();
+   data->journal.close();
+   data->journalPending.clear();
+   data->journalRemoved.clear();
+   data->journalShapes.clear();
+   if (discard) QFile::remove(filename);
+}
+
+/**
+ * Appends the changes made since the last autosave to the journal and flushes it to the storage device.
+ *
+ * Records the current state of all elements inserted or marked as modified (see markModified()) and the identifiers
+ * of all elements removed since the last autosave. The nodes and edges of open diagrams are recorded only if they
+ * changed since the diagram was recorded the last time. The cost is proportional to the size of the changes, not to
+ * the size of the project. The project stays marked as modified, since the element files are not written.
+ * @returns true if successful; false if the journal is not open or cannot be written.
+ */
+bool UmlProject::autosave()
+{
+   setErrorString("");
+   if (!data->journal.isOpen())
+   {
+      setErrorString("The journal of the project is not open.");
+      return false;
+   }
+
+   TraceSpan span("UmlProject::autosave");
+   for (auto* elem : data->journalPending)
+   {
+      QJsonObject json;
+      json[KPropVersion] = (int)KFileVersion;
+      elem->serialize(json, false, KFileVersion);
+
+      QJsonObject shapes;
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram != nullptr && diagram->hasShapes())
+      {
+         diagram->writeShapes(shapes);
+         auto hash = QCryptographicHash::hash(JsonWriter::toCanonical(shapes), QCryptographicHash::Md5);
+         if (data->journalShapes.value(elem->identifier()) == hash)
+         {
+            // Diagrams added by markShapesModified() only are skipped if their shapes did not change:
+            if (!data->modifiedElements.contains(elem)) continue;
+            shapes = QJsonObject();
+         }
+         else
+         {
+            data->journalShapes.insert(elem->identifier(), hash);
+         }
+      }
+
+      data->journal.put(elem->identifier(), elem->className(), json, shapes);
+   }
+
+   for (auto& id : data->journalRemoved)
+   {
+      data->journal.remove(id);
+      data->journalShapes.remove(id);
+   }
+
+   QJsonObject project;
+   project[KPropAuthor] = data->author;
+   project[KPropName] = data->name;
+   project[KPropComment] = data->comment;
+   if (!data->journal.commit(project, data->removedFiles.mid(data->journalFiles)))
+   {
+      setErrorString(data->journal.errorString());
+      return false;
+   }
+
+   span.setDetail(QString("%1 element(s)").arg(data->journalPending.size()));
+   data->journalPending.clear();
+   data->journalRemoved.clear();
+   data->journalFiles = data->removedFiles.size();
+   return true;
+}
+
+/**
+ * Saves the project by folding the journal into the element files on a background thread.
+ *
+ * Calls autosave() first and then moves the journal aside, so new changes can be recorded while the compaction is
+ * running. Since only the elements changed are written, this is a lot faster than save() on big projects, but unlike
+ * save() it writes only the changes reported by insert(), remove() and markModified(). Signal compactionFinished() is
+ * emitted when the compaction is done; the project is marked as not modified then, unless it was changed meanwhile.
+ * Use waitForCompaction() to wait for it, e.g. before the program quits.
+ * @returns true if the compaction was started; false if the journal is not open or cannot be written.
+ */
+bool UmlProject::compact()
+{
+   if (!waitForCompaction() || !autosave()) return false;
+
+   QString target = data->journal.fileName() + KCompactExt;
+   if (!data->journal.rotate(target))
+   {
+      setErrorString(data->journal.errorString());
+      return false;
+   }
+
+   // The bookkeeping of the changes folded is cleared when the compaction succeeded, see waitForCompaction():
+   data->compacting = true;
+   data->compactedElements = data->modifiedElements;
+   data->compactedFiles = data->journalFiles;
+   data->changes = 0;
+   data->compaction = QtConcurrent::run(compactJournal, target, data->fileName, data->elementsFolder,
+                                        data->diagramsFolder);
+   data->watcher.setFuture(data->compaction);
+   return true;
+}
+
+/**
+ * Waits until the compaction started by compact() is done.
+ *
+ * If the compaction succeeded, the elements and files it wrote or removed are no longer counted as changed, and the
+ * project is marked as not modified unless it was changed while the compaction was running. If it failed,
+ * errorString() describes the error; the changes are kept in the journal and folded by the next compaction.
+ * @returns true if no compaction was running or if it succeeded; otherwise false.
+ */
+bool UmlProject::waitForCompaction()
+{
+   if (!data->compacting) return true;
+
+   data->compaction.waitForFinished();
+   data->compacting = false;
+
+   auto result = data->compaction.result();
+   auto compacted = data->compactedElements;
+   data->compactedElements.clear();
+   if (!result.errorString.isEmpty())
+   {
+      setErrorString(result.errorString);
+      return false;
+   }
+
+   for (auto iter = result.written.cbegin(); iter != result.written.cend(); ++iter)
+   {
+      data->fingerprints.insert(iter.key(), iter.value());
+   }
+
+   for (auto& file : result.removed) data->fingerprints.remove(file);
+   data->removedFiles = data->removedFiles.mid(data->compactedFiles);
+   data->journalFiles -= data->compactedFiles;
+   data->compactedFiles = 0;
+   data->modifiedElements.subtract(compacted);
+   data->recovered = 0;
+   if (data->changes == 0) isModified(false);
+   return true;
+}
+
+/**
+ * Adds the memory used by the bookkeeping of the project to a MemoryUsage object.
+ *
+ * The elements registered in the project are not included; use MemoryReport to measure them class by class.
+ * @param usage MemoryUsage object receiving the sizes.
+ */
+void UmlProject::measure(MemoryUsage& usage) const
+{
+   usage.objects += sizeof(UmlProject) + sizeof(Data);
+   usage.strings += MemoryUsage::sizeOf(data->author) + MemoryUsage::sizeOf(data->name) + 
+                    MemoryUsage::sizeOf(data->comment) + MemoryUsage::sizeOf(data->artifactsFolder) + 
+                    MemoryUsage::sizeOf(data->codeFolder) + MemoryUsage::sizeOf(data->diagramsFolder) + 
+                    MemoryUsage::sizeOf(data->elementsFolder) + MemoryUsage::sizeOf(data->projectFolder) + 
+                    MemoryUsage::sizeOf(data->primitiveTypes) + MemoryUsage::sizeOf(data->stereoTypes) + 
+                    MemoryUsage::sizeOf(data->removedFiles) + MemoryUsage::sizeOf(data->errorString);
+   usage.containers += MemoryUsage::sizeOf(data->elements) + MemoryUsage::sizeOf(data->modifiedElements) +
+                       MemoryUsage::sizeOf(data->fingerprints);
+   data->typeIndex.measure(usage);
+   usage.objects -= sizeof(TypeIndex); // Already counted as part of Data
+}
+
+/**
+ * Checks whether the references to a type can be renamed.
+ *
+ * Renaming is refused if the new name is not a single identifier or if it is already referenced by any element, since
+ * the references of both types could not be told apart afterwards.
+ * @param oldName Identifier of the type to be renamed.
+ * @param newName New identifier of the type.
+ */
+bool UmlProject::canRenameType(QString oldName, QString newName) const
+{
+   if (oldName.isEmpty() || oldName == newName) return false;
+   if (TypeIndex::split(newName) != QStringList(newName)) return false;
+   return !data->typeIndex.contains(newName);
+}
+
+/**
+ * Renames a type in the type strings of all elements referencing it.
+ *
+ * Uses the type index of the project to visit the referencing elements only and marks each element modified (see 
+ * markModified()). The type itself (e.g. the classifier) is not renamed by this function. Call canRenameType() first.
+ * @param oldName Identifier of the type to be renamed.
+ * @param newName New identifier of the type.
+ * @returns List of modified elements.
+ */
+QList<UmlElement*> UmlProject::renameType(QString oldName, QString newName)
+{
+   QList<UmlElement*> result;
+   if (oldName.isEmpty() || newName.isEmpty() || oldName == newName) return result;
+
+   // The index is modified while renaming, so work on a copy of the list:
+   auto usages = data->typeIndex.usages(oldName);
+   for (auto* elem : usages)
+   {
+      if (elem->renameTypeReference(oldName, newName))
+      {
+         markModified(elem);
+         result.append(elem);
+      }
+   }
+
+   return result;
+}
+
 /**
  * Adds a primitive type to the list of primitive types of the project.
  *
@@ -943,6 +1916,18 @@ bool UmlProject::isProject(QString filename)
 
    QDir dir(data->projectFolder);
    auto list = dir.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoSymLinks | QDir::NoDotAndDotDot, QDir::DirsFirst | QDir::Name);
+
+   // Journals and the staging folder of transactions are not part of the project structure:
+   QString staging = QFileInfo(ProjectTransaction::stagingFolder(data->projectFolder)).absoluteFilePath();
+   for (int index = list.count() - 1; index >= 0; --index)
+   {
+      if ((list[index].isFile() && list[index].fileName().contains(KJournalExt)) ||
+          list[index].absoluteFilePath() == staging)
+      {
+         list.removeAt(index);
+      }
+   }
+
    if (list.count() == 5)
    { 
       return (list[0].isDir() && list[0].fileName() == KArtifactsFolder) &&
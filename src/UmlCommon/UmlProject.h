@@ -37,6 +37,10 @@
 #include <QStringList>
 #include <QUuid>
 
+struct FileFingerprint;
+struct MemoryUsage;
+class TypeIndex;
+class UmlDiagram;
 class UmlRoot;
 
 class UMLCOMMON_EXPORT UmlProject : public QObject
@@ -72,8 +76,20 @@ public: // Properties
    bool isModified() const;
    void isModified(bool value);
 
+   bool isTransactional() const;
+   void isTransactional(bool value);
+
+   QList<UmlElement*> modifiedElements() const;
+
+   bool isJournaling() const;
+   qint64 journalSize() const;
+   int recoveredCount() const;
+
    QStringList primitiveTypes() const;
    QStringList stereoTypes() const;
+   QStringList removedFiles() const;
+
+   TypeIndex& typeIndex() const;
 
    QString errorString() const;
 
@@ -89,12 +105,27 @@ public: // Methods
    bool create(QString path, QString name);
    bool load(QString filename);
    bool save(QString filename);
+   bool reload();
 
    void dispose();
 
    void removeFile(QString filename);
    void recoverFile(QString filename);
 
+   void markModified(UmlElement* elem);
+   void markShapesModified(UmlDiagram* diagram);
+   void setFingerprint(QString filename, const FileFingerprint& value);
+
+   bool openJournal();
+   void closeJournal(bool discard);
+   bool autosave();
+   bool compact();
+   bool waitForCompaction();
+   void measure(MemoryUsage& usage) const;
+
+   bool canRenameType(QString oldName, QString newName) const;
+   QList<UmlElement*> renameType(QString oldName, QString newName);
+
    void addPrimitiveType(QString name);
    void removePrimitiveType(QString name);
    void resetPrimitiveTypes();
@@ -105,6 +136,8 @@ public: // Methods
 
 signals:
    void updateProgress(int percent);
+   void compactionFinished(bool success);
+   void elementReloaded(UmlElement* element, bool removed);
 
 private:
    bool isProject(QString filename);
@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlTemplateBinding.h"
+#include "MemoryUsage.h"
 #include "UmlParameterSubstitution.h"
 #include "UmlKeywords.h"
 #include "PropertyStrings.h"
@@ -151,6 +152,15 @@ void UmlTemplateBinding::dispose(bool disposing)
    super::dispose(disposing);
 }
 
+/** Adds the estimated memory used by the template binding to a MemoryUsage object, see UmlElement::measure(). */
+void UmlTemplateBinding::measure(MemoryUsage& usage) const
+{
+   super::measure(usage);
+   usage.objects += sizeof(Data) + sizeof(data);
+   usage.containers += MemoryUsage::sizeOf(data->substitutions);
+   for (auto* subst : data->substitutions) subst->measure(usage);
+}
+
 /**
  * Serializes properties of the UmlTemplateBinding instance to a JSON file.
  *
@@ -166,6 +176,7 @@ void UmlTemplateBinding::serialize(QJsonObject& json, bool read, bool flat, int
    if (read)
    {
       array = json[KPropSubstitutions].toArray();
+      if (!data->substitutions.isEmpty()) clear();
       for (int index = 0; index < array.size(); ++index)
       {
          auto obj = array[index].toObject();
@@ -55,6 +55,7 @@ public: // Methods
    void append(UmlParameterSubstitution* subst);
    void remove(UmlParameterSubstitution* subst);
    void clear();
+   void measure(MemoryUsage& usage) const override;
 
 protected:
    void dispose(bool disposing) override;
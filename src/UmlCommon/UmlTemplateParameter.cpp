@@ -26,6 +26,8 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "UmlTemplateParameter.h"
+#include "MemoryUsage.h"
+#include "UmlElement.h"
 #include "PropertyStrings.h"
 #include "SignatureChars.h"
 
@@ -48,10 +50,15 @@
 /// @cond
 struct UmlTemplateParameter::Data
 {
+   Data()
+   : owner(nullptr)
+   {}
+
    QString                 name;
    QString                 type;
    QString                 defaultValue;
    QString                 constraints;
+   UmlElement*             owner;
    QAtomicInteger<quint32> refCount;
 };
 /// @endcond
@@ -92,7 +99,9 @@ QString UmlTemplateParameter::type() const
 /** Sets the type of the template parameter. */
 void UmlTemplateParameter::setType(QString value)
 {
+   if (data->type == value) return;
    data->type = value;
+   if (data->owner != nullptr) data->owner->updateTypeIndex();
 }
 
 /** Gets the default value of the template parameter. */
@@ -119,6 +128,31 @@ void UmlTemplateParameter::setConstraints(QString value)
    data->constraints = value;
 }
 
+/** 
+ * Gets the element owning the template parameter. 
+ *
+ * The owner is a templatable element like a classifier, an operation or a package. It is set automatically when 
+ * appending the template parameter to the element.
+ */
+UmlElement* UmlTemplateParameter::owner() const
+{
+   return data->owner;
+}
+
+/** Sets the element owning the template parameter. */
+void UmlTemplateParameter::setOwner(UmlElement* value)
+{
+   data->owner = value;
+}
+
+/** Adds the estimated memory used by the template parameter to a MemoryUsage object. */
+void UmlTemplateParameter::measure(MemoryUsage& usage) const
+{
+   usage.objects += sizeof(UmlTemplateParameter) + sizeof(Data);
+   usage.strings += MemoryUsage::sizeOf(data->name) + MemoryUsage::sizeOf(data->type) +
+      MemoryUsage::sizeOf(data->defaultValue) + MemoryUsage::sizeOf(data->constraints);
+}
+
 /**
  * Serializes properties of the UmlTemplateParameter instance to a JSON object.
  *
@@ -33,6 +33,9 @@
 
 #include <QString>
 
+class UmlElement;
+struct MemoryUsage;
+
 class UMLCOMMON_EXPORT UmlTemplateParameter : public ISerializable
 {
 public: // Constructors
@@ -52,6 +55,9 @@ public: // Properties:
    QString constraints() const;
    void setConstraints(QString value);
 
+   UmlElement* owner() const;
+   void setOwner(UmlElement* value);
+
 public: // Methods
    void serialize(QJsonObject& json, bool read, int version) override;
 
@@ -60,6 +66,7 @@ public: // Methods
    quint32 refCount() const;
    
    QString toString() const;
+   void measure(MemoryUsage& usage) const;
 
 private: // Attributes
    ///@cond
@@ -0,0 +1,186 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DiagramLayout.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class DiagramLayout.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "DiagramLayout.h"
+#include "ForceLayout.h"
+#include "LayeredLayout.h"
+
+#include "DiaEdge.h"
+#include "DiaNode.h"
+
+/**
+ * @class DiagramLayout
+ * @brief Base class of all algorithms placing the shapes of a diagram automatically.
+ * @since 0.2.0
+ * @ingroup UmlLayout
+ *
+ * A diagram layout computes the positions of the DiaNode objects of a UmlDiagram object and routes its DiaEdge
+ * objects. It works on the diagram data only and does not depend on the GUI, so it may be run by the application as
+ * well as by the command line tool:
+ * ~~~{.cpp}
+ * LayeredLayout layout;
+ * if (diagram->open() && layout.layout(diagram)) diagram->save();
+ * ~~~
+ *
+ * Sizes of nodes never shown in the GUI are unknown; function nodeSize() substitutes a default size for them.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const double KDefaultSpacing = 40.0;
+static const double KDefaultWidth   = 120.0; // Same as the default size of shapes in class DiagramScene
+static const double KDefaultHeight  = 80.0;
+
+struct DiagramLayout::Data
+{
+   Data()
+   : nodeSpacing(KDefaultSpacing)
+   {
+   }
+
+   double  nodeSpacing;
+   QString errorString;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+DiagramLayout::DiagramLayout()
+: data(new Data())
+{
+}
+
+DiagramLayout::~DiagramLayout()
+{
+   delete data;
+}
+
+/** Gets the minimum distance between two nodes placed side by side. */
+double DiagramLayout::nodeSpacing() const
+{
+   return data->nodeSpacing;
+}
+
+/** Sets the minimum distance between two nodes placed side by side. */
+void DiagramLayout::setNodeSpacing(double value)
+{
+   data->nodeSpacing = qMax(0.0, value);
+}
+
+/** Gets a description of the last error; empty if the last call of layout() was successful. */
+QString DiagramLayout::errorString() const
+{
+   return data->errorString;
+}
+
+/** Sets the description of the last error. */
+void DiagramLayout::setErrorString(const QString& value)
+{
+   data->errorString = value;
+}
+
+/**
+ * Creates a layout algorithm by its name.
+ *
+ * @param name Name of the algorithm (see name()): "layered" or "force".
+ * @return New DiagramLayout object owned by the caller or nullptr if the name is unknown.
+ */
+DiagramLayout* DiagramLayout::create(const QString& name)
+{
+   if (name == "layered") return new LayeredLayout();
+   if (name == "force") return new ForceLayout();
+   return nullptr;
+}
+
+/**
+ * Gets the name of the layout algorithm suiting a kind of diagram best.
+ *
+ * Class diagrams are dominated by generalizations and therefore laid out in layers, all other diagrams are laid out
+ * by forces.
+ * @param kind Kind of the diagram.
+ */
+QString DiagramLayout::defaultName(DiagramKind kind)
+{
+   return kind == DiagramKind::Class ? "layered" : "force";
+}
+
+/**
+ * Gets the size of a node.
+ *
+ * @param node DiaNode object.
+ * @return Size of the node or a default size if the node was never shown in the GUI.
+ */
+QSizeF DiagramLayout::nodeSize(DiaNode* node)
+{
+   QSizeF size = node->size();
+   if (size.isEmpty())
+   {
+      size = QSizeF(KDefaultWidth, KDefaultHeight);
+   }
+
+   return size;
+}
+
+/**
+ * Draws an edge directly from the node at its first end to the node at its second end.
+ *
+ * Edges not connecting two different nodes, e.g. edges pointing to the same node, are left unmodified.
+ * @param edge DiaEdge object.
+ */
+void DiagramLayout::routeDirect(DiaEdge* edge)
+{
+   auto* node1 = dynamic_cast<DiaNode*>(edge->shape1());
+   auto* node2 = dynamic_cast<DiaNode*>(edge->shape2());
+   if (node1 == nullptr || node2 == nullptr || node1 == node2) return;
+
+   QVector<QPointF> points;
+   points.append(QPointF(0.0, 0.0));
+   points.append(node2->pos() - node1->pos());
+
+   edge->setRouting(RoutingKind::Direct);
+   edge->setPos(node1->pos());
+   edge->setPoints(points);
+}
+
+/**
+ * @fn DiagramLayout::name() const
+ * Gets the name of the layout algorithm as used e.g. on the command line.
+ */
+
+/**
+ * @fn DiagramLayout::layout(UmlDiagram* diagram)
+ * Places the nodes and routes the edges of a diagram.
+ *
+ * The diagram must be open (see UmlDiagram::open()). The function modifies the DiaNode and DiaEdge objects of the
+ * diagram only; it is up to the caller to save the diagram and to update the GUI.
+ * @param diagram Diagram to be laid out.
+ * @return True, if successful; otherwise false (see errorString()).
+ */
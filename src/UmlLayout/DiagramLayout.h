@@ -0,0 +1,69 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DiagramLayout.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class DiagramLayout.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "DiagramKind.h"
+
+#include <QSizeF>
+#include <QString>
+
+class DiaEdge;
+class DiaNode;
+class UmlDiagram;
+
+class DiagramLayout
+{
+public: // Constructors
+   DiagramLayout();
+   virtual ~DiagramLayout();
+
+public: // Properties
+   virtual QString name() const = 0;
+
+   double nodeSpacing() const;
+   void setNodeSpacing(double value);
+
+   QString errorString() const;
+
+public: // Methods
+   virtual bool layout(UmlDiagram* diagram) = 0;
+
+   static DiagramLayout* create(const QString& name);
+   static QString defaultName(DiagramKind kind);
+   static QSizeF nodeSize(DiaNode* node);
+   static void routeDirect(DiaEdge* edge);
+
+protected:
+   void setErrorString(const QString& value);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -0,0 +1,662 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ForceLayout.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ForceLayout.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ForceLayout.h"
+
+#include "DiaEdge.h"
+#include "DiaNode.h"
+#include "UmlDiagram.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QRectF>
+#include <QVarLengthArray>
+#include <QtMath>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <cmath>
+
+/**
+ * @class ForceLayout
+ * @brief The ForceLayout class arranges the nodes of a diagram by simulating attracting and repelling forces.
+ * @since 0.2.0
+ * @ingroup UmlLayout
+ *
+ * The ForceLayout class implements the force directed method of Fruchterman and Reingold: all nodes repel each
+ * other while the edges of the diagram - of any kind - pull their nodes together like springs. It suits package,
+ * component and other diagrams dominated by dependencies, which have no natural hierarchy.
+ *
+ * The repelling forces are approximated by a Barnes-Hut quadtree, rebuilt on each iteration: groups of nodes far
+ * enough away (see theta()) act like a single node in their center of mass, so an iteration takes O(n log n) instead
+ * of O(n^2) steps. The forces of the nodes are accumulated concurrently on the global thread pool, the nodes are moved
+ * afterwards. Each move is limited by a temperature that cools down linearly to 0, so the simulation always stops
+ * after iterations() steps. Finally overlapping nodes are pushed apart.
+ *
+ * Function layout() places all nodes from scratch, starting from a spiral in breadth first order. Function relax()
+ * places newly added nodes next to their neighbours and moves only these and their direct neighbours, so the
+ * rest of the diagram stays as the user arranged it.
+ *
+ * The simulation has no random elements: the same diagram always results in the same layout.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal structs hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const int    KDefaultIterations = 200;
+static const double KDefaultTheta      = 0.8;
+static const int    KChunkSize         = 256;     // Nodes per task of the force accumulation
+static const double KMinCellSize       = 1.0e-3;  // Cells of the quadtree are not split below this size
+static const double KMinDistance       = 1.0e-4;  // Coincident nodes do not repel each other
+static const double KGravity           = 0.5;     // Pull to the center keeping unconnected parts together
+static const double KSpiralDensity     = 0.6;
+static const double KGoldenAngle       = 2.399963229728653;
+static const int    KOverlapRounds     = 8;
+
+/** Cell of the Barnes-Hut quadtree. */
+struct Cell
+{
+   QPointF center;      ///< Center of the square covered by the cell
+   double  half;        ///< Half of the edge length of the square
+   QPointF sum;         ///< Sum of the positions of the nodes within the cell
+   double  mass;        ///< Number of nodes within the cell
+   int     children[4];
+   int     body;        ///< Node of a leaf; -1 for inner cells
+};
+
+/** Barnes-Hut quadtree approximating the repelling forces between the nodes. */
+class QuadTree
+{
+public:
+   void build(const QVector<QPointF>& pos)
+   {
+      cells.clear();
+      if (pos.isEmpty()) return;
+
+      double left = pos[0].x(), right = left, top = pos[0].y(), bottom = top;
+      for (const QPointF& point : pos)
+      {
+         left = qMin(left, point.x());
+         right = qMax(right, point.x());
+         top = qMin(top, point.y());
+         bottom = qMax(bottom, point.y());
+      }
+
+      addCell(QPointF((left + right) / 2.0, (top + bottom) / 2.0), qMax(right - left, bottom - top) / 2.0 + 1.0);
+      for (int vertex = 0; vertex < pos.size(); ++vertex)
+      {
+         insert(vertex, pos);
+      }
+   }
+
+   /** Gets the sum of the forces of all other nodes repelling a node with strength k^2 / distance. */
+   QPointF repulsion(int vertex, const QVector<QPointF>& pos, double theta, double k2) const
+   {
+      QPointF result;
+      if (cells.isEmpty()) return result;
+
+      QPointF point = pos[vertex];
+      QVarLengthArray<int, 128> stack;
+      stack.append(0);
+      while (!stack.isEmpty())
+      {
+         const Cell& cell = cells[stack.last()];
+         stack.removeLast();
+         if (cell.body == vertex && cell.mass == 1.0) continue;
+
+         QPointF delta = point - cell.sum / cell.mass;
+         double dist2 = QPointF::dotProduct(delta, delta);
+         if (cell.body >= 0 || 4.0 * cell.half * cell.half < theta * theta * dist2)
+         {
+            if (dist2 > KMinDistance) result += delta * (k2 * cell.mass / dist2);
+         }
+         else
+         {
+            for (int child : cell.children)
+            {
+               if (child >= 0) stack.append(child);
+            }
+         }
+      }
+
+      return result;
+   }
+
+private:
+   int addCell(QPointF center, double half)
+   {
+      Cell cell = { center, half, QPointF(), 0.0, { -1, -1, -1, -1 }, -1 };
+      cells.append(cell);
+      return cells.size() - 1;
+   }
+
+   int child(int index, const QPointF& point)
+   {
+      QPointF center = cells[index].center;
+      int quadrant = (point.x() >= center.x() ? 1 : 0) | (point.y() >= center.y() ? 2 : 0);
+      if (cells[index].children[quadrant] < 0)
+      {
+         double half = cells[index].half / 2.0;
+         QPointF offset((quadrant & 1) != 0 ? half : -half, (quadrant & 2) != 0 ? half : -half);
+         int result = addCell(center + offset, half);
+         cells[index].children[quadrant] = result;
+      }
+
+      return cells[index].children[quadrant];
+   }
+
+   void insert(int vertex, const QVector<QPointF>& pos)
+   {
+      QPointF point = pos[vertex];
+      int index = 0;
+      while (true)
+      {
+         cells[index].sum += point;
+         cells[index].mass += 1.0;
+         if (cells[index].mass == 1.0)
+         {
+            cells[index].body = vertex;
+            return;
+         }
+
+         if (cells[index].body >= 0)
+         {
+            if (cells[index].half < KMinCellSize) return; // Coincident nodes share a leaf
+
+            // Split the leaf, moving its node one level down:
+            int other = cells[index].body;
+            cells[index].body = -1;
+            int lower = child(index, pos[other]);
+            cells[lower].sum = pos[other];
+            cells[lower].mass = 1.0;
+            cells[lower].body = other;
+         }
+
+         index = child(index, point);
+      }
+   }
+
+   QVector<Cell> cells;
+};
+
+/** Gets the length of a vector. */
+static double length(const QPointF& vector)
+{
+   return std::sqrt(QPointF::dotProduct(vector, vector));
+}
+
+/** Places all nodes on a spiral in breadth first order, so neighbours start close to each other. */
+static void placeOnSpiral(const QVector<QVector<int>>& adjacent, QVector<QPointF>& pos, double k)
+{
+   int count = adjacent.size();
+   QVector<int>  order;
+   QVector<bool> visited(count, false);
+   for (int root = 0; root < count; ++root)
+   {
+      if (visited[root]) continue;
+
+      visited[root] = true;
+      int head = order.size();
+      order.append(root);
+      for (; head < order.size(); ++head)
+      {
+         for (int other : adjacent[order[head]])
+         {
+            if (visited[other]) continue;
+            visited[other] = true;
+            order.append(other);
+         }
+      }
+   }
+
+   for (int rank = 0; rank < count; ++rank)
+   {
+      double radius = KSpiralDensity * k * std::sqrt(rank + 0.5);
+      double angle = KGoldenAngle * rank;
+      pos[order[rank]] = QPointF(radius * std::cos(angle), radius * std::sin(angle));
+   }
+}
+
+/**
+ * Places new nodes next to the barycenter of their neighbours already placed.
+ *
+ * New nodes without such a neighbour are stacked in a column right of the nodes placed.
+ */
+static void placeNew(const QVector<QVector<int>>& adjacent, const QVector<bool>& isNew, QVector<QPointF>& pos,
+                     double k)
+{
+   int count = adjacent.size();
+   QVector<bool> placed(count);
+   QRectF        bounds;
+   bool          any = false;
+   for (int vertex = 0; vertex < count; ++vertex)
+   {
+      placed[vertex] = !isNew[vertex];
+      if (placed[vertex])
+      {
+         bounds = any ? bounds.united(QRectF(pos[vertex], QSizeF(1.0, 1.0))) : QRectF(pos[vertex], QSizeF(1.0, 1.0));
+         any = true;
+      }
+   }
+
+   if (!any)
+   {
+      placeOnSpiral(adjacent, pos, k);
+      return;
+   }
+
+   // New nodes next to placed ones first, then nodes next to these and so on:
+   QVector<int> pending;
+   for (int vertex = 0; vertex < count; ++vertex)
+   {
+      if (isNew[vertex]) pending.append(vertex);
+   }
+
+   bool progress = true;
+   while (!pending.isEmpty() && progress)
+   {
+      progress = false;
+      QVector<int> rest;
+      for (int vertex : pending)
+      {
+         QPointF sum;
+         int     neighbours = 0;
+         for (int other : adjacent[vertex])
+         {
+            if (!placed[other]) continue;
+            sum += pos[other];
+            ++neighbours;
+         }
+
+         if (neighbours == 0)
+         {
+            rest.append(vertex);
+            continue;
+         }
+
+         double angle = KGoldenAngle * vertex;
+         pos[vertex] = sum / neighbours + QPointF(std::cos(angle), std::sin(angle)) * (k / 2.0);
+         placed[vertex] = true;
+         progress = true;
+      }
+
+      pending = rest;
+   }
+
+   for (int index = 0; index < pending.size(); ++index)
+   {
+      pos[pending[index]] = QPointF(bounds.right() + k, bounds.top() + index * k);
+   }
+}
+
+/**
+ * Pushes overlapping nodes apart along the axis of the smaller overlap.
+ *
+ * Nodes are sorted into a grid with cells as large as the largest node, so only nodes in adjacent cells need to be
+ * compared.
+ */
+static void removeOverlaps(QVector<QPointF>& pos, const QVector<QSizeF>& sizes, const QVector<bool>& movable,
+                           double spacing)
+{
+   int    count = pos.size();
+   double gap = spacing / 2.0;
+   double cellSize = spacing;
+   for (const QSizeF& size : sizes)
+   {
+      cellSize = qMax(cellSize, qMax(size.width(), size.height()) + spacing);
+   }
+
+   for (int round = 0; round < KOverlapRounds; ++round)
+   {
+      QHash<QPair<int,int>, QVector<int>> grid;
+      for (int vertex = 0; vertex < count; ++vertex)
+      {
+         grid[qMakePair(qFloor(pos[vertex].x() / cellSize), qFloor(pos[vertex].y() / cellSize))].append(vertex);
+      }
+
+      bool overlapping = false;
+      for (int vertex = 0; vertex < count; ++vertex)
+      {
+         int column = qFloor(pos[vertex].x() / cellSize);
+         int row = qFloor(pos[vertex].y() / cellSize);
+         for (int x = column - 1; x <= column + 1; ++x)
+         {
+            for (int y = row - 1; y <= row + 1; ++y)
+            {
+               auto iter = grid.constFind(qMakePair(x, y));
+               if (iter == grid.constEnd()) continue;
+
+               for (int other : iter.value())
+               {
+                  if (other <= vertex || (!movable[vertex] && !movable[other])) continue;
+
+                  QPointF delta = pos[other] - pos[vertex];
+                  QSizeF  extent = (sizes[vertex] + sizes[other]) / 2.0 + QSizeF(gap, gap);
+                  double  overlapX = extent.width() - qAbs(delta.x());
+                  double  overlapY = extent.height() - qAbs(delta.y());
+                  if (overlapX <= 0.0 || overlapY <= 0.0) continue;
+                  overlapping = true;
+
+                  // Coincident nodes are separated in a direction depending on their numbers:
+                  QPointF push;
+                  if (overlapX < overlapY)
+                  {
+                     double sign = delta.x() > 0.0 || (delta.x() == 0.0 && ((vertex + other) % 2) == 0) ? 1.0 : -1.0;
+                     push = QPointF(sign * overlapX, 0.0);
+                  }
+                  else
+                  {
+                     double sign = delta.y() > 0.0 || (delta.y() == 0.0 && ((vertex + other) % 2) == 0) ? 1.0 : -1.0;
+                     push = QPointF(0.0, sign * overlapY);
+                  }
+
+                  if (movable[vertex] && movable[other])
+                  {
+                     pos[vertex] -= push / 2.0;
+                     pos[other] += push / 2.0;
+                  }
+                  else if (movable[vertex])
+                  {
+                     pos[vertex] -= push;
+                  }
+                  else
+                  {
+                     pos[other] += push;
+                  }
+               }
+            }
+         }
+      }
+
+      if (!overlapping) break;
+   }
+}
+
+struct ForceLayout::Data
+{
+   Data()
+   : edgeLength(0.0)
+   , iterations(KDefaultIterations)
+   , theta(KDefaultTheta)
+   {
+   }
+
+   double edgeLength;
+   int    iterations;
+   double theta;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+ForceLayout::ForceLayout()
+: data(new Data())
+{
+}
+
+ForceLayout::~ForceLayout()
+{
+   delete data;
+}
+
+/** Gets the name of the layout algorithm. */
+QString ForceLayout::name() const
+{
+   return "force";
+}
+
+/**
+ * Gets the ideal length of an edge, i.e. the distance at which attracting and repelling forces of two connected nodes
+ * neutralize each other.
+ *
+ * 0 (the default) means the average diagonal of the nodes plus nodeSpacing().
+ */
+double ForceLayout::edgeLength() const
+{
+   return data->edgeLength;
+}
+
+/** Sets the ideal length of an edge; 0 means the average diagonal of the nodes plus nodeSpacing(). */
+void ForceLayout::setEdgeLength(double value)
+{
+   data->edgeLength = qMax(0.0, value);
+}
+
+/** Gets the number of iterations of the simulation. */
+int ForceLayout::iterations() const
+{
+   return data->iterations;
+}
+
+/** Sets the number of iterations of the simulation. */
+void ForceLayout::setIterations(int value)
+{
+   data->iterations = qMax(0, value);
+}
+
+/**
+ * Gets the accuracy of the Barnes-Hut approximation.
+ *
+ * A group of nodes is treated as a single node if the ratio of its extent to its distance is below theta. 0 computes
+ * all forces exactly, larger values are faster but less accurate. The default is 0.8.
+ */
+double ForceLayout::theta() const
+{
+   return data->theta;
+}
+
+/** Sets the accuracy of the Barnes-Hut approximation (see theta()). */
+void ForceLayout::setTheta(double value)
+{
+   data->theta = qMax(0.0, value);
+}
+
+/**
+ * Places all nodes of a diagram from scratch and draws its edges directly.
+ *
+ * @param diagram Diagram to be laid out; must be open.
+ * @return True, if successful; otherwise false (see errorString()).
+ */
+bool ForceLayout::layout(UmlDiagram* diagram)
+{
+   return run(diagram, QList<DiaNode*>(), false);
+}
+
+/**
+ * Places nodes newly added to a diagram and relaxes their surroundings.
+ *
+ * Only the nodes added and their direct neighbours are moved; the other nodes keep their positions but still repel
+ * the nodes moved.
+ * @param diagram Diagram containing the nodes; must be open.
+ * @param added Nodes added to the diagram since it was laid out.
+ * @return True, if successful; otherwise false (see errorString()).
+ */
+bool ForceLayout::relax(UmlDiagram* diagram, const QList<DiaNode*>& added)
+{
+   return run(diagram, added, true);
+}
+
+/** Runs the simulation for all nodes or - if incremental is true - around the nodes added only. */
+bool ForceLayout::run(UmlDiagram* diagram, const QList<DiaNode*>& added, bool incremental)
+{
+   setErrorString("");
+   if (diagram == nullptr || !diagram->isOpen())
+   {
+      setErrorString(QObject::tr("The diagram is not open."));
+      return false;
+   }
+
+   auto nodes = diagram->nodes().toVector();
+   int count = nodes.size();
+   if (count == 0) return true;
+
+   QHash<DiaShape*, int> vertices;
+   QVector<QSizeF>       sizes(count);
+   QVector<QPointF>      pos(count);
+   double                diagonal = 0.0;
+   for (int vertex = 0; vertex < count; ++vertex)
+   {
+      vertices.insert(nodes[vertex], vertex);
+      sizes[vertex] = nodeSize(nodes[vertex]);
+      pos[vertex] = nodes[vertex]->pos();
+      diagonal += std::hypot(sizes[vertex].width(), sizes[vertex].height());
+   }
+
+   double k = data->edgeLength > 0.0 ? data->edgeLength : diagonal / count + nodeSpacing();
+
+   // Edges of any kind attract their nodes, parallel edges count once:
+   QVector<QVector<int>> adjacent(count);
+   QSet<QPair<int,int>>  known;
+   for (auto* edge : diagram->edges())
+   {
+      int vertex1 = vertices.value(edge->shape1(), -1);
+      int vertex2 = vertices.value(edge->shape2(), -1);
+      if (vertex1 < 0 || vertex2 < 0 || vertex1 == vertex2) continue;
+
+      auto key = qMakePair(qMin(vertex1, vertex2), qMax(vertex1, vertex2));
+      if (known.contains(key)) continue;
+      known.insert(key);
+
+      adjacent[vertex1].append(vertex2);
+      adjacent[vertex2].append(vertex1);
+   }
+
+   // Select the nodes to be moved and their initial positions:
+   QVector<bool> movable(count, !incremental);
+   if (incremental)
+   {
+      QVector<bool> isNew(count, false);
+      for (auto* node : added)
+      {
+         int vertex = vertices.value(node, -1);
+         if (vertex >= 0) isNew[vertex] = true;
+      }
+
+      placeNew(adjacent, isNew, pos, k);
+      for (int vertex = 0; vertex < count; ++vertex)
+      {
+         if (!isNew[vertex]) continue;
+
+         movable[vertex] = true;
+         for (int other : adjacent[vertex]) movable[other] = true;
+      }
+   }
+   else
+   {
+      placeOnSpiral(adjacent, pos, k);
+   }
+
+   QVector<int> active;
+   for (int vertex = 0; vertex < count; ++vertex)
+   {
+      if (movable[vertex]) active.append(vertex);
+   }
+
+   if (active.isEmpty()) return true;
+
+   QVector<QPair<int,int>> ranges;
+   for (int start = 0; start < active.size(); start += KChunkSize)
+   {
+      ranges.append(qMakePair(start, qMin(start + KChunkSize, active.size())));
+   }
+
+   // Simulate, cooling down linearly:
+   double start = incremental ? k : k * (1.0 + std::sqrt(static_cast<double>(count)) / 10.0);
+   double gravity = incremental ? 0.0 : KGravity;
+   double theta = data->theta;
+   double k2 = k * k;
+
+   QVector<QPointF> disp(count);
+   QPointF*         displacement = disp.data(); // Written concurrently, one entry per node
+   QuadTree         tree;
+   for (int iteration = 0; iteration < data->iterations; ++iteration)
+   {
+      double temperature = start * (1.0 - static_cast<double>(iteration) / data->iterations);
+
+      QPointF center;
+      for (const QPointF& point : pos) center += point;
+      center /= count;
+
+      tree.build(pos);
+      const auto& current = pos;
+      QtConcurrent::blockingMap(ranges, [&](QPair<int,int>& range)
+      {
+         for (int index = range.first; index < range.second; ++index)
+         {
+            int vertex = active[index];
+            QPointF force = tree.repulsion(vertex, current, theta, k2);
+            for (int other : adjacent[vertex])
+            {
+               QPointF delta = current[vertex] - current[other];
+               force -= delta * (length(delta) / k);
+            }
+
+            force -= (current[vertex] - center) * gravity;
+            displacement[vertex] = force;
+         }
+      });
+
+      for (int vertex : active)
+      {
+         double dist = length(disp[vertex]);
+         if (dist > 0.0) pos[vertex] += disp[vertex] * (qMin(dist, temperature) / dist);
+      }
+   }
+
+   removeOverlaps(pos, sizes, movable, nodeSpacing());
+
+   // Move the diagram to the origin, unless other nodes keep their positions:
+   if (!incremental)
+   {
+      double left = pos[0].x() - sizes[0].width() / 2.0;
+      double top = pos[0].y() - sizes[0].height() / 2.0;
+      for (int vertex = 1; vertex < count; ++vertex)
+      {
+         left = qMin(left, pos[vertex].x() - sizes[vertex].width() / 2.0);
+         top = qMin(top, pos[vertex].y() - sizes[vertex].height() / 2.0);
+      }
+
+      for (QPointF& point : pos) point -= QPointF(left, top);
+   }
+
+   for (int vertex : active)
+   {
+      nodes[vertex]->setPos(pos[vertex]);
+   }
+
+   for (auto* edge : diagram->edges())
+   {
+      int vertex1 = vertices.value(edge->shape1(), -1);
+      int vertex2 = vertices.value(edge->shape2(), -1);
+      if (vertex1 >= 0 && vertex2 >= 0 && (movable[vertex1] || movable[vertex2])) routeDirect(edge);
+   }
+
+   return true;
+}
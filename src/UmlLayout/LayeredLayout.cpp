@@ -0,0 +1,803 @@
+//---------------------------------------------------------------------------------------------------------------------
+// LayeredLayout.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class LayeredLayout.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "LayeredLayout.h"
+
+#include "DiaEdge.h"
+#include "DiaNode.h"
+#include "UmlDiagram.h"
+#include "UmlGeneralization.h"
+#include "UmlRealization.h"
+
+#include <QHash>
+#include <QObject>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+/**
+ * @class LayeredLayout
+ * @brief The LayeredLayout class arranges the nodes of a diagram in layers following its class hierarchy.
+ * @since 0.2.0
+ * @ingroup UmlLayout
+ *
+ * The LayeredLayout class implements the layered graph drawing method of Sugiyama et al. on the generalizations and
+ * realizations shown in a diagram: general classifiers are placed above the specific ones. The layout is computed in
+ * four steps:
+ * 1. Cycle removal: edges closing a cycle, found by a depth first search, are reversed.
+ * 2. Layer assignment: each node is placed on the layer following the longest path from the topmost nodes. Edges
+ *    spanning more than one layer are split by dummy nodes, one per layer crossed.
+ * 3. Crossing minimization: the nodes of each layer are sorted by the barycenter of their neighbours in alternating
+ *    downward and upward sweeps. Several sweeps starting from different orders are run concurrently on the global
+ *    thread pool (see restarts()); the order with the fewest crossings wins. Crossings are counted with the
+ *    accumulator tree of Barth, Juenger and Mutzel.
+ * 4. Coordinate assignment: each node is moved as close as possible to the median of its neighbours without
+ *    violating the order or the spacing of its layer. Dummy nodes are weighted higher to keep long edges straight.
+ *
+ * Edges crossing layers are routed along the positions of their dummy nodes (RoutingKind::Custom), all other edges
+ * between different nodes are drawn directly. Nodes neither connected by a generalization nor by a realization are
+ * placed in rows below the layers.
+ *
+ * The result does not depend on the number of threads used: the restarts are seeded by their number.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal structs hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const double KDefaultLayerSpacing = 80.0;
+static const int    KDefaultSweeps       = 12;
+static const int    KMaxStalledSweeps    = 2;   // Sweeps without improvement until crossing minimization stops
+static const int    KBalancingRounds     = 4;
+static const double KDummyWeight         = 4.0; // Weight of dummy nodes when balancing, keeps long edges straight
+static const double KIdleWeight          = 0.5; // Weight of nodes without neighbours in the layer balanced against
+static const double KGridAspect          = 1.6; // Aspect ratio of the rows of unconnected nodes
+
+/** Layered graph built from the nodes and hierarchy edges of the diagram. */
+struct Graph
+{
+   Graph()
+   : layerCount(0)
+   {}
+
+   QVector<DiaNode*>     nodes;  ///< Nodes of the diagram followed by the dummy nodes (nullptr)
+   QVector<QSizeF>       sizes;
+   QVector<int>          layer;  ///< Layer of each vertex; -1 if the node is not connected
+   QVector<QVector<int>> succ;   ///< Neighbours on the layer below
+   QVector<QVector<int>> pred;   ///< Neighbours on the layer above
+   int                   layerCount;
+
+   int count() const
+   {
+      return nodes.size();
+   }
+
+   int addVertex(DiaNode* node, QSizeF size, int layer)
+   {
+      nodes.append(node);
+      sizes.append(size);
+      this->layer.append(layer);
+      succ.append(QVector<int>());
+      pred.append(QVector<int>());
+      return nodes.size() - 1;
+   }
+
+   void addArc(int upper, int lower)
+   {
+      succ[upper].append(lower);
+      pred[lower].append(upper);
+   }
+};
+
+/** Hierarchy edge of the diagram, directed from the upper to the lower node. */
+struct Arc
+{
+   int      upper;
+   int      lower;
+   DiaEdge* edge;
+   int      chain; ///< Index of the chain of vertices connecting both nodes
+};
+
+/** Order of the vertices on each layer as found by one restart of the crossing minimization. */
+struct Ordering
+{
+   Ordering()
+   : crossings(0)
+   {}
+
+   QVector<QVector<int>> layers;
+   qint64                crossings;
+};
+
+/** Reverses all arcs closing a cycle, found by an iterative depth first search. */
+static void removeCycles(int count, QVector<Arc>& arcs)
+{
+   QVector<QVector<int>> out(count);
+   for (int index = 0; index < arcs.size(); ++index)
+   {
+      out[arcs[index].upper].append(index);
+   }
+
+   QVector<char>           state(count, 0); // 0 = not visited, 1 = on stack, 2 = finished
+   QVector<bool>           reversed(arcs.size(), false);
+   QVector<QPair<int,int>> stack;
+   for (int root = 0; root < count; ++root)
+   {
+      if (state[root] != 0) continue;
+
+      state[root] = 1;
+      stack.append(qMakePair(root, 0));
+      while (!stack.isEmpty())
+      {
+         int vertex = stack.last().first;
+         int next = stack.last().second++;
+         if (next < out[vertex].size())
+         {
+            int arc = out[vertex][next];
+            int target = arcs[arc].lower;
+            if (state[target] == 1)
+            {
+               reversed[arc] = true;
+            }
+            else if (state[target] == 0)
+            {
+               state[target] = 1;
+               stack.append(qMakePair(target, 0));
+            }
+         }
+         else
+         {
+            state[vertex] = 2;
+            stack.removeLast();
+         }
+      }
+   }
+
+   for (int index = 0; index < arcs.size(); ++index)
+   {
+      if (reversed[index]) std::swap(arcs[index].upper, arcs[index].lower);
+   }
+}
+
+/** Assigns each connected vertex the length of the longest path from a topmost vertex as layer. */
+static void assignLayers(Graph& graph, const QVector<Arc>& arcs)
+{
+   int count = graph.count();
+   QVector<QVector<int>> out(count);
+   QVector<int>          degree(count, 0);
+   for (const Arc& arc : arcs)
+   {
+      out[arc.upper].append(arc.lower);
+      degree[arc.lower]++;
+      graph.layer[arc.upper] = 0;
+      graph.layer[arc.lower] = 0;
+   }
+
+   QVector<int> queue;
+   for (int vertex = 0; vertex < count; ++vertex)
+   {
+      if (graph.layer[vertex] == 0 && degree[vertex] == 0) queue.append(vertex);
+   }
+
+   for (int head = 0; head < queue.size(); ++head)
+   {
+      int vertex = queue[head];
+      graph.layerCount = qMax(graph.layerCount, graph.layer[vertex] + 1);
+      for (int target : out[vertex])
+      {
+         graph.layer[target] = qMax(graph.layer[target], graph.layer[vertex] + 1);
+         if (--degree[target] == 0) queue.append(target);
+      }
+   }
+}
+
+/** Connects the vertices of each arc, inserting a dummy vertex on each layer crossed. */
+static QVector<QVector<int>> makeChains(Graph& graph, QVector<Arc>& arcs)
+{
+   QVector<QVector<int>> chains;
+   QHash<QPair<int,int>, int> known; // Parallel arcs share their chain
+   for (Arc& arc : arcs)
+   {
+      auto key = qMakePair(arc.upper, arc.lower);
+      auto iter = known.constFind(key);
+      if (iter != known.constEnd())
+      {
+         arc.chain = iter.value();
+         continue;
+      }
+
+      QVector<int> chain;
+      chain.append(arc.upper);
+      for (int layer = graph.layer[arc.upper] + 1; layer < graph.layer[arc.lower]; ++layer)
+      {
+         int dummy = graph.addVertex(nullptr, QSizeF(), layer);
+         graph.addArc(chain.last(), dummy);
+         chain.append(dummy);
+      }
+
+      graph.addArc(chain.last(), arc.lower);
+      chain.append(arc.lower);
+
+      arc.chain = chains.size();
+      known.insert(key, arc.chain);
+      chains.append(chain);
+   }
+
+   return chains;
+}
+
+/** Makes the initial order of the layers by a depth first search, keeping the descendants of a node together. */
+static QVector<QVector<int>> initialOrder(const Graph& graph)
+{
+   QVector<QVector<int>> layers(graph.layerCount);
+   QVector<bool>         visited(graph.count(), false);
+   QVector<int>          stack;
+   for (int root = 0; root < graph.count(); ++root)
+   {
+      if (graph.layer[root] < 0 || !graph.pred[root].isEmpty() || visited[root]) continue;
+
+      stack.append(root);
+      while (!stack.isEmpty())
+      {
+         int vertex = stack.takeLast();
+         if (visited[vertex]) continue;
+
+         visited[vertex] = true;
+         layers[graph.layer[vertex]].append(vertex);
+         for (int index = graph.succ[vertex].size() - 1; index >= 0; --index)
+         {
+            if (!visited[graph.succ[vertex][index]]) stack.append(graph.succ[vertex][index]);
+         }
+      }
+   }
+
+   return layers;
+}
+
+/** Stores the index of each vertex within its layer. */
+static void updatePositions(const QVector<QVector<int>>& layers, QVector<int>& pos)
+{
+   for (const auto& layer : layers)
+   {
+      for (int index = 0; index < layer.size(); ++index)
+      {
+         pos[layer[index]] = index;
+      }
+   }
+}
+
+/** Counts the crossings between two adjacent layers using an accumulator tree (Barth, Juenger, Mutzel). */
+static qint64 countCrossings(const Graph& graph, const QVector<int>& upper, int lowerCount, const QVector<int>& pos,
+                             QVector<int>& targets, QVector<int>& tree)
+{
+   targets.clear();
+   for (int vertex : upper)
+   {
+      int start = targets.size();
+      for (int target : graph.succ[vertex])
+      {
+         targets.append(pos[target]);
+      }
+
+      std::sort(targets.begin() + start, targets.end());
+   }
+
+   int first = 1;
+   while (first < lowerCount) first *= 2;
+   tree.fill(0, 2 * first - 1);
+   first -= 1;
+
+   qint64 result = 0;
+   for (int target : targets)
+   {
+      int index = target + first;
+      tree[index]++;
+      while (index > 0)
+      {
+         if (index % 2 != 0) result += tree[index + 1];
+         index = (index - 1) / 2;
+         tree[index]++;
+      }
+   }
+
+   return result;
+}
+
+/** Counts the crossings of all layers. */
+static qint64 countCrossings(const Graph& graph, const QVector<QVector<int>>& layers, const QVector<int>& pos)
+{
+   QVector<int> targets;
+   QVector<int> tree;
+   qint64       result = 0;
+   for (int index = 0; index + 1 < layers.size(); ++index)
+   {
+      result += countCrossings(graph, layers[index], layers[index + 1].size(), pos, targets, tree);
+   }
+
+   return result;
+}
+
+/** Sorts a layer by the barycenter of the neighbours of its vertices on the adjacent layer. */
+static void sortLayer(QVector<int>& layer, const QVector<QVector<int>>& adjacent, QVector<int>& pos,
+                      QVector<double>& keys)
+{
+   for (int vertex : layer)
+   {
+      const auto& list = adjacent[vertex];
+      if (list.isEmpty())
+      {
+         keys[vertex] = pos[vertex]; // Vertices without neighbours keep their place
+      }
+      else
+      {
+         double sum = 0.0;
+         for (int other : list) sum += pos[other];
+         keys[vertex] = sum / list.size();
+      }
+   }
+
+   std::stable_sort(layer.begin(), layer.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+   for (int index = 0; index < layer.size(); ++index)
+   {
+      pos[layer[index]] = index;
+   }
+}
+
+/** Minimizes the crossings of an ordering by alternating downward and upward barycenter sweeps. */
+static void minimizeCrossings(const Graph& graph, Ordering& ordering, int sweeps)
+{
+   auto& layers = ordering.layers;
+   QVector<int>    pos(graph.count(), 0);
+   QVector<double> keys(graph.count(), 0.0);
+   updatePositions(layers, pos);
+
+   auto   best = layers;
+   qint64 bestCount = countCrossings(graph, layers, pos);
+   int    stalled = 0;
+   for (int sweep = 0; sweep < sweeps && bestCount > 0 && stalled < KMaxStalledSweeps; ++sweep)
+   {
+      for (int index = 1; index < layers.size(); ++index)
+      {
+         sortLayer(layers[index], graph.pred, pos, keys);
+      }
+
+      for (int index = layers.size() - 2; index >= 0; --index)
+      {
+         sortLayer(layers[index], graph.succ, pos, keys);
+      }
+
+      qint64 count = countCrossings(graph, layers, pos);
+      if (count < bestCount)
+      {
+         best = layers;
+         bestCount = count;
+         stalled = 0;
+      }
+      else
+      {
+         ++stalled;
+      }
+   }
+
+   ordering.layers = best;
+   ordering.crossings = bestCount;
+}
+
+/** Gets the minimum distance between the centers of two vertices placed side by side. */
+static double separation(const Graph& graph, int left, int right, double spacing)
+{
+   bool dummy = graph.nodes[left] == nullptr || graph.nodes[right] == nullptr;
+   return (graph.sizes[left].width() + graph.sizes[right].width()) / 2.0 + (dummy ? spacing / 2.0 : spacing);
+}
+
+/**
+ * Moves the vertices of a layer as close as possible to the median of their neighbours on the adjacent layer.
+ *
+ * Keeping order and spacing of the layer, the weighted sum of the squared distances to the medians is minimized by
+ * the pool adjacent violators algorithm: subtracting the minimum offset of each vertex from the left end of the layer
+ * turns the constraints into a monotonic regression.
+ */
+static void balanceLayer(const Graph& graph, const QVector<int>& layer, const QVector<QVector<int>>& adjacent,
+                         QVector<double>& x, double spacing)
+{
+   struct Block
+   {
+      double value;
+      double weight;
+      int    count;
+   };
+
+   int count = layer.size();
+   if (count == 0) return;
+
+   QVector<double> offset(count, 0.0);
+   for (int index = 1; index < count; ++index)
+   {
+      offset[index] = offset[index - 1] + separation(graph, layer[index - 1], layer[index], spacing);
+   }
+
+   QVector<Block>  blocks;
+   QVector<double> values;
+   for (int index = 0; index < count; ++index)
+   {
+      int    vertex = layer[index];
+      double target = x[vertex];
+      double weight = KIdleWeight;
+      if (!adjacent[vertex].isEmpty())
+      {
+         values.clear();
+         for (int other : adjacent[vertex]) values.append(x[other]);
+         std::sort(values.begin(), values.end());
+
+         int middle = values.size() / 2;
+         target = values.size() % 2 != 0 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+         weight = graph.nodes[vertex] == nullptr ? KDummyWeight : 1.0;
+      }
+
+      blocks.append(Block{ target - offset[index], weight, 1 });
+      while (blocks.size() > 1 && blocks[blocks.size() - 2].value > blocks.last().value)
+      {
+         Block last = blocks.takeLast();
+         Block& prev = blocks.last();
+         prev.value = (prev.value * prev.weight + last.value * last.weight) / (prev.weight + last.weight);
+         prev.weight += last.weight;
+         prev.count += last.count;
+      }
+   }
+
+   int index = 0;
+   for (const Block& block : blocks)
+   {
+      for (int step = 0; step < block.count; ++step, ++index)
+      {
+         x[layer[index]] = block.value + offset[index];
+      }
+   }
+}
+
+/** Assigns the horizontal coordinates of all vertices; the leftmost vertex starts at 0. */
+static QVector<double> assignColumns(const Graph& graph, const QVector<QVector<int>>& layers, double spacing)
+{
+   QVector<double> x(graph.count(), 0.0);
+   QVector<double> widths;
+   double          maxWidth = 0.0;
+   for (const auto& layer : layers)
+   {
+      double width = 0.0;
+      for (int index = 0; index < layer.size(); ++index)
+      {
+         if (index > 0) width += separation(graph, layer[index - 1], layer[index], spacing);
+         x[layer[index]] = width;
+      }
+
+      widths.append(width);
+      maxWidth = qMax(maxWidth, width);
+   }
+
+   for (int index = 0; index < layers.size(); ++index)
+   {
+      double shift = (maxWidth - widths[index]) / 2.0;
+      for (int vertex : layers[index]) x[vertex] += shift;
+   }
+
+   for (int round = 0; round < KBalancingRounds; ++round)
+   {
+      for (int index = 1; index < layers.size(); ++index)
+      {
+         balanceLayer(graph, layers[index], graph.pred, x, spacing);
+      }
+
+      for (int index = layers.size() - 2; index >= 0; --index)
+      {
+         balanceLayer(graph, layers[index], graph.succ, x, spacing);
+      }
+   }
+
+   double left = 0.0;
+   bool   first = true;
+   for (const auto& layer : layers)
+   {
+      if (layer.isEmpty()) continue;
+
+      double value = x[layer.first()] - graph.sizes[layer.first()].width() / 2.0;
+      left = first ? value : qMin(left, value);
+      first = false;
+   }
+
+   for (double& value : x) value -= left;
+   return x;
+}
+
+struct LayeredLayout::Data
+{
+   Data()
+   : layerSpacing(KDefaultLayerSpacing)
+   , sweeps(KDefaultSweeps)
+   , restarts(0)
+   , crossings(0)
+   {
+   }
+
+   double layerSpacing;
+   int    sweeps;
+   int    restarts;
+   qint64 crossings;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+LayeredLayout::LayeredLayout()
+: data(new Data())
+{
+}
+
+LayeredLayout::~LayeredLayout()
+{
+   delete data;
+}
+
+/** Gets the name of the layout algorithm. */
+QString LayeredLayout::name() const
+{
+   return "layered";
+}
+
+/** Gets the vertical distance between two layers. */
+double LayeredLayout::layerSpacing() const
+{
+   return data->layerSpacing;
+}
+
+/** Sets the vertical distance between two layers. */
+void LayeredLayout::setLayerSpacing(double value)
+{
+   data->layerSpacing = qMax(0.0, value);
+}
+
+/** Gets the maximum number of downward and upward sweeps per restart of the crossing minimization. */
+int LayeredLayout::sweeps() const
+{
+   return data->sweeps;
+}
+
+/** Sets the maximum number of downward and upward sweeps per restart of the crossing minimization. */
+void LayeredLayout::setSweeps(int value)
+{
+   data->sweeps = qMax(0, value);
+}
+
+/**
+ * Gets the number of restarts of the crossing minimization.
+ *
+ * The first restart begins with the order found by a depth first search, all others with a random order. The
+ * restarts are run concurrently. 0 (the default) means one restart per processor core.
+ */
+int LayeredLayout::restarts() const
+{
+   return data->restarts;
+}
+
+/** Sets the number of restarts of the crossing minimization; 0 means one restart per processor core. */
+void LayeredLayout::setRestarts(int value)
+{
+   data->restarts = qMax(0, value);
+}
+
+/** Gets the number of edge crossings between the layers left by the last call of layout(). */
+qint64 LayeredLayout::crossings() const
+{
+   return data->crossings;
+}
+
+/**
+ * Places the nodes of a diagram in layers and routes its edges.
+ *
+ * @param diagram Diagram to be laid out; must be open.
+ * @return True, if successful; otherwise false (see errorString()).
+ */
+bool LayeredLayout::layout(UmlDiagram* diagram)
+{
+   setErrorString("");
+   data->crossings = 0;
+   if (diagram == nullptr || !diagram->isOpen())
+   {
+      setErrorString(QObject::tr("The diagram is not open."));
+      return false;
+   }
+
+   // Build the graph from the nodes and the hierarchy edges of the diagram:
+   Graph graph;
+   QHash<DiaShape*, int> vertices;
+   for (auto* node : diagram->nodes())
+   {
+      vertices.insert(node, graph.addVertex(node, nodeSize(node), -1));
+   }
+
+   QVector<Arc> arcs;
+   for (auto* edge : diagram->edges())
+   {
+      auto* link = edge->link();
+      if (dynamic_cast<UmlGeneralization*>(link) == nullptr && dynamic_cast<UmlRealization*>(link) == nullptr) continue;
+
+      int specific = vertices.value(edge->shape1(), -1);
+      int general = vertices.value(edge->shape2(), -1);
+      if (specific < 0 || general < 0 || specific == general) continue;
+
+      arcs.append(Arc{ general, specific, edge, -1 });
+   }
+
+   int count = graph.count();
+   removeCycles(count, arcs);
+   assignLayers(graph, arcs);
+   auto chains = makeChains(graph, arcs);
+
+   // Minimize crossings, one restart per thread:
+   int restarts = data->restarts > 0 ? data->restarts : qMax(1, QThread::idealThreadCount());
+   auto initial = initialOrder(graph);
+
+   QVector<Ordering> orderings(restarts);
+   for (int index = 0; index < restarts; ++index)
+   {
+      orderings[index].layers = initial;
+      if (index > 0)
+      {
+         std::mt19937 random(static_cast<std::mt19937::result_type>(index));
+         for (auto& layer : orderings[index].layers) std::shuffle(layer.begin(), layer.end(), random);
+      }
+   }
+
+   int sweeps = data->sweeps;
+   QtConcurrent::blockingMap(orderings, [&graph, sweeps](Ordering& ordering)
+   {
+      minimizeCrossings(graph, ordering, sweeps);
+   });
+
+   int best = 0;
+   for (int index = 1; index < restarts; ++index)
+   {
+      if (orderings[index].crossings < orderings[best].crossings) best = index;
+   }
+
+   const auto& layers = orderings[best].layers;
+   data->crossings = orderings[best].crossings;
+
+   // Assign coordinates:
+   auto x = assignColumns(graph, layers, nodeSpacing());
+
+   QVector<double> tops(layers.size(), 0.0);
+   QVector<double> heights(layers.size(), 0.0);
+   double bottom = 0.0;
+   double right = 0.0;
+   for (int index = 0; index < layers.size(); ++index)
+   {
+      for (int vertex : layers[index])
+      {
+         heights[index] = qMax(heights[index], graph.sizes[vertex].height());
+         right = qMax(right, x[vertex] + graph.sizes[vertex].width() / 2.0);
+      }
+
+      tops[index] = index == 0 ? 0.0 : tops[index - 1] + heights[index - 1] + data->layerSpacing;
+      bottom = tops[index] + heights[index];
+   }
+
+   for (int vertex = 0; vertex < count; ++vertex)
+   {
+      int layer = graph.layer[vertex];
+      if (layer >= 0)
+      {
+         graph.nodes[vertex]->setPos(QPointF(x[vertex], tops[layer] + heights[layer] / 2.0));
+      }
+   }
+
+   // Place unconnected nodes in rows below the layers:
+   double area = 0.0;
+   for (int vertex = 0; vertex < count; ++vertex)
+   {
+      if (graph.layer[vertex] < 0)
+      {
+         area += (graph.sizes[vertex].width() + nodeSpacing()) * (graph.sizes[vertex].height() + nodeSpacing());
+      }
+   }
+
+   if (area > 0.0)
+   {
+      double rowWidth = qMax(right, std::sqrt(area * KGridAspect));
+      double top = layers.isEmpty() ? 0.0 : bottom + data->layerSpacing;
+      double left = 0.0;
+      double rowHeight = 0.0;
+      for (int vertex = 0; vertex < count; ++vertex)
+      {
+         if (graph.layer[vertex] >= 0) continue;
+
+         QSizeF size = graph.sizes[vertex];
+         if (left > 0.0 && left + size.width() > rowWidth)
+         {
+            top += rowHeight + nodeSpacing();
+            left = 0.0;
+            rowHeight = 0.0;
+         }
+
+         graph.nodes[vertex]->setPos(QPointF(left + size.width() / 2.0, top + size.height() / 2.0));
+         left += size.width() + nodeSpacing();
+         rowHeight = qMax(rowHeight, size.height());
+      }
+   }
+
+   // Route the edges:
+   QHash<DiaEdge*, int> routed;
+   for (const Arc& arc : arcs)
+   {
+      routed.insert(arc.edge, arc.chain);
+   }
+
+   for (auto* edge : diagram->edges())
+   {
+      auto* node1 = dynamic_cast<DiaNode*>(edge->shape1());
+      auto* node2 = dynamic_cast<DiaNode*>(edge->shape2());
+      if (node1 == nullptr || node2 == nullptr || node1 == node2) continue;
+
+      int chain = routed.value(edge, -1);
+      if (chain < 0 || chains[chain].size() <= 2)
+      {
+         routeDirect(edge);
+         continue;
+      }
+
+      // Follow the dummy vertices through their layers, from shape1 to shape2:
+      QPointF origin = node1->pos();
+      QVector<QPointF> bends;
+      for (int index = 1; index < chains[chain].size() - 1; ++index)
+      {
+         int vertex = chains[chain][index];
+         int layer = graph.layer[vertex];
+         bends.append(QPointF(x[vertex], tops[layer]) - origin);
+         bends.append(QPointF(x[vertex], tops[layer] + heights[layer]) - origin);
+      }
+
+      if (graph.nodes[chains[chain].first()] != node1)
+      {
+         std::reverse(bends.begin(), bends.end());
+      }
+
+      QVector<QPointF> points;
+      points.append(QPointF(0.0, 0.0));
+      points += bends;
+      points.append(node2->pos() - origin);
+
+      edge->setRouting(RoutingKind::Custom);
+      edge->setPos(origin);
+      edge->setPoints(points);
+   }
+
+   return true;
+}
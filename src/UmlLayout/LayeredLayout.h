@@ -0,0 +1,63 @@
+//---------------------------------------------------------------------------------------------------------------------
+// LayeredLayout.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class LayeredLayout.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "DiagramLayout.h"
+
+class LayeredLayout final : public DiagramLayout
+{
+   ///@cond
+   typedef DiagramLayout super;
+   ///@endcond
+public: // Constructors
+   LayeredLayout();
+   ~LayeredLayout();
+
+public: // Properties
+   QString name() const override;
+
+   double layerSpacing() const;
+   void setLayerSpacing(double value);
+
+   int sweeps() const;
+   void setSweeps(int value);
+
+   int restarts() const;
+   void setRestarts(int value);
+
+   qint64 crossings() const;
+
+public: // Methods
+   bool layout(UmlDiagram* diagram) override;
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
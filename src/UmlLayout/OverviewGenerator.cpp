@@ -0,0 +1,399 @@
+//---------------------------------------------------------------------------------------------------------------------
+// OverviewGenerator.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class OverviewGenerator.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "OverviewGenerator.h"
+
+#include "ForceLayout.h"
+
+#include "DiaEdge.h"
+#include "DiaNode.h"
+#include "UmlDependency.h"
+#include "UmlDiagram.h"
+#include "UmlGeneralization.h"
+#include "UmlModel.h"
+#include "UmlPackage.h"
+#include "UmlProject.h"
+#include "UmlRoot.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QSet>
+
+#include <algorithm>
+
+/**
+ * @class OverviewGenerator
+ * @brief The OverviewGenerator class maintains a diagram showing all packages of a project and their relations.
+ * @since 0.2.0
+ * @ingroup UmlLayout
+ *
+ * The OverviewGenerator class creates a packages diagram named diagramName() in the first model of the project (a new
+ * one if there is none) and keeps it up to date with the model: on each call of generate() it
+ * - collects all packages and models as well as all dependencies and generalizations between them in one pass over
+ *   the elements of the project,
+ * - removes the nodes and edges of elements no longer existing or no longer related from the diagram,
+ * - adds nodes and edges for new elements and
+ * - places the new nodes with ForceLayout: the first time all nodes, later only the new ones and their neighbours
+ *   (see ForceLayout::relax()), so the arrangement of the diagram stays stable.
+ *
+ * The work done depends on the number of elements of the project and the number of changes only, so the diagram can
+ * be refreshed each time the project is saved:
+ * ~~~{.cpp}
+ * OverviewGenerator generator(project);
+ * if (!generator.generate()) qWarning() << generator.errorString();
+ * ~~~
+ *
+ * The diagram is opened and closed by generate() unless it is already open. An open diagram must not be shown in the
+ * GUI while it is refreshed, since nodes and edges may be deleted. Shapes added by the user are removed from the
+ * diagram, but nodes moved by the user keep their positions.
+ *
+ * generate() does not write the diagram file. The shapes changed stay with the diagram, even if it is closed again
+ * (see UmlDiagram::recoverShapes()), and are written by the next save of the project together with the other changes.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const QString KDefaultName = "Overview";
+
+/** Orders elements by their identifiers, making the order of new nodes independent of the project's hash. */
+static bool lessById(UmlElement* elem1, UmlElement* elem2)
+{
+   return elem1->identifier() < elem2->identifier();
+}
+
+struct OverviewGenerator::Data
+{
+   Data()
+   : project(nullptr)
+   , diagramName(KDefaultName)
+   , diagram(nullptr)
+   , created(false)
+   , added(0)
+   , removed(0)
+   {
+   }
+
+   UmlProject* project;
+   QString     diagramName;
+   UmlDiagram* diagram;
+   bool        created;
+   int         added;
+   int         removed;
+   QString     errorString;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the OverviewGenerator class.
+ *
+ * @param project Project to generate the overview diagram of (must not be nullptr).
+ */
+OverviewGenerator::OverviewGenerator(UmlProject* project)
+: data(new Data())
+{
+   Q_ASSERT(project != nullptr);
+   data->project = project;
+}
+
+OverviewGenerator::~OverviewGenerator()
+{
+   delete data;
+}
+
+/** Gets the project of the overview diagram. */
+UmlProject* OverviewGenerator::project() const
+{
+   return data->project;
+}
+
+/** Gets the name of the overview diagram; the default is "Overview". */
+QString OverviewGenerator::diagramName() const
+{
+   return data->diagramName;
+}
+
+/** Sets the name of the overview diagram. */
+void OverviewGenerator::setDiagramName(const QString& value)
+{
+   data->diagramName = value;
+}
+
+/** Gets the diagram refreshed by the last call of generate(); nullptr if generate() was not called yet. */
+UmlDiagram* OverviewGenerator::diagram() const
+{
+   return data->diagram;
+}
+
+/** Gets a value indicating whether the last call of generate() created the diagram. */
+bool OverviewGenerator::isCreated() const
+{
+   return data->created;
+}
+
+/** Gets a value indicating whether the last call of generate() modified the diagram. */
+bool OverviewGenerator::isChanged() const
+{
+   return data->created || data->added > 0 || data->removed > 0;
+}
+
+/** Gets the number of nodes and edges added by the last call of generate(). */
+int OverviewGenerator::addedCount() const
+{
+   return data->added;
+}
+
+/** Gets the number of nodes and edges removed by the last call of generate(). */
+int OverviewGenerator::removedCount() const
+{
+   return data->removed;
+}
+
+/** Gets a description of the last error; empty if the last call of generate() was successful. */
+QString OverviewGenerator::errorString() const
+{
+   return data->errorString;
+}
+
+/**
+ * Finds the overview diagram in the project.
+ *
+ * @return The packages diagram named diagramName() owned by the first model of the project or nullptr if there is
+ * none.
+ */
+UmlDiagram* OverviewGenerator::find() const
+{
+   UmlCompositeElement* owner = data->project->root();
+   for (auto* elem : owner->elements())
+   {
+      if (dynamic_cast<UmlModel*>(elem) != nullptr)
+      {
+         owner = dynamic_cast<UmlModel*>(elem);
+         break;
+      }
+   }
+
+   for (auto* elem : owner->elements())
+   {
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram != nullptr && diagram->kind() == DiagramKind::Packages && diagram->name() == data->diagramName)
+      {
+         return diagram;
+      }
+   }
+
+   return nullptr;
+}
+
+/**
+ * Creates or refreshes the overview diagram.
+ *
+ * @return True, if successful; otherwise false (see errorString()).
+ */
+bool OverviewGenerator::generate()
+{
+   data->errorString.clear();
+   data->diagram = nullptr;
+   data->created = false;
+   data->added = 0;
+   data->removed = 0;
+
+   // Collect packages and their relations in one pass:
+   QVector<UmlPackage*> packages;
+   QVector<UmlLink*>    links;
+   for (auto* elem : data->project->elements())
+   {
+      auto* package = dynamic_cast<UmlPackage*>(elem);
+      if (package != nullptr)
+      {
+         if (package->owner() != nullptr) packages.append(package);
+         continue;
+      }
+
+      if (dynamic_cast<UmlDependency*>(elem) != nullptr || dynamic_cast<UmlGeneralization*>(elem) != nullptr)
+      {
+         links.append(static_cast<UmlLink*>(elem));
+      }
+   }
+
+   QSet<UmlElement*> shown;
+   for (auto* package : packages) shown.insert(package);
+
+   QSet<UmlLink*> wanted;
+   for (auto* link : links)
+   {
+      if (link->source() != link->target() && shown.contains(link->source()) && shown.contains(link->target()))
+      {
+         wanted.insert(link);
+      }
+   }
+
+   std::sort(packages.begin(), packages.end(), lessById);
+   std::sort(links.begin(), links.end(), lessById);
+
+   // Find or create the diagram:
+   auto* diagram = find();
+   if (diagram == nullptr)
+   {
+      UmlModel* owner = nullptr;
+      for (auto* elem : data->project->root()->elements())
+      {
+         owner = dynamic_cast<UmlModel*>(elem);
+         if (owner != nullptr) break;
+      }
+
+      // The root only accepts models:
+      if (owner == nullptr)
+      {
+         owner = new UmlModel();
+         owner->setName(QObject::tr("Model"));
+         data->project->insert(owner);
+         data->project->root()->append(owner);
+      }
+
+      diagram = new UmlDiagram();
+      diagram->setName(data->diagramName);
+      diagram->setComment(QObject::tr("Generated overview of all packages and their relations."));
+      diagram->setKind(DiagramKind::Packages);
+      data->project->insert(diagram);
+      owner->append(diagram);
+      data->created = true;
+   }
+
+   data->diagram = diagram;
+   bool wasOpen = diagram->isOpen();
+   if (!wasOpen && !diagram->open())
+   {
+      data->errorString = diagram->errorString();
+      diagram->close();
+      return false;
+   }
+
+   // Remove edges of links no longer related and nodes of elements no longer shown:
+   QSet<UmlLink*> present;
+   for (auto* edge : diagram->edges())
+   {
+      auto* node1 = dynamic_cast<DiaNode*>(edge->shape1());
+      auto* node2 = dynamic_cast<DiaNode*>(edge->shape2());
+      auto* link = edge->link();
+      if (wanted.contains(link) && !present.contains(link) && node1 != nullptr && node2 != nullptr &&
+          node1->element() == link->source() && node2->element() == link->target())
+      {
+         present.insert(link);
+         continue;
+      }
+
+      edge->setShape1(nullptr);
+      edge->setShape2(nullptr);
+      diagram->remove(edge);
+      ++data->removed;
+   }
+
+   QHash<UmlElement*, DiaNode*> nodes;
+   for (auto* node : diagram->nodes())
+   {
+      if (shown.contains(node->element()) && !nodes.contains(node->element()))
+      {
+         nodes.insert(node->element(), node);
+         continue;
+      }
+
+      for (auto* edge : node->edges())
+      {
+         present.remove(edge->link());
+         edge->setShape1(nullptr);
+         edge->setShape2(nullptr);
+         diagram->remove(edge);
+         ++data->removed;
+      }
+
+      diagram->remove(node);
+      ++data->removed;
+   }
+
+   // Add nodes and edges of new elements:
+   QList<DiaNode*> addedNodes;
+   for (auto* package : packages)
+   {
+      if (nodes.contains(package)) continue;
+
+      auto* node = diagram->addNode(package);
+      nodes.insert(package, node);
+      addedNodes.append(node);
+      ++data->added;
+   }
+
+   QList<DiaEdge*> addedEdges;
+   for (auto* link : links)
+   {
+      if (!wanted.contains(link) || present.contains(link)) continue;
+
+      auto* edge = diagram->addEdge(link);
+      edge->setShape1(nodes.value(link->source()));
+      edge->setShape2(nodes.value(link->target()));
+      addedEdges.append(edge);
+      ++data->added;
+   }
+
+   // Place new nodes:
+   bool success = true;
+   if (!addedNodes.isEmpty())
+   {
+      ForceLayout layout;
+      success = addedNodes.size() == diagram->nodeCount() ? layout.layout(diagram) : layout.relax(diagram, addedNodes);
+      if (!success) data->errorString = layout.errorString();
+   }
+
+   for (auto* edge : addedEdges)
+   {
+      DiagramLayout::routeDirect(edge);
+   }
+
+   // The project writes the shapes with its next save, also those of a closed diagram (see UmlDiagram::hasShapes()):
+   bool changed = success && isChanged();
+   if (changed)
+   {
+      data->project->markShapesModified(diagram);
+      data->project->isModified(true);
+   }
+
+   if (!wasOpen)
+   {
+      QJsonObject shapes;
+      if (changed) diagram->writeShapes(shapes);
+      diagram->close();
+      if (changed) diagram->recoverShapes(shapes);
+   }
+
+   return success;
+}
@@ -0,0 +1,41 @@
+//---------------------------------------------------------------------------------------------------------------------
+// UmlLayout.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Include file of the UmlLayout library.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "DiagramLayout.h"
+#include "ForceLayout.h"
+#include "LayeredLayout.h"
+#include "OverviewGenerator.h"
+
+/**
+ * @defgroup UmlLayout
+ * @brief Classes for laying out ViraquchaUML diagrams automatically
+ *
+ * The UmlLayout module provides algorithms placing the nodes and routing the edges of a UmlDiagram object (see class
+ * DiagramLayout). It does not depend on the GUI and is used by the application as well as by the command line tool.
+ */
@@ -0,0 +1,101 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DanglingLinkRule.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class DanglingLinkRule.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "DanglingLinkRule.h"
+
+#include "UmlLink.h"
+
+#include <QObject>
+
+/**
+ * @class DanglingLinkRule
+ * @brief Finds links whose source or target element is missing.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * A link is dangling if its source or target could not be resolved on loading the project (UmlLink::serialize() 
+ * silently drops unresolved ends) or if one of its ends has been removed from the project while the link remained. 
+ * Dangling links are reported as errors since they cannot be saved or shown in diagrams.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+DanglingLinkRule::DanglingLinkRule()
+{
+}
+
+DanglingLinkRule::~DanglingLinkRule()
+{
+}
+
+/** Gets the name of the rule. */
+QString DanglingLinkRule::name() const
+{
+   return "dangling-link";
+}
+
+/**
+ * Checks whether both ends of a link are part of the project of the link.
+ *
+ * @param elem Element to be checked. Elements other than links are ignored.
+ * @param issues List receiving the issues found.
+ */
+void DanglingLinkRule::check(UmlElement* elem, QList<ValidationIssue>& issues) const
+{
+   auto link = dynamic_cast<UmlLink*>(elem);
+   if (link == nullptr) return;
+
+   auto* source = link->source();
+   auto* target = link->target();
+   if (source == nullptr || source->project() != link->project())
+   {
+      issues.append(ValidationIssue(IssueSeverity::Error, name(), link->identifier(), 
+         QObject::tr("%1 has no source element.").arg(displayName(link))));
+   }
+
+   if (target == nullptr || target->project() != link->project())
+   {
+      issues.append(ValidationIssue(IssueSeverity::Error, name(), link->identifier(), 
+         QObject::tr("%1 has no target element.").arg(displayName(link))));
+   }
+}
+
+/** Gets the links attached to an element. */
+QList<UmlElement*> DanglingLinkRule::dependents(UmlElement* elem, QString oldName) const
+{
+   Q_UNUSED(oldName);
+
+   QList<UmlElement*> list;
+   for (auto* link : elem->links())
+   {
+      list.append(link);
+   }
+
+   return list;
+}
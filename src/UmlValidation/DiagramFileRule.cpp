@@ -0,0 +1,229 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DiagramFileRule.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class DiagramFileRule.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "DiagramFileRule.h"
+
+#include "../UmlCommon/PropertyStrings.h"
+#include "DiaEdge.h"
+#include "DiaNode.h"
+#include "ErrorTools.h"
+#include "UmlDiagram.h"
+#include "UmlLink.h"
+#include "UmlProject.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QSet>
+
+/**
+ * @class DiagramFileRule
+ * @brief Finds diagrams which cannot be opened correctly and orphaned diagram files.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * For diagrams not opened, the rule reads the diagram file and checks it the same way UmlDiagram::open() does:
+ * - the file must be parseable,
+ * - nodes and edges should refer to elements of the project (otherwise they are dropped on opening) and
+ * - both ends of an edge must refer to nodes or edges of the diagram (otherwise opening fails with "Error connecting 
+ *   edge shape").
+ *
+ * For open diagrams, the shapes in memory are checked instead. In addition, the rule reports files in the diagrams
+ * folder of the project which do not belong to any diagram of the project.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+DiagramFileRule::DiagramFileRule()
+{
+}
+
+DiagramFileRule::~DiagramFileRule()
+{
+}
+
+/** Gets the name of the rule. */
+QString DiagramFileRule::name() const
+{
+   return "diagram-file";
+}
+
+/**
+ * Checks whether a diagram can be opened.
+ *
+ * @param elem Element to be checked. Elements other than diagrams are ignored.
+ * @param issues List receiving the issues found.
+ */
+void DiagramFileRule::check(UmlElement* elem, QList<ValidationIssue>& issues) const
+{
+   auto diagram = dynamic_cast<UmlDiagram*>(elem);
+   if (diagram == nullptr || diagram->project() == nullptr) return;
+
+   if (diagram->isOpen())
+   {
+      checkOpen(diagram, issues);
+   }
+   else
+   {
+      checkFile(diagram, issues);
+   }
+}
+
+/**
+ * Looks for files in the diagrams folder not belonging to any diagram of the project.
+ *
+ * Files marked for removal (see UmlProject::removeFile()) are ignored since they are deleted on next saving.
+ */
+void DiagramFileRule::checkProject(UmlProject* project, QList<ValidationIssue>& issues) const
+{
+   QDir folder(project->diagramsFolder());
+   if (project->diagramsFolder().isEmpty() || !folder.exists()) return;
+
+   auto removed = project->removedFiles();
+   for (auto info : folder.entryInfoList(QStringList("*.json"), QDir::Files))
+   {
+      UmlElement* elem = nullptr;
+      QUuid id(info.completeBaseName());
+      if (project->find(id, &elem) && dynamic_cast<UmlDiagram*>(elem) != nullptr) continue;
+      if (removed.contains(info.filePath()) || removed.contains(info.absoluteFilePath())) continue;
+
+      issues.append(ValidationIssue(IssueSeverity::Warning, name(), QUuid(),
+         QObject::tr("Diagram file '%1' does not belong to any diagram of the project.").arg(info.filePath())));
+   }
+}
+
+/** Gets the open diagrams showing an element. */
+QList<UmlElement*> DiagramFileRule::dependents(UmlElement* elem, QString oldName) const
+{
+   Q_UNUSED(oldName);
+
+   QList<UmlElement*> list;
+   for (auto* observer : elem->observers())
+   {
+      auto diagram = dynamic_cast<UmlDiagram*>(observer);
+      if (diagram != nullptr && !list.contains(diagram)) list.append(diagram);
+   }
+
+   return list;
+}
+
+/** Checks the shapes of an open diagram. */
+void DiagramFileRule::checkOpen(UmlDiagram* diagram, QList<ValidationIssue>& issues) const
+{
+   auto* project = diagram->project();
+   for (auto* node : diagram->nodes())
+   {
+      if (node->element() == nullptr || node->element()->project() != project)
+      {
+         issues.append(ValidationIssue(IssueSeverity::Error, name(), diagram->identifier(),
+            QObject::tr("Diagram '%1' shows an element removed from the project.").arg(displayName(diagram))));
+      }
+   }
+
+   for (auto* edge : diagram->edges())
+   {
+      if (edge->link() == nullptr || edge->link()->project() != project)
+      {
+         issues.append(ValidationIssue(IssueSeverity::Error, name(), diagram->identifier(),
+            QObject::tr("Diagram '%1' shows a link removed from the project.").arg(displayName(diagram))));
+      }
+      else if (edge->shape1() == nullptr || edge->shape2() == nullptr)
+      {
+         issues.append(ValidationIssue(IssueSeverity::Error, name(), diagram->identifier(),
+            QObject::tr("Diagram '%1' contains an edge of '%2' not connected to a shape.")
+               .arg(displayName(diagram)).arg(displayName(edge->link()))));
+      }
+   }
+}
+
+/** Checks the file of a diagram not opened. */
+void DiagramFileRule::checkFile(UmlDiagram* diagram, QList<ValidationIssue>& issues) const
+{
+   // A diagram not saved yet has no file, which is fine:
+   QFile file(diagram->diagramFile());
+   if (!file.exists()) return;
+
+   if (!file.open(QIODevice::ReadOnly))
+   {
+      issues.append(ValidationIssue(IssueSeverity::Error, name(), diagram->identifier(),
+         QString(KFileReadError).arg(file.fileName()).arg(file.errorString())));
+      return;
+   }
+
+   QJsonParseError error;
+   auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+   if (doc.isNull())
+   {
+      issues.append(ValidationIssue(IssueSeverity::Error, name(), diagram->identifier(),
+         QString(KFileParseError).arg(file.fileName()).arg(::toString(error))));
+      return;
+   }
+
+   auto*         project = diagram->project();
+   auto          json    = doc.object();
+   QSet<QString> shapes;
+   int           missing = 0;
+
+   for (auto value : json[KPropNodes].toArray())
+   {
+      auto id = value.toObject().value(KPropElement).toString();
+      if (project->contains(QUuid(id))) shapes.insert(id); else ++missing;
+   }
+
+   auto edges = json[KPropEdges].toArray();
+   for (auto value : edges)
+   {
+      auto id = value.toObject().value(KPropLink).toString();
+      if (project->contains(QUuid(id))) shapes.insert(id); else ++missing;
+   }
+
+   if (missing > 0)
+   {
+      issues.append(ValidationIssue(IssueSeverity::Warning, name(), diagram->identifier(),
+         QObject::tr("Diagram '%1' refers to %2 element(s) removed from the project.")
+            .arg(displayName(diagram)).arg(missing)));
+   }
+
+   for (auto value : edges)
+   {
+      auto obj = value.toObject();
+      if (!shapes.contains(obj.value(KPropLink).toString())) continue;
+      if (!shapes.contains(obj.value(KPropNode1).toString()) || !shapes.contains(obj.value(KPropNode2).toString()))
+      {
+         issues.append(ValidationIssue(IssueSeverity::Error, name(), diagram->identifier(),
+            QObject::tr("Diagram '%1' contains an edge which cannot be connected; the diagram cannot be opened.")
+               .arg(displayName(diagram))));
+         break;
+      }
+   }
+}
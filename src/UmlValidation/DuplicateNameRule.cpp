@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DuplicateNameRule.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class DuplicateNameRule.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "DuplicateNameRule.h"
+
+#include "INamedElement.h"
+#include "UmlCompositeElement.h"
+#include "UmlDiagram.h"
+
+#include <QObject>
+
+/**
+ * @class DuplicateNameRule
+ * @brief Finds elements sharing their name with another element of the same owner.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * The rule uses the name index of the owner (see UmlCompositeElement::nameCount()), so checking an element does not
+ * depend on the number of its siblings. Links and diagrams are not checked since they usually do not need to be 
+ * distinguished by name.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+DuplicateNameRule::DuplicateNameRule()
+{
+}
+
+DuplicateNameRule::~DuplicateNameRule()
+{
+}
+
+/** Gets the name of the rule. */
+QString DuplicateNameRule::name() const
+{
+   return "duplicate-name";
+}
+
+/**
+ * Builds the name index of the owner of an element going to be checked.
+ *
+ * The name index is built lazily on first use. Using it the first time in check() would modify the owner from 
+ * several threads at once, so it is done here.
+ */
+void DuplicateNameRule::update(UmlElement* elem)
+{
+   if (elem->owner() != nullptr)
+   {
+      elem->owner()->nameCount(QString());
+   }
+}
+
+/**
+ * Checks whether the owner of an element contains other elements of the same name.
+ *
+ * @param elem Element to be checked.
+ * @param issues List receiving the issues found.
+ */
+void DuplicateNameRule::check(UmlElement* elem, QList<ValidationIssue>& issues) const
+{
+   auto named = dynamic_cast<INamedElement*>(elem);
+   if (named == nullptr || elem->isLink() || dynamic_cast<UmlDiagram*>(elem) != nullptr) return;
+   if (elem->owner() == nullptr || named->name().isEmpty()) return;
+
+   if (elem->owner()->nameCount(named->name()) > 1)
+   {
+      issues.append(ValidationIssue(IssueSeverity::Warning, name(), elem->identifier(), 
+         QObject::tr("Name '%1' is used by more than one element in '%2'.")
+            .arg(named->name()).arg(displayName(elem->owner()))));
+   }
+}
+
+/** Gets the siblings of an element having its current or its former name. */
+QList<UmlElement*> DuplicateNameRule::dependents(UmlElement* elem, QString oldName) const
+{
+   QList<UmlElement*> list;
+   auto named = dynamic_cast<INamedElement*>(elem);
+   if (named == nullptr || elem->owner() == nullptr) return list;
+
+   QString newName = named->name();
+   for (auto* sibling : elem->owner()->elements())
+   {
+      auto other = dynamic_cast<INamedElement*>(sibling);
+      if (other == nullptr || sibling == elem || other->name().isEmpty()) continue;
+      if (other->name() == newName || other->name() == oldName)
+      {
+         list.append(sibling);
+      }
+   }
+
+   return list;
+}
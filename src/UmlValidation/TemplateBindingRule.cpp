@@ -0,0 +1,145 @@
+//---------------------------------------------------------------------------------------------------------------------
+// TemplateBindingRule.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class TemplateBindingRule.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "TemplateBindingRule.h"
+
+#include "ITemplatableElement.h"
+#include "UmlParameterSubstitution.h"
+#include "UmlTemplateBinding.h"
+#include "UmlTemplateParameter.h"
+
+#include <QObject>
+#include <QSet>
+
+/**
+ * @class TemplateBindingRule
+ * @brief Finds template bindings not matching the template they bind.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * A template binding links a bound element (source) to a template (target). The binding is broken if the target is
+ * not templated or if a parameter substitution refers to a template parameter the target does not have. Template
+ * parameters neither substituted nor having a default value are reported as warnings.
+ *
+ * Bindings without source or target are reported by DanglingLinkRule and ignored here.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+TemplateBindingRule::TemplateBindingRule()
+{
+}
+
+TemplateBindingRule::~TemplateBindingRule()
+{
+}
+
+/** Gets the name of the rule. */
+QString TemplateBindingRule::name() const
+{
+   return "template-binding";
+}
+
+/**
+ * Checks the parameter substitutions of a template binding against the template parameters of its target.
+ *
+ * @param elem Element to be checked. Elements other than template bindings are ignored.
+ * @param issues List receiving the issues found.
+ */
+void TemplateBindingRule::check(UmlElement* elem, QList<ValidationIssue>& issues) const
+{
+   auto binding = dynamic_cast<UmlTemplateBinding*>(elem);
+   if (binding == nullptr || binding->target() == nullptr) return;
+
+   auto* target = binding->target();
+   auto  templ  = dynamic_cast<ITemplatableElement*>(target);
+   if (templ == nullptr || !templ->isTemplated())
+   {
+      issues.append(ValidationIssue(IssueSeverity::Error, name(), binding->identifier(),
+         QObject::tr("Template binding refers to '%1' which is not a template.").arg(displayName(target))));
+      return;
+   }
+
+   QSet<QString> params;
+   for (auto* param : templ->templateParameter())
+   {
+      params.insert(param->name());
+   }
+
+   QSet<QString> bound;
+   for (auto* subst : binding->substitutions())
+   {
+      auto param = subst->templParam();
+      if (!params.contains(param))
+      {
+         issues.append(ValidationIssue(IssueSeverity::Error, name(), binding->identifier(),
+            QObject::tr("Template '%1' has no parameter '%2'.").arg(displayName(target)).arg(param)));
+      }
+      else if (bound.contains(param))
+      {
+         issues.append(ValidationIssue(IssueSeverity::Error, name(), binding->identifier(),
+            QObject::tr("Template parameter '%1' of '%2' is substituted more than once.")
+               .arg(param).arg(displayName(target))));
+      }
+      else if (subst->actualParam().isEmpty())
+      {
+         issues.append(ValidationIssue(IssueSeverity::Warning, name(), binding->identifier(),
+            QObject::tr("Template parameter '%1' of '%2' is substituted by nothing.")
+               .arg(param).arg(displayName(target))));
+      }
+
+      bound.insert(param);
+   }
+
+   for (auto* param : templ->templateParameter())
+   {
+      if (!bound.contains(param->name()) && param->defaultValue().isEmpty())
+      {
+         issues.append(ValidationIssue(IssueSeverity::Warning, name(), binding->identifier(),
+            QObject::tr("Template parameter '%1' of '%2' is not bound.").arg(param->name()).arg(displayName(target))));
+      }
+   }
+}
+
+/** Gets the template bindings targeting an element. */
+QList<UmlElement*> TemplateBindingRule::dependents(UmlElement* elem, QString oldName) const
+{
+   Q_UNUSED(oldName);
+
+   QList<UmlElement*> list;
+   for (auto* link : elem->links())
+   {
+      if (link->target() == elem && dynamic_cast<UmlTemplateBinding*>(link) != nullptr)
+      {
+         list.append(link);
+      }
+   }
+
+   return list;
+}
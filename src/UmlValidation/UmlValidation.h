@@ -0,0 +1,46 @@
+//---------------------------------------------------------------------------------------------------------------------
+// UmlValidation.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Include file of the UmlValidation library.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "DanglingLinkRule.h"
+#include "DiagramFileRule.h"
+#include "DuplicateNameRule.h"
+#include "IssueSeverity.h"
+#include "TemplateBindingRule.h"
+#include "UnresolvedTypeRule.h"
+#include "ValidationIssue.h"
+#include "ValidationRule.h"
+#include "Validator.h"
+
+/**
+ * @defgroup UmlValidation
+ * @brief Classes for validating ViraquchaUML projects
+ *
+ * The UmlValidation module provides the Validator class checking a project against pluggable validation rules. It
+ * does not depend on the GUI and is used by the application as well as by the command line tool.
+ */
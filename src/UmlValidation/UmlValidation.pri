@@ -0,0 +1,30 @@
+#---------------------------------------------------------------------------------------------------------------------
+# UmlValidation.pri
+#
+# Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+#
+# Description: Project include file of the UmlValidation library
+#
+# *******************************************************************************************************************
+# *                                                                                                                 *
+# * This file is part of ViraquchaUML.                                                                              *
+# *                                                                                                                 *
+# * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+# * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+# * option) any later version.                                                                                      *
+# *                                                                                                                 *
+# * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+# * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+# * for more details.                                                                                               *
+# *                                                                                                                 *
+# * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+# * http://www.gnu.org/licenses/gpl                                                                                 *
+# *                                                                                                                 *
+# *******************************************************************************************************************
+#
+# See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+#---------------------------------------------------------------------------------------------------------------------
+LIBTARGET    = UmlValidation
+BASEDIR      = $${PWD}
+INCLUDEPATH *= $${BASEDIR}
+LIBS        += -L$${DESTDIR} -lUmlValidation
@@ -0,0 +1,269 @@
+//---------------------------------------------------------------------------------------------------------------------
+// UnresolvedTypeRule.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class UnresolvedTypeRule.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "UnresolvedTypeRule.h"
+
+#include "ITemplatableElement.h"
+#include "TypeIndex.h"
+#include "UmlCompositeElement.h"
+#include "UmlProject.h"
+#include "UmlTemplateParameter.h"
+
+#include "UmlClassifier.h"
+#include "UmlPrimitiveType.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+/**
+ * @class UnresolvedTypeRule
+ * @brief Finds type references not matching any type defined in the project.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * The rule splits the type strings of an element (see UmlElement::typeReferences()) into identifiers and looks each
+ * identifier up in
+ * - the primitive types of the project,
+ * - the names of all classifiers and primitive type elements of the project,
+ * - the template parameters of the element and its owners and
+ * - a small list of C++ keywords like "const" or "unsigned".
+ *
+ * Qualified identifiers like "std::string" are considered external and are not checked. Since the project may use
+ * types defined elsewhere, unresolved types are reported as warnings.
+ *
+ * The names of the types defined in the project are kept in a table updated incrementally by update() and remove(),
+ * so checking an element does not depend on the size of the project.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const QStringList KKeywords = QStringList() 
+   << "auto" << "class" << "const" << "constexpr" << "enum" << "long" << "mutable" << "short" << "signed" 
+   << "static" << "struct" << "typename" << "union" << "unsigned" << "volatile";
+
+struct UnresolvedTypeRule::Data
+{
+   QHash<QUuid, QString> definitions; ///< Names of the types defined by elements of the project
+   QHash<QString, int>   typeNames;   ///< Number of definitions per type name
+   QSet<QString>         builtins;    ///< Primitive types of the project and keywords
+};
+/// @endcond
+
+/** Gets the name of the type defined by an element or a null string if the element does not define a type. */
+static QString definedType(UmlElement* elem)
+{
+   auto classifier = dynamic_cast<UmlClassifier*>(elem);
+   if (classifier != nullptr) return classifier->name();
+
+   auto primitive = dynamic_cast<UmlPrimitiveType*>(elem);
+   if (primitive != nullptr) return primitive->name();
+
+   return QString();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+UnresolvedTypeRule::UnresolvedTypeRule()
+: data(new Data())
+{
+}
+
+UnresolvedTypeRule::~UnresolvedTypeRule()
+{
+   delete data;
+}
+
+/** Gets the name of the rule. */
+QString UnresolvedTypeRule::name() const
+{
+   return "unresolved-type";
+}
+
+/**
+ * Starts a validation run by reading the primitive types of the project.
+ *
+ * On a full run the table of types defined in the project is cleared; it is rebuilt by update().
+ */
+void UnresolvedTypeRule::begin(UmlProject* project, bool full)
+{
+   if (full)
+   {
+      data->definitions.clear();
+      data->typeNames.clear();
+   }
+
+   data->builtins.clear();
+   for (auto type : KKeywords + project->primitiveTypes())
+   {
+      data->builtins.insert(type);
+   }
+}
+
+/** Updates the table of types defined in the project with an element going to be checked. */
+void UnresolvedTypeRule::update(UmlElement* elem)
+{
+   define(elem, definedType(elem));
+}
+
+/** Removes the type defined by an element from the table of types defined in the project. */
+void UnresolvedTypeRule::remove(UmlElement* elem)
+{
+   define(elem, QString());
+}
+
+/**
+ * Checks whether all types referenced by an element are defined.
+ *
+ * @param elem Element to be checked.
+ * @param issues List receiving the issues found.
+ */
+void UnresolvedTypeRule::check(UmlElement* elem, QList<ValidationIssue>& issues) const
+{
+   QStringList unresolved;
+   for (auto type : elem->typeReferences())
+   {
+      for (auto ident : identifiers(type))
+      {
+         if (!isDefined(ident) && !unresolved.contains(ident)) unresolved.append(ident);
+      }
+   }
+
+   if (unresolved.isEmpty()) return;
+
+   // Template parameters are rarely used, so look them up only if needed:
+   QSet<QString> params;
+   for (UmlElement* scope = elem; scope != nullptr; scope = scope->owner())
+   {
+      auto templ = dynamic_cast<ITemplatableElement*>(scope);
+      if (templ == nullptr) continue;
+
+      for (auto* param : templ->templateParameter())
+      {
+         params.insert(param->name());
+      }
+   }
+
+   for (auto ident : unresolved)
+   {
+      if (params.contains(ident)) continue;
+
+      issues.append(ValidationIssue(IssueSeverity::Warning, name(), elem->identifier(),
+         QObject::tr("Type '%1' used by '%2' is not defined in the project.").arg(ident).arg(displayName(elem))));
+   }
+}
+
+/**
+ * Gets the elements affected by modifying an element.
+ *
+ * If the element defines a type, these are all elements referencing its current or former name. If the element is
+ * templatable, these are all elements owned by it since they may use its template parameters.
+ */
+QList<UmlElement*> UnresolvedTypeRule::dependents(UmlElement* elem, QString oldName) const
+{
+   QList<UmlElement*> list;
+   if (elem->project() != nullptr)
+   {
+      QString type = definedType(elem);
+      if (!type.isEmpty()) list.append(elem->project()->typeIndex().usages(type));
+      if (!oldName.isEmpty() && oldName != type) list.append(elem->project()->typeIndex().usages(oldName));
+   }
+
+   auto composite = dynamic_cast<UmlCompositeElement*>(elem);
+   if (composite != nullptr && dynamic_cast<ITemplatableElement*>(elem) != nullptr)
+   {
+      list.append(composite->elements());
+   }
+
+   return list;
+}
+
+/**
+ * Splits a type string into the identifiers to be checked.
+ *
+ * Identifiers are runs of letters, digits and underscores not starting with a digit, like in TypeIndex::split(). 
+ * Identifiers preceded or followed by "::" are qualified and thus skipped.
+ * @param type Type string like "const QList<Order*>&".
+ */
+QStringList UnresolvedTypeRule::identifiers(QString type)
+{
+   QStringList list;
+   int length = type.length();
+   int pos = 0;
+   while (pos < length)
+   {
+      if (!type[pos].isLetterOrNumber() && type[pos] != '_')
+      {
+         ++pos;
+         continue;
+      }
+
+      int start = pos;
+      while (pos < length && (type[pos].isLetterOrNumber() || type[pos] == '_')) ++pos;
+      if (type[start].isDigit()) continue;
+
+      bool qualified = (start >= 2 && type.midRef(start - 2, 2) == "::") || type.midRef(pos, 2) == "::";
+      if (!qualified) list.append(type.mid(start, pos - start));
+   }
+
+   return list;
+}
+
+/** Checks whether a type is a builtin type or defined by an element of the project. */
+bool UnresolvedTypeRule::isDefined(QString type) const
+{
+   return data->builtins.contains(type) || data->typeNames.contains(type);
+}
+
+/** Sets the type defined by an element; a null string removes the definition. */
+void UnresolvedTypeRule::define(UmlElement* elem, QString type)
+{
+   auto id = elem->identifier();
+   auto iter = data->definitions.find(id);
+   if (iter != data->definitions.end())
+   {
+      if (!type.isNull() && iter.value() == type) return;
+
+      auto count = data->typeNames.find(iter.value());
+      if (count != data->typeNames.end() && --count.value() <= 0)
+      {
+         data->typeNames.erase(count);
+      }
+
+      data->definitions.erase(iter);
+   }
+
+   if (!type.isNull())
+   {
+      data->definitions.insert(id, type);
+      ++data->typeNames[type];
+   }
+}
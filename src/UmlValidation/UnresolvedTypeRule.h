@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------------------------------------------------
+// UnresolvedTypeRule.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class UnresolvedTypeRule.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "ValidationRule.h"
+
+class UnresolvedTypeRule : public ValidationRule
+{
+   ///@cond
+   typedef ValidationRule super;
+   ///@endcond
+public: // Constructors
+   UnresolvedTypeRule();
+   virtual ~UnresolvedTypeRule();
+
+public: // Properties
+   QString name() const override;
+
+public: // Methods
+   void begin(UmlProject* project, bool full) override;
+   void update(UmlElement* elem) override;
+   void remove(UmlElement* elem) override;
+   void check(UmlElement* elem, QList<ValidationIssue>& issues) const override;
+   QList<UmlElement*> dependents(UmlElement* elem, QString oldName) const override;
+
+   static QStringList identifiers(QString type);
+
+private:
+   bool isDefined(QString type) const;
+   void define(UmlElement* elem, QString type);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -0,0 +1,115 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ValidationIssue.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ValidationIssue.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ValidationIssue.h"
+
+/**
+ * @class ValidationIssue
+ * @brief The ValidationIssue class describes an issue found by a validation rule.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * A ValidationIssue object stores the severity of the issue, the name of the rule which found it, the identifier of
+ * the element concerned and a human readable message. Issues concerning the project as a whole (like orphaned files)
+ * have a null identifier. ValidationIssue objects are small values and may be copied freely.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Initializes a new, empty object of the ValidationIssue class. */
+ValidationIssue::ValidationIssue()
+: _severity(IssueSeverity::Info)
+{
+}
+
+/**
+ * Initializes a new object of the ValidationIssue class.
+ *
+ * @param severity Severity of the issue.
+ * @param rule Name of the rule which found the issue.
+ * @param element Identifier of the element concerned or a null identifier for project wide issues.
+ * @param message Human readable description of the issue.
+ */
+ValidationIssue::ValidationIssue(IssueSeverity severity, QString rule, QUuid element, QString message)
+: _severity(severity)
+, _rule(rule)
+, _element(element)
+, _message(message)
+{
+}
+
+/** Gets the severity of the issue. */
+IssueSeverity ValidationIssue::severity() const
+{
+   return _severity;
+}
+
+/** Gets the name of the rule which found the issue. */
+QString ValidationIssue::rule() const
+{
+   return _rule;
+}
+
+/** Gets the identifier of the element concerned or a null identifier for project wide issues. */
+QUuid ValidationIssue::element() const
+{
+   return _element;
+}
+
+/** Gets the human readable description of the issue. */
+QString ValidationIssue::message() const
+{
+   return _message;
+}
+
+/**
+ * Compares two issues for sorting.
+ *
+ * Errors are sorted before warnings and warnings before hints. Issues of same severity are sorted by rule and message.
+ */
+bool ValidationIssue::operator<(const ValidationIssue& other) const
+{
+   if (_severity != other._severity) return _severity > other._severity;
+   if (_rule != other._rule) return _rule < other._rule;
+   return _message < other._message;
+}
+
+/** Converts the issue to a string like "error: message [rule]". */
+QString ValidationIssue::toString() const
+{
+   QString severity;
+   switch (_severity)
+   {
+   case IssueSeverity::Error:   severity = "error"; break;
+   case IssueSeverity::Warning: severity = "warning"; break;
+   default:                     severity = "info"; break;
+   }
+
+   return QString("%1: %2 [%3]").arg(severity).arg(_message).arg(_rule);
+}
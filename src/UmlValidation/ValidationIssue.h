@@ -0,0 +1,58 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ValidationIssue.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class ValidationIssue.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "IssueSeverity.h"
+
+#include <QString>
+#include <QUuid>
+
+class ValidationIssue
+{
+public: // Constructors
+   ValidationIssue();
+   ValidationIssue(IssueSeverity severity, QString rule, QUuid element, QString message);
+
+public: // Properties
+   IssueSeverity severity() const;
+   QString rule() const;
+   QUuid element() const;
+   QString message() const;
+
+public: // Methods
+   bool operator<(const ValidationIssue& other) const;
+   QString toString() const;
+
+private: // Attributes
+   ///@cond
+   IssueSeverity _severity;
+   QString       _rule;
+   QUuid         _element;
+   QString       _message;
+   ///@endcond
+};
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ValidationRule.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ValidationRule.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ValidationRule.h"
+
+#include "INamedElement.h"
+#include "UmlElement.h"
+
+/**
+ * @class ValidationRule
+ * @brief Base class of all rules checked by the Validator class.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * A validation rule checks single elements of a project and - optionally - the project as a whole. The Validator
+ * calls the functions of a rule in the following order:
+ * 1. begin() once per validation run,
+ * 2. update() for each element to be checked and remove() for each element removed since the last run,
+ * 3. check() for each element to be checked and
+ * 4. checkProject() once at the end of the run.
+ *
+ * All functions except check() are called from the thread running the Validator and may modify the state of the rule,
+ * e.g. to maintain lookup tables incrementally. Function check() is called concurrently from the threads of the 
+ * global thread pool: it must neither modify the rule nor the elements of the project.
+ *
+ * Since the Validator only re-checks elements modified since the last run, rules checking relations between elements
+ * must report the elements affected by a modification in function dependents().
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+ValidationRule::ValidationRule()
+{
+}
+
+ValidationRule::~ValidationRule()
+{
+}
+
+/**
+ * Starts a validation run.
+ *
+ * The base implementation does nothing.
+ * @param project Project to be validated.
+ * @param full True if all elements of the project are going to be checked, e.g. on the first run.
+ */
+void ValidationRule::begin(UmlProject* project, bool full)
+{
+   Q_UNUSED(project);
+   Q_UNUSED(full);
+}
+
+/**
+ * Updates the state of the rule for an element going to be checked.
+ *
+ * The base implementation does nothing.
+ * @param elem Element going to be checked.
+ */
+void ValidationRule::update(UmlElement* elem)
+{
+   Q_UNUSED(elem);
+}
+
+/**
+ * Removes an element from the state of the rule.
+ *
+ * Called by Validator::remove() before the element is removed from the project. The base implementation does nothing.
+ * @param elem Element going to be removed.
+ */
+void ValidationRule::remove(UmlElement* elem)
+{
+   Q_UNUSED(elem);
+}
+
+/**
+ * Checks the project as a whole after all elements have been checked.
+ *
+ * The base implementation does nothing.
+ * @param project Project being validated.
+ * @param issues List receiving the issues found.
+ */
+void ValidationRule::checkProject(UmlProject* project, QList<ValidationIssue>& issues) const
+{
+   Q_UNUSED(project);
+   Q_UNUSED(issues);
+}
+
+/**
+ * Gets the elements whose result of check() may change if an element is modified or removed.
+ *
+ * The base implementation returns an empty list.
+ * @param elem Element modified or going to be removed.
+ * @param oldName Name of the element on the last validation run; empty if unknown or if the element is not named.
+ */
+QList<UmlElement*> ValidationRule::dependents(UmlElement* elem, QString oldName) const
+{
+   Q_UNUSED(elem);
+   Q_UNUSED(oldName);
+   return QList<UmlElement*>();
+}
+
+/** Gets the name of an element for messages or its class name if the element is not named. */
+QString ValidationRule::displayName(UmlElement* elem)
+{
+   if (elem == nullptr) return QString();
+
+   auto named = dynamic_cast<INamedElement*>(elem);
+   if (named != nullptr && !named->name().isEmpty())
+   {
+      return named->name();
+   }
+
+   return elem->className();
+}
@@ -0,0 +1,407 @@
+//---------------------------------------------------------------------------------------------------------------------
+// Validator.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class Validator.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "Validator.h"
+
+#include "DanglingLinkRule.h"
+#include "DiagramFileRule.h"
+#include "DuplicateNameRule.h"
+#include "TemplateBindingRule.h"
+#include "UnresolvedTypeRule.h"
+#include "ValidationRule.h"
+
+#include "INamedElement.h"
+#include "UmlCompositeElement.h"
+#include "UmlProject.h"
+
+#include <QHash>
+#include <QSet>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <algorithm>
+
+/**
+ * @class Validator
+ * @brief The Validator class checks a project against a set of validation rules.
+ * @since 0.2.0
+ * @ingroup UmlValidation
+ *
+ * The Validator class runs pluggable rules (see class ValidationRule) on the elements of a UmlProject object and 
+ * collects the issues found. It does not depend on the GUI and may be used by the application as well as by command
+ * line tools:
+ * ~~~{.cpp}
+ * Validator validator(project);
+ * validator.addDefaultRules();
+ * if (!validator.validate())
+ * {
+ *    for (auto issue : validator.issues()) qWarning() << issue.toString();
+ * }
+ * ~~~
+ *
+ * The first call of validate() checks all elements of the project. Afterwards only elements invalidated by function
+ * invalidate() or remove() - and the elements depending on them as reported by the rules - are checked again, so 
+ * the application can re-validate the project after each modification. The elements are checked concurrently on the
+ * global thread pool; the project must not be modified while validate() is running.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal struct hiding implementation details
+//---------------------------------------------------------------------------------------------------------------------
+/// @cond
+static const int KMinParallelCount = 64; // Below this number of elements checking is done in the calling thread
+
+struct CheckElement
+{
+   typedef QList<ValidationIssue> result_type;
+
+   CheckElement(const QList<ValidationRule*>* rules)
+   : rules(rules)
+   {
+   }
+
+   QList<ValidationIssue> operator()(UmlElement* elem) const
+   {
+      QList<ValidationIssue> issues;
+      for (auto* rule : *rules)
+      {
+         rule->check(elem, issues);
+      }
+      return issues;
+   }
+
+   const QList<ValidationRule*>* rules;
+};
+
+struct Validator::Data
+{
+   Data()
+   : project(nullptr)
+   , full(true)
+   {
+   }
+
+   UmlProject*                            project;
+   QList<ValidationRule*>                 rules;
+   QHash<QUuid, QList<ValidationIssue>>   issues;        ///< Issues found per element
+   QList<ValidationIssue>                 projectIssues; ///< Issues found by ValidationRule::checkProject()
+   QHash<QUuid, QString>                  names;         ///< Names of the elements on the last run
+   QSet<QUuid>                            dirty;
+   bool                                   full;
+};
+/// @endcond
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the Validator class.
+ *
+ * @param project Project to be validated (must not be nullptr).
+ */
+Validator::Validator(UmlProject* project)
+: data(new Data())
+{
+   Q_ASSERT(project != nullptr);
+   data->project = project;
+}
+
+Validator::~Validator()
+{
+   qDeleteAll(data->rules);
+   delete data;
+}
+
+/** Gets the project validated. */
+UmlProject* Validator::project() const
+{
+   return data->project;
+}
+
+/** Gets the list of rules checked. */
+QList<ValidationRule*> Validator::rules() const
+{
+   return data->rules;
+}
+
+/** Gets all issues found by the last validation run, sorted by severity. */
+QList<ValidationIssue> Validator::issues() const
+{
+   QList<ValidationIssue> list = data->projectIssues;
+   for (auto iter = data->issues.cbegin(); iter != data->issues.cend(); ++iter)
+   {
+      list.append(iter.value());
+   }
+
+   std::sort(list.begin(), list.end());
+   return list;
+}
+
+/**
+ * Gets the issues found for a single element.
+ *
+ * @param id Identifier of the element.
+ */
+QList<ValidationIssue> Validator::issues(QUuid id) const
+{
+   return data->issues.value(id);
+}
+
+/**
+ * Counts the issues of a specific severity.
+ *
+ * @param severity Severity of the issues to be counted.
+ */
+int Validator::count(IssueSeverity severity) const
+{
+   int result = 0;
+   for (auto issue : data->projectIssues)
+   {
+      if (issue.severity() == severity) ++result;
+   }
+
+   for (auto iter = data->issues.cbegin(); iter != data->issues.cend(); ++iter)
+   {
+      for (auto issue : iter.value())
+      {
+         if (issue.severity() == severity) ++result;
+      }
+   }
+
+   return result;
+}
+
+/** Gets a value indicating whether elements need to be checked by the next call of validate(). */
+bool Validator::isDirty() const
+{
+   return data->full || !data->dirty.isEmpty();
+}
+
+/**
+ * Adds a rule to the validator.
+ *
+ * The validator takes ownership of the rule. Adding a rule makes the next call of validate() check all elements.
+ * @param rule Rule to be added (must not be nullptr).
+ */
+void Validator::addRule(ValidationRule* rule)
+{
+   Q_ASSERT(rule != nullptr);
+   data->rules.append(rule);
+   invalidateAll();
+}
+
+/** Adds all rules provided by the UmlValidation library. */
+void Validator::addDefaultRules()
+{
+   addRule(new DanglingLinkRule());
+   addRule(new DuplicateNameRule());
+   addRule(new UnresolvedTypeRule());
+   addRule(new TemplateBindingRule());
+   addRule(new DiagramFileRule());
+}
+
+/**
+ * Marks an element as modified.
+ *
+ * The element and all elements depending on it are checked again by the next call of validate(). Call this function
+ * after an element has been inserted into the project or modified.
+ * @param elem Element modified.
+ * @param recursive If true, all elements owned by the element are marked as well, e.g. after inserting a package.
+ */
+void Validator::invalidate(UmlElement* elem, bool recursive)
+{
+   if (elem == nullptr) return;
+
+   QList<UmlElement*> list;
+   if (recursive)
+   {
+      collect(elem, list);
+   }
+   else
+   {
+      list.append(elem);
+   }
+
+   for (auto* item : list)
+   {
+      data->dirty.insert(item->identifier());
+      invalidateDependents(item);
+   }
+}
+
+/** Marks all elements as modified, so the next call of validate() checks the whole project. */
+void Validator::invalidateAll()
+{
+   data->full = true;
+}
+
+/**
+ * Removes an element and all elements owned by it from the validator.
+ *
+ * Call this function before the element is removed from the project. The issues of the elements are dropped and the
+ * elements depending on them are checked again by the next call of validate().
+ * @param elem Element going to be removed.
+ */
+void Validator::remove(UmlElement* elem)
+{
+   if (elem == nullptr) return;
+
+   QList<UmlElement*> list;
+   collect(elem, list);
+   for (auto* item : list)
+   {
+      invalidateDependents(item);
+      for (auto* rule : data->rules)
+      {
+         rule->remove(item);
+      }
+   }
+
+   for (auto* item : list)
+   {
+      data->dirty.remove(item->identifier());
+      data->issues.remove(item->identifier());
+      data->names.remove(item->identifier());
+   }
+}
+
+/**
+ * Checks all modified elements.
+ *
+ * The elements are checked by all rules concurrently on the global thread pool. Afterwards each rule checks the 
+ * project as a whole.
+ * @returns True if no errors were found; otherwise false. Warnings are ignored.
+ */
+bool Validator::validate()
+{
+   QList<UmlElement*> elems;
+   bool full = data->full;
+   if (full)
+   {
+      data->issues.clear();
+      data->names.clear();
+      elems = data->project->elements();
+   }
+   else
+   {
+      for (auto id : data->dirty)
+      {
+         UmlElement* elem = nullptr;
+         if (data->project->find(id, &elem))
+         {
+            elems.append(elem);
+         }
+         else
+         {
+            data->issues.remove(id);
+            data->names.remove(id);
+         }
+      }
+   }
+
+   data->dirty.clear();
+   data->full = false;
+
+   // Let the rules update their state before checking concurrently:
+   for (auto* rule : data->rules)
+   {
+      rule->begin(data->project, full);
+      for (auto* elem : elems)
+      {
+         rule->update(elem);
+      }
+   }
+
+   QList<QList<ValidationIssue>> results;
+   if (elems.count() < KMinParallelCount)
+   {
+      CheckElement check(&data->rules);
+      for (auto* elem : elems)
+      {
+         results.append(check(elem));
+      }
+   }
+   else
+   {
+      results = QtConcurrent::blockingMapped<QList<QList<ValidationIssue>>>(elems, CheckElement(&data->rules));
+   }
+
+   for (int index = 0; index < elems.count(); ++index)
+   {
+      auto* elem = elems[index];
+      if (results[index].isEmpty())
+      {
+         data->issues.remove(elem->identifier());
+      }
+      else
+      {
+         data->issues.insert(elem->identifier(), results[index]);
+      }
+
+      auto named = dynamic_cast<INamedElement*>(elem);
+      if (named != nullptr)
+      {
+         data->names.insert(elem->identifier(), named->name());
+      }
+   }
+
+   data->projectIssues.clear();
+   for (auto* rule : data->rules)
+   {
+      rule->checkProject(data->project, data->projectIssues);
+   }
+
+   return count(IssueSeverity::Error) == 0;
+}
+
+/** Collects an element and all elements owned by it. */
+void Validator::collect(UmlElement* elem, QList<UmlElement*>& list)
+{
+   list.append(elem);
+
+   auto composite = dynamic_cast<UmlCompositeElement*>(elem);
+   if (composite != nullptr)
+   {
+      for (auto* child : composite->elements())
+      {
+         collect(child, list);
+      }
+   }
+}
+
+/** Marks the elements depending on an element as modified. */
+void Validator::invalidateDependents(UmlElement* elem)
+{
+   auto oldName = data->names.value(elem->identifier());
+   for (auto* rule : data->rules)
+   {
+      for (auto* dep : rule->dependents(elem, oldName))
+      {
+         if (dep != nullptr) data->dirty.insert(dep->identifier());
+      }
+   }
+}
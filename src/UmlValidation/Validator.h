@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------------------------------------------------
+// Validator.h
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Declaration of class Validator.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#pragma once
+
+#include "IssueSeverity.h"
+#include "ValidationIssue.h"
+
+#include <QList>
+#include <QUuid>
+
+class UmlElement;
+class UmlProject;
+class ValidationRule;
+
+class Validator final
+{
+public: // Constructors
+   Validator(UmlProject* project);
+   ~Validator();
+
+public: // Properties
+   UmlProject* project() const;
+   QList<ValidationRule*> rules() const;
+
+   QList<ValidationIssue> issues() const;
+   QList<ValidationIssue> issues(QUuid id) const;
+   int count(IssueSeverity severity) const;
+
+   bool isDirty() const;
+
+public: // Methods
+   void addRule(ValidationRule* rule);
+   void addDefaultRules();
+
+   void invalidate(UmlElement* elem, bool recursive = false);
+   void invalidateAll();
+   void remove(UmlElement* elem);
+
+   bool validate();
+
+private:
+   void collect(UmlElement* elem, QList<UmlElement*>& list);
+   void invalidateDependents(UmlElement* elem);
+
+private: // Attributes
+   ///@cond
+   struct Data;
+   Data* data;
+   ///@endcond
+};
@@ -5,8 +5,19 @@
 //---------------------------------------------------------------------------------------------------------------------
 #include "TestProject.h"
 
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QList>
+#include <QSet>
 #include <QSharedPointer>
+#include <QTemporaryDir>
 
 TestProject::TestProject()
 {
@@ -166,8 +177,7 @@ void TestProject::testSave()
 
    QCOMPARE(prj->count(), 13);
 
-   int res = prj->save(QDir::tempPath() + "/umlsavetest/umlsavetest.uprj");
-   QVERIFY(res == 0);
+   QVERIFY(prj->save(QDir::tempPath() + "/umlsavetest/umlsavetest.uprj"));
 
    prj->dispose();
 }
@@ -180,8 +190,7 @@ void TestProject::testLoad()
    auto prj = QSharedPointer<UmlProject>(new UmlProject());
    QVERIFY(prj != nullptr);
 
-   int res = prj->load(QDir::tempPath() + "/umlsavetest/umlsavetest.uprj");
-   QVERIFY(res == 0);
+   QVERIFY(prj->load(QDir::tempPath() + "/umlsavetest/umlsavetest.uprj"));
    QCOMPARE(prj->count(), 13);
    QVERIFY(prj->contains(QUuid("{4CD3CF41-E522-4101-B57D-402CD2E8DF50}")) == true);
    QVERIFY(prj->contains(QUuid("{93635E6B-F0BB-4DB5-8CEE-E9D569E8A671}")) == true);
@@ -267,6 +276,1358 @@ void TestProject::testOperation()
    QVERIFY(sig1 == "+ func(a: double, b: int = 0): bool [1..22]");
 }
 
+/**
+ * Tests the where-used index of types referenced by attributes and operations.
+ */
+void TestProject::testTypeIndex()
+{
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+
+   auto* cls = createClass(QUuid::createUuid(), "Customer");
+   prj->insert(cls);
+   mdl->insert(0, cls);
+
+   auto* atr = new UmlAttribute();
+   atr->setName("orders");
+   atr->setType("QList<Order*>");
+   prj->insert(atr);
+   cls->insert(0, atr);
+
+   auto* opr = new UmlOperation();
+   opr->setName("find");
+   opr->setReturnType("Order");
+   prj->insert(opr);
+   cls->insert(1, opr);
+
+   auto* par = new UmlParameter();
+   par->setName("id");
+   par->setType("int");
+   opr->append(par);
+
+   auto& index = prj->typeIndex();
+   QCOMPARE(index.usageCount("Order"), 2);
+   QCOMPARE(index.usageCount("QList"), 1);
+   QCOMPARE(index.usageCount("int"), 1);
+   QVERIFY(index.usages("int").first() == opr);
+
+   par->setType("long");
+   QVERIFY(!index.contains("int"));
+   QCOMPARE(index.usageCount("long"), 1);
+
+   opr->setReturnType("void");
+   QCOMPARE(index.usageCount("Order"), 1);
+   QVERIFY(index.usages("Order").first() == atr);
+
+   prj->remove(atr);
+   atr->dispose();
+   QVERIFY(!index.contains("Order"));
+
+   prj->dispose();
+}
+
+/**
+ * Tests renaming a type in all attributes and operations referencing it.
+ */
+void TestProject::testRenameType()
+{
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+
+   auto* cls = createClass(QUuid::createUuid(), "Customer");
+   prj->insert(cls);
+   mdl->insert(0, cls);
+
+   auto* atr = new UmlAttribute();
+   atr->setName("orders");
+   atr->setType("QList<Order*>");
+   prj->insert(atr);
+   cls->insert(0, atr);
+
+   auto* opr = new UmlOperation();
+   opr->setName("find");
+   opr->setReturnType("OrderItem");
+   prj->insert(opr);
+   cls->insert(1, opr);
+
+   auto* par = new UmlParameter();
+   par->setName("order");
+   par->setType("const Order&");
+   opr->append(par);
+
+   QVERIFY(prj->canRenameType("Order", "Purchase"));
+   QVERIFY(!prj->canRenameType("Order", "QList"));
+   QVERIFY(!prj->canRenameType("Order", "Purchase Order"));
+
+   auto changed = prj->renameType("Order", "Purchase");
+   QCOMPARE(changed.size(), 2);
+   QCOMPARE(atr->type(), QString("QList<Purchase*>"));
+   QCOMPARE(par->type(), QString("const Purchase&"));
+   QCOMPARE(opr->returnType(), QString("OrderItem"));
+   QCOMPARE(prj->modifiedElements().size(), 2);
+   QVERIFY(!prj->typeIndex().contains("Order"));
+   QCOMPARE(prj->typeIndex().usageCount("Purchase"), 2);
+
+   prj->dispose();
+}
+
+void TestProject::testNameIndex()
+{
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+
+   NameBuilder builder(mdl);
+   QCOMPARE(builder.build("Class"), QString("Class1"));
+
+   auto* cls1 = createClass(QUuid::createUuid(), builder.build("Class"));
+   prj->insert(cls1);
+   mdl->insert(0, cls1);
+   QVERIFY(mdl->containsName("Class1"));
+   QCOMPARE(builder.build("Class"), QString("Class2"));
+
+   auto* cls2 = createClass(QUuid::createUuid(), "Class2");
+   prj->insert(cls2);
+   mdl->insert(1, cls2);
+   QCOMPARE(builder.build("Class"), QString("Class3"));
+
+   cls2->setName("Class1");
+   QCOMPARE(mdl->nameCount("Class1"), 2);
+   QVERIFY(!mdl->containsName("Class2"));
+
+   mdl->remove(cls2);
+   QCOMPARE(mdl->nameCount("Class1"), 1);
+
+   prj->dispose();
+}
+
+void TestProject::testValidator()
+{
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+
+   auto* cls = createClass(QUuid::createUuid(), "Customer");
+   prj->insert(cls);
+   mdl->insert(0, cls);
+
+   auto* atr = new UmlAttribute();
+   atr->setName("orders");
+   atr->setType("Order*");
+   prj->insert(atr);
+   cls->insert(0, atr);
+
+   Validator validator(prj.data());
+   validator.addDefaultRules();
+   QVERIFY(validator.validate());
+   QCOMPARE(validator.issues(atr->identifier()).size(), 1);
+   QCOMPARE(validator.count(IssueSeverity::Warning), 1);
+
+   // Defining the type resolves the reference:
+   auto* ord = createClass(QUuid::createUuid(), "Order");
+   prj->insert(ord);
+   mdl->insert(1, ord);
+   validator.invalidate(ord);
+   QVERIFY(validator.isDirty());
+   QVERIFY(validator.validate());
+   QVERIFY(validator.issues(atr->identifier()).isEmpty());
+
+   // Renaming the type re-checks the references to its former name and its siblings:
+   ord->setName("Customer");
+   validator.invalidate(ord);
+   QVERIFY(validator.validate());
+   QCOMPARE(validator.issues(atr->identifier()).size(), 1);
+   QCOMPARE(validator.issues(cls->identifier()).size(), 1);
+   QCOMPARE(validator.issues(ord->identifier()).size(), 1);
+
+   // Removing an end of a link leaves the link dangling:
+   auto* lnk = new UmlLink();
+   lnk->setSource(cls);
+   lnk->setTarget(ord);
+   prj->insert(lnk);
+   mdl->insert(2, lnk);
+   validator.invalidate(lnk);
+   QVERIFY(validator.validate());
+
+   validator.remove(ord);
+   mdl->remove(ord);
+   prj->remove(ord);
+   QVERIFY(!validator.validate());
+   QCOMPARE(validator.issues(lnk->identifier()).size(), 1);
+   QVERIFY(validator.issues(cls->identifier()).isEmpty());
+
+   prj->dispose();
+}
+
+void TestProject::testLayeredLayout()
+{
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+
+   auto* dia = createDiagram(QUuid::createUuid(), "Hierarchy", DiagramKind::Class);
+   prj->insert(dia);
+   mdl->insert(0, dia);
+   QVERIFY(dia->open());
+
+   QStringList names = { "Base", "Left", "Right", "Leaf", "Single" };
+   QList<DiaNode*> nodes;
+   for (int index = 0; index < names.size(); ++index)
+   {
+      auto* cls = createClass(QUuid::createUuid(), names[index]);
+      prj->insert(cls);
+      mdl->insert(index + 1, cls);
+      nodes.append(dia->addNode(cls));
+   }
+
+   auto generalize = [&](DiaNode* specific, DiaNode* general)
+   {
+      auto* gen = new UmlGeneralization();
+      gen->setSource(specific->element());
+      gen->setTarget(general->element());
+      prj->insert(gen);
+      mdl->insert(0, gen);
+
+      auto* edge = dia->addEdge(gen);
+      edge->setShape1(specific);
+      edge->setShape2(general);
+      return edge;
+   };
+
+   generalize(nodes[1], nodes[0]);
+   generalize(nodes[2], nodes[0]);
+   generalize(nodes[3], nodes[1]);
+   auto* longEdge = generalize(nodes[3], nodes[0]);
+
+   LayeredLayout layout;
+   layout.setRestarts(2);
+   QVERIFY(layout.layout(dia));
+   QCOMPARE(layout.crossings(), qint64(0));
+
+   // General classes are placed above the specific ones, nodes of a layer do not overlap:
+   QVERIFY(nodes[0]->pos().y() < nodes[1]->pos().y());
+   QVERIFY(nodes[1]->pos().y() < nodes[3]->pos().y());
+   QCOMPARE(nodes[1]->pos().y(), nodes[2]->pos().y());
+   QVERIFY(qAbs(nodes[1]->pos().x() - nodes[2]->pos().x()) >= DiagramLayout::nodeSize(nodes[1]).width());
+
+   // The edge spanning two layers bends through the layer between, unconnected nodes are placed below:
+   QCOMPARE(longEdge->routing(), RoutingKind::Custom);
+   QCOMPARE(longEdge->points().size(), 4);
+   QVERIFY(nodes[4]->pos().y() > nodes[3]->pos().y());
+
+   dia->close();
+   prj->dispose();
+}
+
+void TestProject::testForceLayout()
+{
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+
+   auto* dia = createDiagram(QUuid::createUuid(), "Packages", DiagramKind::Packages);
+   prj->insert(dia);
+   mdl->insert(0, dia);
+   QVERIFY(dia->open());
+
+   QList<DiaNode*> nodes;
+   auto addPackage = [&](QString name)
+   {
+      auto* pkg = createPackage(QUuid::createUuid(), name, VisibilityKind::Public);
+      prj->insert(pkg);
+      mdl->insert(1, pkg);
+      nodes.append(dia->addNode(pkg));
+
+      if (nodes.size() > 1)
+      {
+         auto* prev = nodes[nodes.size() - 2];
+         auto* dep = createDependency(QUuid::createUuid(), pkg, prev->element(), "use");
+         prj->insert(dep);
+         mdl->insert(1, dep);
+
+         auto* edge = dia->addEdge(dep);
+         edge->setShape1(nodes.last());
+         edge->setShape2(prev);
+      }
+   };
+
+   auto overlaps = [&]()
+   {
+      for (int i = 0; i < nodes.size(); ++i)
+      {
+         for (int j = i + 1; j < nodes.size(); ++j)
+         {
+            QSizeF size = DiagramLayout::nodeSize(nodes[i]);
+            QRectF rect1(nodes[i]->pos() - QPointF(size.width() / 2.0, size.height() / 2.0), size);
+            QRectF rect2(nodes[j]->pos() - QPointF(size.width() / 2.0, size.height() / 2.0), size);
+            if (rect1.intersects(rect2)) return true;
+         }
+      }
+
+      return false;
+   };
+
+   for (int index = 0; index < 5; ++index) addPackage(QString("Package%1").arg(index));
+
+   ForceLayout layout;
+   QVERIFY(layout.layout(dia));
+   QVERIFY(!overlaps());
+
+   // Relaxing after adding a node moves only the new node and its neighbour:
+   QList<QPointF> before;
+   for (auto* node : nodes) before.append(node->pos());
+
+   addPackage("Package5");
+   QVERIFY(layout.relax(dia, QList<DiaNode*>() << nodes.last()));
+   for (int index = 0; index < 4; ++index)
+   {
+      QCOMPARE(nodes[index]->pos(), before[index]);
+   }
+
+   QVERIFY(!overlaps());
+
+   dia->close();
+   prj->dispose();
+}
+
+void TestProject::testTracer()
+{
+   Tracer::clear();
+
+   // Nothing is recorded while tracing is disabled:
+   {
+      TraceSpan span("TestProject::disabled");
+      Tracer::counter("TestProject::counter", 1);
+   }
+   QCOMPARE(Tracer::eventCount(), 0);
+
+   Tracer::setEnabled(true);
+   {
+      TraceSpan span("TestProject::span", "test");
+      span.setDetail("file \"a\".json");
+      Tracer::counter("TestProject::counter", 42);
+   }
+   Tracer::setEnabled(false);
+   QCOMPARE(Tracer::eventCount(), 2);
+
+   // The trace is valid JSON in the Trace Event Format:
+   QJsonParseError error;
+   auto doc = QJsonDocument::fromJson(Tracer::toJson(), &error);
+   QCOMPARE(error.error, QJsonParseError::NoError);
+
+   QJsonObject span, counter;
+   for (auto value : doc.object()["traceEvents"].toArray())
+   {
+      auto event = value.toObject();
+      if (event["name"].toString() == "TestProject::span") span = event;
+      if (event["name"].toString() == "TestProject::counter") counter = event;
+   }
+
+   QCOMPARE(span["ph"].toString(), QString("X"));
+   QCOMPARE(span["cat"].toString(), QString("test"));
+   QCOMPARE(span["args"].toObject()["detail"].toString(), QString("file \"a\".json"));
+   QVERIFY(span["dur"].toDouble() >= 0.0);
+   QCOMPARE(counter["ph"].toString(), QString("C"));
+   QCOMPARE(counter["args"].toObject()["value"].toInt(), 42);
+
+   Tracer::clear();
+   QCOMPARE(Tracer::eventCount(), 0);
+
+   // Counters are counted even if tracing is disabled and are not reset by clear():
+   Tracer::setEnabled(false);
+   qint64 reroutes = Tracer::value(Tracer::Reroutes);
+   Tracer::count(Tracer::Reroutes, 3);
+   Tracer::clear();
+   QCOMPARE(Tracer::value(Tracer::Reroutes), reroutes + 3);
+   QCOMPARE(QString(Tracer::counterName(Tracer::Reroutes)), QString("reroutes"));
+}
+
+void TestProject::testOverviewGenerator()
+{
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path(), "umloverviewtest");
+   QVERIFY(prj != nullptr);
+
+   auto* pkg1 = createPackage(QUuid::createUuid(), "Package One", VisibilityKind::Public);
+   prj->insert(pkg1);
+   mdl->insert(0, pkg1);
+
+   auto* pkg2 = createPackage(QUuid::createUuid(), "Package Two", VisibilityKind::Public);
+   prj->insert(pkg2);
+   mdl->insert(1, pkg2);
+
+   auto* cls = createClass(QUuid::createUuid(), "Hidden");
+   prj->insert(cls);
+   pkg1->insert(0, cls);
+
+   auto* dep = createDependency(QUuid::createUuid(), pkg1, pkg2, "use");
+   prj->insert(dep);
+
+   // The model, both packages and their dependency are shown, the class is not:
+   OverviewGenerator generator(prj.data());
+   QVERIFY(generator.generate());
+   QVERIFY(generator.isCreated());
+   QCOMPARE(generator.find(), generator.diagram());
+   QCOMPARE(generator.addedCount(), 4);
+
+   // The diagram is written by the next save of the project:
+   auto* dia = generator.diagram();
+   QVERIFY(!dia->isOpen());
+   QVERIFY(dia->hasShapes());
+   QVERIFY(!QFile::exists(dia->diagramFile()));
+   QVERIFY(prj->save(dir.path() + "/umloverviewtest/umloverviewtest.uprj"));
+   QVERIFY(QFile::exists(dia->diagramFile()));
+
+   QVERIFY(dia->open());
+   QPointF modelPos;
+   for (auto* node : dia->nodes())
+   {
+      if (node->element() == mdl) modelPos = node->pos();
+   }
+   dia->close();
+
+   // Nothing changed, nothing to do:
+   QVERIFY(generator.generate());
+   QVERIFY(!generator.isChanged());
+
+   // Changes are applied incrementally, nodes not related to them keep their positions:
+   auto* pkg3 = createPackage(QUuid::createUuid(), "Package Three", VisibilityKind::Public);
+   prj->insert(pkg3);
+   mdl->insert(2, pkg3);
+   dep->setTarget(pkg3);
+
+   QVERIFY(generator.generate());
+   QVERIFY(!generator.isCreated());
+   QCOMPARE(generator.addedCount(), 2);
+   QCOMPARE(generator.removedCount(), 1);
+
+   QVERIFY(dia->open());
+   QCOMPARE(dia->nodeCount(), 4);
+   QCOMPARE(dia->edgeCount(), 1);
+   for (auto* node : dia->nodes())
+   {
+      if (node->element() == mdl) QCOMPARE(node->pos(), modelPos);
+   }
+   dia->close();
+
+   prj->dispose();
+}
+
+void TestProject::testMemoryReport()
+{
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+
+   for (int index = 0; index < 3; ++index)
+   {
+      auto* cls = createClass(QUuid::createUuid(), QString("Class%1").arg(index));
+      prj->insert(cls);
+      mdl->insert(index, cls);
+   }
+
+   auto find = [](const MemoryReport& report, QString name)
+   {
+      for (auto& entry : report.entries())
+      {
+         if (entry.name == name) return entry;
+      }
+      return MemoryReport::Entry();
+   };
+
+   MemoryReport report;
+   report.addProject(prj.data());
+   auto classes = find(report, "UmlClass");
+   QCOMPARE(classes.count, qint64(3));
+   QVERIFY(classes.usage.objects >= qint64(3 * sizeof(UmlClass)));
+   QVERIFY(classes.usage.strings > 0);
+   QCOMPARE(find(report, "UmlProject").count, qint64(1));
+   QCOMPARE(report.count(), qint64(prj->elements().size() + 1));
+
+   // Children and their strings are counted with their own class, the list of children with the owner:
+   auto* atr = new UmlAttribute();
+   atr->setName(QString(1000, 'a'));
+   prj->insert(atr);
+   mdl->insert(0, atr);
+
+   report.clear();
+   report.addProject(prj.data());
+   QVERIFY(find(report, "UmlAttribute").usage.strings > qint64(2000));
+   QVERIFY(find(report, "UmlModel").usage.containers > 0);
+
+   // Entries are ordered biggest first, external categories are added by name:
+   MemoryUsage usage;
+   usage.undo = 1 << 30;
+   report.add("UndoCommand", 5, usage);
+   QCOMPARE(report.entries().first().name, QString("UndoCommand"));
+   QCOMPARE(report.total().undo, qint64(1 << 30));
+
+   auto json = report.toJson();
+   QCOMPARE(json["entries"].toArray().size(), report.entries().size());
+   QCOMPARE(json["total"].toObject()["undo"].toDouble(), double(1 << 30));
+   QVERIFY(report.toText(1).startsWith("Class"));
+   QCOMPARE(report.toText(1).count('\n'), 3);
+
+   prj->dispose();
+}
+
+void TestProject::testJournal()
+{
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+   QString filename = dir.path() + "/umljournaltest/umljournaltest.uprj";
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path(), "umljournaltest");
+   QVERIFY(prj != nullptr);
+   QVERIFY(!prj->openJournal());
+
+   auto* kept = createClass(QUuid::createUuid(), "Kept");
+   prj->insert(kept);
+   mdl->insert(0, kept);
+
+   auto* removed = createClass(QUuid::createUuid(), "Removed");
+   prj->insert(removed);
+   mdl->insert(1, removed);
+
+   QVERIFY(prj->save(filename));
+   QVERIFY(prj->openJournal());
+   QVERIFY(prj->isJournaling());
+
+   // Changes are appended to the journal, the element files are not written:
+   QUuid keptId = kept->identifier();
+   QUuid removedId = removed->identifier();
+   kept->setName("Renamed");
+   prj->markModified(kept);
+
+   auto* added = createClass(QUuid::createUuid(), "Added");
+   QUuid addedId = added->identifier();
+   prj->insert(added);
+   mdl->insert(2, added);
+
+   removed->dispose();
+   mdl->remove(removed);
+   prj->remove(removed);
+   prj->markModified(mdl);
+
+   QVERIFY(prj->autosave());
+   QVERIFY(prj->journalSize() > 0);
+   qint64 committed = prj->journalSize();
+
+   // Simulate a crash while writing the next batch:
+   QFile journal(filename + ".journal");
+   QVERIFY(journal.open(QIODevice::WriteOnly | QIODevice::Append));
+   journal.write("1234 {\"op\":\"put\",\"id\":");
+   journal.close();
+   prj->dispose();
+
+   // Loading the project recovers the committed changes and ignores the incomplete batch:
+   auto rec = QSharedPointer<UmlProject>(new UmlProject());
+   QVERIFY(rec->load(filename));
+   QCOMPARE(rec->recoveredCount(), 1);
+   QVERIFY(rec->isModified());
+   QVERIFY(rec->contains(addedId));
+   QVERIFY(!rec->contains(removedId));
+
+   UmlElement* elem = nullptr;
+   QVERIFY(rec->find(keptId, &elem));
+   QCOMPARE(dynamic_cast<UmlClass*>(elem)->name(), QString("Renamed"));
+   QCOMPARE(dynamic_cast<UmlModel*>(rec->root()->at(0))->count(), 2);
+
+   // Opening the journal again removes the incomplete batch, new batches are appended:
+   QVERIFY(rec->openJournal());
+   QCOMPARE(rec->journalSize(), committed);
+   dynamic_cast<UmlClass*>(elem)->setName("Again");
+   rec->markModified(elem);
+
+   // Compacting writes the changes to the element files in the background, the project stays modified until done:
+   QVERIFY(rec->compact());
+   QVERIFY(rec->isModified());
+   QVERIFY(rec->waitForCompaction());
+   QVERIFY(!rec->isModified());
+   QVERIFY(rec->modifiedElements().isEmpty());
+   QVERIFY(!QFile::exists(filename + ".journal.compact"));
+   rec->closeJournal(true);
+   QVERIFY(!QFile::exists(filename + ".journal"));
+   rec->dispose();
+
+   auto plain = QSharedPointer<UmlProject>(new UmlProject());
+   QVERIFY(plain->load(filename));
+   QCOMPARE(plain->recoveredCount(), 0);
+   QVERIFY(!plain->isModified());
+   QVERIFY(plain->contains(addedId));
+   QVERIFY(!plain->contains(removedId));
+   QVERIFY(!QFile::exists(plain->elementsFolder() + "/" + removedId.toString() + ".json"));
+   QVERIFY(plain->find(keptId, &elem));
+   QCOMPARE(dynamic_cast<UmlClass*>(elem)->name(), QString("Again"));
+   plain->dispose();
+}
+
+void TestProject::testTransaction()
+{
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+   QString filename = dir.path() + "/umltxtest/umltxtest.uprj";
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path(), "umltxtest");
+   QVERIFY(prj != nullptr);
+   prj->isTransactional(true);
+
+   auto* cls = createClass(QUuid::createUuid(), "Saved");
+   QUuid clsId = cls->identifier();
+   prj->insert(cls);
+   mdl->insert(0, cls);
+
+   // All files are published, nothing is left in the staging folder:
+   QVERIFY(prj->save(filename));
+   QString staging = ProjectTransaction::stagingFolder(prj->projectFolder());
+   QVERIFY(!QFileInfo::exists(staging));
+   QString clsFile = cls->elementFile();
+   QVERIFY(QFile::exists(clsFile));
+   prj->dispose();
+
+   QFile file(clsFile);
+   QVERIFY(file.open(QIODevice::ReadOnly));
+   auto saved = file.readAll();
+   file.close();
+
+   // A transaction interrupted before its commit point leaves the files unchanged:
+   {
+      ProjectTransaction transaction(QFileInfo(filename).path());
+      QVERIFY(transaction.begin());
+      QVERIFY(transaction.write(clsFile, "garbage"));
+      QCOMPARE(transaction.count(), 1);
+      QVERIFY(QFileInfo::exists(staging));
+   }
+
+   QVERIFY(file.open(QIODevice::ReadOnly));
+   QCOMPARE(file.readAll(), saved);
+   file.close();
+
+   // A transaction interrupted after its commit point is completed by load():
+   auto renamed = saved;
+   renamed.replace("Saved", "Renamed");
+   QString relative = QDir(QFileInfo(filename).path()).relativeFilePath(clsFile);
+   QVERIFY(QDir().mkpath(QFileInfo(staging + "/" + relative).path()));
+   QFile staged(staging + "/" + relative);
+   QVERIFY(staged.open(QIODevice::WriteOnly));
+   staged.write(renamed);
+   staged.close();
+
+   QFile manifest(staging + "/manifest.json");
+   QVERIFY(manifest.open(QIODevice::WriteOnly));
+   manifest.write(QString("{\"files\":[\"%1\"],\"removedfiles\":[]}").arg(relative).toUtf8());
+   manifest.close();
+
+   auto rec = QSharedPointer<UmlProject>(new UmlProject());
+   QVERIFY(rec->load(filename));
+   QVERIFY(!QFileInfo::exists(staging));
+   UmlElement* elem = nullptr;
+   QVERIFY(rec->find(clsId, &elem));
+   QCOMPARE(dynamic_cast<UmlClass*>(elem)->name(), QString("Renamed"));
+
+   // A transaction stages only the project file and the files of elements modified:
+   rec->isTransactional(true);
+   dynamic_cast<UmlClass*>(elem)->setName("Modified");
+   rec->markModified(elem);
+   Tracer::clear();
+   Tracer::setEnabled(true);
+   QVERIFY(rec->save(filename));
+   Tracer::setEnabled(false);
+
+   int stagedFiles = -1;
+   for (auto value : QJsonDocument::fromJson(Tracer::toJson()).object()["traceEvents"].toArray())
+   {
+      auto event = value.toObject();
+      if (event["name"].toString() == "ProjectTransaction::files")
+      {
+         stagedFiles = event["args"].toObject()["value"].toInt();
+      }
+   }
+   Tracer::clear();
+   QCOMPARE(stagedFiles, 2);
+   rec->dispose();
+}
+
+/**
+ * Tests reloading of files changed by a second UmlProject object, as after a pull of a version control system.
+ */
+void TestProject::testReload()
+{
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+   QString filename = dir.path() + "/umlreloadtest/umlreloadtest.uprj";
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path(), "umlreloadtest");
+   QVERIFY(prj != nullptr);
+
+   auto* cls1 = createClass(QUuid::createUuid(), "Renamed");
+   QUuid cls1Id = cls1->identifier();
+   prj->insert(cls1);
+   mdl->insert(0, cls1);
+
+   auto* cls2 = createClass(QUuid::createUuid(), "Removed");
+   QUuid cls2Id = cls2->identifier();
+   prj->insert(cls2);
+   mdl->insert(0, cls2);
+
+   auto* cls3 = createClass(QUuid::createUuid(), "Unchanged");
+   QUuid cls3Id = cls3->identifier();
+   prj->insert(cls3);
+   mdl->insert(0, cls3);
+   QVERIFY(prj->save(filename));
+
+   int removed = 0;
+   QSet<UmlElement*> reported;
+   QObject::connect(prj.data(), &UmlProject::elementReloaded, [&](UmlElement* element, bool isRemoved)
+   {
+      if (isRemoved) ++removed;
+      else reported.insert(element);
+   });
+
+   // Nothing changed, nothing is read again:
+   QVERIFY(prj->reload());
+   QCOMPARE(removed, 0);
+   QVERIFY(reported.isEmpty());
+
+   // A second project renames, adds and removes elements:
+   {
+      auto other = QSharedPointer<UmlProject>(new UmlProject());
+      QVERIFY(other->load(filename));
+
+      UmlElement* elem = nullptr;
+      QVERIFY(other->find(cls1Id, &elem));
+      dynamic_cast<UmlClass*>(elem)->setName("Changed");
+
+      QVERIFY(other->find(cls2Id, &elem));
+      auto* owner = elem->owner();
+      elem->dispose();
+      owner->remove(elem);
+      other->remove(elem);
+
+      auto* cls4 = createClass(QUuid::createUuid(), "Added");
+      other->insert(cls4);
+      owner->insert(0, cls4);
+      QVERIFY(other->save(filename));
+      other->dispose();
+   }
+
+   // Rewriting a file with the same content makes it stale, but does not change it:
+   QFile file(cls3->elementFile());
+   QVERIFY(file.open(QIODevice::ReadOnly));
+   auto content = file.readAll();
+   file.close();
+   QVERIFY(file.open(QIODevice::WriteOnly));
+   file.write(content);
+   file.close();
+
+   QVERIFY(prj->reload());
+   QVERIFY(!prj->isModified());
+   QVERIFY(!prj->contains(cls2Id));
+   QCOMPARE(cls1->name(), QString("Changed"));
+   QCOMPARE(mdl->count(), 3);
+
+   QCOMPARE(removed, 1);
+   QVERIFY(reported.contains(cls1));
+   QVERIFY(reported.contains(mdl));
+   QVERIFY(!reported.contains(cls3));
+   QVERIFY(prj->contains(cls3Id));
+   prj->dispose();
+}
+
+/**
+ * Tests the canonical form of JSON written by JsonWriter and that saving an unchanged project gives the same bytes.
+ */
+void TestProject::testCanonicalJson()
+{
+   QJsonObject obj;
+   obj["zeta"] = 1.0;
+   obj["alpha"] = QString("Tab\tQuote\"") + QChar(0x00DC) + "mlaut";
+   obj["mid"] = QJsonArray() << 0.1 << -0.0 << 1e20 << true << QJsonValue();
+   auto canonical = JsonWriter::toCanonical(obj);
+   QCOMPARE(canonical, QByteArray("{\"alpha\":\"Tab\\tQuote\\\"\xC3\x9Cmlaut\","
+                                  "\"mid\":[0.1,0,1e+20,true,null],\"zeta\":1}"));
+   QCOMPARE(QJsonDocument::fromJson(canonical).object(), obj);
+
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+   QString filename = dir.path() + "/umljsontest/umljsontest.uprj";
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path(), "umljsontest");
+   QVERIFY(prj != nullptr);
+   for (int index = 0; index < 20; ++index)
+   {
+      auto* cls = createClass(QUuid::createUuid(), QString("Class%1").arg(index));
+      prj->insert(cls);
+      mdl->insert(0, cls);
+   }
+
+   QVERIFY(prj->save(filename));
+   prj->dispose();
+
+   QFile file(filename);
+   QVERIFY(file.open(QIODevice::ReadOnly));
+   auto saved = file.readAll();
+   file.close();
+
+   // The element index is sorted by identifier:
+   QStringList identifiers;
+   for (auto value : QJsonDocument::fromJson(saved).object()["elements"].toArray())
+   {
+      identifiers.append(value.toObject()["identifier"].toString());
+   }
+
+   auto sorted = identifiers;
+   sorted.sort();
+   QCOMPARE(identifiers, sorted);
+
+   // Loading and saving again gives the same bytes, although the elements are inserted in a different order:
+   auto other = QSharedPointer<UmlProject>(new UmlProject());
+   QVERIFY(other->load(filename));
+   QVERIFY(other->save(filename));
+   other->dispose();
+
+   QVERIFY(file.open(QIODevice::ReadOnly));
+   QCOMPARE(file.readAll(), saved);
+   file.close();
+}
+
+/**
+ * Tests reading JSON token by token with JsonReader against QJsonDocument.
+ */
+void TestProject::testJsonReader()
+{
+   // Values read as a whole equal those parsed by QJsonDocument:
+   QByteArray text = " {\"a\": [1, -2.5e3, true, false, null, {}], \"b\": {\"c\": \"x\\n\\u00dc\\ud83d\\ude00\"}} ";
+   JsonReader reader(text);
+   QCOMPARE(reader.readNext(), JsonReader::TokenType::BeginObject);
+   QCOMPARE(reader.readValue(), QJsonValue(QJsonDocument::fromJson(text).object()));
+   QCOMPARE(reader.readNext(), JsonReader::TokenType::EndDocument);
+   QVERIFY(!reader.hasError());
+
+   // Tokens and skipping:
+   JsonReader tokens(text);
+   QCOMPARE(tokens.readNext(), JsonReader::TokenType::BeginObject);
+   QCOMPARE(tokens.readNext(), JsonReader::TokenType::Name);
+   QCOMPARE(tokens.text(), QString("a"));
+   QCOMPARE(tokens.readNext(), JsonReader::TokenType::BeginArray);
+   tokens.skipValue();
+   QCOMPARE(tokens.tokenType(), JsonReader::TokenType::EndArray);
+   QCOMPARE(tokens.readNext(), JsonReader::TokenType::Name);
+   QCOMPARE(tokens.text(), QString("b"));
+
+   // Errors stop the reader:
+   for (auto bad : QList<QByteArray>() << "[1,]" << "{\"a\" 1}" << "{\"a\":1} x" << "[tru]" << "\"open" << "")
+   {
+      JsonReader invalid(bad);
+      while (!invalid.atEnd()) invalid.readNext();
+      QVERIFY2(invalid.hasError(), bad.constData());
+      QVERIFY(!invalid.errorString().isEmpty());
+   }
+
+   // Devices are read in chunks, all of them are hashed:
+   QJsonArray array;
+   for (int index = 0; index < 20000; ++index) array.append(QString("Element %1").arg(index));
+   auto large = QJsonDocument(array).toJson();
+   QBuffer buffer(&large);
+   QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+   JsonReader chunked(&buffer);
+   chunked.setHash(&hash);
+   QCOMPARE(chunked.readNext(), JsonReader::TokenType::BeginArray);
+   QCOMPARE(chunked.readValue().toArray(), array);
+   QCOMPARE(chunked.readNext(), JsonReader::TokenType::EndDocument);
+   QCOMPARE(hash.result(), QCryptographicHash::hash(large, QCryptographicHash::Md5));
+}
+
+/**
+ * Tests comparing versions of a project element by element, in memory against files and between two folders.
+ */
+void TestProject::testProjectDiff()
+{
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+   QString filename = dir.path() + "/umldifftest/umldifftest.uprj";
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path(), "umldifftest");
+   QVERIFY(prj != nullptr);
+
+   auto* pkg = createPackage(QUuid::createUuid(), "Package", VisibilityKind::Public);
+   prj->insert(pkg);
+   mdl->insert(0, pkg);
+
+   auto* renamed = createClass(QUuid::createUuid(), "Renamed");
+   auto* moved = createClass(QUuid::createUuid(), "Moved");
+   auto* removed = createClass(QUuid::createUuid(), "Removed");
+   for (auto* cls : QList<UmlClass*>() << renamed << moved << removed)
+   {
+      prj->insert(cls);
+      mdl->insert(0, cls);
+   }
+
+   QVERIFY(prj->save(filename));
+
+   // Keep a copy of the saved version:
+   QString oldFolder = dir.path() + "/old";
+   QDirIterator files(QFileInfo(filename).path(), QDir::Files, QDirIterator::Subdirectories);
+   while (files.hasNext())
+   {
+      QString source = files.next();
+      QString target = oldFolder + "/" + QDir(QFileInfo(filename).path()).relativeFilePath(source);
+      QVERIFY(QDir().mkpath(QFileInfo(target).path()));
+      QVERIFY(QFile::copy(source, target));
+   }
+
+   ProjectDiff diff;
+   QVERIFY(diff.compare(filename, prj.data()));
+   QVERIFY(diff.changes().isEmpty());
+   QCOMPARE(diff.comparedCount(), prj->elements().size());
+
+   renamed->setName("Changed");
+   mdl->remove(moved);
+   pkg->insert(0, moved);
+   removed->dispose();
+   mdl->remove(removed);
+   prj->remove(removed);
+   auto* added = createClass(QUuid::createUuid(), "Added");
+   prj->insert(added);
+   pkg->insert(0, added);
+
+   // The project in memory against its saved files, and both versions saved:
+   QVERIFY(diff.compare(filename, prj.data()));
+   QVERIFY(prj->save(filename));
+   ProjectDiff saved;
+   QVERIFY(saved.compare(oldFolder, filename));
+
+   for (auto* result : QList<ProjectDiff*>() << &diff << &saved)
+   {
+      QCOMPARE(result->count(ProjectDiff::ChangeKind::Added), 1);
+      QCOMPARE(result->count(ProjectDiff::ChangeKind::Removed), 1);
+      QCOMPARE(result->count(ProjectDiff::ChangeKind::Moved), 1);
+      QCOMPARE(result->count(ProjectDiff::ChangeKind::Modified), 3); // Renamed class and both owners
+
+      for (auto& change : result->changes())
+      {
+         if (change.identifier == renamed->identifier())
+         {
+            QCOMPARE(change.properties.size(), 1);
+            QCOMPARE(change.properties[0].path, QString("name"));
+            QCOMPARE(change.properties[0].oldValue.toString(), QString("Renamed"));
+            QCOMPARE(change.properties[0].newValue.toString(), QString("Changed"));
+         }
+         else if (change.identifier == moved->identifier())
+         {
+            QVERIFY(change.isMoved);
+            QCOMPARE(change.oldOwner, mdl->identifier());
+            QCOMPARE(change.newOwner, pkg->identifier());
+         }
+         else if (change.identifier == added->identifier())
+         {
+            QCOMPARE(change.kind, ProjectDiff::ChangeKind::Added);
+            QCOMPARE(change.newOwner, pkg->identifier());
+         }
+      }
+   }
+
+   prj->dispose();
+}
+
+/**
+ * Tests merging versions of a project three-way, of single objects and of complete projects.
+ */
+void TestProject::testProjectMerge()
+{
+   // Element lists are merged as lists, properties changed on one side take the changed value:
+   auto base = QJsonDocument::fromJson("{\"elements\": [\"x\", \"y\"], \"name\": \"A\", \"static\": false}").object();
+   auto ours = QJsonDocument::fromJson("{\"elements\": [\"x\", \"y\", \"o\"], \"name\": \"B\", \"static\": false}")
+      .object();
+   auto theirs = QJsonDocument::fromJson("{\"elements\": [\"y\", \"t\"], \"name\": \"A\", \"static\": true}").object();
+
+   ProjectMerge merge;
+   auto merged = merge.merge(base, ours, theirs);
+   QVERIFY(merge.conflicts().isEmpty());
+   QCOMPARE(merged["name"].toString(), QString("B"));
+   QCOMPARE(merged["static"].toBool(), true);
+   QCOMPARE(merged["elements"].toArray(), QJsonArray({ "y", "t", "o" }));
+
+   // Properties changed on both sides keep our value:
+   theirs["name"] = "C";
+   merged = merge.merge(base, ours, theirs, "test.json");
+   QCOMPARE(merged["name"].toString(), QString("B"));
+   QCOMPARE(merge.conflicts().size(), 1);
+   QCOMPARE(merge.conflicts()[0].path, QString("name"));
+   QCOMPARE(merge.conflicts()[0].theirs.toString(), QString("C"));
+
+   // Objects removed on one side are removed, not replaced by null; the other side may change the remaining ones:
+   base = QJsonDocument::fromJson("{\"nodes\": [{\"identifier\": \"a\", \"x\": 1}, "
+      "{\"identifier\": \"b\", \"x\": 2}]}").object();
+   ours = QJsonDocument::fromJson("{\"nodes\": [{\"identifier\": \"a\", \"x\": 1}]}").object();
+   theirs = QJsonDocument::fromJson("{\"nodes\": [{\"identifier\": \"a\", \"x\": 3}, "
+      "{\"identifier\": \"b\", \"x\": 2}]}").object();
+   merged = merge.merge(base, ours, theirs, "test.json");
+   QVERIFY(merge.conflicts().isEmpty());
+   QCOMPARE(merged["nodes"].toArray().size(), 1);
+   QCOMPARE(merged["nodes"].toArray()[0].toObject()["x"].toInt(), 3);
+
+   // Complete projects: our version renames a class and moves another, their version adds a class to the same owner
+   // and both rename the package:
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+   QString baseFile = dir.path() + "/base/merge.uprj";
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path() + "/base", "merge");
+   QVERIFY(prj != nullptr);
+   auto* pkg = createPackage(QUuid::createUuid(), "Package", VisibilityKind::Public);
+   prj->insert(pkg);
+   mdl->insert(0, pkg);
+   auto* cls1 = createClass(QUuid::createUuid(), "Renamed");
+   auto* cls2 = createClass(QUuid::createUuid(), "Moved");
+   for (auto* cls : QList<UmlClass*>() << cls1 << cls2)
+   {
+      prj->insert(cls);
+      mdl->insert(0, cls);
+   }
+
+   QVERIFY(prj->save(baseFile));
+   QUuid mdlId = mdl->identifier(), pkgId = pkg->identifier(), cls1Id = cls1->identifier();
+   QUuid cls2Id = cls2->identifier(), cls3Id = QUuid::createUuid();
+   prj->dispose();
+
+   for (auto& version : QStringList() << "ours" << "theirs")
+   {
+      QDirIterator files(QFileInfo(baseFile).path(), QDir::Files, QDirIterator::Subdirectories);
+      while (files.hasNext())
+      {
+         QString source = files.next();
+         QString target = dir.path() + "/" + version + "/" + QDir(QFileInfo(baseFile).path()).relativeFilePath(source);
+         QVERIFY(QDir().mkpath(QFileInfo(target).path()));
+         QVERIFY(QFile::copy(source, target));
+      }
+
+      auto other = QSharedPointer<UmlProject>(new UmlProject());
+      QString filename = dir.path() + "/" + version + "/merge.uprj";
+      QVERIFY(other->load(filename));
+
+      UmlElement* elem = nullptr;
+      QVERIFY(other->find(pkgId, &elem));
+      auto* otherPkg = dynamic_cast<UmlPackage*>(elem);
+      otherPkg->setName(version);
+      QVERIFY(other->find(mdlId, &elem));
+      auto* otherMdl = dynamic_cast<UmlModel*>(elem);
+      if (version == "ours")
+      {
+         QVERIFY(other->find(cls1Id, &elem));
+         dynamic_cast<UmlClass*>(elem)->setName("Changed");
+         QVERIFY(other->find(cls2Id, &elem));
+         otherMdl->remove(elem);
+         otherPkg->insert(0, elem);
+      }
+      else
+      {
+         auto* cls3 = createClass(cls3Id, "Added");
+         other->insert(cls3);
+         otherMdl->insert(0, cls3);
+      }
+
+      QVERIFY(other->save(filename));
+      other->dispose();
+   }
+
+   QString output = dir.path() + "/merged";
+   QVERIFY(merge.mergeProjects(baseFile, dir.path() + "/ours", dir.path() + "/theirs", output));
+   QCOMPARE(merge.conflicts().size(), 1);
+   QCOMPARE(merge.conflicts()[0].path, QString("name"));
+   QVERIFY(merge.conflicts()[0].file.contains(pkgId.toString()));
+
+   auto result = QSharedPointer<UmlProject>(new UmlProject());
+   QVERIFY(result->load(output + "/merge.uprj"));
+   QCOMPARE(result->elements().size(), 6); // Root, model, package and three classes
+
+   UmlElement* elem = nullptr;
+   QVERIFY(result->find(pkgId, &elem));
+   QCOMPARE(dynamic_cast<UmlPackage*>(elem)->name(), QString("ours"));
+   QVERIFY(result->find(cls1Id, &elem));
+   QCOMPARE(dynamic_cast<UmlClass*>(elem)->name(), QString("Changed"));
+   QVERIFY(result->find(cls2Id, &elem));
+   QCOMPARE(elem->owner()->identifier(), pkgId);
+   QVERIFY(result->find(cls3Id, &elem));
+   QCOMPARE(elem->owner()->identifier(), mdlId);
+   result->dispose();
+
+   // The element index of a project file loses entries removed on either side and counts the remaining ones:
+   QJsonObject index;
+   index["author"] = "Unit Test";
+   index["count"] = 3;
+   index["elements"] = QJsonArray({ QJsonObject({ { "identifier", "a" } }), QJsonObject({ { "identifier", "b" } }),
+      QJsonObject({ { "identifier", "c" } }) });
+   QStringList indexFiles;
+   for (auto& version : QStringList() << "base" << "ours" << "theirs")
+   {
+      auto elements = index["elements"].toArray();
+      if (version == "ours") elements.removeAt(1);
+      if (version == "theirs") elements.removeAt(2);
+      auto content = index;
+      content["elements"] = elements;
+
+      QFile file(dir.path() + "/" + version + ".uprj");
+      QVERIFY(file.open(QIODevice::WriteOnly));
+      file.write(QJsonDocument(content).toJson());
+      indexFiles.append(file.fileName());
+   }
+
+   QVERIFY(merge.mergeFiles(indexFiles[0], indexFiles[1], indexFiles[2], indexFiles[1]));
+   QVERIFY(merge.conflicts().isEmpty());
+   QFile file(indexFiles[1]);
+   QVERIFY(file.open(QIODevice::ReadOnly));
+   auto mergedIndex = QJsonDocument::fromJson(file.readAll()).object();
+   QCOMPARE(mergedIndex["count"].toInt(), 1);
+   QCOMPARE(mergedIndex["elements"].toArray(), QJsonArray({ QJsonObject({ { "identifier", "a" } }) }));
+}
+
+void TestProject::testXmi()
+{
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+   QString xmiFile = dir.path() + "/export.xmi";
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl);
+   QVERIFY(prj != nullptr);
+   auto* pkg = createPackage(QUuid::createUuid(), "Package", VisibilityKind::Public);
+   prj->insert(pkg);
+   mdl->insert(0, pkg);
+   auto* customer = createClass(QUuid::createUuid(), "Customer");
+   auto* person = createClass(QUuid::createUuid(), "Person");
+   auto* order = createClass(QUuid::createUuid(), "Order");
+   for (auto* cls : QList<UmlClass*>() << customer << person << order)
+   {
+      prj->insert(cls);
+      pkg->insert(0, cls);
+   }
+
+   auto* attr = new UmlAttribute(QUuid::createUuid());
+   attr->setName("number");
+   attr->setType("Integer");
+   prj->insert(attr);
+   order->insert(0, attr);
+   auto* op = new UmlOperation(QUuid::createUuid());
+   op->setName("customer");
+   op->setReturnType("Customer");
+   prj->insert(op);
+   order->insert(0, op);
+
+   auto* gen = new UmlGeneralization(QUuid::createUuid());
+   gen->setSource(customer);
+   gen->setTarget(person);
+   auto* assoc = new UmlAssociation(QUuid::createUuid());
+   assoc->setSource(customer);
+   assoc->setTarget(order);
+   assoc->targetEnd().setName("orders");
+   assoc->targetEnd().setUpper(KUnlimited);
+   auto* dep = createDependency(QUuid::createUuid(), order, person, "use");
+   for (auto* lnk : QList<UmlLink*>() << gen << assoc << dep)
+   {
+      prj->insert(lnk);
+      pkg->insert(0, lnk);
+   }
+
+   XmiExporter exporter(prj.data());
+   QVERIFY2(exporter.write(xmiFile), qPrintable(exporter.errorString()));
+   QVERIFY(exporter.exportedCount() >= 10);
+
+   // Importing into another project keeps the identifiers, names, types and relationships:
+   auto other = QSharedPointer<UmlProject>(new UmlProject());
+   XmiImporter importer(other.data());
+   QVERIFY2(importer.read(xmiFile), qPrintable(importer.errorString()));
+   QCOMPARE(importer.skippedCount(), 0);
+   QCOMPARE(importer.importedCount(), exporter.exportedCount());
+
+   UmlElement* elem = nullptr;
+   QVERIFY(other->find(pkg->identifier(), &elem));
+   QCOMPARE(elem->owner()->identifier(), mdl->identifier());
+   QVERIFY(other->find(attr->identifier(), &elem));
+   QCOMPARE(dynamic_cast<UmlAttribute*>(elem)->type(), QString("Integer"));
+   QCOMPARE(elem->owner()->identifier(), order->identifier());
+   QVERIFY(other->find(op->identifier(), &elem));
+   QCOMPARE(dynamic_cast<UmlOperation*>(elem)->returnType(), QString("Customer"));
+
+   QVERIFY(other->find(gen->identifier(), &elem));
+   QVERIFY(dynamic_cast<UmlGeneralization*>(elem) != nullptr);
+   QCOMPARE(dynamic_cast<UmlLink*>(elem)->source()->identifier(), customer->identifier());
+   QCOMPARE(dynamic_cast<UmlLink*>(elem)->target()->identifier(), person->identifier());
+   QVERIFY(other->find(assoc->identifier(), &elem));
+   auto* otherAssoc = dynamic_cast<UmlAssociation*>(elem);
+   QVERIFY(otherAssoc != nullptr);
+   QCOMPARE(otherAssoc->targetEnd().name(), QString("orders"));
+   QCOMPARE(otherAssoc->targetEnd().upper(), KUnlimited);
+   QCOMPARE(otherAssoc->target()->identifier(), order->identifier());
+   QVERIFY(other->find(dep->identifier(), &elem));
+   QCOMPARE(dynamic_cast<UmlDependency*>(elem)->keywords(), QString("use"));
+
+   // Importing the file again remaps the identifiers already used:
+   int count = other->elements().size();
+   QVERIFY(importer.read(xmiFile));
+   QCOMPARE(other->elements().size(), count + importer.importedCount());
+
+   // Packages and classifiers at the root of a file are added to a new model, the root only accepts models:
+   QString looseFile = dir.path() + "/loose.xmi";
+   QFile loose(looseFile);
+   QVERIFY(loose.open(QIODevice::WriteOnly));
+   loose.write("<?xml version=\"1.0\"?>\n"
+               "<xmi:XMI xmlns:xmi=\"http://www.omg.org/spec/XMI/20131001\" "
+               "xmlns:uml=\"http://www.omg.org/spec/UML/20161101\">\n"
+               "<uml:Package xmi:id=\"loosePackage\" name=\"Loose\"/>\n"
+               "<uml:Class xmi:id=\"looseClass\" name=\"Orphan\"/>\n"
+               "</xmi:XMI>\n");
+   loose.close();
+
+   auto third = QSharedPointer<UmlProject>(new UmlProject());
+   XmiImporter looseImporter(third.data());
+   QVERIFY2(looseImporter.read(looseFile), qPrintable(looseImporter.errorString()));
+   QCOMPARE(looseImporter.importedCount(), 3);
+   QCOMPARE(third->root()->count(), 1);
+   auto* wrapper = dynamic_cast<UmlModel*>(third->root()->at(0));
+   QVERIFY(wrapper != nullptr);
+   QCOMPARE(wrapper->name(), QString("loose"));
+   QCOMPARE(wrapper->count(), 2);
+
+   third->dispose();
+   other->dispose();
+   prj->dispose();
+}
+
+void TestProject::testCppGenerator()
+{
+   QTemporaryDir dir;
+   QVERIFY(dir.isValid());
+
+   UmlModel* mdl = nullptr;
+   auto prj = createProject(&mdl, dir.path(), "codegen");
+   QVERIFY(prj != nullptr);
+   auto* pkg = createPackage(QUuid::createUuid(), "Package", VisibilityKind::Public);
+   prj->insert(pkg);
+   mdl->insert(0, pkg);
+
+   auto* shape = new UmlInterface(QUuid::createUuid());
+   shape->setName("Shape");
+   auto* circle = createClass(QUuid::createUuid(), "Circle");
+   auto* drawing = createClass(QUuid::createUuid(), "Drawing");
+   auto* color = new UmlEnumeration(QUuid::createUuid());
+   color->setName("Color");
+   color->append(new UmlLiteral(0, "Red"));
+   color->append(new UmlLiteral(1, "Green"));
+   auto* other = createClass(QUuid::createUuid(), "JavaOnly");
+   other->setLanguage("Java");
+   for (auto* cls : QList<UmlClassifier*>() << shape << circle << drawing << color << other)
+   {
+      prj->insert(cls);
+      pkg->insert(0, cls);
+   }
+
+   for (auto* cls : QList<UmlClassifier*>() << shape << circle)
+   {
+      auto* op = new UmlOperation(QUuid::createUuid());
+      op->setName("area");
+      op->setReturnType("double");
+      if (cls == circle) op->setInitCode("return 3.14 * radius * radius;");
+      prj->insert(op);
+      cls->insert(0, op);
+   }
+
+   auto* radius = new UmlAttribute(QUuid::createUuid());
+   radius->setName("radius");
+   radius->setType("double");
+   prj->insert(radius);
+   circle->insert(0, radius);
+   auto* shapes = new UmlAttribute(QUuid::createUuid());
+   shapes->setName("shapes");
+   shapes->setType("Circle");
+   shapes->setUpper(KUnlimited);
+   prj->insert(shapes);
+   drawing->insert(0, shapes);
+
+   auto* real = new UmlRealization(QUuid::createUuid());
+   real->setSource(circle);
+   real->setTarget(shape);
+   prj->insert(real);
+   pkg->insert(0, real);
+
+   auto readFile = [](const QString& filename)
+   {
+      QFile file(filename);
+      return file.open(QIODevice::ReadOnly) ? QString::fromUtf8(file.readAll()) : QString();
+   };
+
+   CppGenerator generator(prj.data());
+   QString folder = generator.outputFolder() + "/Package/";
+   QVERIFY2(generator.generate(), qPrintable(generator.errorString()));
+   QCOMPARE(generator.generatedCount(), 4);
+   QVERIFY(!QFileInfo::exists(folder + "JavaOnly.h"));
+   QVERIFY(!QFileInfo::exists(folder + "Shape.cpp"));
+   QVERIFY(readFile(folder + "Shape.h").contains("virtual double area() = 0;"));
+   QVERIFY(readFile(folder + "Color.h").contains("enum class Color\n{\n   Red = 0,\n   Green = 1\n};"));
+
+   QString text = readFile(folder + "Circle.h");
+   QVERIFY(text.contains("#include \"Package/Shape.h\""));
+   QVERIFY(text.contains("class Circle : public Shape"));
+   QVERIFY(text.contains("   double area();"));
+   QVERIFY(readFile(folder + "Circle.cpp").contains("double Circle::area()\n{\n   return 3.14 * radius * radius;\n}"));
+
+   text = readFile(folder + "Drawing.h");
+   QVERIFY(text.contains("#include <vector>"));
+   QVERIFY(text.contains("#include \"Package/Circle.h\""));
+   QVERIFY(text.contains("std::vector<Circle> shapes;"));
+
+   // Unchanged classifiers are not written again, renamed ones replace their files:
+   QVERIFY(generator.generate());
+   QCOMPARE(generator.generatedCount(), 0);
+   QCOMPARE(generator.unchangedCount(), 4);
+
+   drawing->setName("Scene");
+   QVERIFY(generator.generate());
+   QCOMPARE(generator.generatedCount(), 1);
+   QCOMPARE(generator.removedCount(), 1);
+   QVERIFY(!QFileInfo::exists(folder + "Drawing.h"));
+   QVERIFY(QFileInfo::exists(folder + "Scene.h"));
+
+   // Files deleted by hand are written again:
+   QVERIFY(QFile::remove(folder + "Color.h"));
+   QVERIFY(generator.generate());
+   QCOMPARE(generator.generatedCount(), 1);
+   QVERIFY(QFileInfo::exists(folder + "Color.h"));
+
+   // Another generator reads the keys of the last run from the manifest:
+   CppGenerator next(prj.data());
+   QVERIFY(next.generate());
+   QCOMPARE(next.generatedCount(), 0);
+   QCOMPARE(next.unchangedCount(), 4);
+
+   // Classifiers whose names map to the same file are reported:
+   for (auto* cls : QList<UmlClassifier*>() << createClass(QUuid::createUuid(), "Foo Bar") <<
+        createClass(QUuid::createUuid(), "Foo_Bar"))
+   {
+      prj->insert(cls);
+      pkg->insert(0, cls);
+   }
+
+   QVERIFY(!next.generate());
+   QVERIFY(next.errorString().contains("Foo_Bar.h"));
+   QCOMPARE(next.generatedCount(), 1);
+
+   prj->dispose();
+}
+
 
 UmlModel* TestProject::createModel(QUuid id, QString name, QString viewpt)
 {
@@ -278,6 +1639,18 @@ UmlModel* TestProject::createModel(QUuid id, QString name, QString viewpt)
    return mdl;
 }
 
+QSharedPointer<UmlProject> TestProject::createProject(UmlModel** mdl, QString folder, QString name)
+{
+   // The project is created in a folder only if one is given, otherwise it is kept in memory:
+   auto prj = QSharedPointer<UmlProject>(new UmlProject());
+   if (!folder.isEmpty() && !prj->create(folder, name)) return QSharedPointer<UmlProject>();
+
+   *mdl = createModel(QUuid::createUuid(), "Model", "Unit Test");
+   prj->insert(*mdl);
+   prj->root()->insert(0, *mdl);
+   return prj;
+}
+
 UmlDiagram* TestProject::createDiagram(QUuid id, QString name, DiagramKind kind)
 {
    auto dia = new UmlDiagram(id);
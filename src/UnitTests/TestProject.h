@@ -6,10 +6,13 @@
 #pragma once
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QTest>
 
 #include "UmlCommon.h"
 #include "UmlClassifiers.h"
+#include "UmlLayout.h"
+#include "UmlValidation.h"
 
 class TestProject : public QObject
 {
@@ -34,13 +37,32 @@ private slots:
    void testRemove();
    void testSave();
    void testLoad();
+   void testTracer();
 
    // UmlClassifier tests:
    void testAttribute();
    void testOperation();
+   void testTypeIndex();
+   void testRenameType();
+   void testNameIndex();
+   void testValidator();
+   void testLayeredLayout();
+   void testForceLayout();
+   void testOverviewGenerator();
+   void testMemoryReport();
+   void testJournal();
+   void testTransaction();
+   void testReload();
+   void testCanonicalJson();
+   void testJsonReader();
+   void testProjectDiff();
+   void testProjectMerge();
+   void testXmi();
+   void testCppGenerator();
 
 private:
    UmlModel* createModel(QUuid id, QString name, QString viewpt);
+   QSharedPointer<UmlProject> createProject(UmlModel** mdl, QString folder = QString(), QString name = QString());
    UmlDiagram* createDiagram(QUuid id, QString name, DiagramKind kind);
    UmlComment* createComment(QUuid id, QString body);
    UmlPackage* createPackage(QUuid id, QString name, VisibilityKind kind);
@@ -5,13 +5,15 @@
 TEMPLATE = app
 TARGET   = UnitTests
 DESTDIR  = ../../bin/tests
-QT      += core
+QT      += core concurrent
 CONFIG  += qtestlib debug console
 
 win32 {
   DEFINES += WIN64 QT_DLL QT_TESTLIB_LIB
 }
 
+include(../UmlLayout/UmlLayout.pri)
+include(../UmlValidation/UmlValidation.pri)
 include(../UmlCommon/UmlCommon.pri)
 include(../UmlClassifiers/UmlClassifiers.pri)
 
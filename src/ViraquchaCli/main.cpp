@@ -0,0 +1,588 @@
+//---------------------------------------------------------------------------------------------------------------------
+// main.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Main function of the ViraquchaCli command line tool.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "Viraqucha.h"
+
+#include "UmlCommon.h"
+#include "UmlClassifiers.h"
+#include "UmlLayout.h"
+#include "UmlValidation.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QScopedPointer>
+#include <QTextStream>
+
+/**
+ * @defgroup ViraquchaCli
+ * Implements the command line tool of ViraquchaUML.
+ *
+ * The command line tool works on projects without starting the GUI, e.g. on build servers. Usage:
+ * ~~~
+ * ViraquchaCli validate <project>
+ * ViraquchaCli layout [--algorithm layered|force] <project> [diagram]
+ * ViraquchaCli overview <project>
+ * ViraquchaCli memory [--json] <project>
+ * ViraquchaCli diff [--json] <old project> <new project>
+ * ViraquchaCli merge [--json] <base project> <our project> <their project> <output folder>
+ * ViraquchaCli merge-file <base file> <our file> <their file>
+ * ViraquchaCli export <project> <xmi file>
+ * ViraquchaCli import <xmi file> <project>
+ * ViraquchaCli generate <project> [output folder]
+ * ~~~
+ * Command "validate" checks the project with all validation rules and prints the issues found. The exit code is 0 if
+ * no errors were found, 1 if errors were found and 2 if the project could not be loaded.
+ *
+ * Command "layout" arranges the shapes of the diagram with the given name - or of all diagrams of the project if no
+ * name is given - and saves the diagrams. Class diagrams are laid out following their class hierarchy (see class
+ * LayeredLayout), all other diagrams by forces (see class ForceLayout) unless option --algorithm says otherwise. The
+ * exit code is 0 if all diagrams were laid out, 1 if a diagram could not be laid out and 2 if the project could not be
+ * loaded.
+ *
+ * Command "overview" creates or refreshes the overview diagram of the packages of the project and their relations
+ * (see class OverviewGenerator) and saves the project. The exit code is 0 on success and 2 on failure.
+ *
+ * Command "memory" loads the project, opens all of its diagrams and prints the estimated memory used per class of
+ * elements (see class MemoryReport), as a table or - with option --json - as a JSON object. The exit code is 0 on
+ * success and 2 if the project could not be loaded.
+ *
+ * Command "diff" compares two versions of a project, given by their project files or folders, element by element (see
+ * class ProjectDiff) and prints the elements added, removed, modified or moved and the properties changed, as text
+ * or - with option --json - as a JSON object. The exit code is 0 if the versions are equal, 1 if they differ and 2 if
+ * a version could not be read.
+ *
+ * Command "merge" merges two versions of a project three-way against their common ancestor (see class ProjectMerge),
+ * writes the merged project to the output folder - which may be the folder of our version - and prints the conflicts
+ * found, as text or - with option --json - as a JSON object. Conflicting properties keep our value. The exit code is
+ * 0 if no conflicts were found, 1 if conflicts were found and 2 if a version could not be read or the merged project
+ * could not be written.
+ *
+ * Command "merge-file" merges a single element, diagram or project file the same way, writes the merged version to
+ * our file and prints the conflicts found to stderr. It serves as a merge driver of git, exit codes as above. Add to
+ * the .gitattributes of the repository
+ * ~~~
+ * *.json merge=viraqucha
+ * *.uprj merge=viraqucha
+ * ~~~
+ * and to the git configuration
+ * ~~~
+ * [merge "viraqucha"]
+ *    name = ViraquchaUML model merge
+ *    driver = ViraquchaCli merge-file %O %A %B
+ * ~~~
+ * Git merges each file on its own, so the checks across files done by command "merge" - elements listed by two
+ * owners, removed elements still listed or referenced by links - are not done for merges by git.
+ *
+ * Command "export" writes the packages and classifiers of the project to an XMI 2.5 file (see class XmiExporter),
+ * command "import" reads them from an XMI file into the project (see class XmiImporter) and saves the project. If the
+ * project file does not exist, a new project named after the file is created in a subfolder of that name. The exit
+ * code is 0 on success, 1 if elements of the XMI file were skipped and 2 on failure.
+ *
+ * Command "generate" generates C++ header and source files from the classes, interfaces, data types and enumerations
+ * of the project (see class CppGenerator) in the output folder - by default subfolder "cpp" of the code folder of the
+ * project. Only files of classifiers changed since the last run are written. The exit code is 0 on success and 2 on
+ * failure.
+ *
+ * All commands accept option --trace <file> recording a trace of the command, which can be opened with
+ * chrome://tracing or https://ui.perfetto.dev (see class Tracer).
+ */
+
+/// @cond
+enum ExitCode
+{
+   ExitSuccess = 0,
+   ExitIssues  = 1,
+   ExitFailure = 2
+};
+/// @endcond
+
+/** Gets the name of an element to be printed or its identifier if the element is not named. */
+static QString describe(UmlProject& project, QUuid id)
+{
+   UmlElement* elem = nullptr;
+   if (!project.find(id, &elem)) return id.toString();
+
+   auto named = dynamic_cast<INamedElement*>(elem);
+   if (named != nullptr && !named->name().isEmpty())
+   {
+      return QString("%1 '%2'").arg(elem->className()).arg(named->name());
+   }
+
+   return QString("%1 %2").arg(elem->className()).arg(id.toString());
+}
+
+/** Validates a project and prints the issues found. */
+static int validate(QString filename)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   UmlProject project;
+   if (!project.load(filename))
+   {
+      err << project.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   Validator validator(&project);
+   validator.addDefaultRules();
+   bool success = validator.validate();
+
+   for (auto issue : validator.issues())
+   {
+      if (issue.element().isNull())
+      {
+         out << issue.toString() << endl;
+      }
+      else
+      {
+         out << describe(project, issue.element()) << ": " << issue.toString() << endl;
+      }
+   }
+
+   out << QCoreApplication::translate("main", "%1 error(s), %2 warning(s)")
+      .arg(validator.count(IssueSeverity::Error)).arg(validator.count(IssueSeverity::Warning)) << endl;
+
+   project.dispose();
+   return success ? ExitSuccess : ExitIssues;
+}
+
+/** Lays out the diagrams of a project and saves them. */
+static int layout(QString filename, QString diagramName, QString algorithm)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   if (!algorithm.isEmpty() && QScopedPointer<DiagramLayout>(DiagramLayout::create(algorithm)).isNull())
+   {
+      err << QCoreApplication::translate("main", "Unknown layout algorithm '%1'.").arg(algorithm) << endl;
+      return ExitFailure;
+   }
+
+   UmlProject project;
+   if (!project.load(filename))
+   {
+      err << project.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   int result = ExitSuccess;
+   int count = 0;
+   for (auto* elem : project.elements())
+   {
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram == nullptr || (!diagramName.isEmpty() && diagram->name() != diagramName)) continue;
+      ++count;
+
+      QElapsedTimer timer;
+      timer.start();
+
+      QString name = algorithm.isEmpty() ? DiagramLayout::defaultName(diagram->kind()) : algorithm;
+      QScopedPointer<DiagramLayout> layout(DiagramLayout::create(name));
+      if (!diagram->open() || !layout->layout(diagram) || !diagram->save())
+      {
+         QString error = diagram->errorString().isEmpty() ? layout->errorString() : diagram->errorString();
+         err << describe(project, diagram->identifier()) << ": " << error << endl;
+         result = ExitIssues;
+      }
+      else
+      {
+         out << QCoreApplication::translate("main", "%1: %2 node(s), %3 edge(s) laid out %4 in %5 ms")
+            .arg(describe(project, diagram->identifier())).arg(diagram->nodeCount()).arg(diagram->edgeCount())
+            .arg(name).arg(timer.elapsed()) << endl;
+      }
+
+      diagram->close();
+   }
+
+   if (count == 0 && !diagramName.isEmpty())
+   {
+      err << QCoreApplication::translate("main", "Diagram '%1' not found.").arg(diagramName) << endl;
+      result = ExitIssues;
+   }
+
+   project.dispose();
+   return result;
+}
+
+/** Creates or refreshes the overview diagram of a project and saves the project. */
+static int overview(QString filename)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   UmlProject project;
+   if (!project.load(filename))
+   {
+      err << project.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   QElapsedTimer timer;
+   timer.start();
+
+   OverviewGenerator generator(&project);
+   if (!generator.generate() || (generator.isChanged() && !project.save(filename)))
+   {
+      err << (generator.errorString().isEmpty() ? project.errorString() : generator.errorString()) << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   out << QCoreApplication::translate("main", "%1: %2 shape(s) added, %3 shape(s) removed in %4 ms")
+      .arg(describe(project, generator.diagram()->identifier())).arg(generator.addedCount())
+      .arg(generator.removedCount()).arg(timer.elapsed()) << endl;
+
+   project.dispose();
+   return ExitSuccess;
+}
+
+/** Prints the estimated memory used by a project with all of its diagrams opened. */
+static int memory(QString filename, bool json)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   UmlProject project;
+   if (!project.load(filename))
+   {
+      err << project.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   QList<UmlDiagram*> opened;
+   for (auto* elem : project.elements())
+   {
+      auto* diagram = dynamic_cast<UmlDiagram*>(elem);
+      if (diagram == nullptr || diagram->isOpen()) continue;
+      if (!diagram->open())
+      {
+         err << describe(project, diagram->identifier()) << ": " << diagram->errorString() << endl;
+         continue;
+      }
+
+      opened.append(diagram);
+   }
+
+   MemoryReport report;
+   report.addProject(&project);
+   if (json)
+   {
+      out << QJsonDocument(report.toJson()).toJson();
+   }
+   else
+   {
+      out << report.toText();
+   }
+
+   for (auto* diagram : opened) diagram->close();
+   project.dispose();
+   return ExitSuccess;
+}
+
+/** Compares two versions of a project and prints the changes found. */
+static int diff(QString oldProject, QString newProject, bool json)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   ProjectDiff projectDiff;
+   if (!projectDiff.compare(oldProject, newProject))
+   {
+      err << projectDiff.errorString() << endl;
+      return ExitFailure;
+   }
+
+   if (json)
+   {
+      out << QJsonDocument(projectDiff.toJson()).toJson();
+   }
+   else
+   {
+      out << projectDiff.toText();
+   }
+
+   return projectDiff.changes().isEmpty() ? ExitSuccess : ExitIssues;
+}
+
+/** Merges two versions of a project and prints the conflicts found. */
+static int merge(QString base, QString ours, QString theirs, QString output, bool json)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   ProjectMerge projectMerge;
+   if (!projectMerge.mergeProjects(base, ours, theirs, output))
+   {
+      err << projectMerge.errorString() << endl;
+      return ExitFailure;
+   }
+
+   if (json)
+   {
+      out << QJsonDocument(projectMerge.toJson()).toJson();
+   }
+   else
+   {
+      out << projectMerge.toText();
+   }
+
+   return projectMerge.conflicts().isEmpty() ? ExitSuccess : ExitIssues;
+}
+
+/** Exports the packages and classifiers of a project to an XMI file. */
+static int exportXmi(QString filename, QString xmiFile)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   UmlProject project;
+   if (!project.load(filename))
+   {
+      err << project.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   QElapsedTimer timer;
+   timer.start();
+
+   XmiExporter exporter(&project);
+   if (!exporter.write(xmiFile))
+   {
+      err << exporter.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   out << QCoreApplication::translate("main", "%1 element(s) exported in %2 ms")
+      .arg(exporter.exportedCount()).arg(timer.elapsed()) << endl;
+
+   project.dispose();
+   return ExitSuccess;
+}
+
+/** Imports the packages and classifiers of an XMI file into a project and saves the project. */
+static int importXmi(QString xmiFile, QString filename)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   UmlProject project;
+   QFileInfo info(filename);
+   if (info.exists())
+   {
+      if (!project.load(filename))
+      {
+         err << project.errorString() << endl;
+         project.dispose();
+         return ExitFailure;
+      }
+   }
+   else
+   {
+      auto name = info.completeBaseName();
+      if (!project.create(info.path(), name))
+      {
+         err << QCoreApplication::translate("main", "Cannot create project '%1'").arg(filename) << endl;
+         project.dispose();
+         return ExitFailure;
+      }
+
+      filename = project.projectFolder() + "/" + name + ".uprj";
+      project.setName(name);
+   }
+
+   QElapsedTimer timer;
+   timer.start();
+
+   XmiImporter importer(&project);
+   if (!importer.read(xmiFile) || !project.save(filename))
+   {
+      err << (importer.errorString().isEmpty() ? project.errorString() : importer.errorString()) << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   out << QCoreApplication::translate("main", "%1 element(s) imported, %2 skipped in %3 ms")
+      .arg(importer.importedCount()).arg(importer.skippedCount()).arg(timer.elapsed()) << endl;
+
+   project.dispose();
+   return importer.skippedCount() == 0 ? ExitSuccess : ExitIssues;
+}
+
+/** Generates C++ files from the classifiers of a project. */
+static int generate(QString filename, QString folder)
+{
+   QTextStream out(stdout);
+   QTextStream err(stderr);
+
+   UmlProject project;
+   if (!project.load(filename))
+   {
+      err << project.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   QElapsedTimer timer;
+   timer.start();
+
+   CppGenerator generator(&project);
+   if (!folder.isEmpty()) generator.setOutputFolder(folder);
+   if (!generator.generate())
+   {
+      err << generator.errorString() << endl;
+      project.dispose();
+      return ExitFailure;
+   }
+
+   out << QCoreApplication::translate("main",
+      "%1: %2 classifier(s) generated, %3 unchanged, %4 file(s) removed in %5 ms")
+      .arg(generator.outputFolder()).arg(generator.generatedCount()).arg(generator.unchangedCount())
+      .arg(generator.removedCount()).arg(timer.elapsed()) << endl;
+
+   project.dispose();
+   return ExitSuccess;
+}
+
+/** Merges a single file of a project into our file, e.g. as a merge driver of git. */
+static int mergeFile(QString base, QString ours, QString theirs)
+{
+   QTextStream err(stderr);
+
+   ProjectMerge projectMerge;
+   if (!projectMerge.mergeFiles(base, ours, theirs, ours))
+   {
+      err << projectMerge.errorString() << endl;
+      return ExitFailure;
+   }
+
+   if (projectMerge.conflicts().isEmpty()) return ExitSuccess;
+
+   err << projectMerge.toText();
+   return ExitIssues;
+}
+
+int main(int argc, char *argv[])
+{
+   QCoreApplication app(argc, argv);
+   QCoreApplication::setOrganizationName(Viraqucha::KOrgaName);
+   QCoreApplication::setOrganizationDomain(Viraqucha::KOrgaDomain);
+   QCoreApplication::setApplicationName("ViraquchaCli");
+   QCoreApplication::setApplicationVersion(Viraqucha::KProgramVersion.toString());
+
+   QCommandLineParser parser;
+   parser.setApplicationDescription(QCoreApplication::translate("main", "Command line tool of %1.")
+      .arg(Viraqucha::KProgramName));
+   parser.addHelpOption();
+   parser.addVersionOption();
+   parser.addPositionalArgument("command", QCoreApplication::translate("main",
+      "Command to execute: validate, layout, overview, memory, diff, merge, merge-file, export, import, generate"));
+   parser.addPositionalArgument("project", QCoreApplication::translate("main", "The project to work on."));
+   parser.addPositionalArgument("diagram",
+      QCoreApplication::translate("main", "Name of the diagram to lay out, or the new project to compare with."),
+      "[diagram]");
+
+   QCommandLineOption algorithmOption(QStringList() << "a" << "algorithm",
+      QCoreApplication::translate("main", "Layout algorithm of command layout: layered or force."), "name");
+   parser.addOption(algorithmOption);
+
+   QCommandLineOption jsonOption("json",
+      QCoreApplication::translate("main", "Print the report of commands memory, diff and merge as JSON."));
+   parser.addOption(jsonOption);
+
+   QCommandLineOption traceOption("trace",
+      QCoreApplication::translate("main", "Record a trace of the command and write it to the given file."), "file");
+   parser.addOption(traceOption);
+   parser.process(app);
+
+   initCommon();
+   initClassifiers();
+   if (parser.isSet(traceOption)) Tracer::setEnabled(true);
+
+   int result = ExitFailure;
+   auto args = parser.positionalArguments();
+   if (args.count() == 2 && args[0] == "validate")
+   {
+      result = validate(args[1]);
+   }
+   else if ((args.count() == 2 || args.count() == 3) && args[0] == "layout")
+   {
+      result = layout(args[1], args.value(2), parser.value(algorithmOption));
+   }
+   else if (args.count() == 2 && args[0] == "overview")
+   {
+      result = overview(args[1]);
+   }
+   else if (args.count() == 2 && args[0] == "memory")
+   {
+      result = memory(args[1], parser.isSet(jsonOption));
+   }
+   else if (args.count() == 3 && args[0] == "diff")
+   {
+      result = diff(args[1], args[2], parser.isSet(jsonOption));
+   }
+   else if (args.count() == 5 && args[0] == "merge")
+   {
+      result = merge(args[1], args[2], args[3], args[4], parser.isSet(jsonOption));
+   }
+   else if (args.count() == 4 && args[0] == "merge-file")
+   {
+      result = mergeFile(args[1], args[2], args[3]);
+   }
+   else if (args.count() == 3 && args[0] == "export")
+   {
+      result = exportXmi(args[1], args[2]);
+   }
+   else if (args.count() == 3 && args[0] == "import")
+   {
+      result = importXmi(args[1], args[2]);
+   }
+   else if ((args.count() == 2 || args.count() == 3) && args[0] == "generate")
+   {
+      result = generate(args[1], args.value(2));
+   }
+   else
+   {
+      parser.showHelp(ExitFailure);
+   }
+
+   if (parser.isSet(traceOption) && !Tracer::write(parser.value(traceOption)))
+   {
+      QTextStream(stderr) << Tracer::errorString() << endl;
+   }
+
+   return result;
+}
@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------------------------------------------------
+// DiagnosticsDialog.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class DiagnosticsDialog.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "DiagnosticsDialog.h"
+#include "MemoryReport.h"
+#include "MessageBox.h"
+#include "Viraqucha.h"
+
+#include <QFile>
+#include <QFileDialog>
+#include <QJsonDocument>
+#include <QPushButton>
+
+/**
+ * @class DiagnosticsDialog
+ * @brief Implements a dialog showing the memory used by the current project
+ * @since 0.2.0
+ * @ingroup ViraquchaUML
+ *
+ * The dialog lists the entries of a MemoryReport, one row per class or category, biggest first. The report can be
+ * saved either as JSON or as plain text, depending on the file type chosen by the user.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the DiagnosticsDialog class.
+ *
+ * @param parent Parent widget
+ */
+DiagnosticsDialog::DiagnosticsDialog(QWidget* parent)
+: super(parent)
+{
+   ui.setupUi(this);
+   connect(ui.buttonBox->button(QDialogButtonBox::Save), &QPushButton::clicked, this, &DiagnosticsDialog::saveReport);
+}
+
+DiagnosticsDialog::~DiagnosticsDialog()
+{
+}
+
+/**
+ * Shows the entries of a memory report.
+ *
+ * @param report MemoryReport object to be shown.
+ */
+void DiagnosticsDialog::showReport(const MemoryReport& report)
+{
+   auto total = report.total();
+   ui.summaryLabel->setText(tr("%1 objects using an estimated %2 of memory.")
+      .arg(report.count()).arg(MemoryReport::formatBytes(total.total())));
+
+   auto entries = report.entries();
+   ui.tableWidget->setRowCount(entries.size());
+   for (int row = 0; row < entries.size(); ++row)
+   {
+      auto& entry = entries[row];
+      QList<qint64> values = { entry.usage.total(), entry.usage.objects, entry.usage.strings, entry.usage.containers,
+                               entry.usage.observers, entry.usage.diagrams, entry.usage.graphics, entry.usage.undo };
+      ui.tableWidget->setItem(row, 0, new QTableWidgetItem(entry.name));
+      ui.tableWidget->setItem(row, 1, new QTableWidgetItem(QString::number(entry.count)));
+      for (int index = 0; index < values.size(); ++index)
+      {
+         auto* item = new QTableWidgetItem(MemoryReport::formatBytes(values[index]));
+         item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+         ui.tableWidget->setItem(row, index + 2, item);
+      }
+
+      ui.tableWidget->item(row, 1)->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+   }
+
+   ui.tableWidget->resizeColumnsToContents();
+   _json = report.toJson();
+   _text = report.toText();
+}
+
+/** Saves the report shown to a JSON or text file chosen by the user. */
+void DiagnosticsDialog::saveReport()
+{
+   auto filename = QFileDialog::getSaveFileName(
+      this,
+      tr("Save Memory Report"),
+      QString(),
+      "JSON - JavaScript Object Notation (.json)(*.json);;Text (.txt)(*.txt)");
+   if (filename.isEmpty()) return;
+
+   bool isText = filename.endsWith(".txt", Qt::CaseInsensitive);
+   auto content = isText ? _text.toUtf8() : QJsonDocument(_json).toJson();
+
+   QFile file(filename);
+   if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size())
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, tr("The memory report could not be saved."));
+   }
+}
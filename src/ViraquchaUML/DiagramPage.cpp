@@ -32,8 +32,15 @@
 #include "Shape.h"
 #include "ToolBoxManager.h"
 
+#include "Viraqucha.h"
+
 #include "UmlDiagram.h"
 
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QScrollBar>
+
 //#define _USE_OPENGL
 #ifdef _USE_OPENGL
 #include <QOpenGLWidget>
@@ -46,7 +53,8 @@
  * @ingroup ViraquchaUML
  *
  * The DiagramPage class manages the DiagramScene object which draws all elements associated with a UmlDiagram object.
- * It also provides slots needed for handling context menu events of the DiagramScene.
+ * It also provides slots needed for handling context menu events of the DiagramScene. The scene is shown by a
+ * DiagramView, which can draw a performance HUD over the diagram (see setHudVisible()).
  */
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -88,6 +96,15 @@ DiagramPage::DiagramPage(UmlDiagram* diagram, const QModelIndex& index, QWidget*
 #ifdef _USE_OPENGL
    ui.graphicsView->setViewport(new QOpenGLWidget());
 #endif
+
+   // Virtualized scenes need to know which part of them is visible:
+   auto* hbar = ui.graphicsView->horizontalScrollBar();
+   auto* vbar = ui.graphicsView->verticalScrollBar();
+   connect(hbar, &QScrollBar::valueChanged, this, &DiagramPage::updateVisibleArea);
+   connect(vbar, &QScrollBar::valueChanged, this, &DiagramPage::updateVisibleArea);
+   connect(hbar, &QScrollBar::rangeChanged, this, &DiagramPage::updateVisibleArea);
+   connect(vbar, &QScrollBar::rangeChanged, this, &DiagramPage::updateVisibleArea);
+   updateVisibleArea();
 }
 
 DiagramPage::~DiagramPage()
@@ -111,6 +128,18 @@ DiagramScene* DiagramPage::scene() const
    return _scene;
 }
 
+/** Gets a value indicating whether the performance HUD is shown over the diagram. */
+bool DiagramPage::isHudVisible() const
+{
+   return ui.graphicsView->isHudVisible();
+}
+
+/** Shows or hides the performance HUD over the diagram (see class DiagramView). */
+void DiagramPage::setHudVisible(bool value)
+{
+   ui.graphicsView->setHudVisible(value);
+}
+
 /** 
  * Captures an image of the complete diagram scene (including all elements). 
  * 
@@ -120,6 +149,10 @@ DiagramScene* DiagramPage::scene() const
  */
 QImage* DiagramPage::captureImage()
 {
+   // The image shall contain all shapes, not only the visible ones:
+   bool virtualized = _scene->isVirtualized();
+   _scene->setVirtualized(false);
+
    QRectF source = _scene->itemsBoundingRect();
    source += QMarginsF(10.0, 10.0, 10.0, 10.0);
    
@@ -130,9 +163,42 @@ QImage* DiagramPage::captureImage()
    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
    _scene->setBackgroundBrush(brush);
    _scene->render(&painter, QRectF(), source, Qt::KeepAspectRatio);
+   _scene->setVirtualized(virtualized);
    return image;
 }
 
+/**
+ * Saves the performance measurements of the view to a file.
+ *
+ * The file contains the snapshot of the DiagramView (see DiagramView::snapshot()) decorated with the name of the
+ * diagram and the program version, so it can be attached to a report about a slow diagram.
+ * @param filename Name of the file including path.
+ * @returns True, if the file was written; otherwise false.
+ */
+bool DiagramPage::savePerformanceSnapshot(const QString& filename)
+{
+   QJsonObject snapshot = ui.graphicsView->snapshot();
+   snapshot["diagram"] = _diagram->name();
+   snapshot["version"] = Viraqucha::KProgramVersion.toString();
+
+   QSaveFile file(filename);
+   if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) return false;
+
+   file.write(QJsonDocument(snapshot).toJson());
+   return file.commit();
+}
+
+/**
+ * Handles resize events: updates the visible area of the scene.
+ *
+ * @param event The event to be handled.
+ */
+void DiagramPage::resizeEvent(QResizeEvent* event)
+{
+   super::resizeEvent(event);
+   updateVisibleArea();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 // Slots
 //---------------------------------------------------------------------------------------------------------------------
@@ -189,7 +255,10 @@ void DiagramPage::editElementProperties()
       Q_ASSERT(shape != nullptr);
       
       PropertiesDialog dialog(this, *model, shape->element());
-      dialog.exec();
+      if (dialog.exec() == QDialog::Accepted)
+      {
+         _scene->refresh(shape->element());
+      }
    }
 }
 
@@ -216,7 +285,9 @@ void DiagramPage::deleteFromDiagram()
          auto edges = shape->diaShape()->edges();
          foreach (DiaEdge* edge, edges)
          {
+            // Edges outside of the visible area of a virtualized scene have no shape:
             auto victim = static_cast<QGraphicsItem*>(edge->itemData());
+            if (victim == nullptr) continue;
             _scene->removeItem(victim);
             delete victim;
          }
@@ -232,3 +303,15 @@ void DiagramPage::deleteFromDiagram()
 void DiagramPage::deleteFromModel()
 {
 }
+
+/**
+ * Passes the area of the scene currently shown by the graphics view to the DiagramScene object.
+ *
+ * Called whenever the view was scrolled or resized.
+ */
+void DiagramPage::updateVisibleArea()
+{
+   QRect viewRect = ui.graphicsView->viewport()->rect();
+   _scene->setVisibleArea(ui.graphicsView->mapToScene(viewRect).boundingRect());
+}
+
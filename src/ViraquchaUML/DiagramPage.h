@@ -35,6 +35,7 @@
 #include <QMenu>
 #include <QModelIndex>
 #include <QPersistentModelIndex>
+#include <QResizeEvent>
 
 class UmlDiagram;
 class UmlElement;
@@ -55,12 +56,19 @@ public: // Properties
    UmlDiagram* diagram() const;
    DiagramScene* scene() const;
 
+   bool isHudVisible() const;
+   void setHudVisible(bool value);
+
 public: // Methods
    QImage* captureImage();
+   bool savePerformanceSnapshot(const QString& filename);
    
 signals: 
    void projectModified(const QModelIndex& index, UmlElement* element);
 
+protected:
+   void resizeEvent(QResizeEvent* event) override;
+
 public slots:
    void startInsert(int id, QString className);
    void updateProject(UmlElement* element);
@@ -70,6 +78,7 @@ private slots:
    void editShapeProperties();
    void deleteFromDiagram();
    void deleteFromModel();
+   void updateVisibleArea();
    
 private: // Attributes
    ///@cond
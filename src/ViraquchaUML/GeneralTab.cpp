@@ -26,6 +26,7 @@
 // See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
 //---------------------------------------------------------------------------------------------------------------------
 #include "GeneralTab.h"
+#include "ProjectTreeModel.h"
 #include "StringProvider.h"
 
 #include "UmlElement.h"
@@ -57,9 +58,11 @@
  *
  * @param parent Parent widget.
  * @param elem UmlElement object to be edited.
+ * @param model ProjectTreeModel object needed for renaming the element.
  */
-GeneralTab::GeneralTab(QWidget* parent, UmlElement* elem)
+GeneralTab::GeneralTab(QWidget* parent, UmlElement* elem, ProjectTreeModel& model)
 : super(parent)
+, _model(model)
 , _element(elem)
 , _named(dynamic_cast<INamedElement*>(elem))
 , _stereotyped(dynamic_cast<IStereotypedElement*>(elem))
@@ -97,7 +100,15 @@ bool GeneralTab::validateInput()
  */
 void GeneralTab::applyChanges()
 {
-   _named->setName(ui.nameEdit->text());
+   if (_element->project() != nullptr)
+   {
+      // Renaming through the model also renames type references and can be undone:
+      _model.rename(_element, ui.nameEdit->text());
+   }
+   else
+   {
+      _named->setName(ui.nameEdit->text());
+   }
    _named->setComment(ui.commentEdit->toPlainText());
    _named->setVisibility((VisibilityKind)(ui.visibCombo->currentIndex() + 1));
    if (_stereotyped != nullptr)
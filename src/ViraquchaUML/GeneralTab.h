@@ -29,6 +29,7 @@
 #include "ui_GeneralTab.h"
 #include "IPropertiesTab.h"
 
+class ProjectTreeModel;
 class UmlElement;
 class INamedElement;
 class IStereotypedElement;
@@ -40,7 +41,7 @@ class GeneralTab : public QWidget, public IPropertiesTab
    typedef QWidget super;
    ///@endcond
 public: // Constructors
-   GeneralTab(QWidget* parent, UmlElement* elem);
+   GeneralTab(QWidget* parent, UmlElement* elem, ProjectTreeModel& model);
    virtual ~GeneralTab();
 
 public: // Methods
@@ -53,6 +54,7 @@ private:
 private: // Attributes
    ///@cond
    Ui::GeneralTab ui;
+   ProjectTreeModel&    _model;
    UmlElement*          _element;
    INamedElement*       _named;
    IStereotypedElement* _stereotyped;
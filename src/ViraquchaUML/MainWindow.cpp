@@ -29,16 +29,29 @@
 
 #include "DiagramPage.h"
 #include "DiagramScene.h"
+#include "DiagramLayout.h"
+#include "DiagnosticsDialog.h"
+#include "ReviewDialog.h"
+#include "OverviewGenerator.h"
 #include "StartPage.h"
+#include "MemoryReport.h"
+#include "Tracer.h"
 #include "MessageBox.h"
 #include "NewDiagramDialog.h"
 #include "NewProjectDialog.h"
+#include "ProjectDiff.h"
 #include "ProjectTreeModel.h"
 #include "PropertiesDialog.h"
+#include "RenameCommand.h"
+#include "Shape.h"
+#include "Validator.h"
 #include "Viraqucha.h"
+#include "XmiExporter.h"
+#include "XmiImporter.h"
 
 #include "UmlDiagram.h"
 #include "UmlClass.h"
+#include "UmlCompositeElement.h"
 #include "UmlModel.h"
 #include "UmlRoot.h"
 
@@ -48,9 +61,11 @@
 #include <QDesktopWidget>
 #include <QDockWidget>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QMessageBox>
 #include <QScopedPointer>
 #include <QSettings>
+#include <QStyle>
 
 /**
  * @class MainWindow
@@ -63,12 +78,21 @@
  * - the project tree dock on the left side of the window,
  * - the toolbox and properties dock on the right side of the window,
  * - the central widget where the diagrams are shown and
- * - an output dock (not yet implemented) at the bottom of the window.
+ * - the problems dock at the bottom of the window.
  * 
  * The MainWindow class manages all these docks as well as the main menu and the status bar at the bottom of the
  * window. It also creates the main menu commands, the toolbox buttons and the project tree model.
+ *
+ * The problems dock lists the issues found by validating the project (see class Validator). The project is validated
+ * shortly after each modification made through the project tree model or the properties dialog; only the elements 
+ * modified are checked again.
  */
 
+/// @cond
+static const int KValidationDelay = 500; // Milliseconds between the last modification and validating the project
+static const int KAutosaveInterval = 60000; // Milliseconds between two autosaves of the project
+/// @endcond
+
 //---------------------------------------------------------------------------------------------------------------------
 // Construction
 //---------------------------------------------------------------------------------------------------------------------
@@ -82,6 +106,9 @@ MainWindow::MainWindow(QWidget *parent)
 : super(parent)
 , _project(nullptr)
 , _startPage(nullptr)
+, _validator(nullptr)
+, _shapeCache(false)
+, _overview(false)
 {
    ui.setupUi(this);
 
@@ -89,6 +116,7 @@ MainWindow::MainWindow(QWidget *parent)
    _progressBar->setRange(0, 100);
    statusBar()->addPermanentWidget(_progressBar);
 
+   createProblemDock();
    readSettings();
    connectAppMenu();
    connectProjectMenu();
@@ -100,6 +128,10 @@ MainWindow::MainWindow(QWidget *parent)
 
    createToolBox();
    connect(ui.centralWidget, &QTabWidget::tabCloseRequested, this, &MainWindow::closeDiagram);
+
+   _autosaveTimer.setInterval(KAutosaveInterval);
+   connect(&_autosaveTimer, &QTimer::timeout, this, &MainWindow::autosaveProject);
+   _autosaveTimer.start();
    enableActions();
 }
 
@@ -164,6 +196,7 @@ void MainWindow::loadProject(QString filename)
    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
    destroyProject();
    _project = new UmlProject();
+   _project->isTransactional(true);
 
    _progressBar->reset();
    connect(_project, &UmlProject::updateProgress, _progressBar, &QProgressBar::setValue);
@@ -173,9 +206,23 @@ void MainWindow::loadProject(QString filename)
    
    if (success)
    {
-      ui.projTreeView->setModel(new ProjectTreeModel(_project->root()));
+      createTreeModel();
       setFileName(filename);
-      setWindowModified(false);
+      setWindowModified(_project->isModified());
+
+      if (_project->recoveredCount() > 0)
+      {
+         MessageBox::info(
+            this, 
+            tr("The project contains changes which have not been saved before the program ended. The changes have "
+               "been restored."),
+            tr("Save the project to keep the changes or close it without saving to drop them."));
+      }
+
+      if (!_project->openJournal())
+      {
+         MessageBox::warning(this, Viraqucha::KProgramName, _project->errorString());
+      }
    }
    else
    {
@@ -209,6 +256,8 @@ void MainWindow::closeEvent(QCloseEvent* event)
 void MainWindow::connectAppMenu()
 {
    connect(ui.actionAbout, &QAction::triggered, this, &MainWindow::about);
+   connect(ui.actionRecordTrace, &QAction::toggled, this, &MainWindow::recordTrace);
+   connect(ui.actionMemoryReport, &QAction::triggered, this, &MainWindow::showMemoryReport);
 }
 
 /** Connects the project menu with the main window command handlers. */
@@ -217,6 +266,10 @@ void MainWindow::connectProjectMenu()
    connect(ui.actionNew, &QAction::triggered, this, &MainWindow::newProject);
    connect(ui.actionOpen, &QAction::triggered, this, &MainWindow::openProject);
    connect(ui.actionClose, &QAction::triggered, this, &MainWindow::closeProject);
+   connect(ui.actionReload, &QAction::triggered, this, &MainWindow::reloadProject);
+   connect(ui.actionReviewChanges, &QAction::triggered, this, &MainWindow::reviewChanges);
+   connect(ui.actionImport, &QAction::triggered, this, &MainWindow::importXmi);
+   connect(ui.actionExport, &QAction::triggered, this, &MainWindow::exportXmi);
    connect(ui.actionSave, &QAction::triggered, this, &MainWindow::saveProject);
    connect(ui.actionSaveAs, &QAction::triggered, this, &MainWindow::saveProjectAs);
    connect(ui.menuProject, &QMenu::aboutToShow, this, &MainWindow::enableProjectActions);
@@ -256,8 +309,11 @@ void MainWindow::connectElementMenu()
 void MainWindow::connectDiagramMenu()
 {
    connect(ui.actionOpenDiagram, &QAction::triggered, this, &MainWindow::openDiagram);
+   connect(ui.actionAutoLayout, &QAction::triggered, this, &MainWindow::layoutDiagram);
    connect(ui.actionSaveToClipboard, &QAction::triggered, this, &MainWindow::saveImageToClipboard);
    connect(ui.actionSaveToFile, &QAction::triggered, this, &MainWindow::saveImageToFile);
+   connect(ui.actionShowHud, &QAction::toggled, this, &MainWindow::showPerformanceHud);
+   connect(ui.actionSaveSnapshot, &QAction::triggered, this, &MainWindow::savePerformanceSnapshot);
    connect(ui.menuDiagram, &QMenu::aboutToShow, this, &MainWindow::enableDiagramActions);
 }
 
@@ -317,6 +373,31 @@ void MainWindow::createToolBox()
    _manager->addButton(id++, tr("Usage"), "UmlDependency::Usage");
 }
 
+/**
+ * Creates the problems dock.
+ *
+ * The problems dock - by default located at the bottom of the main window - lists the issues found by validating the
+ * project. Double clicking an issue selects the element concerned in the project tree.
+ */
+void MainWindow::createProblemDock()
+{
+   _problemList = new QTreeWidget();
+   _problemList->setColumnCount(3);
+   _problemList->setHeaderLabels(QStringList() << tr("Description") << tr("Element") << tr("Rule"));
+   _problemList->setRootIsDecorated(false);
+   connect(_problemList, &QTreeWidget::itemDoubleClicked, this, &MainWindow::showProblem);
+
+   auto* dock = new QDockWidget(tr("Problems"), this);
+   dock->setObjectName("problemDock");
+   dock->setWidget(_problemList);
+   addDockWidget(Qt::BottomDockWidgetArea, dock);
+   ui.menuWindows->addAction(dock->toggleViewAction());
+
+   _validationTimer.setSingleShot(true);
+   _validationTimer.setInterval(KValidationDelay);
+   connect(&_validationTimer, &QTimer::timeout, this, &MainWindow::validateProject);
+}
+
 /** 
  * Shows the start page of the program. 
  * 
@@ -345,6 +426,9 @@ void MainWindow::writeSettings()
    settings.setValue("application/geometry", saveGeometry());
    settings.setValue("application/startPage", ui.actionStartPage->isChecked());
    settings.setValue("projects/recent", _mruList);
+   settings.setValue("diagram/shapeCache", _shapeCache);
+   settings.setValue("diagram/cacheLimit", DiagramScene::cacheLimit());
+   settings.setValue("diagram/overview", _overview);
 }
 
 /** Reads window positions and sizes from a settings file. */
@@ -368,6 +452,13 @@ void MainWindow::readSettings()
    // Restore most recently used projects list:
    _mruList = settings.value("projects/recent").toStringList();
 
+   // Restore pixmap caching of diagram shapes (off by default, the limit is given in kilobytes):
+   _shapeCache = settings.value("diagram/shapeCache", false).toBool();
+   DiagramScene::setCacheLimit(settings.value("diagram/cacheLimit", DiagramScene::cacheLimit()).toInt());
+
+   // Restore generation of the overview diagram on saving (off by default):
+   _overview = settings.value("diagram/overview", false).toBool();
+
    // Restore start page if requested:
    ui.actionStartPage->setChecked(settings.value("application/startPage", true).toBool());
    showStartPage();   
@@ -399,13 +490,39 @@ bool MainWindow::maybeSave()
    return true;
 }
 
+/** Creates a new project tree model for the current project and connects it to the undo stack. */
+void MainWindow::createTreeModel()
+{
+   auto* model = new ProjectTreeModel(_project->root());
+   connect(model, &ProjectTreeModel::renamed, this, &MainWindow::recordRename);
+   connect(model, &ProjectTreeModel::referencesKept, this, &MainWindow::notifyReferencesKept);
+   connect(model, &QAbstractItemModel::dataChanged, this, &MainWindow::invalidateData);
+   connect(model, &QAbstractItemModel::rowsInserted, this, &MainWindow::invalidateRows);
+   connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &MainWindow::removeRows);
+   ui.projTreeView->setModel(model);
+
+   delete _validator;
+   _validator = new Validator(_project);
+   _validator->addDefaultRules();
+   scheduleValidation();
+}
+
 /** Destroys the project and removes all diagram tabs from the main window. */
 void MainWindow::destroyProject()
 {
    if (_project != nullptr)
    {
+      // The changes have either been saved or are discarded by the user:
+      _project->closeJournal(true);
+
       ui.projTreeView->setModel(nullptr);
+      _undoStack.clear();
       setFileName("");
+
+      _validationTimer.stop();
+      _problemList->clear();
+      delete _validator;
+      _validator = nullptr;
       
       // Close and delete all diagram tabs first:
       QList<QWidget*> tabs;
@@ -450,6 +567,59 @@ int MainWindow::findPageIndex(UmlDiagram* diagram) const
    return -1;
 }
 
+/** Records the shapes of all diagrams shown in pages with the next autosave of the project. */
+void MainWindow::markOpenDiagrams()
+{
+   for (int index = 0; index < ui.centralWidget->count(); ++index)
+   {
+      auto* page = dynamic_cast<DiagramPage*>(ui.centralWidget->widget(index));
+      if (page != nullptr) _project->markShapesModified(page->diagram());
+   }
+}
+
+/**
+ * Refreshes the overview diagram of the project, if enabled in the settings (see class OverviewGenerator).
+ *
+ * The shapes of the overview diagram are rebuilt if it is open, the project tree is rebuilt if the diagram was created.
+ */
+void MainWindow::updateOverview()
+{
+   if (!_overview || _project == nullptr) return;
+
+   OverviewGenerator generator(_project);
+   DiagramPage* page = nullptr;
+   int index = findPageIndex(generator.find());
+   if (index >= 0)
+   {
+      page = dynamic_cast<DiagramPage*>(ui.centralWidget->widget(index));
+      page->scene()->releaseShapes();
+   }
+
+   if (!generator.generate())
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, generator.errorString());
+   }
+
+   if (page != nullptr) page->scene()->rebuild();
+   if (generator.isCreated()) createTreeModel();
+}
+
+/**
+ * Refreshes the shapes of a changed element in all open diagrams.
+ *
+ * Shapes only repaint what they computed on the last refresh (and may even be cached in pixmaps), so every change of
+ * an element must be announced to the diagrams.
+ * @param elem The changed UmlElement object.
+ */
+void MainWindow::refreshDiagrams(UmlElement* elem)
+{
+   for (int index = 0; index < ui.centralWidget->count(); ++index)
+   {
+      auto* page = dynamic_cast<DiagramPage*>(ui.centralWidget->widget(index));
+      if (page != nullptr) page->scene()->refresh(elem);
+   }
+}
+
 /** 
  * Updates the list of most recently used files. 
  * 
@@ -482,6 +652,77 @@ void MainWindow::about()
 void MainWindow::preferences()
 {}
 
+/**
+ * Starts or stops recording a performance trace.
+ *
+ * When stopped, the trace is saved to a file chosen by the user. The file can be opened with chrome://tracing or
+ * https://ui.perfetto.dev.
+ * @param checked True, if recording shall be started; false, if it shall be stopped.
+ */
+void MainWindow::recordTrace(bool checked)
+{
+   if (checked)
+   {
+      Tracer::clear();
+      Tracer::setEnabled(true);
+      return;
+   }
+
+   Tracer::setEnabled(false);
+   auto filename = QFileDialog::getSaveFileName(
+      this,
+      tr("Save Trace"),
+      QString(),
+      "JSON - Trace Event Format (.json)(*.json)");
+   if (filename.isEmpty()) return;
+
+   if (!Tracer::write(filename))
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, Tracer::errorString());
+   }
+}
+
+/**
+ * Shows the estimated memory used by the project, the scenes of the open diagrams and the undo stack.
+ *
+ * The elements of the project are listed by class name, see MemoryReport. Scenes, the text sizes remembered by the
+ * shapes and the commands of the undo stack are listed as separate entries.
+ */
+void MainWindow::showMemoryReport()
+{
+   MemoryReport report;
+   report.addProject(_project);
+
+   MemoryUsage scenes;
+   int sceneCount = 0;
+   for (int index = 0; index < ui.centralWidget->count(); ++index)
+   {
+      auto* page = dynamic_cast<DiagramPage*>(ui.centralWidget->widget(index));
+      if (page == nullptr) continue;
+      page->scene()->measure(scenes);
+      sceneCount++;
+   }
+
+   if (sceneCount > 0) report.add("DiagramScene", sceneCount, scenes);
+
+   MemoryUsage texts;
+   Shape::measureTextCache(texts);
+   report.add("TextCache", 1, texts);
+
+   MemoryUsage commands;
+   for (int index = 0; index < _undoStack.count(); ++index)
+   {
+      auto* command = dynamic_cast<const UndoCommand*>(_undoStack.command(index));
+      if (command != nullptr) command->measure(commands);
+   }
+
+   if (_undoStack.count() > 0) report.add("UndoCommand", _undoStack.count(), commands);
+
+   QScopedPointer<DiagnosticsDialog> dialog(new DiagnosticsDialog(this));
+   dialog->showReport(report);
+   dialog->exec();
+}
+
 /** Creates a new project using a default template. */
 void MainWindow::newProject()
 {
@@ -491,7 +732,8 @@ void MainWindow::newProject()
       destroyProject();
 
       _project = new UmlProject();
-      _project->create(dialog->location(), dialog->name());
+      _project->isTransactional(true);
+         _project->create(dialog->location(), dialog->name());
       setFileName(dialog->location() + "/" + dialog->name() + "/" + dialog->name() + ".uprj");
       
       auto* model = new UmlModel();
@@ -509,7 +751,7 @@ void MainWindow::newProject()
       _project->insert(dia);
       pkg->insert(0, dia);
 
-      ui.projTreeView->setModel(new ProjectTreeModel(_project->root()));
+      createTreeModel();
       _project->isModified(true);
    }
 }
@@ -527,14 +769,34 @@ void MainWindow::openProject()
    }
 }
 
-/** Saves the currently opened project. */
+/** 
+ * Saves the currently opened project.
+ *
+ * Writes the files changed (see UmlProject::save()) and starts recording the changes in a journal for autosave.
+ * Folding the journal by UmlProject::compact() is not used here, since it only writes the changes reported to the
+ * project.
+ */
 bool MainWindow::saveProject()
 {
    if (_project != nullptr)
    {
-      _project->save(_fileName);
+      updateOverview();
+      markOpenDiagrams();
+
+      if (!_project->save(_fileName))
+      {
+         MessageBox::error(this, Viraqucha::KProgramName, _project->errorString());
+         return false;
+      }
+
+      if (!_project->isJournaling() && !_project->openJournal())
+      {
+         MessageBox::warning(this, Viraqucha::KProgramName, _project->errorString());
+      }
+
       setWindowModified(false);
       updateMRUList(_fileName, true);
+      scheduleValidation();
    }
    
    return true;
@@ -546,6 +808,189 @@ bool MainWindow::saveProjectAs()
    return false;
 }
 
+/** 
+ * Writes the changes of the project to its journal, see UmlProject::autosave(). 
+ *
+ * Called periodically by a timer. Does nothing if the project has not been saved yet.
+ */
+void MainWindow::autosaveProject()
+{
+   if (_project == nullptr || !_project->isJournaling()) return;
+
+   markOpenDiagrams();
+   if (!_project->autosave())
+   {
+      statusBar()->showMessage(tr("Autosave failed: %1").arg(_project->errorString()));
+   }
+}
+
+/**
+ * Reads the files of the project changed outside of the program again, e.g. by a pull of a version control system.
+ *
+ * Only the files changed are read (see UmlProject::reload()). Open diagrams stay open and their scenes are rebuilt,
+ * pages of diagrams removed from the project are closed. The undo stack is cleared, since its commands may refer to
+ * elements removed.
+ */
+void MainWindow::reloadProject()
+{
+   if (_project == nullptr) return;
+   if (_project->isModified())
+   {
+      MessageBox::warning(this, Viraqucha::KProgramName,
+         tr("The project has been modified. Save the changes before reloading the project."));
+      return;
+   }
+
+   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   _validationTimer.stop();
+   _undoStack.clear();
+   ui.projTreeView->setModel(nullptr);
+
+   // Shapes refer to the nodes and edges of the diagrams, which may be replaced:
+   for (int index = 0; index < ui.centralWidget->count(); ++index)
+   {
+      auto* page = dynamic_cast<DiagramPage*>(ui.centralWidget->widget(index));
+      if (page != nullptr) page->scene()->releaseShapes();
+   }
+
+   int changes = 0;
+   auto connection = connect(_project, &UmlProject::elementReloaded, this,
+      [this, &changes](UmlElement* element, bool removed)
+      {
+         auto* diagram = dynamic_cast<UmlDiagram*>(element);
+         if (removed && diagram != nullptr) closeDiagram(findPageIndex(diagram));
+         ++changes;
+      });
+
+   bool success = _project->reload();
+   disconnect(connection);
+
+   for (int index = 0; index < ui.centralWidget->count(); ++index)
+   {
+      auto* page = dynamic_cast<DiagramPage*>(ui.centralWidget->widget(index));
+      if (page != nullptr) page->scene()->rebuild();
+   }
+
+   createTreeModel();
+   QApplication::restoreOverrideCursor();
+
+   if (success)
+   {
+      statusBar()->showMessage(tr("%1 element(s) reloaded").arg(changes));
+   }
+   else
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, _project->errorString());
+   }
+
+   enableActions();
+}
+
+/**
+ * Shows the elements changed since the project was saved the last time.
+ *
+ * The project in memory is compared with its saved files by a ProjectDiff, so the review lists the same changes a
+ * comparison of the files would list after saving.
+ */
+void MainWindow::reviewChanges()
+{
+   if (_project == nullptr) return;
+   if (!QFileInfo::exists(_fileName))
+   {
+      MessageBox::info(this, Viraqucha::KProgramName, tr("The project has not been saved yet."));
+      return;
+   }
+
+   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   ProjectDiff diff;
+   bool success = diff.compare(_fileName, _project);
+   QApplication::restoreOverrideCursor();
+   if (!success)
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, diff.errorString());
+      return;
+   }
+
+   QScopedPointer<ReviewDialog> dialog(new ReviewDialog(this));
+   dialog->showChanges(diff, _project);
+   dialog->exec();
+}
+
+/**
+ * Imports the packages and classifiers of an XMI file into the currently opened project.
+ *
+ * If no project is opened, a new project is created first. The import cannot be undone, therefore the undo stack is
+ * cleared.
+ */
+void MainWindow::importXmi()
+{
+   if (_project == nullptr) newProject();
+   if (_project == nullptr) return;
+
+   auto filename = QFileDialog::getOpenFileName(
+      this,
+      tr("Import XMI"),
+      QString(),
+      tr("XMI files (*.xmi);;All files (*.*)"));
+   if (filename.isEmpty()) return;
+
+   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   _undoStack.clear();
+   ui.projTreeView->setModel(nullptr);
+
+   XmiImporter importer(_project);
+   bool success = importer.read(filename);
+
+   createTreeModel();
+   QApplication::restoreOverrideCursor();
+
+   if (importer.importedCount() > 0)
+   {
+      // The root received the models read, its file lists them:
+      _project->markModified(_project->root());
+      setWindowModified(true);
+   }
+
+   if (success)
+   {
+      statusBar()->showMessage(tr("%1 element(s) imported, %2 skipped")
+         .arg(importer.importedCount()).arg(importer.skippedCount()));
+   }
+   else
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, importer.errorString());
+   }
+
+   enableActions();
+}
+
+/** Exports the currently opened project to an XMI file. */
+void MainWindow::exportXmi()
+{
+   if (_project == nullptr) return;
+
+   auto filename = QFileDialog::getSaveFileName(
+      this,
+      tr("Export XMI"),
+      QString(),
+      tr("XMI files (*.xmi);;All files (*.*)"));
+   if (filename.isEmpty()) return;
+
+   QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+   XmiExporter exporter(_project);
+   bool success = exporter.write(filename);
+   QApplication::restoreOverrideCursor();
+
+   if (success)
+   {
+      statusBar()->showMessage(tr("%1 element(s) exported").arg(exporter.exportedCount()));
+   }
+   else
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, exporter.errorString());
+   }
+}
+
 /** Closes the currently opened project. */
 void MainWindow::closeProject()
 {
@@ -629,8 +1074,20 @@ void MainWindow::editProperties()
       QScopedPointer<PropertiesDialog> dialog(new PropertiesDialog(this, *treeModel(), treeModel()->getElement(index)));
       if (dialog->exec() == QDialog::Accepted)
       {
-         _project->isModified(true);
+         // The dialog may change the element and its features, e.g. attributes:
+         auto* element = treeModel()->getElement(index);
+         _project->markModified(element);
+         auto* composite = dynamic_cast<UmlCompositeElement*>(element);
+         if (composite != nullptr)
+         {
+            for (auto* child : composite->elements()) _project->markModified(child);
+         }
+
          setWindowModified(true);
+
+         _validator->invalidate(treeModel()->getElement(index), true);
+         scheduleValidation();
+         refreshDiagrams(treeModel()->getElement(index));
       }
    }
 }
@@ -743,6 +1200,8 @@ void MainWindow::openDiagram()
       connect(_manager, &ToolBoxManager::buttonClicked, page, &DiagramPage::startInsert);
       connect(page, &DiagramPage::projectModified, this, &MainWindow::updateModel);
       connect(page->scene(), &DiagramScene::insertAborted, _manager, &ToolBoxManager::resetButton);
+      page->scene()->setCaching(_shapeCache);
+      page->setHudVisible(ui.actionShowHud->isChecked());
 
       ui.centralWidget->addTab(page, diagram->name());
       ui.centralWidget->setCurrentIndex(ui.centralWidget->count() - 1);
@@ -766,11 +1225,41 @@ void MainWindow::closeDiagram(int index)
          return;
       }
       
+      // The diagram stays open in the project, so its shapes are saved even if the page is closed:
+      auto* page = dynamic_cast<DiagramPage*>(widget);
+      if (page != nullptr && _project != nullptr) _project->markShapesModified(page->diagram());
+
       ui.centralWidget->removeTab(index);
       delete widget;
    }
 }
 
+/**
+ * Arranges the shapes of the current diagram automatically.
+ *
+ * Class diagrams are arranged following their class hierarchy, all other diagrams by forces.
+ */
+void MainWindow::layoutDiagram()
+{
+   auto* widget = ui.centralWidget->currentWidget();
+   if (widget->objectName() == "DiagramPage")
+   {
+      auto* page = dynamic_cast<DiagramPage*>(widget);
+      Q_ASSERT(page != nullptr);
+
+      QScopedPointer<DiagramLayout> layout(DiagramLayout::create(DiagramLayout::defaultName(page->diagram()->kind())));
+      if (!layout->layout(page->diagram()))
+      {
+         MessageBox::error(this, Viraqucha::KProgramName, layout->errorString());
+         return;
+      }
+
+      page->scene()->rebuild();
+      _project->markModified(page->diagram());
+      setWindowModified(true);
+   }
+}
+
 /**
  * Saves an image of the current diagram to the clipboard.
  */
@@ -829,6 +1318,45 @@ void MainWindow::saveImageToFile()
    }
 }
 
+/**
+ * Shows or hides the performance HUD in all open diagrams and in diagrams opened later.
+ *
+ * @param checked True, if the HUD shall be shown; otherwise false.
+ */
+void MainWindow::showPerformanceHud(bool checked)
+{
+   for (int index = 0; index < ui.centralWidget->count(); ++index)
+   {
+      auto* page = dynamic_cast<DiagramPage*>(ui.centralWidget->widget(index));
+      if (page != nullptr) page->setHudVisible(checked);
+   }
+}
+
+/**
+ * Saves a snapshot of the performance measurements of the current diagram to a file.
+ */
+void MainWindow::savePerformanceSnapshot()
+{
+   auto* widget = ui.centralWidget->currentWidget();
+   if (widget->objectName() == "DiagramPage")
+   {
+      auto* page = dynamic_cast<DiagramPage*>(widget);
+      Q_ASSERT(page != nullptr);
+
+      auto filename = QFileDialog::getSaveFileName(
+         this,
+         tr("Save Performance Snapshot"),
+         QString(),
+         "JSON - JavaScript Object Notation (.json)(*.json)");
+      if (filename.isEmpty()) return;
+
+      if (!page->savePerformanceSnapshot(filename))
+      {
+         MessageBox::error(this, Viraqucha::KProgramName, tr("The performance snapshot could not be saved."));
+      }
+   }
+}
+
 /** Shows the context menu of the project tree view. */
 void MainWindow::showTreeContextMenu(const QPoint& pos)
 {
@@ -906,6 +1434,8 @@ void MainWindow::enableProjectActions()
    ui.actionSave->setEnabled(hasProject);
    ui.actionSaveAs->setEnabled(hasProject);
    ui.actionClose->setEnabled(hasProject);
+   ui.actionReload->setEnabled(hasProject);
+   ui.actionReviewChanges->setEnabled(hasProject);
    ui.actionExport->setEnabled(hasProject);
    ui.actionSettings->setEnabled(hasProject);
 }
@@ -981,6 +1511,7 @@ void MainWindow::enableDiagramActions()
       bool isDiagram = elem->className() == UmlDiagram::staticMetaObject.className();
       ui.actionOpenDiagram->setEnabled(isDiagram);
       ui.actionAlign->setEnabled(isDiagram);
+      ui.actionAutoLayout->setEnabled(isDiagram);
       ui.actionZoomIn->setEnabled(isDiagram);
       ui.actionZoomOut->setEnabled(isDiagram);
       ui.actionSaveToFile->setEnabled(isDiagram);
@@ -990,11 +1521,42 @@ void MainWindow::enableDiagramActions()
    {
       ui.actionOpenDiagram->setEnabled(false);
       ui.actionAlign->setEnabled(false);
+      ui.actionAutoLayout->setEnabled(false);
       ui.actionZoomIn->setEnabled(false);
       ui.actionZoomOut->setEnabled(false);
       ui.actionSaveToFile->setEnabled(false);
       ui.actionSaveToClipboard->setEnabled(false);
    }
+
+   // Snapshots are taken from the diagram shown, not the one selected in the tree:
+   auto* widget = ui.centralWidget->currentWidget();
+   ui.actionSaveSnapshot->setEnabled(widget != nullptr && widget->objectName() == "DiagramPage");
+}
+
+/** 
+ * Records the renaming of an element in the project tree model on the undo stack. 
+ *
+ * The renaming is already applied, see ProjectTreeModel::rename().
+ */
+void MainWindow::recordRename(UmlElement* element, QString oldName, QString newName, bool refactor)
+{
+   _undoStack.push(new RenameCommand(element, *treeModel(), oldName, newName, refactor));
+   setWindowModified(true);
+}
+
+/** 
+ * Tells the user that the references to a renamed type were not renamed, see ProjectTreeModel::rename().
+ *
+ * This happens if the new name is not a single identifier or already referenced, e.g. when a class is named after
+ * the type of attributes typed before it existed.
+ */
+void MainWindow::notifyReferencesKept(QString oldName, QString newName)
+{
+   MessageBox::info(
+      this,
+      tr("The type '%1' was renamed to '%2', but its references were not.").arg(oldName).arg(newName),
+      tr("References are renamed together with a type only if the new name is a single identifier that is not "
+         "referenced by any element yet. Elements still referencing '%1' keep that type.").arg(oldName));
 }
 
 /** Updates the project tree model. */
@@ -1007,3 +1569,108 @@ void MainWindow::updateModel(const QModelIndex& index, UmlElement* element)
       setWindowModified(true);
    }
 }
+
+/** Validates the project after a short delay, so several modifications in a row are validated together. */
+void MainWindow::scheduleValidation()
+{
+   if (_validator != nullptr)
+   {
+      _validationTimer.start();
+   }
+}
+
+/** Validates the modified elements of the project and shows the issues found in the problems dock. */
+void MainWindow::validateProject()
+{
+   if (_validator == nullptr) return;
+   _validator->validate();
+
+   _problemList->clear();
+   for (auto issue : _validator->issues())
+   {
+      auto* item = new QTreeWidgetItem(_problemList);
+      item->setText(0, issue.message());
+      item->setText(2, issue.rule());
+      item->setData(0, Qt::UserRole, issue.element());
+
+      switch (issue.severity())
+      {
+      case IssueSeverity::Error:
+         item->setIcon(0, style()->standardIcon(QStyle::SP_MessageBoxCritical));
+         break;
+      case IssueSeverity::Warning:
+         item->setIcon(0, style()->standardIcon(QStyle::SP_MessageBoxWarning));
+         break;
+      default:
+         item->setIcon(0, style()->standardIcon(QStyle::SP_MessageBoxInformation));
+         break;
+      }
+
+      UmlElement* elem = nullptr;
+      if (_project->find(issue.element(), &elem))
+      {
+         auto named = dynamic_cast<INamedElement*>(elem);
+         item->setText(1, named != nullptr ? named->name() : elem->className());
+      }
+   }
+
+   _problemList->resizeColumnToContents(0);
+}
+
+/** Marks elements as modified after their data has been changed in the project tree model. */
+void MainWindow::invalidateData(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+   if (_validator == nullptr) return;
+
+   for (int row = topLeft.row(); row <= bottomRight.row(); ++row)
+   {
+      auto* elem = treeModel()->getElement(topLeft.sibling(row, 0));
+      _validator->invalidate(elem);
+      refreshDiagrams(elem);
+   }
+
+   scheduleValidation();
+}
+
+/** Marks elements as modified after they have been inserted into the project tree model. */
+void MainWindow::invalidateRows(const QModelIndex& parent, int first, int last)
+{
+   if (_validator == nullptr) return;
+
+   for (int row = first; row <= last; ++row)
+   {
+      _validator->invalidate(treeModel()->getElement(treeModel()->index(row, 0, parent)), true);
+   }
+
+   scheduleValidation();
+}
+
+/** Removes elements from the validator before they are removed from the project tree model. */
+void MainWindow::removeRows(const QModelIndex& parent, int first, int last)
+{
+   if (_validator == nullptr) return;
+
+   for (int row = first; row <= last; ++row)
+   {
+      _validator->remove(treeModel()->getElement(treeModel()->index(row, 0, parent)));
+   }
+
+   scheduleValidation();
+}
+
+/** Selects the element concerned by an issue in the project tree. */
+void MainWindow::showProblem(QTreeWidgetItem* item)
+{
+   if (_project == nullptr || item == nullptr) return;
+
+   UmlElement* elem = nullptr;
+   if (_project->find(item->data(0, Qt::UserRole).toUuid(), &elem))
+   {
+      auto index = treeModel()->indexOf(elem);
+      if (index.isValid())
+      {
+         ui.projTreeView->setCurrentIndex(index);
+         ui.projTreeView->scrollTo(index);
+      }
+   }
+}
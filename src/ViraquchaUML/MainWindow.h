@@ -36,13 +36,17 @@
 #include <QListView>
 #include <QProgressBar>
 #include <QStringList>
+#include <QTimer>
 #include <QToolBar>
 #include <QTreeView>
+#include <QTreeWidget>
 #include <QUndoStack>
 
 class ProjectTreeModel;
 class StartPage;
 class UmlDiagram;
+class UmlElement;
+class Validator;
 
 class MainWindow : public QMainWindow
 {
@@ -77,13 +81,18 @@ private:
    void connectContextMenus();
    
    void createToolBox();
+   void createProblemDock();
 
    void writeSettings();
    void readSettings();
    bool maybeSave();
+   void createTreeModel();
    void destroyProject();
    
    int findPageIndex(UmlDiagram* diagram) const;
+   void refreshDiagrams(UmlElement* elem);
+   void markOpenDiagrams();
+   void updateOverview();
    void updateMRUList(QString filename, bool prepend);
 
 public slots:
@@ -91,6 +100,8 @@ public slots:
    void help();
    void about();
    void preferences();
+   void recordTrace(bool checked);
+   void showMemoryReport();
 
    // Menu "Project":
    void newProject();
@@ -98,6 +109,10 @@ public slots:
    bool saveProject();
    bool saveProjectAs();
    void closeProject();
+   void reloadProject();
+   void reviewChanges();
+   void importXmi();
+   void exportXmi();
 
    // Menu "Edit":
    void editUndo();
@@ -124,8 +139,11 @@ public slots:
    // Menu "Diagram":
    void openDiagram();
    void closeDiagram(int index);
+   void layoutDiagram();
    void saveImageToClipboard();
    void saveImageToFile();
+   void showPerformanceHud(bool checked);
+   void savePerformanceSnapshot();
 
    // Menu "Tools":
    // Menu "Windows":
@@ -141,6 +159,19 @@ public slots:
    void enableElementActions();
    void enableDiagramActions();
    void updateModel(const QModelIndex& index, UmlElement* element);
+   void recordRename(UmlElement* element, QString oldName, QString newName, bool refactor);
+   void notifyReferencesKept(QString oldName, QString newName);
+
+   // Validation
+   void scheduleValidation();
+   void validateProject();
+   void invalidateData(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+   void invalidateRows(const QModelIndex& parent, int first, int last);
+   void removeRows(const QModelIndex& parent, int first, int last);
+   void showProblem(QTreeWidgetItem* item);
+
+   // Autosave
+   void autosaveProject();
 
 private: // Attributes
    ///@cond
@@ -152,5 +183,11 @@ private: // Attributes
    QStringList     _mruList;
    ToolBoxManager* _manager;
    StartPage*      _startPage;
+   Validator*      _validator;
+   QTimer          _validationTimer;
+   QTimer          _autosaveTimer;
+   QTreeWidget*    _problemList;
+   bool            _shapeCache;
+   bool            _overview;
    ///@endcond
 };
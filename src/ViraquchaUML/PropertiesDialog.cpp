@@ -84,7 +84,7 @@ PropertiesDialog::PropertiesDialog(QWidget* parent, ProjectTreeModel& model, Uml
    {
       // All other UML elements have several properties which must be 
       // distributed on several tabs:
-      addTab(new GeneralTab(this, elem), tr("General"));
+      addTab(new GeneralTab(this, elem, _model), tr("General"));
       if (elem->className() == UmlAttribute::staticMetaObject.className())
       { 
          createTabsFor(dynamic_cast<UmlAttribute*>(elem));
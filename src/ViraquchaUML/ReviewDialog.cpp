@@ -0,0 +1,178 @@
+//---------------------------------------------------------------------------------------------------------------------
+// ReviewDialog.cpp
+//
+// Copyright (C) 2026 Carsten Huber (Dipl.-Ing.)
+//
+// Description  : Implementation of class ReviewDialog.
+// Compiles with: MSVC 15.2 (2017) or newer, GNU GCC 5.1 or newer
+//
+// *******************************************************************************************************************
+// *                                                                                                                 *
+// * This file is part of ViraquchaUML.                                                                              *
+// *                                                                                                                 *
+// * ViraquchaUML is free software; you can redistribute it and/or modify it under the terms of the GNU General      *
+// * Public License as published by the Free Software Foundation; either version 3.0 of the License, or (at your     *
+// * option) any later version.                                                                                      *
+// *                                                                                                                 *
+// * ViraquchaUML is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the      *
+// * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License     *
+// * for more details.                                                                                               *
+// *                                                                                                                 *
+// * You should have received a copy of the GNU General Public License along with ViraquchaUML; if not, see          *
+// * http://www.gnu.org/licenses/gpl                                                                                 *
+// *                                                                                                                 *
+// *******************************************************************************************************************
+//
+// See https://github.com/CarstenH71/viraqucha_uml for the latest version of this software.
+//---------------------------------------------------------------------------------------------------------------------
+#include "ReviewDialog.h"
+#include "INamedElement.h"
+#include "JsonWriter.h"
+#include "MessageBox.h"
+#include "ProjectDiff.h"
+#include "UmlElement.h"
+#include "UmlProject.h"
+#include "Viraqucha.h"
+
+#include <QFile>
+#include <QFileDialog>
+#include <QJsonDocument>
+#include <QPushButton>
+
+/**
+ * @class ReviewDialog
+ * @brief Implements a dialog showing the changes of the current project not yet saved
+ * @since 0.2.0
+ * @ingroup ViraquchaUML
+ *
+ * The dialog lists the elements added, removed, modified or moved as found by a ProjectDiff, one row per element. The
+ * properties changed are listed below each element with their saved and their current value. The changes can be
+ * saved either as JSON or as plain text, depending on the file type chosen by the user.
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+// Internal functions
+//---------------------------------------------------------------------------------------------------------------------
+
+/** Gets the name of an owner to be shown, or its identifier if it is not part of the project anymore. */
+static QString describe(UmlProject* project, QUuid id)
+{
+   if (id.isNull()) return QString();
+
+   UmlElement* elem = nullptr;
+   auto* named = project->find(id, &elem) ? dynamic_cast<INamedElement*>(elem) : nullptr;
+   return named != nullptr && !named->name().isEmpty() ? named->name() : id.toString();
+}
+
+/** Converts a property value to text, undefined values to an empty string. */
+static QString format(const QJsonValue& value)
+{
+   if (value.isUndefined()) return QString();
+   if (value.isString()) return value.toString();
+
+   QByteArray text;
+   JsonWriter writer(&text);
+   writer.value(value);
+   return QString::fromUtf8(text);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Class implementation
+//---------------------------------------------------------------------------------------------------------------------
+
+/**
+ * Initializes a new object of the ReviewDialog class.
+ *
+ * @param parent Parent widget
+ */
+ReviewDialog::ReviewDialog(QWidget* parent)
+: super(parent)
+{
+   ui.setupUi(this);
+   connect(ui.buttonBox->button(QDialogButtonBox::Save), &QPushButton::clicked, this, &ReviewDialog::saveChanges);
+}
+
+ReviewDialog::~ReviewDialog()
+{
+}
+
+/**
+ * Shows the changes found by a comparison.
+ *
+ * @param diff ProjectDiff object that compared the saved files with the project.
+ * @param project Project compared, used to show the names of owners.
+ */
+void ReviewDialog::showChanges(const ProjectDiff& diff, UmlProject* project)
+{
+   ui.summaryLabel->setText(tr("%1 added, %2 removed, %3 modified and %4 moved of %5 elements.")
+      .arg(diff.count(ProjectDiff::ChangeKind::Added)).arg(diff.count(ProjectDiff::ChangeKind::Removed))
+      .arg(diff.count(ProjectDiff::ChangeKind::Modified)).arg(diff.count(ProjectDiff::ChangeKind::Moved))
+      .arg(diff.comparedCount()));
+
+   ui.treeWidget->clear();
+   for (auto& change : diff.changes())
+   {
+      QString name = change.name.isEmpty() ? change.identifier.toString() : change.name;
+      auto* item = new QTreeWidgetItem(ui.treeWidget);
+      item->setText(0, ProjectDiff::toString(change.kind));
+      item->setText(1, QString("%1 (%2)").arg(name).arg(change.className));
+      item->setToolTip(1, change.identifier.toString());
+
+      if (change.kind == ProjectDiff::ChangeKind::Added)
+      {
+         item->setText(3, tr("in %1").arg(describe(project, change.newOwner)));
+      }
+      else if (change.kind == ProjectDiff::ChangeKind::Removed)
+      {
+         item->setText(2, tr("in %1").arg(describe(project, change.oldOwner)));
+      }
+
+      if (change.isMoved)
+      {
+         auto* child = new QTreeWidgetItem(item);
+         child->setText(1, tr("Owner"));
+         child->setText(2, describe(project, change.oldOwner));
+         child->setText(3, describe(project, change.newOwner));
+      }
+
+      if (change.isLayoutChanged)
+      {
+         auto* child = new QTreeWidgetItem(item);
+         child->setText(1, tr("Shapes"));
+         child->setText(3, tr("changed"));
+      }
+
+      for (auto& property : change.properties)
+      {
+         auto* child = new QTreeWidgetItem(item);
+         child->setText(1, property.path);
+         child->setText(2, format(property.oldValue));
+         child->setText(3, format(property.newValue));
+      }
+   }
+
+   ui.treeWidget->expandAll();
+   for (int column = 0; column < ui.treeWidget->columnCount(); ++column) ui.treeWidget->resizeColumnToContents(column);
+   _json = diff.toJson();
+   _text = diff.toText();
+}
+
+/** Saves the changes shown to a JSON or text file chosen by the user. */
+void ReviewDialog::saveChanges()
+{
+   auto filename = QFileDialog::getSaveFileName(
+      this,
+      tr("Save Changes"),
+      QString(),
+      "JSON - JavaScript Object Notation (.json)(*.json);;Text (.txt)(*.txt)");
+   if (filename.isEmpty()) return;
+
+   bool isText = filename.endsWith(".txt", Qt::CaseInsensitive);
+   auto content = isText ? _text.toUtf8() : QJsonDocument(_json).toJson();
+
+   QFile file(filename);
+   if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size())
+   {
+      MessageBox::error(this, Viraqucha::KProgramName, tr("The changes could not be saved."));
+   }
+}
@@ -31,7 +31,7 @@ DESTDIR     = ../../bin
 CONFIG     += qt c++17
 DEPENDPATH += .
 
-QT          += widgets
+QT          += widgets concurrent
 MOC_DIR      = ./moc
 OBJECTS_DIR  = ./obj
 UI_DIR       = ./ui
@@ -43,6 +43,8 @@ include (../GuiDiagram/GuiDiagram.pri)
 include (../GuiProject/GuiProject.pri)
 include (../GuiResources/GuiResources.pri)
 include (../GuiUndoing/GuiUndoing.pri)
+include (../UmlLayout/UmlLayout.pri)
+include (../UmlValidation/UmlValidation.pri)
 include (../UmlCommon/UmlCommon.pri)
 include (../UmlClassifiers/UmlClassifiers.pri)
 
@@ -51,6 +53,7 @@ HEADERS += \
     AttributeTab.h \
     ClassifierTab.h \
     CommentTab.h \
+    DiagnosticsDialog.h \
     DiagramPage.h \
     GeneralTab.h \
     IPropertiesTab.h \
@@ -62,6 +65,7 @@ HEADERS += \
     OperationTab.h \
     ParameterTab.h \
     PropertiesDialog.h \
+    ReviewDialog.h \
     StartPage.h \
     TemplateParameterTab.h \
     ToolBoxManager.h
@@ -71,6 +75,7 @@ FORMS += \
     AttributeTab.ui \
     ClassifierTab.ui \
     CommentTab.ui \
+    DiagnosticsDialog.ui \
     DiagramPage.ui \
     GeneralTab.ui \
     MainWindow.ui \
@@ -81,6 +86,7 @@ FORMS += \
     OperationTab.ui \
     ParameterTab.ui \
     PropertiesDialog.ui \
+    ReviewDialog.ui \
     StartPage.ui \
     TemplateParameterTab.ui
 
@@ -89,6 +95,7 @@ SOURCES += \
     AttributeTab.cpp \
     ClassifierTab.cpp \
     CommentTab.cpp \
+    DiagnosticsDialog.cpp \
     DiagramPage.cpp \
     GeneralTab.cpp \
     main.cpp \
@@ -100,6 +107,7 @@ SOURCES += \
     OperationTab.cpp \
     ParameterTab.cpp \
     PropertiesDialog.cpp \
+    ReviewDialog.cpp \
     StartPage.cpp \
     TemplateParameterTab.cpp \
     ToolBoxManager.cpp
@@ -0,0 +1,126 @@
+/********************************************************************************
+** Form generated from reading UI file 'DiagnosticsDialog.ui'
+**
+** Created by: Qt User Interface Compiler version 5.12.8
+**
+** WARNING! All changes made in this file will be lost when recompiling UI file!
+********************************************************************************/
+
+#ifndef UI_DIAGNOSTICSDIALOG_H
+#define UI_DIAGNOSTICSDIALOG_H
+
+#include <QtCore/QLocale>
+#include <QtCore/QVariant>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QTableWidget>
+#include <QtWidgets/QVBoxLayout>
+
+QT_BEGIN_NAMESPACE
+
+class Ui_DiagnosticsDialog
+{
+public:
+    QVBoxLayout *verticalLayout;
+    QLabel *summaryLabel;
+    QTableWidget *tableWidget;
+    QDialogButtonBox *buttonBox;
+
+    void setupUi(QDialog *DiagnosticsDialog)
+    {
+        if (DiagnosticsDialog->objectName().isEmpty())
+            DiagnosticsDialog->setObjectName(QString::fromUtf8("DiagnosticsDialog"));
+        DiagnosticsDialog->resize(840, 480);
+        DiagnosticsDialog->setLocale(QLocale(QLocale::English, QLocale::UnitedKingdom));
+        DiagnosticsDialog->setModal(true);
+        verticalLayout = new QVBoxLayout(DiagnosticsDialog);
+        verticalLayout->setSpacing(6);
+        verticalLayout->setContentsMargins(11, 11, 11, 11);
+        verticalLayout->setObjectName(QString::fromUtf8("verticalLayout"));
+        summaryLabel = new QLabel(DiagnosticsDialog);
+        summaryLabel->setObjectName(QString::fromUtf8("summaryLabel"));
+
+        verticalLayout->addWidget(summaryLabel);
+
+        tableWidget = new QTableWidget(DiagnosticsDialog);
+        if (tableWidget->columnCount() < 10)
+            tableWidget->setColumnCount(10);
+        QTableWidgetItem *__qtablewidgetitem = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(0, __qtablewidgetitem);
+        QTableWidgetItem *__qtablewidgetitem1 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(1, __qtablewidgetitem1);
+        QTableWidgetItem *__qtablewidgetitem2 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(2, __qtablewidgetitem2);
+        QTableWidgetItem *__qtablewidgetitem3 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(3, __qtablewidgetitem3);
+        QTableWidgetItem *__qtablewidgetitem4 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(4, __qtablewidgetitem4);
+        QTableWidgetItem *__qtablewidgetitem5 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(5, __qtablewidgetitem5);
+        QTableWidgetItem *__qtablewidgetitem6 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(6, __qtablewidgetitem6);
+        QTableWidgetItem *__qtablewidgetitem7 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(7, __qtablewidgetitem7);
+        QTableWidgetItem *__qtablewidgetitem8 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(8, __qtablewidgetitem8);
+        QTableWidgetItem *__qtablewidgetitem9 = new QTableWidgetItem();
+        tableWidget->setHorizontalHeaderItem(9, __qtablewidgetitem9);
+        tableWidget->setObjectName(QString::fromUtf8("tableWidget"));
+        tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
+        tableWidget->setColumnCount(10);
+        tableWidget->verticalHeader()->setVisible(false);
+
+        verticalLayout->addWidget(tableWidget);
+
+        buttonBox = new QDialogButtonBox(DiagnosticsDialog);
+        buttonBox->setObjectName(QString::fromUtf8("buttonBox"));
+        buttonBox->setStandardButtons(QDialogButtonBox::Close|QDialogButtonBox::Save);
+
+        verticalLayout->addWidget(buttonBox);
+
+
+        retranslateUi(DiagnosticsDialog);
+        QObject::connect(buttonBox, SIGNAL(rejected()), DiagnosticsDialog, SLOT(reject()));
+
+        QMetaObject::connectSlotsByName(DiagnosticsDialog);
+    } // setupUi
+
+    void retranslateUi(QDialog *DiagnosticsDialog)
+    {
+        DiagnosticsDialog->setWindowTitle(QApplication::translate("DiagnosticsDialog", "Memory Report", nullptr));
+        summaryLabel->setText(QString());
+        QTableWidgetItem *___qtablewidgetitem = tableWidget->horizontalHeaderItem(0);
+        ___qtablewidgetitem->setText(QApplication::translate("DiagnosticsDialog", "Class", nullptr));
+        QTableWidgetItem *___qtablewidgetitem1 = tableWidget->horizontalHeaderItem(1);
+        ___qtablewidgetitem1->setText(QApplication::translate("DiagnosticsDialog", "Count", nullptr));
+        QTableWidgetItem *___qtablewidgetitem2 = tableWidget->horizontalHeaderItem(2);
+        ___qtablewidgetitem2->setText(QApplication::translate("DiagnosticsDialog", "Total", nullptr));
+        QTableWidgetItem *___qtablewidgetitem3 = tableWidget->horizontalHeaderItem(3);
+        ___qtablewidgetitem3->setText(QApplication::translate("DiagnosticsDialog", "Objects", nullptr));
+        QTableWidgetItem *___qtablewidgetitem4 = tableWidget->horizontalHeaderItem(4);
+        ___qtablewidgetitem4->setText(QApplication::translate("DiagnosticsDialog", "Strings", nullptr));
+        QTableWidgetItem *___qtablewidgetitem5 = tableWidget->horizontalHeaderItem(5);
+        ___qtablewidgetitem5->setText(QApplication::translate("DiagnosticsDialog", "Containers", nullptr));
+        QTableWidgetItem *___qtablewidgetitem6 = tableWidget->horizontalHeaderItem(6);
+        ___qtablewidgetitem6->setText(QApplication::translate("DiagnosticsDialog", "Observers", nullptr));
+        QTableWidgetItem *___qtablewidgetitem7 = tableWidget->horizontalHeaderItem(7);
+        ___qtablewidgetitem7->setText(QApplication::translate("DiagnosticsDialog", "Diagrams", nullptr));
+        QTableWidgetItem *___qtablewidgetitem8 = tableWidget->horizontalHeaderItem(8);
+        ___qtablewidgetitem8->setText(QApplication::translate("DiagnosticsDialog", "Graphics", nullptr));
+        QTableWidgetItem *___qtablewidgetitem9 = tableWidget->horizontalHeaderItem(9);
+        ___qtablewidgetitem9->setText(QApplication::translate("DiagnosticsDialog", "Undo", nullptr));
+    } // retranslateUi
+
+};
+
+namespace Ui {
+    class DiagnosticsDialog: public Ui_DiagnosticsDialog {};
+} // namespace Ui
+
+QT_END_NAMESPACE
+
+#endif // UI_DIAGNOSTICSDIALOG_H
@@ -13,9 +13,9 @@
 #include <QtCore/QVariant>
 #include <QtWidgets/QAction>
 #include <QtWidgets/QApplication>
-#include <QtWidgets/QGraphicsView>
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QWidget>
+#include "DiagramView.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -27,7 +27,7 @@ public:
     QAction *actionDeleteFromDiagram;
     QAction *actionDeleteFromModel;
     QVBoxLayout *verticalLayout;
-    QGraphicsView *graphicsView;
+    DiagramView *graphicsView;
 
     void setupUi(QWidget *DiagramPage)
     {
@@ -48,7 +48,7 @@ public:
         verticalLayout->setContentsMargins(0, 0, 0, 0);
         verticalLayout->setObjectName(QString::fromUtf8("verticalLayout"));
         verticalLayout->setContentsMargins(5, 5, 5, 5);
-        graphicsView = new QGraphicsView(DiagramPage);
+        graphicsView = new DiagramView(DiagramPage);
         graphicsView->setObjectName(QString::fromUtf8("graphicsView"));
         graphicsView->setLineWidth(0);
         graphicsView->setSizeAdjustPolicy(QAbstractScrollArea::AdjustIgnored);
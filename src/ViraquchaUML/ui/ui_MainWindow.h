@@ -37,12 +37,16 @@ public:
     QAction *actionHelp;
     QAction *actionAbout;
     QAction *actionPreferences;
+    QAction *actionRecordTrace;
+    QAction *actionMemoryReport;
     QAction *actionExit;
     QAction *actionNew;
     QAction *actionOpen;
     QAction *actionSave;
     QAction *actionSaveAs;
     QAction *actionClose;
+    QAction *actionReload;
+    QAction *actionReviewChanges;
     QAction *actionImport;
     QAction *actionExport;
     QAction *actionRecentlyUsed;
@@ -57,6 +61,7 @@ public:
     QAction *actionViewToolbox;
     QAction *actionViewProperties;
     QAction *actionAlign;
+    QAction *actionAutoLayout;
     QAction *actionZoomIn;
     QAction *actionMoveUp;
     QAction *actionMoveDown;
@@ -79,6 +84,8 @@ public:
     QAction *actionSaveToFile;
     QAction *actionSaveToClipboard;
     QAction *actionShowGrid;
+    QAction *actionShowHud;
+    QAction *actionSaveSnapshot;
     QAction *actionZoomOut;
     QAction *actionSettings;
     QTabWidget *centralWidget;
@@ -123,6 +130,11 @@ public:
         actionAbout->setObjectName(QString::fromUtf8("actionAbout"));
         actionPreferences = new QAction(MainWindowClass);
         actionPreferences->setObjectName(QString::fromUtf8("actionPreferences"));
+        actionRecordTrace = new QAction(MainWindowClass);
+        actionRecordTrace->setObjectName(QString::fromUtf8("actionRecordTrace"));
+        actionRecordTrace->setCheckable(true);
+        actionMemoryReport = new QAction(MainWindowClass);
+        actionMemoryReport->setObjectName(QString::fromUtf8("actionMemoryReport"));
         actionExit = new QAction(MainWindowClass);
         actionExit->setObjectName(QString::fromUtf8("actionExit"));
         QIcon icon2;
@@ -150,6 +162,10 @@ public:
         QIcon icon6;
         icon6.addFile(QString::fromUtf8(":/images/close_16x16.png"), QSize(), QIcon::Normal, QIcon::Off);
         actionClose->setIcon(icon6);
+        actionReload = new QAction(MainWindowClass);
+        actionReload->setObjectName(QString::fromUtf8("actionReload"));
+        actionReviewChanges = new QAction(MainWindowClass);
+        actionReviewChanges->setObjectName(QString::fromUtf8("actionReviewChanges"));
         actionImport = new QAction(MainWindowClass);
         actionImport->setObjectName(QString::fromUtf8("actionImport"));
         actionExport = new QAction(MainWindowClass);
@@ -190,6 +206,8 @@ public:
         actionViewProperties->setChecked(true);
         actionAlign = new QAction(MainWindowClass);
         actionAlign->setObjectName(QString::fromUtf8("actionAlign"));
+        actionAutoLayout = new QAction(MainWindowClass);
+        actionAutoLayout->setObjectName(QString::fromUtf8("actionAutoLayout"));
         actionZoomIn = new QAction(MainWindowClass);
         actionZoomIn->setObjectName(QString::fromUtf8("actionZoomIn"));
         actionMoveUp = new QAction(MainWindowClass);
@@ -283,6 +301,11 @@ public:
         actionShowGrid->setObjectName(QString::fromUtf8("actionShowGrid"));
         actionShowGrid->setCheckable(true);
         actionShowGrid->setChecked(true);
+        actionShowHud = new QAction(MainWindowClass);
+        actionShowHud->setObjectName(QString::fromUtf8("actionShowHud"));
+        actionShowHud->setCheckable(true);
+        actionSaveSnapshot = new QAction(MainWindowClass);
+        actionSaveSnapshot->setObjectName(QString::fromUtf8("actionSaveSnapshot"));
         actionZoomOut = new QAction(MainWindowClass);
         actionZoomOut->setObjectName(QString::fromUtf8("actionZoomOut"));
         actionSettings = new QAction(MainWindowClass);
@@ -379,6 +402,8 @@ public:
         menuApplication->addAction(actionAbout);
         menuApplication->addSeparator();
         menuApplication->addAction(actionPreferences);
+        menuApplication->addAction(actionRecordTrace);
+        menuApplication->addAction(actionMemoryReport);
         menuApplication->addSeparator();
         menuApplication->addAction(actionExit);
         menuProject->addAction(actionNew);
@@ -387,6 +412,8 @@ public:
         menuProject->addAction(actionSave);
         menuProject->addAction(actionSaveAs);
         menuProject->addAction(actionClose);
+        menuProject->addAction(actionReload);
+        menuProject->addAction(actionReviewChanges);
         menuProject->addSeparator();
         menuProject->addAction(actionImport);
         menuProject->addAction(actionExport);
@@ -406,11 +433,14 @@ public:
         menuDiagram->addAction(actionOpenDiagram);
         menuDiagram->addSeparator();
         menuDiagram->addAction(actionAlign);
+        menuDiagram->addAction(actionAutoLayout);
         menuDiagram->addSeparator();
         menuDiagram->addAction(actionZoomIn);
         menuDiagram->addAction(actionZoomOut);
         menuDiagram->addSeparator();
         menuDiagram->addAction(actionShowGrid);
+        menuDiagram->addAction(actionShowHud);
+        menuDiagram->addAction(actionSaveSnapshot);
         menuDiagram->addSeparator();
         menuDiagram->addAction(menuSaveImage->menuAction());
         menuSaveImage->addAction(actionSaveToClipboard);
@@ -484,6 +514,20 @@ public:
 #endif // QT_NO_TOOLTIP
 #ifndef QT_NO_STATUSTIP
         actionPreferences->setStatusTip(QApplication::translate("MainWindowClass", "Edit preferences", nullptr));
+#endif // QT_NO_STATUSTIP
+        actionRecordTrace->setText(QApplication::translate("MainWindowClass", "Record Trace", nullptr));
+#ifndef QT_NO_TOOLTIP
+        actionRecordTrace->setToolTip(QApplication::translate("MainWindowClass", "Starts recording a performance trace; saves the trace to a file when stopped", nullptr));
+#endif // QT_NO_TOOLTIP
+#ifndef QT_NO_STATUSTIP
+        actionRecordTrace->setStatusTip(QApplication::translate("MainWindowClass", "Record performance trace", nullptr));
+#endif // QT_NO_STATUSTIP
+        actionMemoryReport->setText(QApplication::translate("MainWindowClass", "Memory Report...", nullptr));
+#ifndef QT_NO_TOOLTIP
+        actionMemoryReport->setToolTip(QApplication::translate("MainWindowClass", "Shows the estimated memory used by the project, its open diagrams and the undo stack", nullptr));
+#endif // QT_NO_TOOLTIP
+#ifndef QT_NO_STATUSTIP
+        actionMemoryReport->setStatusTip(QApplication::translate("MainWindowClass", "Show memory report", nullptr));
 #endif // QT_NO_STATUSTIP
         actionExit->setText(QApplication::translate("MainWindowClass", "Exit", nullptr));
 #ifndef QT_NO_TOOLTIP
@@ -535,6 +579,23 @@ public:
 #endif // QT_NO_TOOLTIP
 #ifndef QT_NO_STATUSTIP
         actionClose->setStatusTip(QApplication::translate("MainWindowClass", "Close project", nullptr));
+#endif // QT_NO_STATUSTIP
+        actionReload->setText(QApplication::translate("MainWindowClass", "Reload", nullptr));
+#ifndef QT_NO_TOOLTIP
+        actionReload->setToolTip(QApplication::translate("MainWindowClass", "Reads the files of the project changed outside of the program again", nullptr));
+#endif // QT_NO_TOOLTIP
+#ifndef QT_NO_STATUSTIP
+        actionReload->setStatusTip(QApplication::translate("MainWindowClass", "Reload changed files", nullptr));
+#endif // QT_NO_STATUSTIP
+#ifndef QT_NO_SHORTCUT
+        actionReload->setShortcut(QApplication::translate("MainWindowClass", "F5", nullptr));
+#endif // QT_NO_SHORTCUT
+        actionReviewChanges->setText(QApplication::translate("MainWindowClass", "Review Changes...", nullptr));
+#ifndef QT_NO_TOOLTIP
+        actionReviewChanges->setToolTip(QApplication::translate("MainWindowClass", "Shows the elements changed since the project was saved the last time", nullptr));
+#endif // QT_NO_TOOLTIP
+#ifndef QT_NO_STATUSTIP
+        actionReviewChanges->setStatusTip(QApplication::translate("MainWindowClass", "Review changes", nullptr));
 #endif // QT_NO_STATUSTIP
         actionImport->setText(QApplication::translate("MainWindowClass", "Import...", nullptr));
 #ifndef QT_NO_TOOLTIP
@@ -623,6 +684,13 @@ public:
         actionViewToolbox->setText(QApplication::translate("MainWindowClass", "Toolbox", nullptr));
         actionViewProperties->setText(QApplication::translate("MainWindowClass", "Properties", nullptr));
         actionAlign->setText(QApplication::translate("MainWindowClass", "Align", nullptr));
+        actionAutoLayout->setText(QApplication::translate("MainWindowClass", "Layout Automatically", nullptr));
+#ifndef QT_NO_TOOLTIP
+        actionAutoLayout->setToolTip(QApplication::translate("MainWindowClass", "Arranges the shapes of a diagram automatically", nullptr));
+#endif // QT_NO_TOOLTIP
+#ifndef QT_NO_STATUSTIP
+        actionAutoLayout->setStatusTip(QApplication::translate("MainWindowClass", "Layout diagram automatically", nullptr));
+#endif // QT_NO_STATUSTIP
         actionZoomIn->setText(QApplication::translate("MainWindowClass", "Zoom in", nullptr));
 #ifndef QT_NO_SHORTCUT
         actionZoomIn->setShortcut(QApplication::translate("MainWindowClass", "+", nullptr));
@@ -753,6 +821,20 @@ public:
 #endif // QT_NO_TOOLTIP
 #ifndef QT_NO_STATUSTIP
         actionShowGrid->setStatusTip(QApplication::translate("MainWindowClass", "Show grid in diagrams", nullptr));
+#endif // QT_NO_STATUSTIP
+        actionShowHud->setText(QApplication::translate("MainWindowClass", "Show Performance HUD", nullptr));
+#ifndef QT_NO_TOOLTIP
+        actionShowHud->setToolTip(QApplication::translate("MainWindowClass", "Shows or hides frame times and painting counters over the diagrams", nullptr));
+#endif // QT_NO_TOOLTIP
+#ifndef QT_NO_STATUSTIP
+        actionShowHud->setStatusTip(QApplication::translate("MainWindowClass", "Show performance HUD in diagrams", nullptr));
+#endif // QT_NO_STATUSTIP
+        actionSaveSnapshot->setText(QApplication::translate("MainWindowClass", "Save Performance Snapshot...", nullptr));
+#ifndef QT_NO_TOOLTIP
+        actionSaveSnapshot->setToolTip(QApplication::translate("MainWindowClass", "Saves the frame times and painting counters of the current diagram to a file", nullptr));
+#endif // QT_NO_TOOLTIP
+#ifndef QT_NO_STATUSTIP
+        actionSaveSnapshot->setStatusTip(QApplication::translate("MainWindowClass", "Save performance snapshot of diagram", nullptr));
 #endif // QT_NO_STATUSTIP
         actionZoomOut->setText(QApplication::translate("MainWindowClass", "Zoom out", nullptr));
 #ifndef QT_NO_SHORTCUT
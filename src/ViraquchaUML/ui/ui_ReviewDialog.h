@@ -0,0 +1,88 @@
+/********************************************************************************
+** Form generated from reading UI file 'ReviewDialog.ui'
+**
+** Created by: Qt User Interface Compiler version 5.12.8
+**
+** WARNING! All changes made in this file will be lost when recompiling UI file!
+********************************************************************************/
+
+#ifndef UI_REVIEWDIALOG_H
+#define UI_REVIEWDIALOG_H
+
+#include <QtCore/QLocale>
+#include <QtCore/QVariant>
+#include <QtWidgets/QApplication>
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+QT_BEGIN_NAMESPACE
+
+class Ui_ReviewDialog
+{
+public:
+    QVBoxLayout *verticalLayout;
+    QLabel *summaryLabel;
+    QTreeWidget *treeWidget;
+    QDialogButtonBox *buttonBox;
+
+    void setupUi(QDialog *ReviewDialog)
+    {
+        if (ReviewDialog->objectName().isEmpty())
+            ReviewDialog->setObjectName(QString::fromUtf8("ReviewDialog"));
+        ReviewDialog->resize(840, 480);
+        ReviewDialog->setLocale(QLocale(QLocale::English, QLocale::UnitedKingdom));
+        ReviewDialog->setModal(true);
+        verticalLayout = new QVBoxLayout(ReviewDialog);
+        verticalLayout->setSpacing(6);
+        verticalLayout->setContentsMargins(11, 11, 11, 11);
+        verticalLayout->setObjectName(QString::fromUtf8("verticalLayout"));
+        summaryLabel = new QLabel(ReviewDialog);
+        summaryLabel->setObjectName(QString::fromUtf8("summaryLabel"));
+
+        verticalLayout->addWidget(summaryLabel);
+
+        treeWidget = new QTreeWidget(ReviewDialog);
+        treeWidget->setObjectName(QString::fromUtf8("treeWidget"));
+        treeWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        treeWidget->setAlternatingRowColors(true);
+        treeWidget->setColumnCount(4);
+
+        verticalLayout->addWidget(treeWidget);
+
+        buttonBox = new QDialogButtonBox(ReviewDialog);
+        buttonBox->setObjectName(QString::fromUtf8("buttonBox"));
+        buttonBox->setStandardButtons(QDialogButtonBox::Close|QDialogButtonBox::Save);
+
+        verticalLayout->addWidget(buttonBox);
+
+
+        retranslateUi(ReviewDialog);
+        QObject::connect(buttonBox, SIGNAL(rejected()), ReviewDialog, SLOT(reject()));
+
+        QMetaObject::connectSlotsByName(ReviewDialog);
+    } // setupUi
+
+    void retranslateUi(QDialog *ReviewDialog)
+    {
+        ReviewDialog->setWindowTitle(QApplication::translate("ReviewDialog", "Review Changes", nullptr));
+        summaryLabel->setText(QString());
+        QTreeWidgetItem *___qtreewidgetitem = treeWidget->headerItem();
+        ___qtreewidgetitem->setText(3, QApplication::translate("ReviewDialog", "Current", nullptr));
+        ___qtreewidgetitem->setText(2, QApplication::translate("ReviewDialog", "Saved", nullptr));
+        ___qtreewidgetitem->setText(1, QApplication::translate("ReviewDialog", "Element", nullptr));
+        ___qtreewidgetitem->setText(0, QApplication::translate("ReviewDialog", "Change", nullptr));
+    } // retranslateUi
+
+};
+
+namespace Ui {
+    class ReviewDialog: public Ui_ReviewDialog {};
+} // namespace Ui
+
+QT_END_NAMESPACE
+
+#endif // UI_REVIEWDIALOG_H